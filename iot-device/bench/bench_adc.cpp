@@ -0,0 +1,113 @@
+/**
+ * ADS1115 acquisition benchmark (simulation HAL)
+ *
+ * Times SkinSensor::readSensorData() with each AdcReadyMode and prints
+ * the per-stage timing of the pipelined acquisition (SHT31, VL6180X and
+ * the three ADS1115 channels are collected as each becomes ready). The
+ * simulated devices model their conversion latency, so the difference
+ * between modes is the time spent waiting beyond the conversions.
+ *
+ * "i2c txn" counts bus transactions per frame and "calls" the HAL calls
+ * they took (a batch of transactions is one call). The simulated bus
+ * charges each transaction its wire time at I2C_SPEED_HZ.
+ *
+ * With --virtual the sensor runs on a VirtualClock: ms/read is then
+ * virtual (model) time, identical from run to run, and "wall ms" shows
+ * what a read actually costs in CPU time.
+ *
+ * Usage: bench_adc [reads] [data rate SPS] [--virtual]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "SkinSensor.h"
+
+namespace {
+
+const char* modeName(SkinSensor::AdcReadyMode mode)
+{
+    switch (mode) {
+        case SkinSensor::AdcReadyMode::FIXED_DELAY:    return "fixed delay";
+        case SkinSensor::AdcReadyMode::POLL_STATUS:    return "status poll";
+        case SkinSensor::AdcReadyMode::DRDY_INTERRUPT: return "DRDY interrupt";
+    }
+    return "?";
+}
+
+struct Result {
+    double msPerRead;                       // On the sensor's clock
+    double wallMsPerRead;
+    SkinSensor::AcquisitionTiming timing;   // Last frame
+};
+
+Result measure(SkinSensor::AdcReadyMode mode, int reads, int dataRate, bool virtualTime)
+{
+    Result result = Result();
+
+    VirtualClock virtualClock;
+    Clock& clock = virtualTime ? static_cast<Clock&>(virtualClock) : Clock::system();
+
+    SkinSensor sensor;
+    sensor.setClock(clock);
+    sensor.setAdcReadyMode(mode);
+    sensor.setAdcDataRate(dataRate);
+    if (!sensor.initialize()) {
+        result.msPerRead = -1.0;
+        return result;
+    }
+
+    sensor.readSensorData();    // Warm up
+
+    auto start = clock.now();
+    auto wallStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < reads; i++) {
+        sensor.readSensorData();
+    }
+    auto elapsed = clock.now() - start;
+    auto wallElapsed = std::chrono::steady_clock::now() - wallStart;
+    result.msPerRead = std::chrono::duration<double, std::milli>(elapsed).count() / reads;
+    result.wallMsPerRead = std::chrono::duration<double, std::milli>(wallElapsed).count() / reads;
+    result.timing = sensor.getLastAcquisitionTiming();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int reads = (argc > 1) ? std::atoi(argv[1]) : 50;
+    int dataRate = (argc > 2) ? std::atoi(argv[2]) : 128;
+    bool virtualTime = (argc > 3) && std::strcmp(argv[3], "--virtual") == 0;
+
+    const SkinSensor::AdcReadyMode modes[] = {
+        SkinSensor::AdcReadyMode::FIXED_DELAY,
+        SkinSensor::AdcReadyMode::POLL_STATUS,
+        SkinSensor::AdcReadyMode::DRDY_INTERRUPT
+    };
+
+    Result results[3];
+    for (int i = 0; i < 3; i++) {
+        // Keep the sensor's initialization log out of the report
+        std::streambuf* saved = std::cout.rdbuf(nullptr);
+        results[i] = measure(modes[i], reads, dataRate, virtualTime);
+        std::cout.rdbuf(saved);
+    }
+
+    std::printf("readSensorData(), %d reads at %d SPS (3 ADC channels), %s time\n",
+                reads, dataRate, virtualTime ? "virtual" : "real");
+    std::printf("  %-16s %8s | stage done at (ms): %6s %6s %6s %6s %6s | %6s | %7s %5s | %8s\n",
+                "mode", "ms/read", "SHT31", "ToF", "AIN0", "AIN1", "AIN2", "waited", "i2c txn", "calls", "wall ms");
+    for (int i = 0; i < 3; i++) {
+        const SkinSensor::AcquisitionTiming& t = results[i].timing;
+        std::printf("  %-16s %8.2f | %19s %6.2f %6.2f %6.2f %6.2f %6.2f | %6.2f | %7u %5u | %8.3f\n",
+                    modeName(modes[i]), results[i].msPerRead, "",
+                    t.climateUs / 1000.0, t.rangeUs / 1000.0,
+                    t.adcUs[0] / 1000.0, t.adcUs[1] / 1000.0, t.adcUs[2] / 1000.0,
+                    t.busWaitUs / 1000.0, t.busTransactions, t.busCalls, results[i].wallMsPerRead);
+    }
+    return 0;
+}
@@ -0,0 +1,248 @@
+/**
+ * Edge window aggregation benchmark
+ *
+ * Feeds a simulated sensor stream (SkinSensor on the simulation HAL and
+ * a VirtualClock, one read per SENSOR_READ_INTERVAL_MS) through a
+ * WindowAggregator and reports:
+ * - WindowAggregator::add() ns/sample
+ * - upload bytes: every sample as a JSON record vs one summary record
+ *   per window
+ * - per channel, how far the P² quantile estimates are from the exact
+ *   quantiles of each window of 50 samples or more, as a rank error
+ *   (share of the window's samples between the estimate and the exact
+ *   quantile)
+ *
+ * min, max, mean and standard deviation are checked against a two-pass
+ * computation and category counts against a direct count; the exit
+ * status is nonzero on a mismatch. The quantile error is only reported:
+ * P² assumes a roughly stationary window and lags after a step change
+ * inside one (the simulated pd1 has such steps).
+ *
+ * Usage: bench_aggregate [samples] [window seconds]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Config.h"
+#include "Payload.h"
+#include "SkinSensor.h"
+#include "WindowAggregator.h"
+
+namespace {
+
+using SensorData = SkinSensor::SensorData;
+
+const std::string DEVICE_ID = "THE3-SKIN-DEVICE-001";
+const size_t MIN_QUANTILE_SAMPLES = 50;
+
+std::vector<SensorData> acquire(size_t count)
+{
+    VirtualClock clock;
+    SkinSensor sensor;
+    sensor.setClock(clock);
+    if (!sensor.initialize()) {
+        return {};
+    }
+    sensor.setPatientInfo("Hong Gildong", "1990-01-01");
+
+    std::vector<SensorData> records;
+    records.reserve(count);
+    auto next = clock.now();
+    for (size_t i = 0; i < count; i++) {
+        records.push_back(sensor.readSensorData());
+        next += std::chrono::milliseconds(Config::SENSOR_READ_INTERVAL_MS);
+        clock.sleepUntil(next);
+    }
+    return records;
+}
+
+// Same order as WindowAggregator's channels
+float channelValue(const SensorData& data, size_t channel)
+{
+    const float values[WindowAggregator::CHANNELS] = {
+        data.pd1, data.pd2, data.s1, data.s2, data.s3, data.moistureLevel, data.temperatureC
+    };
+    return values[channel];
+}
+
+// Share of `sorted` between the estimate's rank and the target rank p.
+// An estimate between two sample values ranks anywhere up to the upper
+// one (discrete channels such as s2 have few distinct values).
+double rankError(const std::vector<float>& sorted, double estimate, double p)
+{
+    auto below = std::lower_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin();
+    auto atOrBelow = std::upper_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin();
+    if (below == atOrBelow && atOrBelow < static_cast<std::ptrdiff_t>(sorted.size())) {
+        atOrBelow = std::upper_bound(sorted.begin(), sorted.end(), sorted[atOrBelow]) - sorted.begin();
+    }
+    double n = static_cast<double>(sorted.size());
+    double target = p * n;
+    if (target < below) {
+        return (below - target) / n;
+    }
+    if (target > atOrBelow) {
+        return (target - atOrBelow) / n;
+    }
+    return 0.0;
+}
+
+struct Check {
+    double maxRankError[WindowAggregator::CHANNELS];
+    double sumRankError[WindowAggregator::CHANNELS];
+    size_t estimates;           // Per channel
+    bool ok;
+};
+
+// Compare a summary with the exact statistics of its samples
+void verify(const WindowAggregator::Summary& summary, const std::vector<SensorData>& window, Check& check)
+{
+    if (summary.samples != window.size()) {
+        check.ok = false;
+        return;
+    }
+
+    for (size_t c = 0; c < WindowAggregator::CHANNELS; c++) {
+        std::vector<float> values;
+        double sum = 0.0;
+        for (const auto& data : window) {
+            values.push_back(channelValue(data, c));
+            sum += values.back();
+        }
+        double mean = sum / values.size();
+        double squares = 0.0;
+        for (float value : values) {
+            squares += (value - mean) * (value - mean);
+        }
+        double stddev = values.size() > 1 ? std::sqrt(squares / (values.size() - 1)) : 0.0;
+        std::sort(values.begin(), values.end());
+
+        const auto& channel = summary.channels[c];
+        if (channel.min != values.front() || channel.max != values.back() ||
+            std::fabs(channel.mean - mean) > 1e-9 * (std::fabs(mean) + 1.0) ||
+            std::fabs(channel.stddev - stddev) > 1e-6 * (stddev + 1.0)) {
+            check.ok = false;
+        }
+        // P² needs some samples to settle; short (partial) windows are left out
+        for (size_t q = 0; q < WindowAggregator::QUANTILES && values.size() >= MIN_QUANTILE_SAMPLES; q++) {
+            double error = rankError(values, channel.quantiles[q], WindowAggregator::QUANTILE_P[q]);
+            check.maxRankError[c] = std::max(check.maxRankError[c], error);
+            check.sumRankError[c] += error;
+            check.estimates += (c == 0) ? 1 : 0;
+        }
+    }
+
+    const std::string SensorData::* fields[WindowAggregator::CATEGORIES] = {
+        &SensorData::moistureLevelResult, &SensorData::elasticityResult, &SensorData::thicknessResult
+    };
+    for (size_t c = 0; c < WindowAggregator::CATEGORIES; c++) {
+        std::map<std::string, uint32_t> expected;
+        for (const auto& data : window) {
+            expected[data.*(fields[c])]++;
+        }
+        std::map<std::string, uint32_t> counted;
+        for (const auto& count : summary.categories[c].counts) {
+            counted[count.value] = count.count;
+        }
+        if (counted != expected) {
+            check.ok = false;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t count = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 3600;
+    int windowSec = (argc > 2) ? std::atoi(argv[2]) : Config::AGGREGATION_WINDOW_SEC;
+
+    // Keep the sensor's log out of the report
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    std::vector<SensorData> records = acquire(count);
+    std::cout.rdbuf(saved);
+    if (records.empty()) {
+        std::fprintf(stderr, "Sensor failed to initialize\n");
+        return 1;
+    }
+
+    // Throughput: add() only
+    const uint64_t windowMs = static_cast<uint64_t>(std::max(windowSec, 1)) * 1000;
+    const int repeat = 20;
+    uint64_t windows = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; r++) {
+        WindowAggregator aggregator(windowMs);
+        for (const auto& data : records) {
+            aggregator.add(data);
+        }
+        aggregator.flush();
+        windows += aggregator.getStats().windows;
+    }
+    double addNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                   (static_cast<double>(records.size()) * repeat);
+
+    // Upload volume and accuracy
+    WindowAggregator aggregator(windowMs);
+    Check check = Check();
+    check.ok = true;
+    std::string json;
+    size_t rawBytes = 0;
+    size_t summaryBytes = 0;
+    size_t summaries = 0;
+    size_t first = 0;
+
+    auto summarize = [&](size_t end) {
+        json.clear();
+        Payload::appendWindowSummaryJson(json, aggregator.summary(), DEVICE_ID);
+        summaryBytes += json.size();
+        summaries++;
+        std::vector<SensorData> window(records.begin() + first, records.begin() + end);
+        verify(aggregator.summary(), window, check);
+        first = end;
+    };
+
+    for (size_t i = 0; i < records.size(); i++) {
+        json.clear();
+        Payload::appendSkinAnalysisJson(json, records[i], DEVICE_ID);
+        rawBytes += json.size();
+        if (aggregator.add(records[i])) {
+            summarize(i);
+        }
+    }
+    if (aggregator.flush()) {
+        summarize(records.size());
+    }
+
+    std::printf("Window aggregation: %zu samples, %d s windows, %zu summaries\n", records.size(), windowSec,
+                summaries);
+    std::printf("  add            %8.1f ns/sample (%llu windows in %d runs)\n", addNs,
+                static_cast<unsigned long long>(windows), repeat);
+    std::printf("  upload JSON    %8zu bytes raw, %zu bytes summaries (%.0fx less, %.0f bytes/summary)\n",
+                rawBytes, summaryBytes, static_cast<double>(rawBytes) / std::max<size_t>(summaryBytes, 1),
+                static_cast<double>(summaryBytes) / std::max<size_t>(summaries, 1));
+    std::printf("  P2 rank error (p10/p50/p90, %zu estimates per channel):\n", check.estimates);
+    std::printf("    %-14s %7s %7s\n", "channel", "mean", "max");
+
+    const char* names[WindowAggregator::CHANNELS] = {
+        "pd1", "pd2", "s1", "s2", "s3", "moistureLevel", "temperatureC"
+    };
+    for (size_t c = 0; c < WindowAggregator::CHANNELS; c++) {
+        std::printf("    %-14s %6.2f%% %6.2f%%\n", names[c],
+                    check.sumRankError[c] * 100.0 / std::max<size_t>(check.estimates, 1),
+                    check.maxRankError[c] * 100.0);
+    }
+
+    if (!check.ok) {
+        std::printf("MISMATCH: summaries differ from the exact window statistics\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,177 @@
+/**
+ * Change-only upload benchmark
+ *
+ * Feeds a simulated sensor stream (SkinSensor on the simulation HAL and
+ * a VirtualClock, one read per SENSOR_READ_INTERVAL_MS: a probe resting
+ * on the skin) through a ChangeFilter and reports:
+ * - ChangeFilter::add() ns/sample
+ * - uploaded and suppressed samples, uploads per reason and channel, and
+ *   upload JSON bytes against uploading every sample
+ * - per channel, the largest gap between a sample and the last uploaded
+ *   value (what the server believes), in deadbands
+ * - per channel, how many samples it takes to report a step of half a
+ *   deadband (CUSUM) and of two deadbands (deadband) added to the stream
+ *   from the middle on
+ *
+ * The exit status is nonzero if a sample ever differs from the last
+ * upload by more than its deadband, or a step goes unreported.
+ *
+ * Usage: bench_changes [samples] [heartbeat seconds]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ChangeFilter.h"
+#include "Config.h"
+#include "Payload.h"
+#include "SkinSensor.h"
+
+namespace {
+
+using SensorData = SkinSensor::SensorData;
+
+const std::string DEVICE_ID = "THE3-SKIN-DEVICE-001";
+
+// Same order as ChangeFilter's channels
+float SensorData::* const CHANNELS[ChangeFilter::CHANNELS] = {
+    &SensorData::pd1, &SensorData::pd2, &SensorData::s1, &SensorData::s2,
+    &SensorData::s3, &SensorData::moistureLevel, &SensorData::temperatureC
+};
+
+std::vector<SensorData> acquire(size_t count)
+{
+    VirtualClock clock;
+    SkinSensor sensor;
+    sensor.setClock(clock);
+    if (!sensor.initialize()) {
+        return {};
+    }
+    sensor.setPatientInfo("Hong Gildong", "1990-01-01");
+
+    std::vector<SensorData> records;
+    records.reserve(count);
+    auto next = clock.now();
+    for (size_t i = 0; i < count; i++) {
+        records.push_back(sensor.readSensorData());
+        next += std::chrono::milliseconds(Config::SENSOR_READ_INTERVAL_MS);
+        clock.sleepUntil(next);
+    }
+    return records;
+}
+
+// Samples from the step until the channel itself triggers an upload; -1 if never
+long stepLatency(const std::vector<SensorData>& records, uint64_t heartbeatMs, size_t channel, float step)
+{
+    ChangeFilter filter(heartbeatMs);
+    size_t start = records.size() / 2;
+    for (size_t i = 0; i < records.size(); i++) {
+        SensorData data = records[i];
+        if (i >= start) {
+            data.*(CHANNELS[channel]) += step;
+        }
+        uint64_t before = filter.getStats().byChannel[channel];
+        filter.add(data);
+        if (i >= start && filter.getStats().byChannel[channel] != before) {
+            return static_cast<long>(i - start);
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t count = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 3600;
+    int heartbeatSec = (argc > 2) ? std::atoi(argv[2]) : Config::CHANGE_HEARTBEAT_SEC;
+    const uint64_t heartbeatMs = static_cast<uint64_t>(std::max(heartbeatSec, 0)) * 1000;
+
+    // Keep the sensor's log out of the report
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    std::vector<SensorData> records = acquire(count);
+    std::cout.rdbuf(saved);
+    if (records.empty()) {
+        std::fprintf(stderr, "Sensor failed to initialize\n");
+        return 1;
+    }
+
+    // Throughput: add() only
+    const int repeat = 20;
+    uint64_t uploads = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; r++) {
+        ChangeFilter filter(heartbeatMs);
+        for (const auto& data : records) {
+            filter.add(data);
+        }
+        uploads += filter.getStats().uploaded;
+    }
+    double addNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                   (static_cast<double>(records.size()) * repeat);
+
+    // Upload volume and what the server sees
+    ChangeFilter filter(heartbeatMs);
+    std::string json;
+    size_t rawBytes = 0;
+    size_t changeBytes = 0;
+    float server[ChangeFilter::CHANNELS] = {};
+    double maxGap[ChangeFilter::CHANNELS] = {};
+    bool ok = true;
+
+    for (const auto& data : records) {
+        json.clear();
+        Payload::appendSkinAnalysisJson(json, data, DEVICE_ID);
+        rawBytes += json.size();
+        if (filter.add(data) != ChangeFilter::Reason::NONE) {
+            changeBytes += json.size();
+            for (size_t c = 0; c < ChangeFilter::CHANNELS; c++) {
+                server[c] = data.*(CHANNELS[c]);
+            }
+        }
+        for (size_t c = 0; c < ChangeFilter::CHANNELS; c++) {
+            double gap = std::fabs(data.*(CHANNELS[c]) - server[c]) / filter.deadband(c);
+            maxGap[c] = std::max(maxGap[c], gap);
+            ok = ok && gap <= 1.0;
+        }
+    }
+
+    auto stats = filter.getStats();
+    std::printf("Change filter: %zu samples, heartbeat %d s\n", records.size(), heartbeatSec);
+    std::printf("  add            %8.1f ns/sample (%llu uploads in %d runs)\n", addNs,
+                static_cast<unsigned long long>(uploads), repeat);
+    std::printf("  uploaded       %8llu samples (%.1f%%), %llu suppressed\n",
+                static_cast<unsigned long long>(stats.uploaded), stats.uploaded * 100.0 / records.size(),
+                static_cast<unsigned long long>(stats.suppressed));
+    std::printf("  by reason     ");
+    for (size_t r = 1; r < ChangeFilter::REASONS; r++) {
+        std::printf(" %s %llu", ChangeFilter::reasonName(static_cast<ChangeFilter::Reason>(r)),
+                    static_cast<unsigned long long>(stats.byReason[r]));
+    }
+    std::printf("\n");
+    std::printf("  upload JSON    %8zu bytes raw, %zu bytes changes (%.0fx less)\n", rawBytes, changeBytes,
+                static_cast<double>(rawBytes) / std::max<size_t>(changeBytes, 1));
+    std::printf("    %-14s %9s %8s %8s %10s %10s\n", "channel", "deadband", "uploads", "max gap",
+                "0.5 step", "2 step");
+
+    for (size_t c = 0; c < ChangeFilter::CHANNELS; c++) {
+        long small = stepLatency(records, heartbeatMs, c, 0.5f * filter.deadband(c));
+        long large = stepLatency(records, heartbeatMs, c, 2.0f * filter.deadband(c));
+        ok = ok && small >= 0 && large >= 0;
+        std::printf("    %-14s %9.2f %8llu %8.2f %7ld smp %7ld smp\n", ChangeFilter::channelName(c),
+                    filter.deadband(c), static_cast<unsigned long long>(stats.byChannel[c]), maxGap[c],
+                    small, large);
+    }
+
+    if (!ok) {
+        std::printf("MISMATCH: a change went unreported\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * CRC throughput benchmark
+ *
+ * CRC-16-CCITT over buffers from one queue record to a large batch, with
+ * each kernel (bitwise reference, byte table, slicing-by-8), plus the
+ * incremental API fed in uneven chunks and the SHT31 CRC-8 per word.
+ * Every kernel must give the same value for the same buffer; the exit
+ * status is nonzero otherwise.
+ *
+ * Usage: bench_crc [total MiB per measurement]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "Crc.h"
+
+namespace {
+
+template <typename Fn>
+double measureMBps(size_t bufferSize, size_t totalBytes, Fn fn)
+{
+    size_t rounds = totalBytes / bufferSize + 1;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < rounds; i++) {
+        fn();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(rounds * bufferSize) / seconds / 1e6;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t totalMiB = (argc > 1) ? static_cast<size_t>(std::atoi(argv[1])) : 64;
+    size_t totalBytes = totalMiB << 20;
+
+    const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    const uint8_t word[] = { 0xBE, 0xEF };
+    bool ok = Crc16::compute(check, sizeof(check)) == 0x29B1 && Crc8::compute(word, sizeof(word)) == 0x92;
+
+    std::vector<uint8_t> data(1 << 20);
+    uint32_t seed = 12345;
+    for (auto& byte : data) {
+        seed = seed * 1664525u + 1013904223u;
+        byte = static_cast<uint8_t>(seed >> 24);
+    }
+
+    const Crc16::Method methods[] = { Crc16::Method::BITWISE, Crc16::Method::TABLE, Crc16::Method::SLICE8 };
+    const size_t sizes[] = { 64, 1024, 65536 };
+    volatile uint16_t sink = 0;
+
+    std::printf("CRC-16-CCITT throughput (MB/s), %zu MiB per measurement\n", totalMiB);
+    std::printf("  %-14s %10s %10s %10s\n", "kernel", "64 B", "1 KiB", "64 KiB");
+    for (Crc16::Method method : methods) {
+        std::printf("  %-14s", Crc16::methodName(method));
+        // The reference kernel is ~10x slower; a tenth of the data is plenty
+        size_t bytes = (method == Crc16::Method::BITWISE) ? totalBytes / 10 : totalBytes;
+        for (size_t size : sizes) {
+            double mbps = measureMBps(size, bytes, [&]() {
+                sink = Crc16::compute(data.data(), size, method);
+            });
+            std::printf(" %10.1f", mbps);
+            ok = ok && Crc16::compute(data.data(), size, method) == Crc16::compute(data.data(), size, Crc16::Method::BITWISE);
+        }
+        std::printf("\n");
+    }
+
+    // Incremental: the same 64 KiB in chunks of 1..61 bytes
+    const size_t streamSize = 65536;
+    auto streamed = [&]() {
+        Crc16 crc;
+        size_t offset = 0;
+        for (size_t chunk = 1; offset < streamSize; chunk = chunk % 61 + 1) {
+            size_t length = (streamSize - offset < chunk) ? streamSize - offset : chunk;
+            crc.update(data.data() + offset, length);
+            offset += length;
+        }
+        return crc.value();
+    };
+    double streamMBps = measureMBps(streamSize, totalBytes, [&]() { sink = streamed(); });
+    std::printf("  %-14s %32.1f  (64 KiB in 1..61 byte chunks)\n", "streaming", streamMBps);
+    ok = ok && streamed() == Crc16::compute(data.data(), streamSize, Crc16::Method::BITWISE);
+
+    // SHT31: one CRC-8 per 2-byte word
+    const size_t words = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    uint32_t crc8Sum = 0;
+    for (size_t i = 0; i < words; i++) {
+        crc8Sum += Crc8::compute(&data[(i * 2) & (data.size() - 1)], 2);
+    }
+    double tableNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / words;
+
+    start = std::chrono::steady_clock::now();
+    uint32_t bitwiseSum = 0;
+    for (size_t i = 0; i < words; i++) {
+        bitwiseSum += Crc8::computeBitwise(&data[(i * 2) & (data.size() - 1)], 2);
+    }
+    double bitwiseNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / words;
+    ok = ok && crc8Sum == bitwiseSum;
+
+    std::printf("Sensirion CRC-8 per SHT31 word: table %.2f ns, bitwise %.2f ns\n", tableNs, bitwiseNs);
+    std::printf("kernels agree: %s\n", ok ? "yes" : "NO");
+    (void)sink;
+    return ok ? 0 : 1;
+}
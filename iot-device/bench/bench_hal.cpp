@@ -0,0 +1,139 @@
+/**
+ * Static vs virtual HAL dispatch benchmark
+ *
+ * Runs SkinSensor's register access layer (HAL::SensorBus) over the same
+ * in-memory bus twice: as SensorBus<RegisterFileI2C>, where the bus type
+ * is final and every call binds statically and inlines (what
+ * THE3_STATIC_HAL gives SkinSensor on PLATFORM_RPI), and as
+ * SensorBus<I2CInterface>, where each transfer is a virtual call (the
+ * default, which trace/replay and simulation need).
+ *
+ * The bus answers from a register array, so the time is the register
+ * helpers and the dispatch alone; on real hardware each transfer also
+ * costs its ioctl and wire time (~100 us at 400 kHz).
+ *
+ * Usage: bench_hal [operations]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "SensorBus.h"
+
+namespace {
+
+/**
+ * Bus backed by a 256-entry register file per address: a write sets the
+ * register pointer (first byte) and stores the rest, a read returns bytes
+ * from the pointer on
+ */
+class RegisterFileI2C final : public HAL::I2CInterface {
+public:
+    RegisterFileI2C() : m_pointer() { std::memset(m_registers, 0x5A, sizeof(m_registers)); }
+
+    bool initialize(int /*busNumber*/) override { return true; }
+    void cleanup() override {}
+    bool isDevicePresent(uint8_t /*deviceAddr*/) override { return true; }
+
+    bool transfer(HAL::I2CMessage* messages, size_t count) override
+    {
+        for (size_t i = 0; i < count; i++) {
+            HAL::I2CMessage& message = messages[i];
+            uint8_t address = message.address & 0x7F;
+            uint8_t* registers = m_registers[address];
+            if (message.isRead()) {
+                for (size_t b = 0; b < message.length; b++) {
+                    message.buffer[b] = registers[static_cast<uint8_t>(m_pointer[address] + b)];
+                }
+            } else if (message.length > 0) {
+                m_pointer[address] = message.buffer[0];
+                for (size_t b = 1; b < message.length; b++) {
+                    registers[static_cast<uint8_t>(m_pointer[address] + b - 1)] = message.buffer[b];
+                }
+            }
+        }
+        return true;
+    }
+
+    size_t transferBatch(HAL::I2CTransaction* transactions, size_t count) override
+    {
+        for (size_t i = 0; i < count; i++) {
+            transactions[i].ok = transfer(transactions[i].messages, transactions[i].count);
+        }
+        return count;
+    }
+
+private:
+    uint8_t m_pointer[128];
+    uint8_t m_registers[128][256];
+};
+
+/**
+ * The acquisition's register traffic pattern for one ADC sample: config
+ * write, conversion read, ToF status poll, and a batched read + restart
+ */
+template <typename Bus>
+uint32_t samplePattern(HAL::SensorBus<Bus>& bus, uint16_t config)
+{
+    uint32_t sum = 0;
+    bus.adcWriteRegister(HAL::ADC::REG_CONFIG, config);
+    sum += bus.adcReadRegister(HAL::ADC::REG_CONVERSION);       // Pointer write + read
+    sum += bus.adcReadRegister(HAL::ADC::REG_CONVERSION);       // Read only
+    sum += bus.tofReadRegister(HAL::ToFSensor::REG_RESULT_INTERRUPT_STATUS);
+
+    uint8_t raw[2];
+    HAL::I2CBatch batch;
+    bus.queueAdcRead(batch, raw);
+    bus.queueAdcWrite(batch, HAL::ADC::REG_CONFIG, config);
+    bus.submit(batch);
+    return sum + raw[0] + raw[1];
+}
+
+template <typename Bus>
+double measure(HAL::SensorBus<Bus>& bus, int operations, uint32_t& checksum)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < operations; i++) {
+        checksum += samplePattern(bus, static_cast<uint16_t>(0x8000 | (i & 0x7FFF)));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / operations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int operations = (argc > 1) ? std::atoi(argv[1]) : 2000000;
+
+    RegisterFileI2C bus;
+
+    // Through a volatile pointer so the compiler cannot see the dynamic type
+    HAL::I2CInterface* volatile opaque = &bus;
+    HAL::I2CInterface* dynamicBus = opaque;
+
+    HAL::SensorBus<RegisterFileI2C> staticAccess;
+    HAL::SensorBus<HAL::I2CInterface> virtualAccess;
+    staticAccess.attach(&bus);
+    virtualAccess.attach(dynamicBus);
+
+    uint32_t staticSum = 0;
+    uint32_t virtualSum = 0;
+    measure(staticAccess, operations / 10, staticSum);        // Warm up
+    measure(virtualAccess, operations / 10, virtualSum);
+
+    staticSum = virtualSum = 0;
+    double staticNs = measure(staticAccess, operations, staticSum);
+    double virtualNs = measure(virtualAccess, operations, virtualSum);
+
+    // Per pattern: 6 transactions in 5 bus calls
+    const double calls = 5.0;
+    std::printf("SensorBus register pattern (6 transactions, 5 HAL calls), %d iterations\n", operations);
+    std::printf("  %-28s %10s %12s %10s\n", "bus type", "ns/pattern", "ns/HAL call", "checksum");
+    std::printf("  %-28s %10.1f %12.2f %10x\n", "RegisterFileI2C (static)", staticNs, staticNs / calls, staticSum);
+    std::printf("  %-28s %10.1f %12.2f %10x\n", "I2CInterface (virtual)", virtualNs, virtualNs / calls, virtualSum);
+    std::printf("  static / virtual: %.2fx\n", staticNs / virtualNs);
+    return staticSum == virtualSum ? 0 : 1;
+}
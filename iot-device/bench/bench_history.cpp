@@ -0,0 +1,249 @@
+/**
+ * Measurement history benchmark
+ *
+ * Fills a TimeSeriesStore in a scratch directory with N rows at 1 Hz
+ * (Config segment size, partition and retention), then reports:
+ * - append ns/row and bytes/row on disk
+ * - reopen time (segment files mapped, newest segment checked)
+ * - range scan of one column, ns/row
+ * - per-window aggregates (last hour by minute, last day by hour, all
+ *   rows by hour), query time
+ * against the same aggregates over an in-RAM std::vector<SensorRecord>
+ * (row layout, how measurements are held elsewhere on the device). The
+ * exit status is nonzero if the two disagree.
+ *
+ * Usage: bench_history [rows] [directory]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include "Config.h"
+#include "SensorRecord.h"
+#include "TimeSeriesStore.h"
+
+namespace {
+
+using Column = TimeSeriesStore::Column;
+using Aggregate = TimeSeriesStore::Aggregate;
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void removeSegments(const std::string& directory)
+{
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) {
+        return;
+    }
+    while (struct dirent* entry = readdir(dir)) {
+        if (std::strncmp(entry->d_name, "seg-", 4) == 0) {
+            unlink((directory + "/" + entry->d_name).c_str());
+        }
+    }
+    closedir(dir);
+}
+
+// Row-layout reference: same windows as TimeSeriesStore::aggregate()
+std::vector<Aggregate> aggregateRows(const std::vector<SensorRecord>& rows, uint64_t from, uint64_t to,
+                                     uint64_t windowMs)
+{
+    // Rows are in time order: binary search the range like the store does
+    auto before = [](const SensorRecord& row, uint64_t timestamp) { return row.timestamp < timestamp; };
+    auto first = std::lower_bound(rows.begin(), rows.end(), from, before);
+    auto last = std::lower_bound(first, rows.end(), to, before);
+
+    std::vector<Aggregate> windows;
+    for (auto it = first; it != last; ++it) {
+        const SensorRecord& row = *it;
+        uint64_t start = from + (row.timestamp - from) / windowMs * windowMs;
+        if (windows.empty() || windows.back().start != start) {
+            windows.push_back(Aggregate{start, 0, row.pd1, row.pd1, 0.0});
+        }
+        Aggregate& window = windows.back();
+        window.count++;
+        window.min = std::min(window.min, row.pd1);
+        window.max = std::max(window.max, row.pd1);
+        window.sum += row.pd1;
+    }
+    return windows;
+}
+
+bool same(const std::vector<Aggregate>& a, const std::vector<Aggregate>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].start != b[i].start || a[i].count != b[i].count || a[i].min != b[i].min ||
+            a[i].max != b[i].max || std::fabs(a[i].sum - b[i].sum) > 1e-9 * std::fabs(b[i].sum) + 1e-6) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t rows = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 1000000;
+    std::string directory;
+    if (argc > 2) {
+        directory = argv[2];
+    } else {
+        char scratch[] = "/tmp/bench_history.XXXXXX";
+        if (!mkdtemp(scratch)) {
+            std::perror("mkdtemp");
+            return 1;
+        }
+        directory = scratch;
+    }
+    removeSegments(directory);
+
+    const uint64_t start = 1767225600000ULL;       // 2026-01-01T00:00:00Z
+    const uint64_t period = Config::SENSOR_READ_INTERVAL_MS;
+    bool ok = true;
+
+    std::printf("Measurement history: %zu rows at %llu ms, %d rows/segment, retention %d MB\n", rows,
+                static_cast<unsigned long long>(period), Config::HISTORY_SEGMENT_ROWS,
+                Config::HISTORY_MAX_BYTES / (1024 * 1024));
+
+    // Append
+    std::vector<SensorRecord> reference(rows);
+    TimeSeriesStore store;
+    if (!store.open(directory, Config::HISTORY_MAX_BYTES, Config::HISTORY_SEGMENT_ROWS,
+                    Config::HISTORY_PARTITION_MS)) {
+        return 1;
+    }
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < rows; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        float noise = static_cast<float>(seed >> 8) / 16777216.0f - 0.5f;
+        SensorRecord& row = reference[i];
+        std::memset(&row, 0, sizeof(row));
+        row.timestamp = start + i * period;
+        row.pd1 = 12000.0f + 800.0f * std::sin(static_cast<float>(i) / 600.0f) + 40.0f * noise;
+        row.pd2 = row.pd1 * 0.9f;
+        row.s1 = 45.0f + noise;
+        row.s2 = 12.0f + noise;
+        row.s3 = 2000.0f + 10.0f * noise;
+        row.moistureLevel = 50.0f + 5.0f * noise;
+        row.temperatureC = 31.5f + 0.1f * noise;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    for (const auto& row : reference) {
+        const float values[TimeSeriesStore::COLUMNS] = {
+            row.pd1, row.pd2, row.s1, row.s2, row.s3, row.moistureLevel, row.temperatureC
+        };
+        ok = store.append(row.timestamp, values) && ok;
+    }
+    double appendNs = secondsSince(begin) * 1e9 / std::max<size_t>(rows, 1);
+    store.sync(true);
+    uint64_t retired = store.getStats().retired;
+    store.close();
+
+    // Reopen: what a query after a restart pays
+    begin = std::chrono::steady_clock::now();
+    if (!store.open(directory, Config::HISTORY_MAX_BYTES, Config::HISTORY_SEGMENT_ROWS,
+                    Config::HISTORY_PARTITION_MS)) {
+        return 1;
+    }
+    double openMs = secondsSince(begin) * 1e3;
+    auto stats = store.getStats();
+
+    // Rows dropped by retention are not in the store
+    reference.erase(reference.begin(), reference.end() - static_cast<std::ptrdiff_t>(stats.rows));
+    ok = ok && !reference.empty() && stats.oldest == reference.front().timestamp &&
+         stats.newest == reference.back().timestamp;
+
+    std::printf("  append     %8.1f ns/row, %6.1f bytes/row on disk (SensorRecord %zu bytes)\n", appendNs,
+                static_cast<double>(stats.bytes) / std::max<uint64_t>(stats.rows, 1), sizeof(SensorRecord));
+    std::printf("  reopen     %8.2f ms, %zu segments, %llu rows kept, %llu segments retired\n", openMs,
+                stats.segments, static_cast<unsigned long long>(stats.rows),
+                static_cast<unsigned long long>(retired));
+
+    // Full scan of one column
+    std::vector<TimeSeriesStore::Span> spans;
+    begin = std::chrono::steady_clock::now();
+    size_t scanned = store.scan(Column::PD1, 0, UINT64_MAX, spans);
+    double sum = 0.0;
+    for (const auto& span : spans) {
+        for (size_t i = 0; i < span.count; i++) {
+            sum += span.values[i];
+        }
+    }
+    double scanNs = secondsSince(begin) * 1e9 / std::max<size_t>(scanned, 1);
+    double rowSum = 0.0;
+    begin = std::chrono::steady_clock::now();
+    for (const auto& row : reference) {
+        rowSum += row.pd1;
+    }
+    double rowScanNs = secondsSince(begin) * 1e9 / std::max<size_t>(reference.size(), 1);
+    ok = ok && scanned == reference.size() && sum == rowSum;
+    std::printf("  scan pd1   %8.2f ns/row (vector<SensorRecord> %.2f ns/row)\n", scanNs, rowScanNs);
+
+    struct Query {
+        const char* name;
+        uint64_t span;
+        uint64_t window;
+    };
+    const uint64_t newest = stats.newest + 1;
+    const Query queries[] = {
+        { "last hour by minute", 3600 * 1000ULL, 60 * 1000ULL },
+        { "last day by hour", 24 * 3600 * 1000ULL, 3600 * 1000ULL },
+        { "all rows by hour", newest - stats.oldest, 3600 * 1000ULL },
+    };
+
+    std::printf("  %-22s %8s %8s %14s %14s\n", "aggregate pd1", "rows", "windows", "store", "row vector");
+    for (const auto& query : queries) {
+        uint64_t from = newest - std::min(query.span, newest - stats.oldest);
+
+        const int repeat = 5;
+        std::vector<Aggregate> windows;
+        begin = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeat; r++) {
+            windows = store.aggregate(Column::PD1, from, newest, query.window);
+        }
+        double storeUs = secondsSince(begin) * 1e6 / repeat;
+
+        std::vector<Aggregate> expected;
+        begin = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeat; r++) {
+            expected = aggregateRows(reference, from, newest, query.window);
+        }
+        double rowUs = secondsSince(begin) * 1e6 / repeat;
+
+        uint64_t covered = 0;
+        for (const auto& window : windows) {
+            covered += window.count;
+        }
+        ok = ok && same(windows, expected);
+        std::printf("  %-22s %8llu %8zu %11.1f us %11.1f us\n", query.name,
+                    static_cast<unsigned long long>(covered), windows.size(), storeUs, rowUs);
+    }
+
+    store.close();
+    removeSegments(directory);
+    if (argc <= 2) {
+        rmdir(directory.c_str());
+    }
+
+    if (!ok) {
+        std::printf("MISMATCH: store contents or aggregates differ from the row reference\n");
+        return 1;
+    }
+    return 0;
+}
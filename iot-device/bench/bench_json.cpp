@@ -0,0 +1,148 @@
+/**
+ * JSON serialization microbenchmark
+ *
+ * Compares the previous std::ostringstream payload builder with
+ * Payload::appendSkinAnalysisJson writing into a reused buffer, and
+ * counts heap allocations per measurement through a global operator new.
+ *
+ * Exits non-zero if the steady-state writer path allocates.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <string>
+
+#include "Payload.h"
+
+static size_t g_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    g_allocations++;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Builder used by main.cpp before JsonWriter
+std::string legacySkinAnalysisJson(const SkinSensor::SensorData& data, const std::string& deviceId)
+{
+    std::ostringstream json;
+    json << "{"
+         << "\"deviceId\":\"" << deviceId << "\","
+         << "\"patientName\":\"" << data.patientName << "\","
+         << "\"birthDate\":\"" << data.birthDate << "\","
+         << "\"pd1\":\"" << std::fixed << std::setprecision(2) << data.pd1 << "\","
+         << "\"pd2\":\"" << data.pd2 << "\","
+         << "\"hz\":\"" << data.hz << "\","
+         << "\"s1\":\"" << data.s1 << "\","
+         << "\"s2\":\"" << data.s2 << "\","
+         << "\"s3\":\"" << data.s3 << "\","
+         << "\"moistureLevel\":\"" << data.moistureLevel << "\","
+         << "\"thicknessResult\":\"" << data.thicknessResult << "\","
+         << "\"elasticityResult\":\"" << data.elasticityResult << "\","
+         << "\"moistureLevelResult\":\"" << data.moistureLevelResult << "\""
+         << "}";
+    return json.str();
+}
+
+SkinSensor::SensorData makeSample()
+{
+    SkinSensor::SensorData data = SkinSensor::SensorData();
+    data.pd1 = 125.5f;
+    data.pd2 = 130.25f;
+    data.hz = 50.0f;
+    data.s1 = 45.3f;
+    data.s2 = 52.8f;
+    data.s3 = 48.0f;
+    data.moistureLevel = 65.0f;
+    data.thicknessResult = "normal";
+    data.elasticityResult = "good";
+    data.moistureLevelResult = "normal";
+    data.patientName = "Hong \"GD\" Gildong";
+    data.birthDate = "1990-01-01";
+    return data;
+}
+
+template <typename Fn>
+void run(const char* name, int iterations, Fn fn)
+{
+    // Warm up (lets reused buffers reach their steady-state capacity)
+    for (int i = 0; i < 1000; i++) {
+        fn(i);
+    }
+
+    size_t allocationsBefore = g_allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        fn(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    size_t allocations = g_allocations - allocationsBefore;
+
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    std::printf("%-28s %8.1f ns/op  %6.2f allocs/op\n", name, ns,
+                static_cast<double>(allocations) / iterations);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int iterations = (argc > 1) ? std::atoi(argv[1]) : 200000;
+    const std::string deviceId = "THE3-SKIN-DEVICE-001";
+    SkinSensor::SensorData data = makeSample();
+
+    size_t sink = 0;
+
+    run("ostringstream (legacy)", iterations, [&](int i) {
+        data.pd1 = 100.0f + static_cast<float>(i % 1000) * 0.01f;
+        sink += legacySkinAnalysisJson(data, deviceId).size();
+    });
+
+    std::string buffer;
+    run("JsonWriter quoted", iterations, [&](int i) {
+        data.pd1 = 100.0f + static_cast<float>(i % 1000) * 0.01f;
+        buffer.clear();
+        Payload::appendSkinAnalysisJson(buffer, data, deviceId);
+        sink += buffer.size();
+    });
+
+    run("JsonWriter numbers", iterations, [&](int i) {
+        data.pd1 = 100.0f + static_cast<float>(i % 1000) * 0.01f;
+        buffer.clear();
+        Payload::appendSkinAnalysisJson(buffer, data, deviceId, JsonWriter::NumberStyle::NUMBER);
+        sink += buffer.size();
+    });
+
+    run("Schema binary", iterations, [&](int i) {
+        data.pd1 = 100.0f + static_cast<float>(i % 1000) * 0.01f;
+        buffer.clear();
+        Payload::appendSkinAnalysisBinary(buffer, data);
+        sink += buffer.size();
+    });
+
+    // Steady-state allocation check
+    size_t before = g_allocations;
+    for (int i = 0; i < 1000; i++) {
+        buffer.clear();
+        Payload::appendSkinAnalysisJson(buffer, data, deviceId);
+    }
+    size_t steadyAllocations = g_allocations - before;
+
+    std::printf("\nsample: %s\n", buffer.c_str());
+    std::printf("steady-state allocations per measurement: %zu (checksum %zu)\n",
+                steadyAllocations / 1000, sink);
+
+    return steadyAllocations == 0 ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+/**
+ * Record ring microbenchmark
+ *
+ * Moves SensorRecord-sized values from a producer thread to a consumer
+ * thread through SpscRing and through a mutex-protected std::deque (the
+ * obvious alternative), and reports ns/record and the producer's worst
+ * push latency. The consumer checks that sequence numbers arrive in order.
+ *
+ * Usage: bench_ring [records] [capacity]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "SpscRing.h"
+
+namespace {
+
+// Same size as SensorRecord, without pulling in SkinSensor
+struct Record {
+    uint32_t sequence;
+    uint8_t payload[180];
+};
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    double nsPerRecord;
+    double maxPushNs;
+    bool ordered;
+};
+
+class MutexQueue {
+public:
+    explicit MutexQueue(size_t capacity) : m_capacity(capacity) {}
+
+    bool tryPush(const Record& record)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_queue.size() >= m_capacity) {
+            return false;
+        }
+        m_queue.push_back(record);
+        return true;
+    }
+
+    bool tryPop(Record& record)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_queue.empty()) {
+            return false;
+        }
+        record = m_queue.front();
+        m_queue.pop_front();
+        return true;
+    }
+
+private:
+    size_t m_capacity;
+    std::mutex m_mutex;
+    std::deque<Record> m_queue;
+};
+
+template <typename Queue>
+Result run(Queue& queue, uint32_t count)
+{
+    Result result = Result();
+    result.ordered = true;
+
+    std::thread consumer([&]() {
+        Record record;
+        uint32_t expected = 0;
+        while (expected < count) {
+            if (queue.tryPop(record)) {
+                result.ordered = result.ordered && record.sequence == expected;
+                expected++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    Record record;
+    std::memset(&record, 0, sizeof(record));
+    double maxPushNs = 0.0;
+
+    auto start = Clock::now();
+    for (uint32_t i = 0; i < count; i++) {
+        record.sequence = i;
+        auto pushStart = Clock::now();
+        while (!queue.tryPush(record)) {
+            std::this_thread::yield();     // Full: let the consumer run (single-core targets)
+        }
+        maxPushNs = std::max(maxPushNs, std::chrono::duration<double, std::nano>(Clock::now() - pushStart).count());
+    }
+    consumer.join();
+    auto elapsed = Clock::now() - start;
+
+    result.nsPerRecord = std::chrono::duration<double, std::nano>(elapsed).count() / count;
+    result.maxPushNs = maxPushNs;
+    return result;
+}
+
+void print(const char* name, const Result& result)
+{
+    std::printf("%-14s %12.1f %14.0f %8s\n", name, result.nsPerRecord, result.maxPushNs,
+                result.ordered ? "yes" : "NO");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    uint32_t count = (argc > 1) ? static_cast<uint32_t>(std::atoi(argv[1])) : 1000000;
+    size_t capacity = (argc > 2) ? static_cast<size_t>(std::atoi(argv[2])) : 256;
+
+    std::printf("%u records of %zu bytes, capacity %zu\n", count, sizeof(Record), capacity);
+    std::printf("%-14s %12s %14s %8s\n", "queue", "ns/record", "max push ns", "ordered");
+
+    SpscRing<Record> ring(capacity);
+    Result spsc = run(ring, count);
+    print("SpscRing", spsc);
+
+    MutexQueue locked(capacity);
+    Result mutex = run(locked, count);
+    print("mutex+deque", mutex);
+
+    return (spsc.ordered && mutex.ordered) ? 0 : 1;
+}
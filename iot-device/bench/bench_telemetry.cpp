@@ -0,0 +1,285 @@
+/**
+ * Telemetry batch encoding benchmark
+ *
+ * Encodes the same measurement stream in batches of the uplink's size
+ * (Config::TELEMETRY_BATCH_MAX_RECORDS) as
+ * - the JSON array TelemetryBatcher posts today (quoted two-decimal
+ *   numbers, and plain numbers)
+ * - SensorSchema binary records (fixed width, no inter-record coding)
+ * - TelemetryCodec (delta-of-delta timestamps, XOR floats)
+ * and reports bytes per record and encode/decode ns per record. JSON
+ * has no decoder on the device; its decode column is empty.
+ *
+ * Two streams:
+ * - "sensor": SkinSensor on the simulation HAL and a VirtualClock, read
+ *   every SENSOR_READ_INTERVAL_MS (exact period, simulated noise)
+ * - "jitter": the sensor stream with +-20 ms of timestamp jitter and a
+ *   patient change every 500 records, closer to a field device
+ *
+ * Every TelemetryCodec batch is decoded and compared bit for bit with
+ * its records; the exit status is nonzero on a mismatch.
+ *
+ * Usage: bench_telemetry [records] [batch size]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Config.h"
+#include "Payload.h"
+#include "SkinSensor.h"
+#include "TelemetryCodec.h"
+
+namespace {
+
+using SensorData = SkinSensor::SensorData;
+
+const std::string DEVICE_ID = "THE3-SKIN-DEVICE-001";
+
+std::vector<SensorData> acquire(size_t count)
+{
+    VirtualClock clock;
+    SkinSensor sensor;
+    sensor.setClock(clock);
+    if (!sensor.initialize()) {
+        return {};
+    }
+    sensor.setPatientInfo("Hong Gildong", "1990-01-01");
+
+    std::vector<SensorData> records;
+    records.reserve(count);
+    auto next = clock.now();
+    for (size_t i = 0; i < count; i++) {
+        records.push_back(sensor.readSensorData());
+        next += std::chrono::milliseconds(Config::SENSOR_READ_INTERVAL_MS);
+        clock.sleepUntil(next);
+    }
+    return records;
+}
+
+std::vector<SensorData> jittered(std::vector<SensorData> records)
+{
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < records.size(); i++) {
+        seed = seed * 1664525u + 1013904223u;
+        records[i].timestamp += (seed >> 8) % 41;
+        records[i].timestamp -= 20;
+        if ((i / 500) % 2 == 1) {
+            records[i].patientName = "Kim Cheolsu";
+            records[i].birthDate = "1985-06-15";
+        }
+    }
+    return records;
+}
+
+bool sameBits(float a, float b)
+{
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+bool same(const SensorData& a, const SensorData& b)
+{
+    return sameBits(a.pd1, b.pd1) && sameBits(a.pd2, b.pd2) && sameBits(a.hz, b.hz) &&
+           sameBits(a.s1, b.s1) && sameBits(a.s2, b.s2) && sameBits(a.s3, b.s3) &&
+           sameBits(a.moistureLevel, b.moistureLevel) && sameBits(a.temperatureC, b.temperatureC) &&
+           a.timestamp == b.timestamp && a.thicknessResult == b.thicknessResult &&
+           a.elasticityResult == b.elasticityResult && a.moistureLevelResult == b.moistureLevelResult &&
+           a.patientName == b.patientName && a.birthDate == b.birthDate;
+}
+
+struct Result {
+    double bytesPerRecord;
+    double encodeNs;        // Per record
+    double decodeNs;        // Per record; < 0 if not measured
+};
+
+template <typename Fn>
+double nsPerRecord(size_t records, Fn fn)
+{
+    const int repeat = 5;
+    fn();   // Warm up (reused buffers reach their steady-state capacity)
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; r++) {
+        fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / repeat / std::max<size_t>(records, 1);
+}
+
+Result json(const std::vector<SensorData>& records, size_t batch, JsonWriter::NumberStyle style)
+{
+    size_t bytes = 0;
+    std::string body;
+    Result result = Result();
+    result.encodeNs = nsPerRecord(records.size(), [&]() {
+        bytes = 0;
+        for (size_t first = 0; first < records.size(); first += batch) {
+            size_t last = std::min(first + batch, records.size());
+            body.clear();
+            body.push_back('[');
+            for (size_t i = first; i < last; i++) {
+                if (i > first) body.push_back(',');
+                Payload::appendSkinAnalysisJson(body, records[i], DEVICE_ID, style);
+            }
+            body.push_back(']');
+            bytes += body.size();
+        }
+    });
+    result.bytesPerRecord = static_cast<double>(bytes) / records.size();
+    result.decodeNs = -1.0;
+    return result;
+}
+
+Result schemaBinary(const std::vector<SensorData>& records, size_t batch, bool& ok)
+{
+    std::vector<std::string> bodies;
+    std::vector<std::vector<size_t>> offsets;
+    Result result = Result();
+    result.encodeNs = nsPerRecord(records.size(), [&]() {
+        bodies.clear();
+        offsets.clear();
+        for (size_t first = 0; first < records.size(); first += batch) {
+            size_t last = std::min(first + batch, records.size());
+            bodies.emplace_back();
+            offsets.emplace_back();
+            bodies.back().push_back(static_cast<char>(DEVICE_ID.size()));   // Same header as the codec
+            bodies.back().append(DEVICE_ID);
+            for (size_t i = first; i < last; i++) {
+                offsets.back().push_back(bodies.back().size());
+                Payload::appendSkinAnalysisBinary(bodies.back(), records[i]);
+            }
+        }
+    });
+
+    size_t bytes = 0;
+    for (const auto& body : bodies) {
+        bytes += body.size();
+    }
+    result.bytesPerRecord = static_cast<double>(bytes) / records.size();
+
+    SensorData record = SensorData();
+    result.decodeNs = nsPerRecord(records.size(), [&]() {
+        size_t index = 0;
+        for (size_t b = 0; b < bodies.size(); b++) {
+            const uint8_t* data = reinterpret_cast<const uint8_t*>(bodies[b].data());
+            for (size_t offset : offsets[b]) {
+                if (!Payload::readSkinAnalysisBinary(data + offset, bodies[b].size() - offset, record) ||
+                    !same(record, records[index++])) {
+                    ok = false;
+                }
+            }
+        }
+    });
+    return result;
+}
+
+Result gorilla(const std::vector<SensorData>& records, size_t batch, bool& ok)
+{
+    std::vector<std::string> bodies;
+    TelemetryCodec::Encoder encoder;
+    Result result = Result();
+    result.encodeNs = nsPerRecord(records.size(), [&]() {
+        bodies.clear();
+        for (size_t first = 0; first < records.size(); first += batch) {
+            size_t last = std::min(first + batch, records.size());
+            bodies.emplace_back();
+            encoder.begin(bodies.back(), DEVICE_ID);
+            for (size_t i = first; i < last; i++) {
+                encoder.add(records[i]);
+            }
+            encoder.finish();
+        }
+    });
+
+    size_t bytes = 0;
+    for (const auto& body : bodies) {
+        bytes += body.size();
+    }
+    result.bytesPerRecord = static_cast<double>(bytes) / records.size();
+
+    TelemetryCodec::Decoder decoder;
+    SensorData record = SensorData();
+    result.decodeNs = nsPerRecord(records.size(), [&]() {
+        size_t index = 0;
+        for (const auto& body : bodies) {
+            if (!decoder.open(reinterpret_cast<const uint8_t*>(body.data()), body.size()) ||
+                decoder.deviceId() != DEVICE_ID) {
+                ok = false;
+                continue;
+            }
+            while (decoder.next(record)) {
+                if (index >= records.size() || !same(record, records[index++])) {
+                    ok = false;
+                }
+            }
+            ok = ok && !decoder.failed();
+        }
+        ok = ok && index == records.size();
+    });
+    return result;
+}
+
+void print(const char* name, const Result& result, double jsonBytes)
+{
+    char decode[16] = "-";
+    if (result.decodeNs >= 0.0) {
+        std::snprintf(decode, sizeof(decode), "%.1f", result.decodeNs);
+    }
+    std::printf("  %-18s %10.1f %8.1fx %12.1f %12s\n", name, result.bytesPerRecord,
+                jsonBytes / result.bytesPerRecord, result.encodeNs, decode);
+}
+
+bool run(const char* stream, const std::vector<SensorData>& records, size_t batch)
+{
+    bool ok = true;
+    Result quoted = json(records, batch, JsonWriter::NumberStyle::QUOTED);
+    Result numbers = json(records, batch, JsonWriter::NumberStyle::NUMBER);
+    Result binary = schemaBinary(records, batch, ok);
+    Result compressed = gorilla(records, batch, ok);
+
+    std::printf("%s stream: %zu records, batches of %zu\n", stream, records.size(), batch);
+    std::printf("  %-18s %10s %9s %12s %12s\n", "encoding", "bytes/rec", "vs JSON", "encode ns", "decode ns");
+    print("JSON quoted", quoted, quoted.bytesPerRecord);
+    print("JSON numbers", numbers, quoted.bytesPerRecord);
+    print("Schema binary", binary, quoted.bytesPerRecord);
+    print("TelemetryCodec", compressed, quoted.bytesPerRecord);
+    std::printf("  TelemetryCodec: %.1f bits/record, %.1f MB/s encode, %.1f MB/s decode (of JSON equivalent)\n\n",
+                compressed.bytesPerRecord * 8.0,
+                quoted.bytesPerRecord * 1e3 / compressed.encodeNs,
+                quoted.bytesPerRecord * 1e3 / compressed.decodeNs);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t count = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 3000;
+    size_t batch = (argc > 2) ? static_cast<size_t>(std::atol(argv[2]))
+                              : static_cast<size_t>(Config::TELEMETRY_BATCH_MAX_RECORDS);
+    batch = std::max<size_t>(batch, 1);
+
+    // Keep the sensor's log out of the report
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    std::vector<SensorData> records = acquire(count);
+    std::cout.rdbuf(saved);
+    if (records.empty()) {
+        std::fprintf(stderr, "Sensor failed to initialize\n");
+        return 1;
+    }
+
+    bool ok = run("sensor", records, batch);
+    ok = run("jitter", jittered(records), batch) && ok;
+
+    if (!ok) {
+        std::printf("MISMATCH: decoded records differ from the encoded ones\n");
+        return 1;
+    }
+    return 0;
+}
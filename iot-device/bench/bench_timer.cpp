@@ -0,0 +1,154 @@
+/**
+ * Timer wheel benchmark
+ *
+ * TimerWheel against an ordered multimap (the structure SystemClock uses
+ * for its timers) with N pending timers:
+ * - schedule + cancel of one-shot timers (the health probe / request
+ *   timeout pattern)
+ * - firing: N periodic timers with periods of 1..1000 ticks, the clock
+ *   advanced one tick at a time for 10 s of timer time
+ * Every timer must fire at or after its deadline and within one tick of
+ * it; the exit status is nonzero otherwise.
+ *
+ * Usage: bench_timer [timers]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "TimerWheel.h"
+
+namespace {
+
+// Time moves only when the benchmark advances it
+class ManualClock : public Clock {
+public:
+    ManualClock() : m_now(std::chrono::steady_clock::now()) {}
+
+    TimePoint now() const override { return m_now; }
+    uint64_t unixTimeMs() const override { return 0; }
+    void sleepUntil(TimePoint deadline) override { m_now = std::max(m_now, deadline); }
+    void notify(std::condition_variable&) override {}
+    void schedule(TimePoint, Callback) override {}
+
+    void advance(Duration duration) { m_now += duration; }
+
+protected:
+    void blockUntil(std::unique_lock<std::mutex>&, std::condition_variable&, TimePoint) override {}
+
+private:
+    TimePoint m_now;
+};
+
+uint32_t g_seed = 12345;
+
+uint32_t nextRandom()
+{
+    g_seed = g_seed * 1664525u + 1013904223u;
+    return g_seed >> 8;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t maxTimers = (argc > 1) ? static_cast<size_t>(std::atoi(argv[1])) : 100000;
+    const auto tick = std::chrono::milliseconds(1);
+    const size_t rounds = 1000000;
+    bool ok = true;
+
+    std::printf("Timer wheel vs multimap (1 ms tick)\n");
+    std::printf("  %-8s %18s %18s %18s %18s\n", "timers", "wheel sched+cancel", "map sched+cancel",
+                "wheel fire", "map fire");
+
+    for (size_t timers = 100; timers <= maxTimers; timers *= 10) {
+        // Schedule + cancel with `timers` pending: ns per pair
+        ManualClock clock;
+        TimerWheel wheel(clock, tick, tick);
+        std::multimap<Clock::TimePoint, std::function<void()>> map;
+        for (size_t i = 0; i < timers; i++) {
+            auto when = clock.now() + std::chrono::milliseconds(nextRandom() % 60000);
+            wheel.schedule(when, []() {});
+            map.emplace(when, []() {});
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rounds; i++) {
+            auto id = wheel.schedule(clock.now() + std::chrono::milliseconds(nextRandom() % 60000), []() {});
+            wheel.cancel(id);
+        }
+        double wheelSchedule = secondsSince(start) * 1e9 / rounds;
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rounds; i++) {
+            auto it = map.emplace(clock.now() + std::chrono::milliseconds(nextRandom() % 60000), []() {});
+            map.erase(it);
+        }
+        double mapSchedule = secondsSince(start) * 1e9 / rounds;
+
+        // Firing: periodic timers over 10 s, one runDue per tick; ns per fired timer
+        ManualClock fireClock;
+        TimerWheel fireWheel(fireClock, tick, tick);
+        std::multimap<Clock::TimePoint, size_t> fireMap;
+        std::vector<Clock::Duration> periods(timers);
+        std::vector<Clock::TimePoint> deadlines(timers);
+        size_t wheelFired = 0;
+        for (size_t i = 0; i < timers; i++) {
+            periods[i] = std::chrono::milliseconds(1 + nextRandom() % 1000);
+            deadlines[i] = fireClock.now() + std::chrono::microseconds(1 + nextRandom() % 1000000);
+            fireWheel.schedulePeriodic(deadlines[i], periods[i], [&, i]() {
+                auto lateness = fireClock.now() - deadlines[i];
+                ok = ok && lateness >= Clock::Duration::zero() && lateness < tick;
+                deadlines[i] += periods[i];
+                wheelFired++;
+            });
+            fireMap.emplace(deadlines[i], i);
+        }
+
+        auto origin = fireClock.now();
+        start = std::chrono::steady_clock::now();
+        for (int t = 0; t < 10000; t++) {
+            fireClock.advance(tick);
+            fireWheel.runDue();
+        }
+        double wheelFire = secondsSince(start) * 1e9 / std::max<size_t>(wheelFired, 1);
+
+        // Same callback cost on both sides
+        size_t mapFired = 0;
+        std::vector<std::function<void()>> mapCallbacks(timers, [&mapFired]() { mapFired++; });
+        auto now = origin;
+        start = std::chrono::steady_clock::now();
+        for (int t = 0; t < 10000; t++) {
+            now += tick;
+            while (!fireMap.empty() && fireMap.begin()->first <= now) {
+                auto node = fireMap.begin();
+                size_t i = node->second;
+                auto next = node->first + periods[i];
+                fireMap.erase(node);
+                fireMap.emplace(next, i);
+                mapCallbacks[i]();
+            }
+        }
+        double mapFire = secondsSince(start) * 1e9 / std::max<size_t>(mapFired, 1);
+        ok = ok && wheelFired == mapFired;
+
+        std::printf("  %-8zu %15.1f ns %15.1f ns %15.1f ns %15.1f ns\n",
+                    timers, wheelSchedule, mapSchedule, wheelFire, mapFire);
+    }
+
+    if (!ok) {
+        std::printf("MISMATCH: a timer fired early, more than one tick late, or too few times\n");
+        return 1;
+    }
+    return 0;
+}
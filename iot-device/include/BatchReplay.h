@@ -0,0 +1,73 @@
+#ifndef BATCH_REPLAY_H
+#define BATCH_REPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "HttpClient.h"
+#include "PersistentQueue.h"
+
+/**
+ * BatchReplay - 저장된 배치 재전송 (store-and-forward 소비 측)
+ *
+ * Shared by auto mode (synchronous) and the daemon (asynchronous) to
+ * decide what happens to a telemetry batch after an upload attempt:
+ *
+ * - SENT     : 2xx; a queued batch is popped
+ * - RETRY    : no HTTP response (transport error, circuit open,
+ *              cancelled), 408, 429 or 5xx; the batch stays queued (at
+ *              the head when replaying) until the server can take it
+ * - REJECTED : any other status (400, 413, 422, ...); the server will
+ *              never accept this body, so it is dropped with a warning
+ *              instead of blocking everything queued behind it
+ *
+ * A failed live batch is only worth queueing when it is RETRY.
+ *
+ * A queued record is "<endpoint>\n<body>", so each batch is replayed to
+ * the endpoint it was meant for (raw measurements and window summaries
+ * go to different ones). Records written before the prefix existed start
+ * with the body's '[' and go to Config::API_ENDPOINT_TELEMETRY.
+ */
+namespace BatchReplay {
+
+enum class Outcome { SENT, RETRY, REJECTED };
+
+struct Stats {
+    size_t replayed;        // Queued batches delivered
+    size_t rejected;        // Batches dropped as REJECTED (live or queued)
+};
+
+struct Record {
+    std::string endpoint;
+    std::string body;
+};
+
+/**
+ * Append a failed batch for `endpoint` to the queue
+ * @return false if the queue is full or closed
+ */
+bool store(PersistentQueue& queue, const std::string& endpoint, const std::string& body);
+
+/**
+ * Split a queued record into its endpoint and body
+ */
+Record decode(const uint8_t* data, size_t length);
+
+Outcome classify(const HttpClient::Response& response);
+
+/**
+ * Apply the response to a replay of the queue's head record: pop it
+ * unless the outcome is RETRY
+ */
+Outcome complete(PersistentQueue& queue, const HttpClient::Response& response, Stats& stats);
+
+/**
+ * Replay up to `maxBatches` queued batches with blocking requests,
+ * stopping at the first RETRY
+ * @return batches removed from the queue (sent or rejected)
+ */
+size_t replay(PersistentQueue& queue, HttpClient& client, int maxBatches, Stats& stats);
+
+} // namespace BatchReplay
+
+#endif // BATCH_REPLAY_H
@@ -0,0 +1,116 @@
+#ifndef CHANGE_FILTER_H
+#define CHANGE_FILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "SkinSensor.h"
+
+/**
+ * ChangeFilter - 변화 감지 업로드 억제 (데드밴드 + CUSUM)
+ *
+ * Sits between SkinSensor::readSensorData() and the uploader and passes
+ * on only the samples that carry news; while the probe rests untouched
+ * on the skin the stream is noise around a constant and almost every
+ * sample is dropped. A sample is uploaded when
+ *
+ * - a channel moved more than its deadband from the last uploaded value
+ * - a channel's two-sided CUSUM crossed its threshold: a sustained shift
+ *   or slow drift smaller than the deadband (e.g. skin warming the
+ *   probe). The CUSUM runs against the mean of the first CUSUM_WARMUP
+ *   samples after an upload, not the uploaded sample itself, so that
+ *   one noisy sample does not bias it
+ * - a result category (moistureLevelResult, ...) or the patient changed
+ * - HEARTBEAT ms passed since the last upload (the server sees the
+ *   device alive and the current values), or the clock stepped back
+ *
+ * The drift allowance k and the decision threshold h are fractions of
+ * the channel's deadband: with a deadband of about five noise standard
+ * deviations, a shift of half the deadband is caught within a few
+ * samples while noise alone practically never trips it. Every upload
+ * resets the reference values and the CUSUM sums of all channels.
+ *
+ * Not thread-safe.
+ */
+class ChangeFilter {
+public:
+    enum class Reason {
+        NONE,               // Suppressed
+        FIRST,              // First sample
+        DEADBAND,           // A channel left its deadband
+        CUSUM,              // A channel's CUSUM crossed the threshold
+        CATEGORY,           // A result category changed
+        PATIENT,            // Patient name or birth date changed
+        HEARTBEAT           // Heartbeat interval elapsed (or clock stepped back)
+    };
+
+    static constexpr size_t CHANNELS = 7;       // pd1, pd2, s1, s2, s3, moistureLevel, temperatureC
+    static constexpr size_t REASONS = 7;
+
+    static constexpr double CUSUM_DRIFT = 0.25;     // k, in deadbands
+    static constexpr double CUSUM_THRESHOLD = 1.0;  // h, in deadbands
+    static constexpr uint32_t CUSUM_WARMUP = 8;     // Samples averaged into the CUSUM baseline
+
+    struct Stats {
+        uint64_t samples;           // Samples seen
+        uint64_t uploaded;          // Samples passed on
+        uint64_t suppressed;        // Samples dropped
+        uint64_t byReason[REASONS]; // Uploads per Reason (NONE: same as suppressed)
+        uint64_t byChannel[CHANNELS]; // DEADBAND and CUSUM uploads per triggering channel
+    };
+
+public:
+    /**
+     * @param heartbeatMs Upload at least one sample per this interval (0: never)
+     */
+    explicit ChangeFilter(uint64_t heartbeatMs);
+
+    /**
+     * Deadband of one channel (same unit as the SensorData field); the
+     * defaults are Config::CHANGE_DEADBAND_*
+     */
+    void setDeadband(size_t channel, float deadband);
+    float deadband(size_t channel) const { return m_channels[channel].deadband; }
+
+    /**
+     * Decide whether to upload `data`
+     * @return the reason to upload it, or Reason::NONE to drop it
+     */
+    Reason add(const SkinSensor::SensorData& data);
+
+    /**
+     * Forget the last upload: the next sample is uploaded as FIRST
+     */
+    void reset();
+
+    uint64_t heartbeatMs() const { return m_heartbeatMs; }
+    Stats getStats() const { return m_stats; }
+
+    static const char* channelName(size_t channel);
+    static const char* reasonName(Reason reason);
+
+private:
+    struct Channel {
+        float deadband;
+        float reference;    // Value of the last upload
+        double baseline;    // CUSUM target: mean of the first samples after it
+        uint32_t warmup;    // Samples in baseline (up to CUSUM_WARMUP)
+        double high;        // CUSUM sums of upward and downward deviations
+        double low;
+    };
+
+    Reason detect(const SkinSensor::SensorData& data, size_t& channel);
+    void accept(const SkinSensor::SensorData& data);
+
+    uint64_t m_heartbeatMs;
+    bool m_started;
+    uint64_t m_lastUpload;
+    std::string m_categories[3];
+    std::string m_patientName;
+    std::string m_birthDate;
+    Channel m_channels[CHANNELS];
+
+    Stats m_stats;
+};
+
+#endif // CHANGE_FILTER_H
@@ -0,0 +1,212 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Clock - 시간/대기 추상화
+ *
+ * Every timing path in the device (sensor conversion waits, the sampling
+ * cadence, batch age limits, simulated device latencies) goes through a
+ * Clock so that simulation can run on virtual time.
+ *
+ * - SystemClock  : steady_clock and real sleeps (Clock::system())
+ * - VirtualClock : discrete-event time that jumps straight to the next
+ *                  deadline; an hour of device operation runs in the
+ *                  time the code itself takes
+ *
+ * Rules for code that waits:
+ * - sleep with sleepFor() / sleepUntil()
+ * - wait on a condition variable with waitUntil(), and wake waiters with
+ *   notify() instead of notify_one() / notify_all()
+ * - timed device behaviour (interrupt edges) uses schedule()
+ */
+class Clock {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+    using Duration = std::chrono::steady_clock::duration;
+    using Callback = std::function<void()>;
+
+public:
+    virtual ~Clock() = default;
+
+    virtual TimePoint now() const = 0;
+
+    /**
+     * Wall-clock time for record timestamps (Unix epoch, milliseconds)
+     */
+    virtual uint64_t unixTimeMs() const = 0;
+
+    virtual void sleepUntil(TimePoint deadline) = 0;
+
+    template <typename Rep, typename Period>
+    void sleepFor(std::chrono::duration<Rep, Period> duration)
+    {
+        sleepUntil(now() + std::chrono::duration_cast<Duration>(duration));
+    }
+
+    /**
+     * condition_variable::wait_until() on this clock
+     * @return pred() at exit (false on timeout)
+     */
+    template <typename Predicate>
+    bool waitUntil(std::unique_lock<std::mutex>& lock, std::condition_variable& cv,
+                   TimePoint deadline, Predicate pred)
+    {
+        while (!pred()) {
+            if (now() >= deadline) {
+                return pred();
+            }
+            blockUntil(lock, cv, deadline);
+        }
+        return true;
+    }
+
+    /**
+     * Wake every waitUntil() on `cv`
+     */
+    virtual void notify(std::condition_variable& cv) = 0;
+
+    /**
+     * Run `callback` at `when` (immediately if already due), on a timer
+     * thread (SystemClock) or on the thread that advances time
+     * (VirtualClock). Callbacks must not block on the clock.
+     */
+    virtual void schedule(TimePoint when, Callback callback) = 0;
+
+    /**
+     * Threads that wait on the clock concurrently must be registered for
+     * VirtualClock to know when all of them are idle (no-op on SystemClock).
+     * A parent may attach() on behalf of a thread before starting it.
+     */
+    virtual void attach() {}
+    virtual void detach() {}
+
+    /**
+     * Scoped attach() / detach()
+     */
+    class Participant {
+    public:
+        explicit Participant(Clock& clock) : m_clock(clock) { m_clock.attach(); }
+        ~Participant() { m_clock.detach(); }
+
+        Participant(const Participant&) = delete;
+        Participant& operator=(const Participant&) = delete;
+
+    private:
+        Clock& m_clock;
+    };
+
+    /**
+     * Process-wide real-time clock
+     */
+    static Clock& system();
+
+protected:
+    /**
+     * Block once until notified or `deadline`; may return spuriously
+     */
+    virtual void blockUntil(std::unique_lock<std::mutex>& lock, std::condition_variable& cv,
+                            TimePoint deadline) = 0;
+};
+
+/**
+ * SystemClock - 실시간 시계
+ */
+class SystemClock : public Clock {
+public:
+    SystemClock();
+    ~SystemClock() override;
+
+    TimePoint now() const override { return std::chrono::steady_clock::now(); }
+    uint64_t unixTimeMs() const override;
+    void sleepUntil(TimePoint deadline) override;
+    void notify(std::condition_variable& cv) override { cv.notify_all(); }
+    void schedule(TimePoint when, Callback callback) override;
+
+protected:
+    void blockUntil(std::unique_lock<std::mutex>& lock, std::condition_variable& cv,
+                    TimePoint deadline) override;
+
+private:
+    void timerLoop();
+
+    // Timer thread, started by the first schedule()
+    std::mutex m_timerMutex;
+    std::condition_variable m_timerCv;
+    std::thread m_timerThread;
+    bool m_running;
+    std::multimap<TimePoint, Callback> m_timers;
+};
+
+/**
+ * VirtualClock - 가상 시간 시계 (시뮬레이션용)
+ *
+ * Time only moves when every attached thread (or the single caller, if
+ * none are attached) is blocked in sleepUntil() / waitUntil(). It then
+ * jumps to the earliest pending deadline or timer, runs due timers in
+ * (time, insertion) order and wakes the sleepers that are due. notify()
+ * marks waiters runnable before time can move again, so a simulation
+ * with the same inputs always sees the same ordering of events.
+ *
+ * Work that does not go through the clock (HTTP, console I/O) takes no
+ * virtual time. Callbacks must not need a lock that a sleeping thread
+ * holds.
+ */
+class VirtualClock : public Clock {
+public:
+    /**
+     * @param startUnixMs Wall time at virtual time zero (0: current time)
+     */
+    explicit VirtualClock(uint64_t startUnixMs = 0);
+
+    TimePoint now() const override;
+    uint64_t unixTimeMs() const override;
+    void sleepUntil(TimePoint deadline) override;
+    void notify(std::condition_variable& cv) override;
+    void schedule(TimePoint when, Callback callback) override;
+
+    void attach() override;
+    void detach() override;
+
+    /**
+     * Virtual time elapsed since construction
+     */
+    Duration elapsed() const;
+
+protected:
+    void blockUntil(std::unique_lock<std::mutex>& lock, std::condition_variable& cv,
+                    TimePoint deadline) override;
+
+private:
+    struct Waiter {
+        TimePoint deadline;
+        bool wakeable;      // waitUntil(): notify() ends the wait
+        bool woken;
+    };
+
+    void waitLocked(std::unique_lock<std::mutex>& lock, TimePoint deadline, bool wakeable);
+    void advanceLocked(std::unique_lock<std::mutex>& lock);
+    void releaseDueLocked();
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+
+    TimePoint m_now;
+    uint64_t m_startUnixMs;
+
+    int m_participants;
+    int m_blocked;
+    bool m_advancing;
+    std::vector<Waiter*> m_waiters;
+    std::multimap<TimePoint, Callback> m_timers;
+};
+
+#endif // CLOCK_H
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <cstdlib>
+#include <stdexcept>
 
 /**
  * THE 3.0 IoT Device Configuration
@@ -60,6 +61,7 @@ const std::string API_ENDPOINT_SKIN = "/api/iot/skin-analysis";
 const std::string API_ENDPOINT_TREATMENT = "/api/iot/treatment";
 const std::string API_ENDPOINT_HEALTH = "/api/iot/health";
 const std::string API_ENDPOINT_TELEMETRY = "/api/iot/telemetry/batch";
+const std::string API_ENDPOINT_TELEMETRY_SUMMARY = "/api/iot/telemetry/summary";   // THE3_UPLOAD_MODE=summary
 
 //==============================================================================
 // Device Configuration
@@ -83,11 +85,104 @@ const int DATA_SEND_INTERVAL_MS = 5000;         // Send to server every 5 second
 const int HEALTH_CHECK_INTERVAL_MS = 30000;     // Health check every 30 seconds
 const int RETRY_INTERVAL_MS = 3000;             // Retry failed requests after 3 seconds
 const int MAX_RETRY_COUNT = 3;                  // Maximum retry attempts
+const int RETRY_MAX_INTERVAL_MS = 30000;        // Backoff cap (RETRY_INTERVAL_MS doubles per retry)
+const double RETRY_BUDGET_RATIO = 0.2;          // Retry tokens earned per request
+const double RETRY_BUDGET_MAX_TOKENS = 10.0;    // Retry burst allowance
+
+// Blocking requests back off on the caller's thread (menu modes): at most
+// one retry, and none that would start past the deadline
+const int HTTP_SYNC_MAX_RETRIES = 1;
+const int HTTP_SYNC_DEADLINE_MS = 10000;        // From the start of the request
+
+// Circuit breaker: fail fast while the backend is down
+const int CIRCUIT_FAILURE_THRESHOLD = 3;        // Consecutive failed attempts before opening
+const int CIRCUIT_OPEN_MS = 30000;              // Fail-fast period before a probe request
+const int HTTP_CONNECT_TIMEOUT_SEC = 5;         // TCP/TLS connect timeout (total timeout stays 30 s)
+
+// Telemetry batching (POST API_ENDPOINT_TELEMETRY)
+// A batch is flushed when any limit is reached; the age limit is DATA_SEND_INTERVAL_MS
+const int TELEMETRY_BATCH_MAX_RECORDS = 50;     // Records per batch
+const int TELEMETRY_BATCH_MAX_BYTES = 64 * 1024; // Serialized JSON array size
+
+// Edge aggregation: "raw" uploads every sample, "summary" one WindowAggregator
+// summary per window (min/max/mean/stddev/quantiles, result category counts),
+// "changes" only the samples ChangeFilter finds significant
+inline std::string getUploadMode() {
+    return getEnvOrDefault("THE3_UPLOAD_MODE", "raw");
+}
+const int AGGREGATION_WINDOW_SEC = 600;         // 600 samples per summary at 1 Hz (~1/135 of the raw JSON)
+
+inline int getAggregationWindowSec() {
+    return getEnvOrDefault("THE3_AGGREGATION_WINDOW_SEC", AGGREGATION_WINDOW_SEC);
+}
+
+// Change-only upload: deadbands around the last uploaded value, about five
+// times each channel's noise standard deviation (CUSUM also catches shifts
+// of half a deadband that persist for a few samples)
+const float CHANGE_DEADBAND_PD = 0.6f;          // pd1, pd2
+const float CHANGE_DEADBAND_MOISTURE = 1.5f;    // s1
+const float CHANGE_DEADBAND_ELASTICITY = 8.0f;  // s2
+const float CHANGE_DEADBAND_THICKNESS = 0.4f;   // s3
+const float CHANGE_DEADBAND_MOISTURE_LEVEL = 1.8f;
+const float CHANGE_DEADBAND_TEMPERATURE = 0.3f; // degrees C
+const int CHANGE_HEARTBEAT_SEC = 60;            // Upload at least one sample per minute
+
+inline int getChangeHeartbeatSec() {
+    return getEnvOrDefault("THE3_CHANGE_HEARTBEAT_SEC", CHANGE_HEARTBEAT_SEC);
+}
+
+// Store-and-forward queue for batches that failed to upload
+inline std::string getQueueFile() {
+    return getEnvOrDefault("THE3_QUEUE_FILE", "/var/lib/the3-device/outbound.queue");
+}
+const int STORE_FORWARD_QUEUE_BYTES = 16 * 1024 * 1024;  // Ring file size (~10 h at 1 Hz)
+const int STORE_FORWARD_REPLAY_BATCHES = 10;    // Max queued batches replayed per upload cycle
+const int STORE_FORWARD_SYNC_INTERVAL = 16;     // msync after this many appended batches
+
+// Local measurement history (TimeSeriesStore): mmap columnar segment files
+inline std::string getHistoryDir() {
+    return getEnvOrDefault("THE3_HISTORY_DIR", "/var/lib/the3-device/history");
+}
+const int HISTORY_SEGMENT_ROWS = 3600;          // Rows per segment file (1 h at 1 Hz, ~148 KB)
+const int HISTORY_PARTITION_MS = 3600 * 1000;   // A segment never spans two hours
+const int HISTORY_MAX_BYTES = 64 * 1024 * 1024; // Oldest segments deleted beyond this (~18 days at 1 Hz)
+const int HISTORY_SYNC_INTERVAL = 60;           // msync after this many appended rows
+
+// Auto mode: acquisition thread -> uploader thread record buffer
+const int RECORD_BUFFER_CAPACITY = 256;         // SensorRecords in RAM (~4 min at 1 Hz)
+const int RECORD_SPILL_BYTES = 4 * 1024 * 1024; // Spill file ring (~6 h at 1 Hz)
+
+// Ring overflow policy: "drop-oldest", "block" or "spill"
+inline std::string getRecordOverflowPolicy() {
+    return getEnvOrDefault("THE3_RECORD_OVERFLOW", "drop-oldest");
+}
+
+inline std::string getSpillFile() {
+    return getEnvOrDefault("THE3_SPILL_FILE", "/var/lib/the3-device/records.spill");
+}
+
+// HTTP connection pool
+const int HTTP_POOL_MAX_IDLE_HANDLES = 4;       // Idle keep-alive handles kept across all hosts
+const int HTTP_POOL_IDLE_TIMEOUT_SEC = 60;      // Evict handles unused for this long
+const int HTTP_KEEPALIVE_IDLE_SEC = 30;         // TCP keep-alive probe start
+const int HTTP_KEEPALIVE_INTERVAL_SEC = 15;     // TCP keep-alive probe interval
+
+// HTTP async engine (curl_multi event loop)
+const int HTTP_ASYNC_QUEUE_CAPACITY = 4096;     // Max queued + in-flight async requests
+const int HTTP_ASYNC_MAX_CONNECTIONS = 64;      // Max sockets opened by the event loop
+const int HTTP_ASYNC_POLL_TIMEOUT_MS = 1000;    // Idle wait between curl_multi_poll wakeups
 
 // Treatment timeouts (seconds)
 const int TREATMENT_MAX_DURATION_SEC = 1800;    // 30 minutes max treatment
 const int TREATMENT_IDLE_TIMEOUT_SEC = 300;     // 5 minutes idle timeout
 
+// Daemon mode (--daemon): one event loop on a timer wheel
+const int DAEMON_TIMER_TICK_MS = 1;             // Timer wheel resolution
+const int DAEMON_TIMER_SLACK_MS = 5;            // Start later than this counts as a late run
+const int DAEMON_TREATMENT_TICK_MS = 100;       // Treatment output update period
+const int DAEMON_STATS_INTERVAL_MS = 60000;     // Deadline/utilization report period
+const int DAEMON_DRAIN_TIMEOUT_MS = 5000;       // Wait for in-flight uploads at shutdown
+
 //==============================================================================
 // Hardware Configuration
 //==============================================================================
@@ -101,10 +196,39 @@ namespace Hardware {
     const int ADC_RESOLUTION_BITS = 16;
     const float ADC_VREF = 4.096f;              // Reference voltage
     const int ADC_SAMPLES_PER_READ = 4;         // Oversampling for noise reduction
+    const int ADC_MAX_SAMPLES_PER_READ = 64;
+    const float MEASUREMENT_HZ = 50.0f;         // Reported as SensorData::hz
+
+    // Decimation filter for oversampled blocks: "boxcar", "cic" or "median"
+    inline std::string getAdcFilter() {
+        return getEnvOrDefault("THE3_ADC_FILTER", "boxcar");
+    }
+
+    // Record every I2C transaction and DRDY edge to this file (empty: off)
+    inline std::string getI2CTraceFile() {
+        return getEnvOrDefault("THE3_I2C_TRACE", "");
+    }
 
     // Sensor power-on delay (milliseconds)
     const int SENSOR_WARMUP_MS = 100;
-    const int ADC_SETTLING_MS = 10;
+    const int ADC_SETTLING_MS = 10;             // Fixed wait (AdcReadyMode::FIXED_DELAY)
+
+    // ADC conversion completion
+    const int ADC_DATA_RATE_SPS = 860;          // Oversampled: 4 x 860 SPS per channel
+    const int ADC_READY_TIMEOUT_MS = 50;        // DRDY / status poll give-up time
+    const int ADC_POLL_INTERVAL_US = 200;       // Status register poll period
+
+    // Pipelined acquisition
+    const int TOF_POLL_INTERVAL_US = 500;       // VL6180X result status poll period
+    const int ACQUISITION_TIMEOUT_MS = 100;     // Give up on a sensor after this
+
+    // EEPROM (AT24C256)
+    const int EEPROM_ACK_POLL_US = 100;         // Address poll period during a write cycle
+    const int EEPROM_WRITE_TIMEOUT_MS = 10;     // Write cycle give-up time (2x datasheet max)
+    const int CALIBRATION_FACTORY_ADDR = 0x0000; // CalibrationData written at manufacturing
+    const int CALIBRATION_SLOT_BASE = 0x0040;   // Recalibration history slots
+    const int CALIBRATION_SLOT_SIZE = 128;      // Header + CalibrationData, two pages
+    const int CALIBRATION_SLOTS = 8;            // Saves rotate through these
 }
 
 //==============================================================================
@@ -165,6 +289,40 @@ namespace Treatment {
     const int L_DEFAULT_BRIGHTNESS = 80;
 }
 
+//==============================================================================
+// Simulation Configuration (PLATFORM_SIMULATION)
+//==============================================================================
+
+namespace Simulation {
+    // "real" or "virtual": on virtual time every wait completes as soon as
+    // all threads are idle, so a simulated hour runs in seconds
+    inline std::string getClockMode() {
+        return getEnvOrDefault("THE3_SIM_CLOCK", "real");
+    }
+
+    // Signal/device model file for the simulated sensors (empty: defaults)
+    inline std::string getConfigFile() {
+        return getEnvOrDefault("THE3_SIM_CONFIG", "");
+    }
+
+    // Overrides the seed of the model file; empty keeps it
+    inline std::string getSeed() {
+        return getEnvOrDefault("THE3_SIM_SEED", "");
+    }
+
+    // Image file of the simulated AT24C256, kept across runs (empty: erased
+    // at every start)
+    inline std::string getEepromFile() {
+        return getEnvOrDefault("THE3_SIM_EEPROM", "");
+    }
+
+    // Answer the I2C bus from a recorded trace instead of the models
+    // (original speed; as fast as possible with THE3_SIM_CLOCK=virtual)
+    inline std::string getReplayFile() {
+        return getEnvOrDefault("THE3_I2C_REPLAY", "");
+    }
+}
+
 //==============================================================================
 // Logging Configuration
 //==============================================================================
@@ -0,0 +1,79 @@
+#ifndef CRC_H
+#define CRC_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Crc16 - CRC-16-CCITT 계산
+ *
+ * CRC-16-CCITT as used for EEPROM calibration records and the
+ * store-and-forward queue framing: polynomial 0x1021, initial value
+ * 0xFFFF, MSB first, no final XOR ("CRC-16/CCITT-FALSE", check value
+ * 0x29B1 for "123456789").
+ *
+ * Three interchangeable kernels:
+ * - BITWISE : 8 shift/XOR steps per byte (reference)
+ * - TABLE   : one 256-entry table lookup per byte
+ * - SLICE8  : slicing-by-8, eight lookups in independent tables per
+ *             8 bytes, so the loads do not wait on each other (default)
+ *
+ * Incremental use:
+ *
+ *     Crc16 crc;
+ *     crc.update(header, sizeof(header));
+ *     crc.update(payload, length);
+ *     uint16_t value = crc.value();
+ */
+class Crc16 {
+public:
+    enum class Method { BITWISE, TABLE, SLICE8 };
+
+    static constexpr uint16_t INIT = 0xFFFF;
+
+    Crc16() : m_crc(INIT) {}
+
+    void update(const void* data, size_t length) { m_crc = update(m_crc, data, length); }
+    uint16_t value() const { return m_crc; }
+    void reset() { m_crc = INIT; }
+
+    /**
+     * CRC of one buffer
+     */
+    static uint16_t compute(const void* data, size_t length, Method method = Method::SLICE8)
+    {
+        return update(INIT, data, length, method);
+    }
+
+    /**
+     * Continue `crc` over `data` (no final XOR, so the value of a prefix
+     * is the state for the rest)
+     */
+    static uint16_t update(uint16_t crc, const void* data, size_t length, Method method = Method::SLICE8);
+
+    static const char* methodName(Method method);
+
+private:
+    uint16_t m_crc;
+};
+
+/**
+ * Crc8 - Sensirion CRC-8
+ *
+ * CRC-8 protecting each 16-bit word the SHT31 returns: polynomial 0x31,
+ * initial value 0xFF, no final XOR (check value 0x92 for 0xBE 0xEF).
+ * Table driven; words are 2 bytes, so slicing gains nothing.
+ */
+class Crc8 {
+public:
+    static constexpr uint8_t INIT = 0xFF;
+
+    static uint8_t compute(const uint8_t* data, size_t length);
+
+    /**
+     * Bit-at-a-time reference
+     */
+    static uint8_t computeBitwise(const uint8_t* data, size_t length);
+};
+
+#endif // CRC_H
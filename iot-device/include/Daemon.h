@@ -0,0 +1,145 @@
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Clock.h"
+#include "HttpClient.h"
+#include "SkinSensor.h"
+#include "TimerWheel.h"
+#include "TimeSeriesStore.h"
+#include "UploadPipeline.h"
+
+/**
+ * Daemon - 헤드리스 이벤트 루프 모드 (--daemon)
+ *
+ * Runs the device without the interactive menu. Sampling runs on its own
+ * acquisition thread, readSensorData() every SENSOR_READ_INTERVAL_MS into
+ * a SensorRecordBuffer (as in auto mode), so a slow bus transaction never
+ * delays the loop and the loop never delays sampling. Everything else is
+ * on one loop thread, which drains the buffer through the UploadPipeline
+ * (telemetry batch or window summary or changes only, per
+ * THE3_UPLOAD_MODE, plus the local measurement history) whenever the
+ * acquisition thread posts that records are waiting. Every periodic job is a timer on a TimerWheel, each on its
+ * own fixed phase:
+ * - flush         : upload the pending batch every DATA_SEND_INTERVAL_MS
+ * - health        : GET API_ENDPOINT_HEALTH every HEALTH_CHECK_INTERVAL_MS
+ * - treatment     : session tick every DAEMON_TREATMENT_TICK_MS while a
+ *                   treatment runs; the record is posted when it ends
+ * - stats         : deadline / utilization report every
+ *                   DAEMON_STATS_INTERVAL_MS
+ *
+ * HTTP requests are asynchronous. Their callbacks run on the HTTP event
+ * loop and only post() the completion back here, so the loop never waits
+ * on the network and all daemon state is touched by one thread. Batches
+ * that fail to upload go to the store-and-forward queue and are replayed,
+ * one request at a time, once a health probe succeeds.
+ *
+ * Between timers the loop blocks on the clock (so it runs on virtual time
+ * too); the share of time it was not blocked is reported as utilization.
+ */
+class Daemon {
+public:
+    Daemon(SkinSensor& sensor, HttpClient& client, Clock& clock, const std::string& deviceId);
+    ~Daemon();
+
+    Daemon(const Daemon&) = delete;
+    Daemon& operator=(const Daemon&) = delete;
+
+    /**
+     * Stop after this much clock time (default: until `running` is cleared)
+     */
+    void setDuration(Clock::Duration duration) { m_duration = duration; }
+
+    /**
+     * Run a treatment session of `mode` at the mode's default duration
+     * (capped at TREATMENT_MAX_DURATION_SEC), starting with the loop
+     */
+    void setTreatment(SkinSensor::TreatmentMode mode);
+
+    /**
+     * Run the loop until `running` is cleared (checked at least once per
+     * acquisition period) or the duration has passed, then stop the
+     * acquisition thread, take the records it left, flush and wait up to
+     * DAEMON_DRAIN_TIMEOUT_MS for in-flight uploads
+     */
+    void run(const std::atomic<bool>& running);
+
+    /**
+     * Run `task` on the loop thread. Thread-safe; tasks posted after the
+     * daemon is destroyed are dropped.
+     */
+    void post(std::function<void()> task);
+
+private:
+    // Shared with HTTP callbacks, which may outlive the daemon
+    struct Mailbox {
+        explicit Mailbox(Clock& clock) : clock(clock), open(true) {}
+
+        Clock& clock;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::function<void()>> tasks;
+        bool open;
+    };
+
+    static void post(const std::shared_ptr<Mailbox>& mailbox, std::function<void()> task);
+
+    size_t runPosted();
+    void wait(Clock::TimePoint deadline);
+    void drain();
+
+    void acquisitionLoop(const std::atomic<bool>& running);
+    void drainRecords();
+    void probeHealth();
+    void onHealth(const HttpClient::Response& response);
+    void treatmentTick();
+    void replayQueued();
+    void printReport(bool final);
+
+    SkinSensor& m_sensor;
+    HttpClient& m_client;
+    Clock& m_clock;
+    std::string m_deviceId;
+
+    std::shared_ptr<Mailbox> m_mailbox;
+    TimerWheel m_wheel;
+    TimeSeriesStore m_history;
+    UploadPipeline m_pipeline;
+
+    // Acquisition thread -> m_pipeline.records() -> loop;
+    // m_drainPosted: a drainRecords() task is queued
+    std::thread m_acquisition;
+    std::atomic<bool> m_acquiring;
+    std::atomic<bool> m_drainPosted;
+
+    Clock::Duration m_duration;
+    Clock::TimePoint m_started;
+    Clock::TimePoint m_reportStarted;
+    Clock::Duration m_idle;                     // Blocked on the clock since m_reportStarted
+    Clock::Duration m_totalIdle;
+
+    size_t m_requestsInFlight;                  // Health, replay and treatment requests
+
+    bool m_serverOnline;                        // Assumed until a probe says otherwise
+    bool m_healthInFlight;
+    size_t m_healthProbes;
+    size_t m_healthFailures;
+
+    bool m_replayInFlight;
+
+    bool m_treatment;
+    SkinSensor::TreatmentMode m_treatmentMode;
+    Clock::Duration m_treatmentLength;
+    Clock::TimePoint m_treatmentStarted;
+    TimerWheel::TimerId m_treatmentTimer;
+    size_t m_treatmentTicks;
+};
+
+#endif // DAEMON_H
@@ -0,0 +1,74 @@
+#ifndef DECIMATION_FILTER_H
+#define DECIMATION_FILTER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * DecimationFilter - ADC 오버샘플링 데시메이션 필터
+ *
+ * Reduces a block of raw ADC samples (one channel, taken back to back in
+ * continuous conversion mode) to a single value:
+ *
+ * - BOXCAR : arithmetic mean; best white-noise reduction (sqrt(N))
+ * - CIC    : cascaded integrator-comb of order CIC_ORDER with decimation
+ *            ratio R = (N - 1) / order + 1, evaluated as its equivalent
+ *            FIR (the order-fold convolution of a length-R box); stronger
+ *            rejection of the mains-frequency ripple folded into the block
+ * - MEDIAN : median of N; rejects isolated spikes (ESD, bus glitches)
+ *
+ * The kernels are plain loops over contiguous int16 arrays with integer
+ * accumulators so the compiler can vectorize them; CIC weights and the
+ * median scratch buffer are allocated once per block size, not per call.
+ *
+ * Not thread-safe: one filter per acquisition thread.
+ */
+class DecimationFilter {
+public:
+    enum class Type { BOXCAR, CIC, MEDIAN };
+
+    static constexpr int CIC_ORDER = 3;
+
+public:
+    explicit DecimationFilter(Type type = Type::BOXCAR);
+
+    void setType(Type type) { m_type = type; }
+    Type getType() const { return m_type; }
+
+    /**
+     * Decimate `count` samples to one value (in ADC counts)
+     * @return 0 if count is 0
+     */
+    float decimate(const int16_t* samples, size_t count);
+
+    //==========================================================================
+    // Kernels (usable without a filter object where no state is needed)
+    //==========================================================================
+
+    static float boxcar(const int16_t* samples, size_t count);
+    float cic(const int16_t* samples, size_t count);
+    float median(const int16_t* samples, size_t count);
+
+    /**
+     * Parse "boxcar", "cic" or "median" (case-sensitive)
+     * @return false for an unknown name; `type` is left unchanged
+     */
+    static bool parseType(const std::string& name, Type& type);
+    static const char* typeName(Type type);
+
+private:
+    void buildCicWeights(size_t count);
+
+    Type m_type;
+
+    // CIC equivalent FIR for the last block size
+    size_t m_cicBlockSize;
+    std::vector<int32_t> m_cicWeights;
+    int64_t m_cicGain;
+
+    std::vector<int16_t> m_scratch;
+};
+
+#endif // DECIMATION_FILTER_H
@@ -0,0 +1,153 @@
+#ifndef EEPROM_H
+#define EEPROM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "HardwareAbstraction.h"
+
+class Clock;
+
+/**
+ * Eeprom - AT24C256 드라이버 (페이지 쓰기, write-back 캐시)
+ *
+ * Reads and writes go through a RAM copy of the device, kept per 64-byte
+ * page. A read loads the pages it touches that are not cached yet (one
+ * sequential read per run of missing pages); a write only changes the
+ * copy and marks pages whose bytes actually changed as dirty. flush()
+ * writes each dirty page with one page write.
+ *
+ * Write cycles are not waited for with a fixed delay: the next access
+ * polls the device address until it ACKs (Config::Hardware::
+ * EEPROM_ACK_POLL_US, giving up after EEPROM_WRITE_TIMEOUT_MS), so the
+ * caller is free during the cycle and a fast part is not held to the
+ * datasheet maximum. flush() returns once the last cycle has completed.
+ *
+ * Dirty pages are flushed on destruction. Not thread-safe.
+ */
+class Eeprom {
+public:
+    struct Stats {
+        uint64_t bytesRead;         // Read from the device (cache misses)
+        uint64_t pageWrites;        // Page writes sent
+        uint64_t unchangedWrites;   // write() calls that matched the cached bytes
+        uint64_t ackPolls;          // Address polls NACKed during a write cycle
+        uint64_t writeTimeouts;     // Write cycles that did not finish in time
+    };
+
+public:
+    Eeprom(HAL::I2CInterface& bus, Clock& clock, uint8_t deviceAddr = HAL::I2C::ADDR_EEPROM);
+    ~Eeprom();
+
+    Eeprom(const Eeprom&) = delete;
+    Eeprom& operator=(const Eeprom&) = delete;
+
+    /**
+     * @return false if the range is outside the device or a bus transfer fails
+     */
+    bool read(size_t address, void* buffer, size_t length);
+    bool write(size_t address, const void* data, size_t length);
+
+    /**
+     * Write all dirty pages and wait for the last write cycle
+     * @return false if a page write or write cycle failed; failed pages stay dirty
+     */
+    bool flush();
+
+    /**
+     * Forget cached pages that are not dirty (re-read from the device next time)
+     */
+    void invalidate();
+
+    size_t dirtyPages() const;
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    enum PageState : uint8_t { PAGE_ABSENT, PAGE_CLEAN, PAGE_DIRTY };
+
+    bool load(size_t address, size_t length);      // Cache the pages of a range
+    bool loadPages(size_t first, size_t last);
+    bool writePage(size_t page);
+    bool waitReady();
+
+    HAL::I2CInterface& m_bus;
+    Clock& m_clock;
+    uint8_t m_address;
+
+    std::vector<uint8_t> m_data;            // HAL::EEPROM::SIZE bytes
+    std::vector<PageState> m_pages;
+    bool m_writeCycle;                      // Last page write not yet acknowledged
+    Stats m_stats;
+};
+
+/**
+ * EepromSlotTable - 버전 관리되는 레코드 슬롯 (웨어 레벨링)
+ *
+ * A record that is rewritten over the device's lifetime (calibration)
+ * kept as a history in `slots` equal slots. Each slot holds a header
+ * (magic, sequence number, length, CRC-16 over header and record) and
+ * the record. save() writes the slot after the newest one, so the slots
+ * are written in turn, each page wears at 1/slots of the save rate, and
+ * the newest record is never overwritten: a save interrupted by power
+ * loss leaves a slot with a bad CRC and the previous record in place.
+ */
+class EepromSlotTable {
+public:
+    struct Entry {
+        uint32_t sequence;          // Increases by one per save
+        size_t slot;
+        size_t length;
+    };
+
+    static constexpr size_t HEADER_SIZE = 12;
+
+public:
+    /**
+     * @param base     First slot address
+     * @param slotSize Bytes per slot, a multiple of HAL::EEPROM::PAGE_SIZE
+     */
+    EepromSlotTable(Eeprom& eeprom, size_t base, size_t slotSize, size_t slots);
+
+    /**
+     * Read and validate every slot
+     * @return false on a bus error
+     */
+    bool scan();
+
+    /**
+     * Valid records, newest first (after scan())
+     */
+    const std::vector<Entry>& history() const { return m_history; }
+
+    /**
+     * Copy a record; `length` must match the stored length
+     */
+    bool load(const Entry& entry, void* record, size_t length);
+
+    /**
+     * Store a new version and flush it to the device; a record equal to
+     * the newest version is not written again
+     */
+    bool save(const void* record, size_t length);
+
+    size_t capacity() const { return m_slotSize - HEADER_SIZE; }
+
+private:
+    struct Header {
+        uint16_t magic;
+        uint16_t length;
+        uint32_t sequence;
+        uint16_t crc;               // Over the header with crc = 0, then the record
+        uint16_t reserved;
+    };
+
+    static uint16_t checksum(Header header, const uint8_t* record);
+
+    Eeprom& m_eeprom;
+    size_t m_base;
+    size_t m_slotSize;
+    size_t m_slots;
+    std::vector<Entry> m_history;
+};
+
+#endif // EEPROM_H
@@ -1,9 +1,13 @@
 #ifndef HARDWARE_ABSTRACTION_H
 #define HARDWARE_ABSTRACTION_H
 
+#include <cstddef>
 #include <cstdint>
+#include <initializer_list>
 #include <string>
 
+class Clock;
+
 /**
  * Hardware Abstraction Layer (HAL) for THE 3.0 Skin Analysis Device
  *
@@ -13,7 +17,7 @@
  * 3. Easy hardware replacement without changing business logic
  *
  * Supported platforms:
- * - PLATFORM_RPI: Raspberry Pi (bcm2835 library)
+ * - PLATFORM_RPI: Raspberry Pi / Linux (i2c-dev, sysfs GPIO; LinuxHAL.h)
  * - PLATFORM_STM32: STM32 microcontroller (HAL library)
  * - PLATFORM_SIMULATION: Software simulation for testing
  */
@@ -91,13 +95,67 @@ namespace ADC {
     constexpr uint8_t REG_HI_THRESH  = 0x03;
 
     // Config register bits
-    constexpr uint16_t CFG_OS_SINGLE     = 0x8000;  // Start single conversion
+    constexpr uint16_t CFG_OS_SINGLE     = 0x8000;  // Write: start single conversion
+    constexpr uint16_t CFG_OS_IDLE       = 0x8000;  // Read: 1 = no conversion in progress
+    constexpr uint16_t CFG_MUX_MASK      = 0x7000;
     constexpr uint16_t CFG_MUX_AIN0      = 0x4000;  // AIN0 (PD1)
     constexpr uint16_t CFG_MUX_AIN1      = 0x5000;  // AIN1 (PD2)
     constexpr uint16_t CFG_MUX_AIN2      = 0x6000;  // AIN2 (Thickness sensor)
+    constexpr uint16_t CFG_MUX_AIN3      = 0x7000;  // AIN3 (unused)
     constexpr uint16_t CFG_PGA_4V        = 0x0200;  // +/-4.096V range
+    constexpr uint16_t CFG_MODE_CONTINUOUS = 0x0000; // Continuous conversion
     constexpr uint16_t CFG_MODE_SINGLE   = 0x0100;  // Single-shot mode
+
+    // Data rate (samples per second)
+    constexpr uint16_t CFG_DR_MASK       = 0x00E0;
+    constexpr uint16_t CFG_DR_8SPS       = 0x0000;
+    constexpr uint16_t CFG_DR_16SPS      = 0x0020;
+    constexpr uint16_t CFG_DR_32SPS      = 0x0040;
+    constexpr uint16_t CFG_DR_64SPS      = 0x0060;
     constexpr uint16_t CFG_DR_128SPS     = 0x0080;  // 128 samples per second
+    constexpr uint16_t CFG_DR_250SPS     = 0x00A0;
+    constexpr uint16_t CFG_DR_475SPS     = 0x00C0;
+    constexpr uint16_t CFG_DR_860SPS     = 0x00E0;
+
+    // Comparator queue: asserting ALERT/RDY after one conversion turns the
+    // pin into a conversion-ready signal; DISABLE leaves it high-impedance
+    constexpr uint16_t CFG_COMP_QUE_1CONV   = 0x0000;
+    constexpr uint16_t CFG_COMP_QUE_DISABLE = 0x0003;
+
+    // Hi_thresh MSB = 1 and Lo_thresh MSB = 0 select conversion-ready mode
+    // for ALERT/RDY (datasheet section 9.3.8): an active-low pulse after
+    // each conversion
+    constexpr uint16_t THRESH_RDY_HI = 0x8000;
+    constexpr uint16_t THRESH_RDY_LO = 0x0000;
+
+    /**
+     * Data rate bits for the nearest supported rate not above `sps`
+     */
+    constexpr uint16_t dataRateBits(int sps)
+    {
+        return sps >= 860 ? CFG_DR_860SPS :
+               sps >= 475 ? CFG_DR_475SPS :
+               sps >= 250 ? CFG_DR_250SPS :
+               sps >= 128 ? CFG_DR_128SPS :
+               sps >= 64  ? CFG_DR_64SPS :
+               sps >= 32  ? CFG_DR_32SPS :
+               sps >= 16  ? CFG_DR_16SPS : CFG_DR_8SPS;
+    }
+
+    /**
+     * Nominal conversion time in microseconds for the data rate bits
+     * (the internal oscillator is specified to +/-10%)
+     */
+    constexpr int conversionTimeUs(uint16_t drBits)
+    {
+        return 1000000 / ((drBits & CFG_DR_MASK) == CFG_DR_8SPS   ? 8 :
+                          (drBits & CFG_DR_MASK) == CFG_DR_16SPS  ? 16 :
+                          (drBits & CFG_DR_MASK) == CFG_DR_32SPS  ? 32 :
+                          (drBits & CFG_DR_MASK) == CFG_DR_64SPS  ? 64 :
+                          (drBits & CFG_DR_MASK) == CFG_DR_128SPS ? 128 :
+                          (drBits & CFG_DR_MASK) == CFG_DR_250SPS ? 250 :
+                          (drBits & CFG_DR_MASK) == CFG_DR_475SPS ? 475 : 860);
+    }
 
     // Voltage reference
     constexpr float VREF = 4.096f;
@@ -129,12 +187,99 @@ namespace MoistureSensor {
     constexpr int MEASURE_DELAY_LOW_MS  = 4;
 }
 
+//==============================================================================
+// ToF Sensor Configuration (VL6180X)
+//==============================================================================
+
+/**
+ * VL6180X proximity/range sensor registers (16-bit register index)
+ * Reference: ST VL6180X Datasheet (DocID025086) Section 6
+ */
+namespace ToFSensor {
+    constexpr uint16_t REG_GPIO_INTERRUPT_CONFIG = 0x0014;
+    constexpr uint16_t REG_INTERRUPT_CLEAR       = 0x0015;
+    constexpr uint16_t REG_FRESH_OUT_OF_RESET    = 0x0016;
+    constexpr uint16_t REG_SYSRANGE_START        = 0x0018;
+    constexpr uint16_t REG_RESULT_INTERRUPT_STATUS = 0x004F;
+    constexpr uint16_t REG_RESULT_RANGE_VAL      = 0x0062;   // Range in mm
+
+    constexpr uint8_t RANGE_START_SINGLE   = 0x01;
+    constexpr uint8_t INT_CONFIG_NEW_SAMPLE = 0x04;          // Range: new sample ready
+    constexpr uint8_t INT_STATUS_RANGE_MASK = 0x07;
+    constexpr uint8_t INT_CLEAR_ALL        = 0x07;
+
+    // Typical single-shot ranging time (ms)
+    constexpr int RANGE_TIME_TYPICAL_MS = 8;
+}
+
+//==============================================================================
+// EEPROM Configuration (AT24C256)
+//==============================================================================
+
+/**
+ * AT24C256 256Kbit serial EEPROM
+ * Reference: Microchip AT24C256C Datasheet (DS20006270)
+ *
+ * Every access starts with a 16-bit word address (MSB first). A write
+ * stores up to one page and wraps within it; reads run sequentially
+ * across the whole array. After a write the device runs its internal
+ * write cycle and NACKs its address until done (ACK polling).
+ */
+namespace EEPROM {
+    constexpr size_t SIZE = 32768;
+    constexpr size_t PAGE_SIZE = 64;
+    constexpr size_t PAGES = SIZE / PAGE_SIZE;
+
+    // Self-timed write cycle (us)
+    constexpr int WRITE_CYCLE_MAX_US = 5000;
+    constexpr int WRITE_CYCLE_TYPICAL_US = 3000;
+}
+
 //==============================================================================
 // HAL Interface Classes
 //==============================================================================
 
+/**
+ * One segment of a combined I2C transaction (Linux struct i2c_msg)
+ */
+struct I2CMessage {
+    static constexpr uint16_t READ = 0x0001;    // I2C_M_RD; otherwise a write
+
+    uint8_t address;
+    uint16_t flags;
+    uint16_t length;
+    uint8_t* buffer;
+
+    bool isRead() const { return (flags & READ) != 0; }
+
+    static I2CMessage write(uint8_t address, const uint8_t* data, size_t length)
+    {
+        // Write buffers are only read by the bus
+        return I2CMessage{address, 0, static_cast<uint16_t>(length), const_cast<uint8_t*>(data)};
+    }
+
+    static I2CMessage read(uint8_t address, uint8_t* buffer, size_t length)
+    {
+        return I2CMessage{address, READ, static_cast<uint16_t>(length), buffer};
+    }
+};
+
+/**
+ * Messages sent as one transaction: START, a repeated START between
+ * messages, STOP at the end. `ok` is set by transferBatch().
+ */
+struct I2CTransaction {
+    I2CMessage* messages;
+    size_t count;
+    bool ok;
+};
+
 /**
  * I2C communication interface
+ *
+ * Backends implement transfer() (one combined transaction, like Linux
+ * I2C_RDWR) and may override transferBatch() to submit several
+ * transactions at once. The register helpers are one transaction each.
  */
 class I2CInterface {
 public:
@@ -143,13 +288,181 @@ public:
     virtual bool initialize(int busNumber) = 0;
     virtual void cleanup() = 0;
 
-    virtual bool writeRegister(uint8_t deviceAddr, uint8_t regAddr, uint8_t value) = 0;
-    virtual bool writeRegister16(uint8_t deviceAddr, uint8_t regAddr, uint16_t value) = 0;
-    virtual uint8_t readRegister(uint8_t deviceAddr, uint8_t regAddr) = 0;
-    virtual uint16_t readRegister16(uint8_t deviceAddr, uint8_t regAddr) = 0;
-    virtual bool readBytes(uint8_t deviceAddr, uint8_t* buffer, size_t length) = 0;
+    /**
+     * Run `messages` as one combined transaction
+     * @return false if a message fails (NACK); later messages are not sent
+     */
+    virtual bool transfer(I2CMessage* messages, size_t count) = 0;
+
+    /**
+     * Run independent transactions in order, each ending with STOP; a
+     * failed one does not stop the others
+     * @return Number of transactions that succeeded
+     */
+    virtual size_t transferBatch(I2CTransaction* transactions, size_t count)
+    {
+        size_t succeeded = 0;
+        for (size_t i = 0; i < count; i++) {
+            transactions[i].ok = transfer(transactions[i].messages, transactions[i].count);
+            succeeded += transactions[i].ok ? 1 : 0;
+        }
+        return succeeded;
+    }
 
     virtual bool isDevicePresent(uint8_t deviceAddr) = 0;
+
+    //==========================================================================
+    // Transaction helpers
+    //==========================================================================
+
+    bool write(uint8_t deviceAddr, const uint8_t* data, size_t length)
+    {
+        I2CMessage message = I2CMessage::write(deviceAddr, data, length);
+        return transfer(&message, 1);
+    }
+
+    bool readBytes(uint8_t deviceAddr, uint8_t* buffer, size_t length)
+    {
+        I2CMessage message = I2CMessage::read(deviceAddr, buffer, length);
+        return transfer(&message, 1);
+    }
+
+    /**
+     * Write then read with a repeated START (register pointer + data)
+     */
+    bool writeRead(uint8_t deviceAddr, const uint8_t* tx, size_t txLength, uint8_t* rx, size_t rxLength)
+    {
+        I2CMessage messages[2] = {
+            I2CMessage::write(deviceAddr, tx, txLength),
+            I2CMessage::read(deviceAddr, rx, rxLength)
+        };
+        return transfer(messages, 2);
+    }
+
+    bool writeRegister(uint8_t deviceAddr, uint8_t regAddr, uint8_t value)
+    {
+        const uint8_t data[2] = {regAddr, value};
+        return write(deviceAddr, data, sizeof(data));
+    }
+
+    bool writeRegister16(uint8_t deviceAddr, uint8_t regAddr, uint16_t value)
+    {
+        // MSB first
+        const uint8_t data[3] = {regAddr, static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value & 0xFF)};
+        return write(deviceAddr, data, sizeof(data));
+    }
+
+    /**
+     * @return 0xFF on failure (an undriven bus reads high)
+     */
+    uint8_t readRegister(uint8_t deviceAddr, uint8_t regAddr)
+    {
+        uint8_t value = 0xFF;
+        return writeRead(deviceAddr, &regAddr, 1, &value, 1) ? value : 0xFF;
+    }
+
+    /**
+     * @return 0xFFFF on failure
+     */
+    uint16_t readRegister16(uint8_t deviceAddr, uint8_t regAddr)
+    {
+        uint8_t data[2];
+        if (!writeRead(deviceAddr, &regAddr, 1, data, sizeof(data))) {
+            return 0xFFFF;
+        }
+        return static_cast<uint16_t>((data[0] << 8) | data[1]);
+    }
+};
+
+/**
+ * I2CBatch - 여러 트랜잭션을 한 번에 제출
+ *
+ * Queues up to MAX_TRANSACTIONS transactions and submits them with a
+ * single transferBatch() call. Write payloads are copied into the batch,
+ * so they may be temporaries; read buffers must stay valid until submit().
+ * Fixed capacity, no allocation. Queueing into a full batch returns false
+ * and queues nothing.
+ */
+class I2CBatch {
+public:
+    static constexpr size_t MAX_TRANSACTIONS = 8;
+    static constexpr size_t MAX_MESSAGES = 16;
+    static constexpr size_t MAX_WRITE_BYTES = 64;
+
+    I2CBatch() : m_transactionCount(0), m_messageCount(0), m_writeBytes(0) {}
+
+    I2CBatch(const I2CBatch&) = delete;
+    I2CBatch& operator=(const I2CBatch&) = delete;
+
+    bool write(uint8_t deviceAddr, std::initializer_list<uint8_t> data)
+    {
+        return add(deviceAddr, data, nullptr, 0);
+    }
+
+    bool read(uint8_t deviceAddr, uint8_t* buffer, size_t length)
+    {
+        return add(deviceAddr, {}, buffer, length);
+    }
+
+    bool writeRead(uint8_t deviceAddr, std::initializer_list<uint8_t> tx, uint8_t* rx, size_t rxLength)
+    {
+        return add(deviceAddr, tx, rx, rxLength);
+    }
+
+    /**
+     * Run the queued transactions; ok(i) then reports each one
+     * @param bus I2CInterface or a concrete bus (bound statically)
+     * @return Number of transactions that succeeded
+     */
+    template <typename Bus>
+    size_t submit(Bus& bus)
+    {
+        return m_transactionCount > 0 ? bus.transferBatch(m_transactions, m_transactionCount) : 0;
+    }
+
+    bool ok(size_t index) const { return index < m_transactionCount && m_transactions[index].ok; }
+    size_t size() const { return m_transactionCount; }
+
+    void clear()
+    {
+        m_transactionCount = 0;
+        m_messageCount = 0;
+        m_writeBytes = 0;
+    }
+
+private:
+    bool add(uint8_t deviceAddr, std::initializer_list<uint8_t> tx, uint8_t* rx, size_t rxLength)
+    {
+        size_t messages = (tx.size() > 0 ? 1 : 0) + (rx ? 1 : 0);
+        if (m_transactionCount == MAX_TRANSACTIONS || m_messageCount + messages > MAX_MESSAGES ||
+            m_writeBytes + tx.size() > MAX_WRITE_BYTES) {
+            return false;
+        }
+
+        I2CTransaction& transaction = m_transactions[m_transactionCount++];
+        transaction.messages = &m_messages[m_messageCount];
+        transaction.count = messages;
+        transaction.ok = false;
+
+        if (tx.size() > 0) {
+            uint8_t* data = &m_writeData[m_writeBytes];
+            for (uint8_t byte : tx) {
+                m_writeData[m_writeBytes++] = byte;
+            }
+            m_messages[m_messageCount++] = I2CMessage::write(deviceAddr, data, tx.size());
+        }
+        if (rx) {
+            m_messages[m_messageCount++] = I2CMessage::read(deviceAddr, rx, rxLength);
+        }
+        return true;
+    }
+
+    I2CTransaction m_transactions[MAX_TRANSACTIONS];
+    I2CMessage m_messages[MAX_MESSAGES];
+    uint8_t m_writeData[MAX_WRITE_BYTES];
+    size_t m_transactionCount;
+    size_t m_messageCount;
+    size_t m_writeBytes;
 };
 
 /**
@@ -184,10 +497,11 @@ public:
 //==============================================================================
 
 /**
- * Factory function to create platform-specific HAL instances
+ * Factory function to create platform-specific HAL instances.
+ * Simulated devices time their conversions and interrupts on `clock`.
  */
-I2CInterface* createI2CInterface();
-GPIOInterface* createGPIOInterface();
+I2CInterface* createI2CInterface(Clock& clock);
+GPIOInterface* createGPIOInterface(Clock& clock);
 
 /**
  * Check if running in simulation mode
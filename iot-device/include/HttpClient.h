@@ -3,7 +3,20 @@
 
 #include <string>
 #include <map>
+#include <set>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <future>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include "RetryPolicy.h"
+
+struct curl_slist;
 
 /**
  * HttpClient - HTTP 통신 클라이언트
@@ -12,6 +25,12 @@
  * - REST API 호출 (GET, POST)
  * - JSON 데이터 송수신
  * - API Key 인증 지원
+ * - Keep-alive 연결 풀 (호스트별 curl easy handle 재사용)
+ * - 비동기 요청: 단일 curl_multi 이벤트 루프 스레드에서 모든 요청을 다중화
+ * - 재시도: 지수 백오프 + 지터, 재시도 예산, 엔드포인트별 재시도 상태 코드 분류
+ * - 서킷 브레이커: 서버 장애 시 타임아웃을 기다리지 않고 즉시 실패
+ *
+ * Async callbacks run on the event-loop thread and must not block.
  */
 class HttpClient {
 public:
@@ -22,16 +41,32 @@ public:
         std::map<std::string, std::string> headers;
         bool success;
         std::string errorMessage;
+        int attempts = 0;           // Transfers performed, including retries (0 = failed fast)
+        bool requestSent = false;   // The last transfer sent its request (the server may have acted on it)
     };
 
     // 콜백 타입 정의
     using ResponseCallback = std::function<void(const Response&)>;
 
+    // 비동기 요청 식별자 (0 = 요청이 거부됨)
+    using RequestId = uint64_t;
+
+    // 연결 풀 통계
+    struct PoolStats {
+        size_t idleHandles;         // Handles currently parked in the pool
+        size_t handlesCreated;      // curl_easy_init calls
+        size_t handlesReused;       // Checkouts served from the pool
+        size_t handlesEvicted;      // Handles closed by idle timeout or pool overflow
+    };
+
 public:
     HttpClient();
     HttpClient(const std::string& baseUrl, const std::string& apiKey);
     ~HttpClient();
 
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
     // 초기화
     bool initialize();
     void cleanup();
@@ -47,31 +82,147 @@ public:
 
     // HTTP GET 요청
     Response get(const std::string& endpoint);
-    void getAsync(const std::string& endpoint, ResponseCallback callback);
+    RequestId getAsync(const std::string& endpoint, ResponseCallback callback);
 
     // HTTP POST 요청 (JSON)
     Response post(const std::string& endpoint, const std::string& jsonBody);
-    void postAsync(const std::string& endpoint, const std::string& jsonBody, ResponseCallback callback);
+    RequestId postAsync(const std::string& endpoint, const std::string& jsonBody, ResponseCallback callback);
+    std::future<Response> postAsync(const std::string& endpoint, const std::string& jsonBody);
+
+    /**
+     * Cancel a queued or in-flight async request.
+     * The callback still runs once, with errorMessage "Request cancelled".
+     * @return false if the request already completed
+     */
+    bool cancel(RequestId id);
 
     // 서버 연결 상태 확인
     bool checkConnection();
 
     // 타임아웃 설정 (초)
     void setTimeout(int seconds);
+    void setConnectTimeout(int seconds);
+
+    //==========================================================================
+    // Retry / Circuit Breaker
+    //==========================================================================
+
+    RetryPolicy& retryPolicy() { return m_retryPolicy; }
+    CircuitBreaker& circuitBreaker() { return m_breaker; }
+
+    //==========================================================================
+    // Connection Pool
+    //==========================================================================
+
+    /**
+     * Maximum number of idle handles kept across all hosts.
+     * A value of 0 disables pooling (every request opens a new connection).
+     */
+    void setPoolSize(size_t maxIdleHandles);
+
+    /**
+     * Idle handles older than this are closed on the next checkout/return
+     */
+    void setIdleTimeout(int seconds);
+
+    /**
+     * Close every pooled handle that exceeded the idle timeout
+     */
+    void evictIdleConnections();
+
+    PoolStats getPoolStats();
+
+    //==========================================================================
+    // Async Engine
+    //==========================================================================
+
+    /**
+     * Maximum number of outstanding (queued + in-flight) async requests.
+     * Submissions beyond this fail immediately with "Async queue full".
+     */
+    void setAsyncQueueCapacity(size_t capacity);
+
+    /**
+     * Maximum number of sockets the event loop opens (default
+     * Config::HTTP_ASYNC_MAX_CONNECTIONS); takes effect at initialize()
+     */
+    void setAsyncMaxConnections(size_t maxConnections);
+
+    size_t getPendingAsyncCount();
 
 private:
+    // Async request state (defined in HttpClient.cpp)
+    struct AsyncRequest;
+
+    // Pooled curl easy handle (void* keeps <curl/curl.h> out of the header)
+    struct PooledHandle {
+        void* handle;
+        std::chrono::steady_clock::time_point lastUsed;
+    };
+
     // CURL 콜백 함수
     static size_t writeCallback(void* contents, size_t size, size_t nmemb, std::string* userp);
 
     // 내부 요청 처리
+    Response executeRequest(const std::string& endpoint, const std::string& method, const std::string& body = "");
     Response performRequest(const std::string& url, const std::string& method, const std::string& body = "");
+    void configureHandle(void* handle, const std::string& url, const std::string& method,
+                         const std::string& body, std::string* responseBody, curl_slist* headers);
+    curl_slist* buildHeaderList();
+    static void completeResponse(void* handle, int curlCode, std::string& responseBody, Response& response);
+    bool recordOutcome(const std::string& endpoint, const Response& response);
+    static Response circuitOpenResponse();
+
+    // 비동기 이벤트 루프
+    RequestId submitAsync(const std::string& endpoint, const std::string& method, const std::string& body,
+                          ResponseCallback callback, std::shared_ptr<std::promise<Response>> promise);
+    void eventLoop();
+    void startAsyncRequest(std::unique_ptr<AsyncRequest> request);
+    std::unique_ptr<AsyncRequest> detachAsyncRequest(void* handle);
+    void completeAsyncRequest(std::unique_ptr<AsyncRequest> request, const Response& response);
+    void startDueRetries(bool flushAll);
+    bool cancelInLoop(RequestId id);
+    static void deliver(AsyncRequest& request, const Response& response);
+
+    // 연결 풀 관리
+    static std::string poolKey(const std::string& url);
+    void* acquireHandle(const std::string& key);
+    void releaseHandle(const std::string& key, void* handle);
+    void evictIdleLocked(std::chrono::steady_clock::time_point now);
+    void clearPool();
 
     // 멤버 변수
     std::string m_baseUrl;
     std::string m_apiKey;
     std::map<std::string, std::string> m_headers;
     int m_timeout;
+    int m_connectTimeout;
     bool m_initialized;
+
+    RetryPolicy m_retryPolicy;
+    CircuitBreaker m_breaker;
+
+    // Keep-alive handle pool, keyed by scheme://host:port
+    std::mutex m_poolMutex;
+    std::map<std::string, std::vector<PooledHandle>> m_idleHandles;
+    size_t m_maxIdleHandles;
+    std::chrono::seconds m_idleTimeout;
+    PoolStats m_poolStats;
+
+    // curl_multi event loop; all async requests are multiplexed on one thread
+    void* m_multi;
+    std::thread m_loopThread;
+    std::mutex m_asyncMutex;
+    std::deque<std::unique_ptr<AsyncRequest>> m_submitQueue;
+    std::vector<RequestId> m_cancelQueue;
+    std::set<RequestId> m_outstanding;          // Queued or in flight
+    std::map<void*, std::unique_ptr<AsyncRequest>> m_inFlight;  // Loop thread only
+    std::multimap<std::chrono::steady_clock::time_point,
+                  std::unique_ptr<AsyncRequest>> m_retryTimers;   // Loop thread only
+    size_t m_asyncQueueCapacity;
+    size_t m_asyncMaxConnections;
+    std::atomic<RequestId> m_nextRequestId;
+    bool m_stopping;
 };
 
 #endif // HTTP_CLIENT_H
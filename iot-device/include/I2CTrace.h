@@ -0,0 +1,231 @@
+#ifndef I2C_TRACE_H
+#define I2C_TRACE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "HardwareAbstraction.h"
+#include "Clock.h"
+
+namespace HAL {
+
+/**
+ * I2C trace - 버스 트랜잭션 기록/재생
+ *
+ * TracingI2C / TracingGPIO wrap a real (or simulated) backend and record
+ * every I2C transaction and every interrupt edge delivered to SkinSensor.
+ * ReplayI2C plays such a trace back without hardware, so a field capture
+ * can be used to profile acquisition code on a dev box.
+ *
+ * File format (little-endian):
+ *   header : "I2CT" | u8 version | u64 Unix time of the first record (ms)
+ *   record : u8 type | zigzag varint time delta (us) to the previous record
+ *   type 1 : transaction (time = start)
+ *            varint duration (us) | u8 ok | u8 message count | messages
+ *            message: u8 address | u8 flags (I2CMessage::READ) |
+ *                     varint length | data (written, or read back)
+ *   type 2 : interrupt edge | u8 pin
+ *
+ * Records are written in completion order, so a time delta can be
+ * negative (an edge delivered during a transaction).
+ */
+class I2CTraceWriter {
+public:
+    static constexpr uint8_t VERSION = 1;
+
+    /**
+     * Writer for `path`, shared by every caller that opens the same path
+     * while it is open (the I2C and GPIO wrappers write one file)
+     * @return nullptr if the file cannot be created
+     */
+    static std::shared_ptr<I2CTraceWriter> open(const std::string& path, Clock& clock);
+
+    ~I2CTraceWriter();
+
+    I2CTraceWriter(const I2CTraceWriter&) = delete;
+    I2CTraceWriter& operator=(const I2CTraceWriter&) = delete;
+
+    void transaction(Clock::TimePoint start, Clock::TimePoint end,
+                     const I2CMessage* messages, size_t count, bool ok);
+    void edge(int pin, Clock::TimePoint when);
+    void flush();
+
+    uint64_t getRecords() const;
+
+private:
+    I2CTraceWriter(std::FILE* file, Clock& clock);
+
+    void putTime(Clock::TimePoint when);
+    void putVarint(uint64_t value);
+    void putByte(uint8_t value) { m_buffer.push_back(value); }
+    void flushIfFull();
+
+    std::FILE* m_file;
+    Clock& m_clock;
+    mutable std::mutex m_mutex;
+    std::vector<uint8_t> m_buffer;
+    Clock::TimePoint m_origin;          // Time of the header
+    int64_t m_lastUs;                   // Time of the previous record
+    uint64_t m_records;
+};
+
+/**
+ * Records every transaction of `inner` (which it owns)
+ *
+ * transferBatch() is traced transaction by transaction, so each record
+ * has its own start and duration.
+ */
+class TracingI2C : public I2CInterface {
+public:
+    TracingI2C(I2CInterface* inner, std::shared_ptr<I2CTraceWriter> writer, Clock& clock);
+
+    bool initialize(int busNumber) override;
+    void cleanup() override;
+    bool transfer(I2CMessage* messages, size_t count) override;
+    bool isDevicePresent(uint8_t deviceAddr) override { return m_inner->isDevicePresent(deviceAddr); }
+
+private:
+    std::shared_ptr<I2CTraceWriter> m_writer;
+    Clock& m_clock;
+    std::unique_ptr<I2CInterface> m_inner;
+};
+
+/**
+ * Records every interrupt edge `inner` (which it owns) delivers
+ */
+class TracingGPIO : public GPIOInterface {
+public:
+    TracingGPIO(GPIOInterface* inner, std::shared_ptr<I2CTraceWriter> writer, Clock& clock);
+
+    bool initialize() override { return m_inner->initialize(); }
+    void cleanup() override;
+
+    bool setDirection(int pin, Direction dir) override { return m_inner->setDirection(pin, dir); }
+    bool setPullMode(int pin, PullMode mode) override { return m_inner->setPullMode(pin, mode); }
+    bool write(int pin, bool value) override { return m_inner->write(pin, value); }
+    bool read(int pin) override { return m_inner->read(pin); }
+    bool setPWM(int pin, int frequency, int dutyCycle) override { return m_inner->setPWM(pin, frequency, dutyCycle); }
+    bool stopPWM(int pin) override { return m_inner->stopPWM(pin); }
+
+    bool setInterrupt(int pin, Edge edge, void (*callback)(int, void*), void* userData) override;
+
+private:
+    struct Hook {
+        TracingGPIO* self;
+        void (*callback)(int, void*);
+        void* userData;
+    };
+
+    static void onEdge(int pin, void* hook);
+
+    // Destroyed in reverse: the inner GPIO stops delivering edges before
+    // the hooks and the writer it calls into go away
+    std::shared_ptr<I2CTraceWriter> m_writer;
+    Clock& m_clock;
+    std::map<int, std::unique_ptr<Hook>> m_hooks;
+    std::unique_ptr<GPIOInterface> m_inner;
+};
+
+/**
+ * `bus` wrapped in a TracingI2C writing to `path`, or `bus` itself when
+ * `path` is empty or cannot be created
+ */
+I2CInterface* traceI2C(I2CInterface* bus, const std::string& path, Clock& clock);
+GPIOInterface* traceGPIO(GPIOInterface* gpio, const std::string& path, Clock& clock);
+
+/**
+ * Bus that answers from a recorded trace
+ *
+ * Transactions are replayed per device (address of the first message),
+ * so the order in which the pipelined acquisition interleaves devices
+ * may differ from the recording, as it does when replay timing differs
+ * slightly. For each request to a device:
+ *   1. the device's next recorded transaction, if the request matches it
+ *   2. else its previous one again, if that matches (an extra status poll)
+ *   3. else the next one anyway, counted as a mismatch
+ * A match means the same addresses, directions, lengths and written
+ * bytes. The recorded read data and result are returned and the recorded
+ * duration is taken on the clock (original speed on SystemClock, no wall
+ * time on VirtualClock). Requests to a device with no transactions left
+ * fail.
+ *
+ * Each recorded edge is anchored to the transaction before it - by
+ * default any device's, or the last one to the device set with
+ * setEdgeSource() - and raised through the edge sink at the same offset
+ * from the end of that transaction's replay.
+ */
+class ReplayI2C : public I2CInterface {
+public:
+    using EdgeSink = std::function<void(int pin, Clock::TimePoint when)>;
+
+    struct Stats {
+        uint64_t replayed;      // Transactions answered from the trace
+        uint64_t repeated;      // ... by repeating the device's previous one (rule 2)
+        uint64_t mismatched;    // ... whose request differed from the recording (rule 3)
+        uint64_t edges;         // Interrupt edges raised
+        uint64_t exhausted;     // Transfers to a device with nothing left
+        size_t remaining;       // Transactions left
+    };
+
+    ReplayI2C(Clock& clock, EdgeSink edgeSink);
+
+    /**
+     * Anchor edges on `pin` to transactions to `deviceAddr` (before load())
+     */
+    void setEdgeSource(int pin, uint8_t deviceAddr) { m_edgeSources[pin] = deviceAddr; }
+
+    /**
+     * @param error Set on failure (unreadable file, bad header, truncated record)
+     */
+    bool load(const std::string& path, std::string& error);
+
+    bool initialize(int busNumber) override;
+    void cleanup() override;
+    bool transfer(I2CMessage* messages, size_t count) override;
+    bool isDevicePresent(uint8_t deviceAddr) override { return m_devices.count(deviceAddr) != 0; }
+
+    Stats getStats() const;
+    bool finished() const;
+
+private:
+    struct Message {
+        uint8_t address;
+        uint8_t flags;
+        std::vector<uint8_t> data;
+    };
+
+    struct Record {
+        uint8_t type;
+        int64_t timeUs;                 // Since the first record
+        uint32_t durationUs;
+        bool ok;
+        int pin;
+        std::vector<Message> messages;
+        std::vector<size_t> edges;      // Edge records anchored to this transaction
+    };
+
+    struct Device {
+        std::vector<size_t> transactions;
+        size_t next;
+    };
+
+    bool matches(const Record& record, const I2CMessage* messages, size_t count) const;
+    void raiseEdges(const Record& record, Clock::TimePoint replayedEnd);
+
+    Clock& m_clock;
+    EdgeSink m_edgeSink;
+    std::map<int, uint8_t> m_edgeSources;
+    std::vector<Record> m_records;
+    std::map<uint8_t, Device> m_devices;
+    size_t m_edgeCount;
+    Stats m_stats;
+};
+
+} // namespace HAL
+
+#endif // I2C_TRACE_H
@@ -0,0 +1,82 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * JsonWriter - 할당 없는 JSON 직렬화
+ *
+ * Appends JSON tokens to a caller-owned std::string. When the caller
+ * clears and reuses the same buffer, steady-state serialization performs
+ * no heap allocation: numbers are formatted into stack buffers and
+ * strings are escaped in place.
+ *
+ * - Commas are inserted automatically from the previous character
+ * - Strings are escaped per RFC 8259 (quotes, backslash, control
+ *   characters); UTF-8 is passed through unchanged
+ * - Floats use fixed-point formatting with a given number of decimals,
+ *   independent of the global locale; NaN/Inf are written as null
+ * - NumberStyle::QUOTED writes numbers as strings ("125.50"), which is
+ *   what the backend DTOs expect; NumberStyle::NUMBER writes 125.50
+ */
+class JsonWriter {
+public:
+    enum class NumberStyle { QUOTED, NUMBER };
+
+public:
+    explicit JsonWriter(std::string& buffer, NumberStyle style = NumberStyle::QUOTED)
+        : m_out(buffer), m_style(style) {}
+
+    JsonWriter& beginObject() { separator(); m_out.push_back('{'); return *this; }
+    JsonWriter& endObject() { m_out.push_back('}'); return *this; }
+    JsonWriter& beginArray() { separator(); m_out.push_back('['); return *this; }
+    JsonWriter& endArray() { m_out.push_back(']'); return *this; }
+
+    JsonWriter& key(const char* name);
+
+    JsonWriter& value(const std::string& str) { return value(str.data(), str.size()); }
+    JsonWriter& value(const char* str);
+    JsonWriter& value(const char* str, size_t length);
+    JsonWriter& value(int64_t number);
+    JsonWriter& value(int number) { return value(static_cast<int64_t>(number)); }
+    JsonWriter& value(double number, int decimals = 2);
+    JsonWriter& value(bool flag);
+    JsonWriter& null();
+
+    // key + value shorthands
+    JsonWriter& field(const char* name, const std::string& str) { return key(name).value(str); }
+    JsonWriter& field(const char* name, const char* str);
+    JsonWriter& field(const char* name, int number) { return key(name).value(number); }
+    JsonWriter& field(const char* name, int64_t number) { return key(name).value(number); }
+    JsonWriter& field(const char* name, double number, int decimals = 2) { return key(name).value(number, decimals); }
+
+    NumberStyle numberStyle() const { return m_style; }
+
+    //==========================================================================
+    // Formatting primitives (usable without a writer)
+    //==========================================================================
+
+    static void appendEscaped(std::string& out, const char* str, size_t length);
+    static void appendInt(std::string& out, int64_t number);
+    static void appendFixed(std::string& out, double number, int decimals);
+
+private:
+    // Comma unless this is the first token of the buffer, object or array,
+    // or the value of a key
+    void separator()
+    {
+        if (!m_out.empty()) {
+            char last = m_out.back();
+            if (last != '{' && last != '[' && last != ':') {
+                m_out.push_back(',');
+            }
+        }
+    }
+
+    std::string& m_out;
+    NumberStyle m_style;
+};
+
+#endif // JSON_WRITER_H
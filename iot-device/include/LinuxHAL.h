@@ -0,0 +1,125 @@
+#ifndef LINUX_HAL_H
+#define LINUX_HAL_H
+
+#ifdef __linux__
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <sys/ioctl.h>
+#include "HardwareAbstraction.h"
+
+/**
+ * Linux HAL - i2c-dev / sysfs GPIO 백엔드
+ *
+ * The real-hardware backend of PLATFORM_RPI (any Linux board with the
+ * i2c-dev driver loaded works the same way).
+ *
+ * - LinuxI2C  : /dev/i2c-N; each transaction is one ioctl(I2C_RDWR), so a
+ *               write-then-read is a repeated start as the devices expect
+ * - LinuxGPIO : /sys/class/gpio with BCM pin numbers; interrupts poll()
+ *               the value file on a thread per pin. Pull resistors and
+ *               PWM are not available through sysfs.
+ *
+ * With THE3_I2C_TRACE set, createI2CInterface() / createGPIOInterface()
+ * record the bus to a trace file (see I2CTrace.h).
+ */
+
+namespace HAL {
+
+/**
+ * final, with transfer() inline, so SensorBus<LinuxI2C> (THE3_STATIC_HAL)
+ * reaches the ioctl without a virtual call
+ */
+class LinuxI2C final : public I2CInterface {
+public:
+    LinuxI2C();
+    ~LinuxI2C() override;
+
+    bool initialize(int busNumber) override;
+    void cleanup() override;
+
+    bool transfer(I2CMessage* messages, size_t count) override
+    {
+        if (m_fd < 0 || count == 0 || count > I2C_RDWR_IOCTL_MAX_MSGS) {
+            return false;
+        }
+
+        struct i2c_msg msgs[I2C_RDWR_IOCTL_MAX_MSGS];
+        for (size_t i = 0; i < count; i++) {
+            msgs[i].addr = messages[i].address;
+            msgs[i].flags = messages[i].isRead() ? I2C_M_RD : 0;
+            msgs[i].len = messages[i].length;
+            msgs[i].buf = messages[i].buffer;
+        }
+
+        struct i2c_rdwr_ioctl_data data;
+        data.msgs = msgs;
+        data.nmsgs = static_cast<__u32>(count);
+
+        // Returns the number of messages completed; a NACK fails the whole call
+        return ::ioctl(m_fd, I2C_RDWR, &data) == static_cast<int>(count);
+    }
+
+    // One ioctl per transaction: I2C_RDWR ends only the last message with a STOP
+    size_t transferBatch(I2CTransaction* transactions, size_t count) override
+    {
+        size_t succeeded = 0;
+        for (size_t i = 0; i < count; i++) {
+            transactions[i].ok = transfer(transactions[i].messages, transactions[i].count);
+            succeeded += transactions[i].ok ? 1 : 0;
+        }
+        return succeeded;
+    }
+
+    bool isDevicePresent(uint8_t deviceAddr) override;
+
+private:
+    int m_fd;
+    std::string m_path;
+};
+
+class LinuxGPIO : public GPIOInterface {
+public:
+    LinuxGPIO();
+    ~LinuxGPIO() override;
+
+    bool initialize() override;
+    void cleanup() override;
+
+    bool setDirection(int pin, Direction dir) override;
+    bool setPullMode(int pin, PullMode mode) override;
+    bool write(int pin, bool value) override;
+    bool read(int pin) override;
+
+    bool setPWM(int pin, int frequency, int dutyCycle) override;
+    bool stopPWM(int pin) override;
+
+    bool setInterrupt(int pin, Edge edge, void (*callback)(int, void*), void* userData) override;
+
+private:
+    struct Watcher {
+        int fd;
+        std::atomic<bool> running;
+        std::thread thread;
+    };
+
+    bool exportPin(int pin);
+    bool writeAttribute(int pin, const char* attribute, const std::string& value);
+    void stopWatcher(int pin);
+    static void watch(Watcher* watcher, int pin, void (*callback)(int, void*), void* userData);
+
+    std::set<int> m_exported;           // Unexported again by cleanup()
+    std::map<int, std::unique_ptr<Watcher>> m_watchers;
+};
+
+} // namespace HAL
+
+#endif // __linux__
+
+#endif // LINUX_HAL_H
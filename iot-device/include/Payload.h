@@ -0,0 +1,85 @@
+#ifndef PAYLOAD_H
+#define PAYLOAD_H
+
+#include <string>
+#include <cstdint>
+#include "SkinSensor.h"
+#include "JsonWriter.h"
+#include "WindowAggregator.h"
+
+/**
+ * Payload - 서버 전송용 페이로드 생성
+ *
+ * Serializes SensorData / TreatmentData into the JSON bodies accepted by
+ * the backend's SkinAnalysisRequest and TreatmentDataRequest DTOs (and
+ * window summaries into telemetry batch records), and
+ * into the compact binary and CSV encodings defined by the same field
+ * tables (see SensorSchema.h).
+ *
+ * The append* functions write into a caller-supplied buffer; clear and
+ * reuse the same buffer per measurement and no allocation takes place
+ * once it has grown to payload size.
+ */
+namespace Payload {
+
+//==============================================================================
+// JSON
+//==============================================================================
+
+void appendSkinAnalysisJson(std::string& out,
+                            const SkinSensor::SensorData& data,
+                            const std::string& deviceId,
+                            JsonWriter::NumberStyle style = JsonWriter::NumberStyle::QUOTED);
+
+void appendTreatmentJson(std::string& out,
+                         const SkinSensor::TreatmentData& data,
+                         const std::string& deviceId,
+                         JsonWriter::NumberStyle style = JsonWriter::NumberStyle::QUOTED);
+
+/**
+ * One WindowAggregator summary, posted in the telemetry batch array in
+ * place of the window's samples. "recordType":"summary" tells it apart
+ * from a measurement; each channel is an object with min, max, mean,
+ * stddev and p10/p50/p90, each result field an object of category counts.
+ */
+void appendWindowSummaryJson(std::string& out,
+                             const WindowAggregator::Summary& summary,
+                             const std::string& deviceId,
+                             JsonWriter::NumberStyle style = JsonWriter::NumberStyle::QUOTED);
+
+// Convenience wrappers returning a new string
+std::string buildSkinAnalysisJson(const SkinSensor::SensorData& data, const std::string& deviceId);
+std::string buildTreatmentJson(const SkinSensor::TreatmentData& data, const std::string& deviceId);
+
+//==============================================================================
+// Binary
+//==============================================================================
+
+/**
+ * Schema fields in table order. Treatment records start with one byte
+ * holding the TreatmentMode, followed by the common and mode fields.
+ */
+void appendSkinAnalysisBinary(std::string& out, const SkinSensor::SensorData& data);
+void appendTreatmentBinary(std::string& out, const SkinSensor::TreatmentData& data);
+
+/**
+ * @return false if the buffer is truncated or the mode byte is invalid
+ */
+bool readSkinAnalysisBinary(const uint8_t* data, size_t length, SkinSensor::SensorData& out);
+bool readTreatmentBinary(const uint8_t* data, size_t length, SkinSensor::TreatmentData& out);
+
+//==============================================================================
+// CSV
+//==============================================================================
+
+// Header and row without line terminator
+void appendSkinAnalysisCsvHeader(std::string& out);
+void appendSkinAnalysisCsvRow(std::string& out, const SkinSensor::SensorData& data);
+
+// Treatment columns depend on the mode: common fields, then mode fields
+void appendTreatmentCsvHeader(std::string& out, SkinSensor::TreatmentMode mode);
+void appendTreatmentCsvRow(std::string& out, const SkinSensor::TreatmentData& data);
+
+} // namespace Payload
+
+#endif // PAYLOAD_H
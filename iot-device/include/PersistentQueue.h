@@ -0,0 +1,134 @@
+#ifndef PERSISTENT_QUEUE_H
+#define PERSISTENT_QUEUE_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * PersistentQueue - 오프라인 저장 후 전송(store-and-forward) 큐
+ *
+ * Fixed-size ring of variable-length records stored in a memory-mapped
+ * file, used to keep telemetry that could not be uploaded.
+ *
+ * File layout:
+ *   [0x0000] Header (one page): magic, version, capacity, head, tail
+ *   [0x1000] Data ring (capacity bytes)
+ *
+ * Record framing (8-byte aligned, never split across the ring end):
+ *   u32 length | u16 CRC16-CCITT of payload | u16 flags | payload | pad
+ *
+ * head/tail are monotonically increasing logical byte offsets; the
+ * physical position is offset % capacity. A record is published by
+ * writing payload, then frame, then the tail in the header, so a crash
+ * can lose at most the record being written. On open the ring is walked
+ * from head to tail and the tail is truncated at the first frame whose
+ * CRC does not match. Nothing is fsync'd per record; call sync() at a
+ * cadence that fits the storage.
+ *
+ * When full, the oldest records are dropped to make room.
+ * Not thread-safe.
+ */
+class PersistentQueue {
+public:
+    struct Stats {
+        uint64_t appended;      // Records committed since open
+        uint64_t consumed;      // Records popped since open
+        uint64_t dropped;       // Oldest records overwritten because the ring was full
+        uint64_t corrupt;       // Records discarded on open or read due to CRC mismatch
+        size_t records;         // Records currently queued
+        size_t bytesUsed;       // Ring bytes in use (frames + padding)
+        size_t capacity;        // Ring size in bytes
+    };
+
+public:
+    PersistentQueue();
+    ~PersistentQueue();
+
+    PersistentQueue(const PersistentQueue&) = delete;
+    PersistentQueue& operator=(const PersistentQueue&) = delete;
+
+    /**
+     * Open or create the ring file.
+     * An existing file with a different capacity or a bad header is reset.
+     * @param capacityBytes Ring size, rounded up to a multiple of 8
+     */
+    bool open(const std::string& path, size_t capacityBytes);
+    void close();
+    bool isOpen() const { return m_base != nullptr; }
+
+    //==========================================================================
+    // Producer
+    //==========================================================================
+
+    /**
+     * Reserve space for a record and return a pointer into the mapping.
+     * The caller writes the payload in place, then calls commit().
+     * @return nullptr if the record can never fit (larger than capacity / 4)
+     */
+    uint8_t* reserve(size_t length);
+
+    /**
+     * Publish the reserved record; length may be smaller than reserved
+     */
+    bool commit(size_t length);
+
+    /**
+     * reserve() + copy + commit()
+     */
+    bool append(const void* data, size_t length);
+
+    //==========================================================================
+    // Consumer
+    //==========================================================================
+
+    /**
+     * Oldest record, pointing into the mapping (valid until the next pop/append)
+     */
+    bool peek(const uint8_t*& data, size_t& length);
+
+    /**
+     * Discard the record returned by peek()
+     */
+    void pop();
+
+    bool empty() const;
+    size_t size() const { return m_records; }
+
+    /**
+     * Flush dirty pages to storage
+     * @param wait true for MS_SYNC, false to only schedule write-back
+     */
+    void sync(bool wait = false);
+
+    Stats getStats() const;
+
+private:
+    struct Header;
+    struct Frame;
+
+    Header* header() const;
+    uint8_t* ring() const;
+    size_t physical(uint64_t offset) const;
+    Frame* frameAt(uint64_t offset) const;
+    size_t frameSpan(const Frame* frame) const;
+
+    void initializeHeader();
+    void recover();
+    bool dropOldest();
+
+    int m_fd;
+    uint8_t* m_base;
+    size_t m_mappedSize;
+    size_t m_capacity;
+
+    // Reservation in progress (logical tail offset of its frame)
+    uint64_t m_reservedAt;
+    size_t m_reservedLength;
+    bool m_reserved;
+
+    size_t m_records;
+    Stats m_stats;
+};
+
+#endif // PERSISTENT_QUEUE_H
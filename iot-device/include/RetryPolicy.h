@@ -0,0 +1,140 @@
+#ifndef RETRY_POLICY_H
+#define RETRY_POLICY_H
+
+#include <string>
+#include <set>
+#include <map>
+#include <mutex>
+#include <random>
+#include <chrono>
+
+/**
+ * RetryPolicy - HTTP 재시도 정책
+ *
+ * Decides whether a failed request is retried and how long to wait:
+ * - Exponential backoff from Config::RETRY_INTERVAL_MS with equal jitter
+ *   (half the delay is fixed, half is random) so devices that lost the
+ *   server at the same time do not retry in lockstep
+ * - At most Config::MAX_RETRY_COUNT retries per request
+ * - Retry budget: each request earns RETRY_BUDGET_RATIO tokens and each
+ *   retry spends one, so retries stay a bounded fraction of traffic
+ * - Per-endpoint classification of retryable HTTP statuses, because a
+ *   non-idempotent POST must not be replayed on every 5xx
+ *
+ * Thread-safe.
+ */
+class RetryPolicy {
+public:
+    struct EndpointRule {
+        std::set<int> retryableStatuses;
+        bool retryTransportErrors;      // Connection refused, timeout, DNS, ...
+        bool retryAfterSend;            // Also when the request was sent (e.g. timed out
+                                        // waiting for the reply: it may have been processed)
+    };
+
+public:
+    RetryPolicy();
+
+    /**
+     * Override the classification for one endpoint path
+     */
+    void setEndpointRule(const std::string& endpoint, const EndpointRule& rule);
+
+    void setMaxRetries(int maxRetries);
+    void setBackoff(std::chrono::milliseconds base, std::chrono::milliseconds max);
+
+    /**
+     * @param transportOk false if no HTTP response was received
+     * @param statusCode HTTP status (ignored when transportOk is false)
+     * @param requestSent the request went out before the transport error
+     */
+    bool isRetryable(const std::string& endpoint, bool transportOk, int statusCode,
+                     bool requestSent = false) const;
+
+    /**
+     * Delay before retry number `retry` (1-based), jittered
+     */
+    std::chrono::milliseconds backoffDelay(int retry);
+
+    int maxRetries() const;
+
+    /**
+     * Budget accounting: call onRequest() once per logical request, and
+     * tryAcquireRetry() before each retry
+     */
+    void onRequest();
+    bool tryAcquireRetry();
+
+private:
+    const EndpointRule& ruleFor(const std::string& endpoint) const;
+
+    mutable std::mutex m_mutex;
+    EndpointRule m_defaultRule;
+    std::map<std::string, EndpointRule> m_rules;
+
+    int m_maxRetries;
+    std::chrono::milliseconds m_baseDelay;
+    std::chrono::milliseconds m_maxDelay;
+
+    double m_budgetTokens;
+    std::mt19937 m_rng;
+};
+
+/**
+ * CircuitBreaker - 서버 장애 시 빠른 실패 처리
+ *
+ * CLOSED    : requests flow; consecutive failures are counted
+ * OPEN      : after CIRCUIT_FAILURE_THRESHOLD consecutive failures every
+ *             request fails immediately for CIRCUIT_OPEN_MS
+ * HALF_OPEN : after the open period one probe request is let through;
+ *             success closes the circuit, failure re-opens it. A probe
+ *             that ends without an outcome (cancelled, never sent) must
+ *             be released, or no request would ever be let through again
+ *
+ * Thread-safe.
+ */
+class CircuitBreaker {
+public:
+    enum class State { CLOSED, OPEN, HALF_OPEN };
+
+public:
+    CircuitBreaker();
+    CircuitBreaker(int failureThreshold, std::chrono::milliseconds openDuration);
+
+    /**
+     * @param probe Set to true if the request was admitted as the
+     *              HALF_OPEN probe; it must then end in recordSuccess(),
+     *              recordFailure() or releaseProbe()
+     * @return false if the request must fail fast
+     */
+    bool allowRequest(bool* probe = nullptr);
+
+    /**
+     * Consecutive failures that open the circuit; 0 disables the breaker
+     */
+    void setFailureThreshold(int failureThreshold);
+
+    void recordSuccess();
+    void recordFailure();
+
+    /**
+     * The probe finished without a result: let the next request probe
+     */
+    void releaseProbe();
+
+    State state() const;
+    size_t rejectedCount() const;
+
+private:
+    mutable std::mutex m_mutex;
+    int m_failureThreshold;
+    std::chrono::milliseconds m_openDuration;
+
+    State m_state;
+    int m_consecutiveFailures;
+    bool m_probeInFlight;
+    std::chrono::steady_clock::time_point m_openedAt;
+    size_t m_rejected;
+};
+
+#endif // RETRY_POLICY_H
@@ -0,0 +1,214 @@
+#ifndef SENSOR_BUS_H
+#define SENSOR_BUS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include "HardwareAbstraction.h"
+
+#if defined(PLATFORM_RPI) && defined(THE3_STATIC_HAL)
+#include "LinuxHAL.h"
+#endif
+
+namespace HAL {
+
+/**
+ * SensorBus - 센서 레지스터 접근 계층
+ *
+ * Every bus access of SkinSensor: raw transfers and batches, the ADS1115
+ * register helpers (with the pointer register tracked so back-to-back
+ * conversion reads skip the pointer write) and the VL6180X 16-bit index
+ * helpers. Counts transactions and HAL calls for AcquisitionTiming.
+ *
+ * `Bus` is the bus type the calls are bound to:
+ * - a concrete final bus (LinuxI2C): every call binds statically and the
+ *   register helpers inline down to the ioctl
+ * - I2CInterface: calls dispatch through the vtable, so any backend
+ *   works (simulation, trace recording and replay, test doubles)
+ *
+ * Header-only so each instantiation is compiled where it is used.
+ */
+template <typename Bus>
+class SensorBus {
+public:
+    static constexpr uint8_t ADC_POINTER_UNKNOWN = 0xFF;
+
+    SensorBus()
+        : m_bus(nullptr)
+        , m_adcPointer(ADC_POINTER_UNKNOWN)
+        , m_transactions(0)
+        , m_calls(0)
+    {
+    }
+
+    /**
+     * Bus to use (not owned); nullptr makes every access fail
+     */
+    void attach(Bus* bus)
+    {
+        m_bus = bus;
+        m_adcPointer = ADC_POINTER_UNKNOWN;
+    }
+
+    //==========================================================================
+    // Transfers
+    //==========================================================================
+
+    bool transfer(I2CMessage* messages, size_t count)
+    {
+        if (!m_bus) {
+            return false;
+        }
+        m_transactions++;
+        m_calls++;
+        return m_bus->transfer(messages, count);
+    }
+
+    /**
+     * @return Transactions that succeeded
+     */
+    size_t submit(I2CBatch& batch)
+    {
+        if (!m_bus) {
+            return 0;
+        }
+        m_transactions += static_cast<uint32_t>(batch.size());
+        m_calls++;
+
+        size_t succeeded = batch.submit(*m_bus);
+        if (succeeded < batch.size()) {
+            m_adcPointer = ADC_POINTER_UNKNOWN;     // A queued pointer write may not have landed
+        }
+        return succeeded;
+    }
+
+    bool write(uint8_t addr, std::initializer_list<uint8_t> data)
+    {
+        I2CMessage message = I2CMessage::write(addr, data.begin(), data.size());
+        return transfer(&message, 1);
+    }
+
+    bool read(uint8_t addr, uint8_t* buffer, size_t length)
+    {
+        I2CMessage message = I2CMessage::read(addr, buffer, length);
+        return transfer(&message, 1);
+    }
+
+    bool writeRead(uint8_t addr, std::initializer_list<uint8_t> tx, uint8_t* rx, size_t rxLength)
+    {
+        I2CMessage messages[2] = {
+            I2CMessage::write(addr, tx.begin(), tx.size()),
+            I2CMessage::read(addr, rx, rxLength)
+        };
+        return transfer(messages, 2);
+    }
+
+    //==========================================================================
+    // ADS1115 Registers
+    //==========================================================================
+
+    bool adcWriteRegister(uint8_t reg, uint16_t value)
+    {
+        // Pointer byte, then the value MSB first; the pointer stays at `reg`
+        bool ok = write(I2C::ADDR_PHOTODIODE_ADC,
+                        {reg, static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value & 0xFF)});
+        m_adcPointer = ok ? reg : ADC_POINTER_UNKNOWN;
+        return ok;
+    }
+
+    /**
+     * @return Register value, 0xFFFF on failure
+     */
+    uint16_t adcReadRegister(uint8_t reg)
+    {
+        // The pointer register persists, so a repeated read needs no pointer write
+        uint8_t data[2];
+        bool ok = (m_adcPointer == reg) ? read(I2C::ADDR_PHOTODIODE_ADC, data, sizeof(data))
+                                        : writeRead(I2C::ADDR_PHOTODIODE_ADC, {reg}, data, sizeof(data));
+        m_adcPointer = ok ? reg : ADC_POINTER_UNKNOWN;
+        return ok ? static_cast<uint16_t>((data[0] << 8) | data[1]) : 0xFFFF;
+    }
+
+    void queueAdcWrite(I2CBatch& batch, uint8_t reg, uint16_t value)
+    {
+        batch.write(I2C::ADDR_PHOTODIODE_ADC,
+                    {reg, static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value & 0xFF)});
+        m_adcPointer = reg;
+    }
+
+    /**
+     * Queue a read of the conversion register (2 bytes into `data`)
+     */
+    void queueAdcRead(I2CBatch& batch, uint8_t* data)
+    {
+        if (m_adcPointer == ADC::REG_CONVERSION) {
+            batch.read(I2C::ADDR_PHOTODIODE_ADC, data, 2);
+        } else {
+            batch.writeRead(I2C::ADDR_PHOTODIODE_ADC, {ADC::REG_CONVERSION}, data, 2);
+        }
+        m_adcPointer = ADC::REG_CONVERSION;
+    }
+
+    //==========================================================================
+    // VL6180X Registers (16-bit indices)
+    //==========================================================================
+
+    bool tofWriteRegister(uint16_t index, uint8_t value)
+    {
+        // Bytes on the wire: index MSB, index LSB, value
+        return write(I2C::ADDR_ELASTICITY_SENSOR,
+                     {static_cast<uint8_t>(index >> 8), static_cast<uint8_t>(index & 0xFF), value});
+    }
+
+    /**
+     * @return Register value, 0 on failure
+     */
+    uint8_t tofReadRegister(uint16_t index)
+    {
+        // Set the 16-bit index pointer, then read one byte after a repeated START
+        uint8_t value = 0;
+        if (!writeRead(I2C::ADDR_ELASTICITY_SENSOR,
+                       {static_cast<uint8_t>(index >> 8), static_cast<uint8_t>(index & 0xFF)}, &value, 1)) {
+            return 0;
+        }
+        return value;
+    }
+
+    //==========================================================================
+    // Counters (acquisition thread only)
+    //==========================================================================
+
+    uint32_t getTransactions() const { return m_transactions; }
+    uint32_t getCalls() const { return m_calls; }
+
+private:
+    Bus* m_bus;
+    uint8_t m_adcPointer;               // ADS1115 pointer register, or ADC_POINTER_UNKNOWN
+    uint32_t m_transactions;
+    uint32_t m_calls;
+};
+
+template <typename Bus>
+constexpr uint8_t SensorBus<Bus>::ADC_POINTER_UNKNOWN;
+
+//==============================================================================
+// Platform bus
+//==============================================================================
+
+/**
+ * Bus type SkinSensor is compiled against, and its factory.
+ * THE3_STATIC_HAL (PLATFORM_RPI only, off by default) binds it to
+ * LinuxI2C; the I2C trace wrapper is then unavailable and GPIO is not
+ * traced either. Otherwise createI2CInterface() is used.
+ */
+#if defined(PLATFORM_RPI) && defined(THE3_STATIC_HAL)
+using PlatformBus = LinuxI2C;
+PlatformBus* createPlatformBus(Clock& clock);
+#else
+using PlatformBus = I2CInterface;
+inline PlatformBus* createPlatformBus(Clock& clock) { return createI2CInterface(clock); }
+#endif
+
+} // namespace HAL
+
+#endif // SENSOR_BUS_H
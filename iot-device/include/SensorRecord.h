@@ -0,0 +1,49 @@
+#ifndef SENSOR_RECORD_H
+#define SENSOR_RECORD_H
+
+#include <cstdint>
+#include "SkinSensor.h"
+
+/**
+ * SensorRecord - 고정 크기 측정 레코드
+ *
+ * Trivially copyable copy of SkinSensor::SensorData for passing
+ * measurements between threads (SpscRing) and spilling them to disk
+ * (PersistentQueue) without allocation. Strings are stored NUL-terminated
+ * in fixed arrays; longer values are truncated on a UTF-8 character
+ * boundary. The layout is the spill file format: bump VERSION when it
+ * changes.
+ */
+struct SensorRecord {
+    static constexpr uint16_t VERSION = 1;
+
+    static constexpr size_t RESULT_LEN = 16;    // "slightly_dry" is the longest result
+    static constexpr size_t NAME_LEN = 64;
+    static constexpr size_t DATE_LEN = 16;      // YYYY-MM-DD
+
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t sequence;          // Assigned by the producer, wraps
+
+    float pd1;
+    float pd2;
+    float hz;
+    float s1;
+    float s2;
+    float s3;
+    float moistureLevel;
+    float temperatureC;
+    uint16_t adcRaw[4];
+    uint64_t timestamp;
+
+    char thicknessResult[RESULT_LEN];
+    char elasticityResult[RESULT_LEN];
+    char moistureLevelResult[RESULT_LEN];
+    char patientName[NAME_LEN];
+    char birthDate[DATE_LEN];
+
+    static SensorRecord fromSensorData(const SkinSensor::SensorData& data, uint32_t sequence = 0);
+    SkinSensor::SensorData toSensorData() const;
+};
+
+#endif // SENSOR_RECORD_H
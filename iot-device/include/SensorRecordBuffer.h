@@ -0,0 +1,142 @@
+#ifndef SENSOR_RECORD_BUFFER_H
+#define SENSOR_RECORD_BUFFER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include "SensorRecord.h"
+#include "SpscRing.h"
+#include "PersistentQueue.h"
+#include "Clock.h"
+
+/**
+ * SensorRecordBuffer - 측정 스레드와 업로드 스레드 사이의 레코드 버퍼
+ *
+ * Decouples the acquisition thread (producer) from the uploader thread
+ * (consumer) so a slow or hanging POST never delays sampling. Records go
+ * through a SpscRing; what happens when the ring is full is set by the
+ * overflow policy:
+ *
+ * - DROP_OLDEST : overwrite the oldest record (wait-free, default)
+ * - BLOCK       : the producer waits for the consumer (lossless, but
+ *                 sampling stalls while the uploader is stuck)
+ * - SPILL       : append to a PersistentQueue file. While spilled records
+ *                 exist every new record is spilled too, and the consumer
+ *                 drains the ring before the file, so order is preserved.
+ *                 Records left in the file are delivered after a restart.
+ *
+ * The producer never takes a lock on the DROP_OLDEST path; the mutex is
+ * only used for the spill file and to wake a sleeping side. Waits run on
+ * the given Clock, so both threads can live on virtual time.
+ */
+class SensorRecordBuffer {
+public:
+    enum class OverflowPolicy { DROP_OLDEST, BLOCK, SPILL };
+
+    struct Stats {
+        uint64_t pushed;        // Records accepted by push()
+        uint64_t popped;        // Records returned by pop()
+        uint64_t dropped;       // Records lost (overwritten, or spill file full / closed)
+        uint64_t spilled;       // Records written to the spill file
+        uint64_t unspilled;     // Records read back from the spill file
+        uint64_t blocked;       // push() calls that had to wait (BLOCK)
+        size_t highWater;       // Largest ring occupancy seen
+        size_t size;            // Records currently in the ring
+        size_t spillPending;    // Records currently in the spill file
+        size_t capacity;        // Ring capacity
+    };
+
+public:
+    SensorRecordBuffer(size_t capacity, OverflowPolicy policy, Clock& clock = Clock::system());
+    ~SensorRecordBuffer();
+
+    SensorRecordBuffer(const SensorRecordBuffer&) = delete;
+    SensorRecordBuffer& operator=(const SensorRecordBuffer&) = delete;
+
+    /**
+     * Open the spill file (SPILL policy). Call before the threads start.
+     * @return false if it cannot be opened; the policy falls back to DROP_OLDEST
+     */
+    bool openSpill(const std::string& path, size_t capacityBytes);
+
+    OverflowPolicy getPolicy() const { return m_policy; }
+
+    //==========================================================================
+    // Producer
+    //==========================================================================
+
+    /**
+     * @return false if the record was not queued (closed, or lost on spill failure).
+     *         An overwrite of an older record still returns true.
+     */
+    bool push(const SensorRecord& record);
+
+    /**
+     * No more records will be pushed; wakes both sides
+     */
+    void close();
+
+    //==========================================================================
+    // Consumer
+    //==========================================================================
+
+    /**
+     * Oldest record, waiting up to `timeout` for one
+     * @return false on timeout, or once closed and drained
+     */
+    bool pop(SensorRecord& record, std::chrono::milliseconds timeout);
+
+    /**
+     * true once close() was called and every record has been popped
+     */
+    bool finished() const;
+
+    Stats getStats() const;
+
+    /**
+     * Parse "drop-oldest", "block" or "spill"
+     * @return false for an unknown name; `policy` is left unchanged
+     */
+    static bool parsePolicy(const std::string& name, OverflowPolicy& policy);
+    static const char* policyName(OverflowPolicy policy);
+
+private:
+    bool spill(const SensorRecord& record);
+    bool unspill(SensorRecord& record);
+    bool tryPop(SensorRecord& record);
+    void wakeConsumer();
+    void wakeProducer();
+
+    SpscRing<SensorRecord> m_ring;
+    OverflowPolicy m_policy;
+    Clock& m_clock;
+
+    std::atomic<bool> m_closed;
+    uint32_t m_sequence;                // Producer only
+
+    // Spill file (SPILL policy); m_spillActive mirrors !m_spill.empty()
+    PersistentQueue m_spill;
+    std::mutex m_spillMutex;
+    std::atomic<bool> m_spillActive;
+    std::atomic<size_t> m_spillRecords;
+
+    // Sleeping side, woken by the other
+    mutable std::mutex m_waitMutex;
+    std::condition_variable m_dataCv;
+    std::condition_variable m_spaceCv;
+    std::atomic<bool> m_consumerWaiting;
+    std::atomic<bool> m_producerWaiting;
+
+    // Relaxed counters; m_highWater is written by the producer only
+    std::atomic<uint64_t> m_pushed;
+    std::atomic<uint64_t> m_popped;
+    std::atomic<uint64_t> m_dropped;
+    std::atomic<uint64_t> m_spilled;
+    std::atomic<uint64_t> m_unspilled;
+    std::atomic<uint64_t> m_blocked;
+    std::atomic<size_t> m_highWater;
+};
+
+#endif // SENSOR_RECORD_BUFFER_H
@@ -0,0 +1,323 @@
+#ifndef SENSOR_SCHEMA_H
+#define SENSOR_SCHEMA_H
+
+#include <string>
+#include <tuple>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+#include "SkinSensor.h"
+#include "JsonWriter.h"
+
+/**
+ * SensorSchema - 컴파일 타임 필드 스키마
+ *
+ * One constexpr field-descriptor table per record type (name, member
+ * pointer, output formats, float decimals) drives every encoding:
+ *
+ * - JSON fields through JsonWriter (the backend DTO field names)
+ * - Compact binary: little-endian, float as IEEE-754 bits, int as int32,
+ *   uint64 as 8 bytes, strings as u8 length + bytes (max 255)
+ * - CSV header and rows (RFC 4180 quoting)
+ *
+ * Tables are std::tuples of Field<T, M> built in constexpr functions and
+ * walked with an index_sequence, so each encoder is a straight-line
+ * sequence of typed member accesses the compiler can fully inline; there
+ * is no runtime type information or name lookup.
+ *
+ * TreatmentData has a common table plus one table per TreatmentMode;
+ * visitTreatmentMode() selects the table for a mode.
+ */
+namespace Schema {
+
+//==============================================================================
+// Field Descriptors
+//==============================================================================
+
+enum Format : unsigned {
+    JSON   = 1u << 0,
+    BINARY = 1u << 1,
+    CSV    = 1u << 2,
+    ALL    = JSON | BINARY | CSV
+};
+
+template <typename T, typename M>
+struct Field {
+    const char* name;
+    M T::* member;
+    unsigned formats;
+    int decimals;           // Float fields only
+};
+
+template <typename T, typename M>
+constexpr Field<T, M> field(const char* name, M T::* member, unsigned formats = ALL, int decimals = 2)
+{
+    return Field<T, M>{name, member, formats, decimals};
+}
+
+template <typename Tuple, typename Fn, size_t... I>
+inline void forEachImpl(const Tuple& fields, Fn&& fn, std::index_sequence<I...>)
+{
+    using expand = int[];
+    (void)expand{0, (fn(std::get<I>(fields)), 0)...};
+}
+
+/**
+ * Call fn(field) for every descriptor in the table, in order
+ */
+template <typename... F, typename Fn>
+inline void forEach(const std::tuple<F...>& fields, Fn&& fn)
+{
+    forEachImpl(fields, std::forward<Fn>(fn), std::index_sequence_for<F...>());
+}
+
+//==============================================================================
+// Tables
+//==============================================================================
+
+using SensorData = SkinSensor::SensorData;
+using TreatmentData = SkinSensor::TreatmentData;
+
+// Field order of the skin analysis payload; timestamp and temperature are
+// kept locally (binary / CSV) but are not part of the backend DTO
+constexpr auto sensorFields()
+{
+    return std::make_tuple(
+        field("patientName", &SensorData::patientName),
+        field("birthDate", &SensorData::birthDate),
+        field("pd1", &SensorData::pd1),
+        field("pd2", &SensorData::pd2),
+        field("hz", &SensorData::hz),
+        field("s1", &SensorData::s1),
+        field("s2", &SensorData::s2),
+        field("s3", &SensorData::s3),
+        field("moistureLevel", &SensorData::moistureLevel),
+        field("thicknessResult", &SensorData::thicknessResult),
+        field("elasticityResult", &SensorData::elasticityResult),
+        field("moistureLevelResult", &SensorData::moistureLevelResult),
+        field("temperatureC", &SensorData::temperatureC, BINARY | CSV),
+        field("timestamp", &SensorData::timestamp, BINARY | CSV));
+}
+
+constexpr auto treatmentCommonFields()
+{
+    return std::make_tuple(
+        field("patientName", &TreatmentData::patientName),
+        field("birthDate", &TreatmentData::birthDate),
+        field("timestamp", &TreatmentData::timestamp, BINARY | CSV));
+}
+
+constexpr auto vibrationFields()
+{
+    return std::make_tuple(
+        field("vMode", &TreatmentData::vMode),
+        field("vSensitivity", &TreatmentData::vSensitivity),
+        field("vTime", &TreatmentData::vTime),
+        field("vHz", &TreatmentData::vHz));
+}
+
+constexpr auto iontophoresisFields()
+{
+    return std::make_tuple(
+        field("iTime", &TreatmentData::iTime),
+        field("iCurrent", &TreatmentData::iCurrent));
+}
+
+constexpr auto highFrequencyFields()
+{
+    return std::make_tuple(
+        field("tTime", &TreatmentData::tTime),
+        field("tVoltage", &TreatmentData::tVoltage),
+        field("tHz", &TreatmentData::tHz));
+}
+
+constexpr auto ledFields()
+{
+    return std::make_tuple(
+        field("lMode", &TreatmentData::lMode),
+        field("lBrightness", &TreatmentData::lBrightness),
+        field("lTime", &TreatmentData::lTime),
+        field("lHz", &TreatmentData::lHz));
+}
+
+/**
+ * Call fn(treatmentTypeCode, modeFields) for the table of `mode`.
+ * The code is the single-letter treatmentType used by the backend.
+ *
+ * @return false for an unknown mode value
+ */
+template <typename Fn>
+inline bool visitTreatmentMode(SkinSensor::TreatmentMode mode, Fn&& fn)
+{
+    switch (mode) {
+        case SkinSensor::TreatmentMode::VIBRATION:      fn("V", vibrationFields()); return true;
+        case SkinSensor::TreatmentMode::IONTOPHORESIS:  fn("I", iontophoresisFields()); return true;
+        case SkinSensor::TreatmentMode::HIGH_FREQUENCY: fn("T", highFrequencyFields()); return true;
+        case SkinSensor::TreatmentMode::LED_THERAPY:    fn("L", ledFields()); return true;
+    }
+    return false;
+}
+
+//==============================================================================
+// Per-Type Encoders
+//==============================================================================
+
+namespace detail {
+
+// JSON
+inline void writeJson(JsonWriter& json, const char* name, const std::string& v, int) { json.field(name, v); }
+inline void writeJson(JsonWriter& json, const char* name, float v, int decimals) { json.field(name, static_cast<double>(v), decimals); }
+inline void writeJson(JsonWriter& json, const char* name, int v, int) { json.field(name, v); }
+inline void writeJson(JsonWriter& json, const char* name, uint64_t v, int) { json.field(name, static_cast<int64_t>(v)); }
+
+// Binary
+inline void putLE(std::string& out, uint64_t v, size_t bytes)
+{
+    char buffer[8];
+    for (size_t i = 0; i < bytes; i++) {
+        buffer[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+    }
+    out.append(buffer, bytes);
+}
+
+inline uint64_t getLE(const uint8_t* p, size_t bytes)
+{
+    uint64_t v = 0;
+    for (size_t i = 0; i < bytes; i++) {
+        v |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    return v;
+}
+
+inline void writeBinary(std::string& out, const std::string& v)
+{
+    size_t length = v.size() < 255 ? v.size() : 255;
+    out.push_back(static_cast<char>(length));
+    out.append(v.data(), length);
+}
+
+inline void writeBinary(std::string& out, float v)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    putLE(out, bits, 4);
+}
+
+inline void writeBinary(std::string& out, int v) { putLE(out, static_cast<uint32_t>(v), 4); }
+inline void writeBinary(std::string& out, uint64_t v) { putLE(out, v, 8); }
+
+inline bool readBinary(const uint8_t*& p, const uint8_t* end, std::string& v)
+{
+    if (p >= end || static_cast<size_t>(end - p) < 1u + p[0]) return false;
+    v.assign(reinterpret_cast<const char*>(p + 1), p[0]);
+    p += 1 + p[0];
+    return true;
+}
+
+inline bool readBinary(const uint8_t*& p, const uint8_t* end, float& v)
+{
+    if (end - p < 4) return false;
+    uint32_t bits = static_cast<uint32_t>(getLE(p, 4));
+    std::memcpy(&v, &bits, sizeof(v));
+    p += 4;
+    return true;
+}
+
+inline bool readBinary(const uint8_t*& p, const uint8_t* end, int& v)
+{
+    if (end - p < 4) return false;
+    v = static_cast<int32_t>(static_cast<uint32_t>(getLE(p, 4)));
+    p += 4;
+    return true;
+}
+
+inline bool readBinary(const uint8_t*& p, const uint8_t* end, uint64_t& v)
+{
+    if (end - p < 8) return false;
+    v = getLE(p, 8);
+    p += 8;
+    return true;
+}
+
+// CSV
+inline void writeCsv(std::string& out, const std::string& v, int)
+{
+    if (v.find_first_of(",\"\r\n") == std::string::npos) {
+        out.append(v);
+        return;
+    }
+    out.push_back('"');
+    for (char c : v) {
+        if (c == '"') out.push_back('"');
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+inline void writeCsv(std::string& out, float v, int decimals) { JsonWriter::appendFixed(out, v, decimals); }
+inline void writeCsv(std::string& out, int v, int) { JsonWriter::appendInt(out, v); }
+inline void writeCsv(std::string& out, uint64_t v, int) { JsonWriter::appendInt(out, static_cast<int64_t>(v)); }
+
+inline void csvSeparator(std::string& out, bool& first)
+{
+    if (!first) out.push_back(',');
+    first = false;
+}
+
+} // namespace detail
+
+//==============================================================================
+// Table-Driven Encoders
+//==============================================================================
+
+template <typename T, typename Table>
+inline void appendJsonFields(JsonWriter& json, const T& obj, const Table& fields)
+{
+    forEach(fields, [&](const auto& f) {
+        if (f.formats & JSON) detail::writeJson(json, f.name, obj.*(f.member), f.decimals);
+    });
+}
+
+template <typename T, typename Table>
+inline void appendBinary(std::string& out, const T& obj, const Table& fields)
+{
+    forEach(fields, [&](const auto& f) {
+        if (f.formats & BINARY) detail::writeBinary(out, obj.*(f.member));
+    });
+}
+
+template <typename T, typename Table>
+inline bool readBinary(const uint8_t*& p, const uint8_t* end, T& obj, const Table& fields)
+{
+    bool ok = true;
+    forEach(fields, [&](const auto& f) {
+        if (ok && (f.formats & BINARY)) ok = detail::readBinary(p, end, obj.*(f.member));
+    });
+    return ok;
+}
+
+template <typename Table>
+inline void appendCsvHeader(std::string& out, const Table& fields, bool& first)
+{
+    forEach(fields, [&](const auto& f) {
+        if (f.formats & CSV) {
+            detail::csvSeparator(out, first);
+            out.append(f.name);
+        }
+    });
+}
+
+template <typename T, typename Table>
+inline void appendCsvRow(std::string& out, const T& obj, const Table& fields, bool& first)
+{
+    forEach(fields, [&](const auto& f) {
+        if (f.formats & CSV) {
+            detail::csvSeparator(out, first);
+            detail::writeCsv(out, obj.*(f.member), f.decimals);
+        }
+    });
+}
+
+} // namespace Schema
+
+#endif // SENSOR_SCHEMA_H
@@ -0,0 +1,158 @@
+#ifndef SIMULATION_HAL_H
+#define SIMULATION_HAL_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include "HardwareAbstraction.h"
+
+/**
+ * Simulation HAL - 모델 기반 시뮬레이션 장치
+ *
+ * The simulated I2C devices (ADS1115, SHT31, VL6180X) return values from
+ * per-channel signal models and take a modelled, jittered time to convert.
+ * The AT24C256 EEPROM starts erased, or from the image file named by
+ * THE3_SIM_EEPROM, which every page write updates.
+ * Transfers to a device can fail with a configured probability, like a
+ * NACK on a noisy bus.
+ *
+ * Everything random comes from std::mt19937 streams derived from one seed
+ * (one stream per signal, plus one for latencies and one for bus errors),
+ * so a run with the same seed, configuration and clock produces the same
+ * values. On a VirtualClock the whole run is reproducible.
+ *
+ * Configuration: defaults, then the file named by THE3_SIM_CONFIG, then
+ * THE3_SIM_SEED. The file holds `key = value` lines ('#' starts a comment):
+ *
+ *     seed = 42
+ *     adc0.base = 24000          # signals: adc0..adc3 (counts),
+ *     adc0.noise = 60            # temperature (°C), humidity (%RH),
+ *     adc0.amplitude = 200       # range (mm)
+ *     ads1115.error_rate = 0.001 # devices: ads1115, sht31, vl6180x,
+ *                                # at24c256
+ *
+ * Signal keys: base, drift (per hour), noise (standard deviation), step
+ * (standard deviation of a step change), step_rate (steps per hour),
+ * amplitude, hz (periodic component; default is the measurement rate
+ * reported as SensorData::hz). Device keys: latency_scale (x typical
+ * conversion time), latency_jitter (+/- fraction), error_rate (0..1).
+ */
+
+namespace HAL {
+
+/**
+ * One simulated channel:
+ * base + drift * t + steps + amplitude * sin(2 pi hz t) + noise
+ */
+struct SignalModel {
+    double base;
+    double driftPerHour;
+    double noise;           // Gaussian, standard deviation
+    double stepSize;        // Gaussian step change, standard deviation
+    double stepsPerHour;    // Mean rate of step changes (Poisson)
+    double amplitude;
+    double frequencyHz;
+};
+
+/**
+ * Timing and reliability of one simulated device
+ */
+struct DeviceModel {
+    double latencyScale;    // Multiplies the typical conversion time
+    double latencyJitter;   // Uniform +/- fraction of the conversion time
+    double errorRate;       // Probability that a transfer fails
+};
+
+struct SimulationConfig {
+    static constexpr int ADC_CHANNELS = 4;
+
+    uint32_t seed;
+    SignalModel adc[ADC_CHANNELS];  // ADS1115 AIN0..AIN3, in counts
+    SignalModel temperature;        // SHT31, °C
+    SignalModel humidity;           // SHT31, %RH
+    SignalModel range;              // VL6180X, mm
+
+    DeviceModel ads1115;
+    DeviceModel sht31;
+    DeviceModel vl6180x;
+    DeviceModel at24c256;
+
+    static SimulationConfig defaults();
+
+    /**
+     * Apply one `key = value` setting
+     * @return false for an unknown key or a malformed value
+     */
+    bool set(const std::string& key, const std::string& value);
+
+    /**
+     * Apply the settings in a file; nothing is applied if any line is bad
+     * @param error Set to "path:line: reason" on failure
+     */
+    bool load(const std::string& path, std::string& error);
+};
+
+/**
+ * Deterministic random source for the simulation
+ *
+ * Seeded through std::seed_seq{seed, stream}, and gaussian() is a
+ * Box-Muller transform on the raw mt19937 output, so the sequence does
+ * not depend on the standard library's distribution implementations.
+ */
+class SimulationRandom {
+public:
+    SimulationRandom(uint32_t seed, uint32_t stream);
+
+    double uniform();               // (0, 1)
+    double gaussian();              // Mean 0, standard deviation 1
+    double exponential(double mean);
+
+private:
+    std::mt19937 m_engine;
+    bool m_hasSpare;
+    double m_spare;
+};
+
+/**
+ * Generator for one SignalModel
+ *
+ * Step times and noise use separate streams, so when steps happen does
+ * not depend on how often the channel is sampled.
+ */
+class SimulationSignal {
+public:
+    SimulationSignal(const SignalModel& model, uint32_t seed, uint32_t stream);
+
+    /**
+     * Value at `seconds` since the start of the simulation. Steps are only
+     * applied going forward; sample times should not decrease.
+     */
+    double sample(double seconds);
+
+private:
+    SignalModel m_model;
+    SimulationRandom m_stepRandom;
+    SimulationRandom m_noiseRandom;
+    double m_stepOffset;
+    double m_nextStepAt;
+};
+
+#ifdef PLATFORM_SIMULATION
+
+/**
+ * Simulated I2C bus with the given models (createI2CInterface() reads
+ * them from the environment)
+ */
+I2CInterface* createSimulationI2C(Clock& clock, const SimulationConfig& config);
+
+/**
+ * Defaults + THE3_SIM_CONFIG + THE3_SIM_SEED; errors are reported on
+ * stderr and leave the defaults in place
+ */
+SimulationConfig loadSimulationConfig();
+
+#endif // PLATFORM_SIMULATION
+
+} // namespace HAL
+
+#endif // SIMULATION_HAL_H
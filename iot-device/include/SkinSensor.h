@@ -4,7 +4,15 @@
 #include <string>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <vector>
 #include "HardwareAbstraction.h"
+#include "SensorBus.h"
+#include "DecimationFilter.h"
+#include "Eeprom.h"
+#include "Clock.h"
 
 /**
  * SkinSensor - 피부 측정 센서 모듈
@@ -26,6 +34,8 @@
  *
  * - EEPROM: Calibration data storage
  *   - AT24C256 256Kbit EEPROM (I2C addr: 0x50)
+ *   - Factory record at 0x0000, recalibrations in a rotating history of
+ *     Config::Hardware::CALIBRATION_SLOTS versioned slots (Eeprom.h)
  */
 class SkinSensor {
 public:
@@ -105,6 +115,48 @@ public:
         uint64_t timestamp;
     };
 
+    /**
+     * How readADC() waits for an ADS1115 conversion to complete
+     */
+    enum class AdcReadyMode {
+        FIXED_DELAY,        // Sleep Config::Hardware::ADC_SETTLING_MS
+        POLL_STATUS,        // Poll the config register OS bit
+        DRDY_INTERRUPT      // Wait for the ALERT/RDY pulse on PIN_ADC_DRDY
+    };
+
+    /**
+     * SHT31 measurement repeatability (accuracy vs. measurement time)
+     */
+    enum class Repeatability {
+        LOW,                // HAL::MoistureSensor::MEASURE_DELAY_LOW_MS
+        MEDIUM,             // HAL::MoistureSensor::MEASURE_DELAY_MED_MS
+        HIGH                // HAL::MoistureSensor::MEASURE_DELAY_HIGH_MS
+    };
+
+    /**
+     * One SHT31 measurement: both values come from the same frame
+     */
+    struct ClimateReading {
+        float temperatureC;
+        float humidityRH;       // Relative humidity (%)
+    };
+
+    /**
+     * Per-stage timing of the last readSensorData() frame, in microseconds
+     * from the start of the frame. Each device is started at the beginning
+     * of the frame and collected when ready; the ADS1115 has one
+     * multiplexer, so its three channels convert back to back.
+     */
+    struct AcquisitionTiming {
+        uint32_t climateUs;     // SHT31 frame read
+        uint32_t rangeUs;       // VL6180X range read
+        uint32_t adcUs[3];      // ADS1115 AIN0..AIN2 result read
+        uint32_t totalUs;       // Whole frame
+        uint32_t busWaitUs;     // Time spent sleeping / waiting for events
+        uint32_t busTransactions;   // I2C transactions (START ... STOP)
+        uint32_t busCalls;          // HAL transfer calls (a batch is one)
+    };
+
     /**
      * Calibration data stored in EEPROM
      */
@@ -156,15 +208,53 @@ public:
     bool calibrate();
 
     /**
-     * Load calibration data from EEPROM
+     * Load calibration data from EEPROM: the newest valid history slot,
+     * else the factory record
      */
     bool loadCalibration();
 
     /**
-     * Save calibration data to EEPROM
+     * Save calibration data to EEPROM as a new version in the next slot
      */
     bool saveCalibration();
 
+    /**
+     * Stored calibration versions, newest first
+     */
+    std::vector<CalibrationData> getCalibrationHistory();
+
+    /**
+     * Select conversion completion handling (default DRDY_INTERRUPT).
+     * Takes effect on the next initialize() for DRDY_INTERRUPT, which
+     * falls back to POLL_STATUS if the interrupt cannot be attached.
+     */
+    void setAdcReadyMode(AdcReadyMode mode);
+    AdcReadyMode getAdcReadyMode() const { return m_adcReadyMode; }
+
+    /**
+     * ADS1115 samples per reading and how they are combined. With more
+     * than one sample the ADC runs in continuous mode for the block
+     * (default: Config::Hardware::ADC_SAMPLES_PER_READ, boxcar).
+     */
+    void setAdcOversampling(int samplesPerRead, DecimationFilter::Type filter);
+
+    /**
+     * SHT31 repeatability used by readSensorData() (default HIGH)
+     */
+    void setClimateRepeatability(Repeatability repeatability);
+
+    /**
+     * ADS1115 data rate; rounded down to a supported rate (8 - 860 SPS)
+     */
+    void setAdcDataRate(int samplesPerSecond);
+
+    /**
+     * Clock for every wait and timestamp, also handed to the HAL (default
+     * Clock::system()). Set before initialize(); must outlive the sensor.
+     */
+    void setClock(Clock& clock) { m_clock = &clock; }
+    Clock& getClock() const { return *m_clock; }
+
     //==========================================================================
     // Patient Management
     //==========================================================================
@@ -188,6 +278,11 @@ public:
      */
     TreatmentData createTreatmentData(TreatmentMode mode);
 
+    /**
+     * Stage timing of the most recent readSensorData()
+     */
+    AcquisitionTiming getLastAcquisitionTiming() const { return m_lastTiming; }
+
     //==========================================================================
     // Diagnostics
     //==========================================================================
@@ -208,17 +303,42 @@ private:
     // Hardware Communication (platform-specific)
     //==========================================================================
 
-    // I2C communication helpers
-    bool i2cWriteRegister(uint8_t addr, uint8_t reg, uint8_t value);
-    bool i2cWriteRegister16(uint8_t addr, uint8_t reg, uint16_t value);
-    uint8_t i2cReadRegister(uint8_t addr, uint8_t reg);
-    uint16_t i2cReadRegister16(uint8_t addr, uint8_t reg);
+    // Every bus access goes through m_bus (SensorBus.h)
 
-    // Sensor-specific read functions
+    // Blocking single reads (calibration)
     float readADC(uint8_t channel);     // ADS1115 ADC reading
-    float readMoisture();                // SHT31 humidity reading
-    float readTemperature();             // SHT31 temperature reading
-    float readElasticity();              // VL6180X ToF reading
+
+    //==========================================================================
+    // Pipelined Acquisition
+    //==========================================================================
+
+    struct RawFrame {
+        ClimateReading climate;
+        bool climateValid;
+        float range;                    // VL6180X distance (mm)
+        bool rangeValid;
+        float adc[3];                   // ADS1115 AIN0..AIN2 (sensor units)
+    };
+
+    // Start every conversion, then collect each as its device becomes ready
+    void acquireFrame(RawFrame& frame);
+
+    // Per-device start / collect steps; queue*() add the start command to a batch
+    int queueClimateMeasurement(HAL::I2CBatch& batch);     // @return measurement time (ms)
+    bool collectClimate(ClimateReading& reading);
+    void queueRange(HAL::I2CBatch& batch);
+    bool isRangeReady();
+    bool collectRange(float& range);
+    uint16_t adcConversionConfig(uint8_t channel) const;
+    uint16_t adcStopConfig() const;
+    uint64_t adcReadySnapshot();
+    uint64_t startAdcConversion(uint8_t channel);   // @return ready sequence snapshot
+    uint64_t queueAdcConversion(HAL::I2CBatch& batch, uint8_t channel);
+    void stopAdcConversion();
+    bool isConversionReady(uint64_t& readySequence);
+    int16_t readAdcRaw();
+    float adcToSensorUnits(float counts) const;
+    bool adcContinuous() const { return m_adcSampleBuffer.size() > 1; }
 
     //==========================================================================
     // Data Processing
@@ -231,8 +351,19 @@ private:
     // Apply temperature compensation
     float compensateTemperature(float value, float tempC);
 
-    // CRC calculation for EEPROM validation
-    uint16_t calculateCRC16(const uint8_t* data, size_t length);
+    // Magic number and CRC of a stored calibration record
+    static bool isValidCalibration(const CalibrationData& data);
+
+    //==========================================================================
+    // ADC Conversion Completion
+    //==========================================================================
+
+    bool configureAdcReady();
+    std::chrono::microseconds adcCheckDelay() const;
+    bool waitForConversion(uint64_t& readySequence);    // Advances readySequence
+
+    // GPIO interrupt handler for the ALERT/RDY pin
+    static void onAdcReady(int pin, void* userData);
 
     //==========================================================================
     // Internal State
@@ -242,15 +373,36 @@ private:
     std::string m_patientName;
     std::string m_birthDate;
 
-    // HAL interfaces
-    std::unique_ptr<HAL::I2CInterface> m_i2c;
+    // HAL interfaces; m_bus is bound to HAL::PlatformBus at compile time
+    Clock* m_clock;
+    std::unique_ptr<HAL::PlatformBus> m_i2c;
     std::unique_ptr<HAL::GPIOInterface> m_gpio;
+    HAL::SensorBus<HAL::PlatformBus> m_bus;
+
+    // AT24C256 (present only if the EEPROM answered at initialize())
+    std::unique_ptr<Eeprom> m_eeprom;
+    std::unique_ptr<EepromSlotTable> m_calibrationSlots;
 
     // Calibration data (loaded from EEPROM)
     CalibrationData m_calibration;
 
-    // Last temperature reading for compensation
+    // Last SHT31 reading, reused if a measurement fails
     float m_lastTemperature;
+    float m_lastHumidity;
+    Repeatability m_climateRepeatability;
+
+    // ADC conversion completion
+    AdcReadyMode m_adcReadyMode;
+    uint16_t m_adcDataRate;             // HAL::ADC::CFG_DR_* bits
+    std::mutex m_adcMutex;
+    std::condition_variable m_adcReadyCv;
+    uint64_t m_adcReadySequence;        // Incremented by each ALERT/RDY pulse
+
+    // Oversampling
+    DecimationFilter m_adcFilter;
+    std::vector<int16_t> m_adcSampleBuffer;     // One block, ADC_SAMPLES_PER_READ
+
+    AcquisitionTiming m_lastTiming;
 };
 
 #endif // SKIN_SENSOR_H
@@ -0,0 +1,152 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+/**
+ * SpscRing - 단일 생산자/단일 소비자 링 버퍼
+ *
+ * Bounded lock-free queue of trivially copyable values between exactly
+ * one producer thread and one consumer thread.
+ *
+ * head (next slot to read) and tail (next slot to write) are monotonically
+ * increasing 64-bit counters on separate cache lines; the slot index is
+ * counter % slots. One spare slot is kept so the slot the producer writes
+ * is never the one at head. Each side caches the other side's counter and
+ * only reloads it when the ring looks full / empty.
+ *
+ * - tryPush() / pushOverwrite() are wait-free (at most one CAS, no loop)
+ * - tryPop() is lock-free: it copies the slot at head, then claims it with
+ *   a CAS on head and retries if pushOverwrite() dropped that slot in the
+ *   meantime. A copy that races with an overwrite is always discarded
+ *   (seqlock-style), which is why T must be trivially copyable.
+ */
+template <typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing requires a trivially copyable type");
+
+public:
+    explicit SpscRing(size_t capacity)
+        : m_slots((capacity > 0 ? capacity : 1) + 1)
+        , m_capacity(m_slots.size() - 1)
+        , m_head(0)
+        , m_cachedTail(0)
+        , m_tail(0)
+        , m_cachedHead(0)
+    {
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    //==========================================================================
+    // Producer
+    //==========================================================================
+
+    /**
+     * @return false if the ring is full (nothing is written)
+     */
+    bool tryPush(const T& value)
+    {
+        const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead >= m_capacity) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead >= m_capacity) {
+                return false;
+            }
+        }
+
+        m_slots[tail % m_slots.size()] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Push, discarding the oldest value if the ring is full
+     * @return true if a value was discarded
+     */
+    bool pushOverwrite(const T& value)
+    {
+        const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        bool dropped = false;
+
+        if (tail - m_cachedHead >= m_capacity) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead >= m_capacity) {
+                // Claim the oldest slot; failure means the consumer just freed one
+                uint64_t head = m_cachedHead;
+                dropped = m_head.compare_exchange_strong(head, head + 1, std::memory_order_acq_rel);
+                m_cachedHead = dropped ? head + 1 : head;
+            }
+        }
+
+        m_slots[tail % m_slots.size()] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return dropped;
+    }
+
+    //==========================================================================
+    // Consumer
+    //==========================================================================
+
+    /**
+     * @return false if the ring is empty
+     */
+    bool tryPop(T& value)
+    {
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        for (;;) {
+            if (head == m_cachedTail) {
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+                if (head == m_cachedTail) {
+                    return false;
+                }
+            }
+
+            value = m_slots[head % m_slots.size()];
+
+            // On failure head is reloaded with the producer's value
+            if (m_head.compare_exchange_strong(head, head + 1, std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+    }
+
+    //==========================================================================
+    // Either side (approximate while the other side is running)
+    //==========================================================================
+
+    size_t size() const
+    {
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+        const uint64_t tail = m_tail.load(std::memory_order_acquire);
+        return tail > head ? static_cast<size_t>(tail - head) : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+    bool full() const { return size() >= m_capacity; }
+    size_t capacity() const { return m_capacity; }
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::vector<T> m_slots;
+    const size_t m_capacity;
+
+    // Consumer line: head and the consumer's view of tail
+    char m_padBefore[CACHE_LINE];
+    std::atomic<uint64_t> m_head;
+    uint64_t m_cachedTail;
+
+    // Producer line: tail and the producer's view of head
+    char m_padMiddle[CACHE_LINE - sizeof(std::atomic<uint64_t>) - sizeof(uint64_t)];
+    std::atomic<uint64_t> m_tail;
+    uint64_t m_cachedHead;
+    char m_padAfter[CACHE_LINE - sizeof(std::atomic<uint64_t>) - sizeof(uint64_t)];
+};
+
+#endif // SPSC_RING_H
@@ -0,0 +1,127 @@
+#ifndef TELEMETRY_BATCHER_H
+#define TELEMETRY_BATCHER_H
+
+#include <string>
+#include <chrono>
+#include <functional>
+#include "HttpClient.h"
+#include "Clock.h"
+
+/**
+ * TelemetryBatcher - 측정 데이터 배치 전송
+ *
+ * Collects serialized measurement records and uploads them as one JSON
+ * array to Config::API_ENDPOINT_TELEMETRY (or the endpoint set with
+ * setEndpoint()). A batch is flushed as soon as
+ * the first of these limits is reached:
+ * - record count (Config::TELEMETRY_BATCH_MAX_RECORDS)
+ * - serialized size (Config::TELEMETRY_BATCH_MAX_BYTES)
+ * - age of the oldest record (Config::DATA_SEND_INTERVAL_MS)
+ *
+ * Records are appended straight into the array body, so a flush costs
+ * one POST and no re-serialization. Not thread-safe; drive it from the
+ * uploader loop.
+ *
+ * With a dispatcher set, flush() posts the batch asynchronously and
+ * returns at once; the HTTP callback hands the completion (statistics,
+ * failure handler) to the dispatcher, which must run it on the thread
+ * that drives the batcher.
+ */
+class TelemetryBatcher {
+public:
+    struct Stats {
+        size_t recordsAdded;
+        size_t recordsSent;
+        size_t recordsFailed;
+        size_t batchesSent;
+        size_t batchesFailed;
+        size_t bytesSent;
+    };
+
+    /**
+     * Called with the complete array body and the response when an upload fails
+     */
+    using FailureHandler = std::function<void(const std::string& body, size_t recordCount,
+                                              const HttpClient::Response& response)>;
+
+    /**
+     * Runs a completion on the batcher's thread; called from the HTTP event loop
+     */
+    using Dispatcher = std::function<void(std::function<void()> completion)>;
+
+public:
+    explicit TelemetryBatcher(HttpClient& client);
+    TelemetryBatcher(HttpClient& client, size_t maxRecords, size_t maxBytes, int maxAgeMs);
+
+    /**
+     * Append one serialized JSON object.
+     * Flushes first if the record would overflow the byte limit, and after
+     * appending if the record limit is reached.
+     * @return false if a flush triggered by this call failed
+     */
+    bool add(const std::string& recordJson);
+
+    /**
+     * Flush if the oldest pending record has reached the age limit
+     * @return false if a flush was due and failed
+     */
+    bool poll();
+
+    /**
+     * Upload all pending records now
+     * @return true if nothing was pending or the upload succeeded (was
+     *         submitted, with a dispatcher)
+     */
+    bool flush();
+
+    /**
+     * Time until the pending batch reaches its age limit (max if empty)
+     */
+    std::chrono::milliseconds timeUntilDeadline() const;
+
+    size_t pendingRecords() const { return m_pendingRecords; }
+    size_t pendingBytes() const { return m_body.size() + 1; }
+    size_t inFlight() const { return m_inFlight; }
+    Stats getStats() const { return m_stats; }
+
+    void setFailureHandler(FailureHandler handler) { m_onFailure = handler; }
+
+    /**
+     * Endpoint the batches are posted to (default Config::API_ENDPOINT_TELEMETRY);
+     * set it before the first record
+     */
+    void setEndpoint(const std::string& endpoint) { m_endpoint = endpoint; }
+    const std::string& getEndpoint() const { return m_endpoint; }
+
+    /**
+     * Clock for the age limit (default Clock::system())
+     */
+    void setClock(Clock& clock) { m_clock = &clock; }
+
+    /**
+     * Upload asynchronously, completing through `dispatcher`
+     */
+    void setDispatcher(Dispatcher dispatcher) { m_dispatch = dispatcher; }
+
+private:
+    void resetBody();
+    void complete(const HttpClient::Response& response, const std::string& body, size_t count);
+
+    HttpClient& m_client;
+    Clock* m_clock;
+    std::string m_endpoint;
+    size_t m_maxRecords;
+    size_t m_maxBytes;
+    std::chrono::milliseconds m_maxAge;
+
+    std::string m_body;                 // "[" + records, closed on flush
+    size_t m_pendingRecords;
+    Clock::TimePoint m_oldestRecord;
+
+    FailureHandler m_onFailure;
+    Dispatcher m_dispatch;
+    size_t m_inFlight;                  // Async batches awaiting completion
+    Stats m_stats;
+};
+
+#endif // TELEMETRY_BATCHER_H
@@ -0,0 +1,168 @@
+#ifndef TELEMETRY_CODEC_H
+#define TELEMETRY_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SkinSensor.h"
+
+/**
+ * TelemetryCodec - 측정 배치 압축 인코딩 (Gorilla 방식)
+ *
+ * Compressed binary encoding of a batch of skin analysis records for
+ * metered uplinks, after Facebook's Gorilla time-series format:
+ * delta-of-delta timestamps and XOR-compressed floats. Successive
+ * measurements of one device share most of their bits (the timestamp
+ * advances at a near-fixed period, the channels drift slowly), so a
+ * record costs a few bytes instead of the ~280 of its JSON object.
+ *
+ * Experimental: only bench_telemetry uses it. Uploads stay JSON, and the
+ * backend has no decoder for this format.
+ *
+ * Every field of Schema::sensorFields() with the BINARY format is coded,
+ * in table order, against the same field of the previous record in the
+ * batch; the encoding is lossless (floats are kept bit for bit, unlike
+ * the two-decimal JSON strings). adcRaw is not part of the schema and
+ * decodes as zero.
+ *
+ * Batch layout:
+ *
+ *   byte 0..3   magic "T3G" + format version (1)
+ *   byte 4      deviceId length n (max 255), then n bytes of deviceId
+ *   then        bit stream, most significant bit of each byte first:
+ *               '1' + record for each record, '0' (end of batch),
+ *               zero bits to a byte boundary
+ *
+ * Record: one code per field. Before the first record every previous
+ * value is zero (empty for strings).
+ *
+ *   uint64 (timestamp), D = (t - t') - (t' - t''), signed:
+ *     '0'                   D == 0
+ *     '10'    + 7 bits      -64 <= D < 64
+ *     '110'   + 9 bits      -256 <= D < 256
+ *     '1110'  + 12 bits     -2048 <= D < 2048
+ *     '11110' + 32 bits     fits int32
+ *     '11111' + 64 bits     otherwise
+ *   The first record has no previous interval: its D is the timestamp
+ *   itself and the second record's D is its full interval.
+ *
+ *   float, X = bits(v) XOR bits(v'):
+ *     '0'                   X == 0 (same value)
+ *     '10' + bits           meaningful bits of X fit the previous window:
+ *                           32 - lead - trail bits from that window
+ *     '11' + 5 bits lead + 5 bits (length - 1) + length bits
+ *                           new window: lead = leading zero bits of X,
+ *                           length = bits up to the last set bit
+ *
+ *   string:
+ *     '0'                   same as the previous record
+ *     '1' + 8 bits length + length bytes (values over 255 bytes are cut)
+ *
+ * The encoder appends into a caller-supplied buffer as records arrive
+ * (no batch array is built); the decoder returns one record at a time.
+ */
+namespace TelemetryCodec {
+
+constexpr uint8_t VERSION = 1;
+
+// Fields of Schema::sensorFields() (checked in TelemetryCodec.cpp)
+constexpr size_t FIELDS = 14;
+
+// Per-field state shared by encoder and decoder
+struct Channel {
+    uint64_t previous;      // timestamp, or float bits in the low 32
+    uint64_t delta;         // timestamp interval (modulo 2^64)
+    uint8_t lead;           // float XOR window (lead 32: none yet)
+    uint8_t trail;
+    std::string text;       // string fields
+};
+
+class Encoder {
+public:
+    Encoder();
+
+    /**
+     * Start a batch: append the header to `out`. Records are appended
+     * into the same buffer, which must outlive the batch.
+     */
+    void begin(std::string& out, const std::string& deviceId);
+
+    void add(const SkinSensor::SensorData& data);
+
+    /**
+     * Append the end marker and padding; the batch in `out` is complete
+     */
+    void finish();
+
+    size_t records() const { return m_records; }
+
+    /**
+     * Encoded size so far, bytes (partial byte counted)
+     */
+    size_t size() const;
+
+private:
+    // Bit writer, MSB first; bits 1..64
+    void put(uint64_t value, unsigned bits);
+
+    void encode(Channel& channel, uint64_t value);
+    void encode(Channel& channel, float value);
+    void encode(Channel& channel, const std::string& value);
+
+    std::string* m_out;
+    uint64_t m_bits;        // Pending bits, low m_fill of them valid
+    unsigned m_fill;
+    size_t m_records;
+    Channel m_channels[FIELDS];
+};
+
+class Decoder {
+public:
+    Decoder();
+
+    /**
+     * Start reading a batch; the buffer must outlive the decoder
+     * @return false if the header is truncated or not this format/version
+     */
+    bool open(const uint8_t* data, size_t length);
+
+    /**
+     * Decode the next record into `out`
+     * @return false at the end marker or on error (see failed())
+     */
+    bool next(SkinSensor::SensorData& out);
+
+    bool failed() const { return m_failed; }
+    const std::string& deviceId() const { return m_deviceId; }
+    size_t records() const { return m_records; }
+
+private:
+    // Bit reader, MSB first; bits 1..64
+    bool get(unsigned bits, uint64_t& value);
+    bool decode(Channel& channel, uint64_t& value);
+    bool decode(Channel& channel, float& value);
+    bool decode(Channel& channel, std::string& value);
+
+    const uint8_t* m_data;
+    const uint8_t* m_end;
+    uint64_t m_bits;
+    unsigned m_fill;
+    bool m_done;
+    bool m_failed;
+    size_t m_records;
+    std::string m_deviceId;
+    Channel m_channels[FIELDS];
+};
+
+/**
+ * Decode a whole batch
+ * @return false if the batch is malformed; `out` then holds the records
+ *         decoded before the error
+ */
+bool decodeBatch(const uint8_t* data, size_t length, std::string& deviceId,
+                 std::vector<SkinSensor::SensorData>& out);
+
+} // namespace TelemetryCodec
+
+#endif // TELEMETRY_CODEC_H
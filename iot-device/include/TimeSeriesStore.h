@@ -0,0 +1,162 @@
+#ifndef TIME_SERIES_STORE_H
+#define TIME_SERIES_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+#include "SkinSensor.h"
+
+/**
+ * TimeSeriesStore - 측정 이력 컬럼형 시계열 저장소
+ *
+ * Append-only local history of the numeric measurement channels, kept in
+ * memory-mapped segment files in one directory so recent history can be
+ * queried on the device without loading it into RAM.
+ *
+ * Segment file (seg-<sequence>.tss), every region page-aligned:
+ *   [0x0000] Header (one page): magic, version, columns, capacity,
+ *            published row count, partition start, first/last timestamp
+ *   [0x1000] timestamp column: capacity x u64 (Unix ms)
+ *   ...      one column per channel: capacity x f32
+ *
+ * A scan touches only the pages of the columns it reads. Rows are
+ * appended in timestamp order; a row older than the newest stored one is
+ * rejected. A segment holds one time partition (partitionMs, aligned to
+ * the Unix epoch) and is sealed (msync'd) when it is full or the next row
+ * belongs to a later partition. When the files exceed maxBytes the oldest
+ * segments are deleted.
+ *
+ * A row is published by writing its values, then the row count in the
+ * header. On open, the timestamps of the newest segment are checked and
+ * its row count is cut at the first out-of-order one (pages lost in a
+ * power cut). Nothing is fsync'd per row; call sync() at a cadence that
+ * fits the storage.
+ *
+ * Not thread-safe.
+ */
+class TimeSeriesStore {
+public:
+    enum class Column {
+        PD1,
+        PD2,
+        S1,
+        S2,
+        S3,
+        MOISTURE,           // moistureLevel
+        TEMPERATURE         // temperatureC
+    };
+
+    static constexpr size_t COLUMNS = 7;
+
+    struct Stats {
+        size_t segments;
+        uint64_t rows;          // Rows stored
+        uint64_t bytes;         // Segment file sizes
+        uint64_t oldest;        // Timestamp of the oldest row (0 if empty)
+        uint64_t newest;        // Timestamp of the newest row (0 if empty)
+        uint64_t appended;      // Rows appended since open
+        uint64_t rejected;      // Rows older than the newest stored one
+        uint64_t retired;       // Segments deleted by retention since open
+        uint64_t corrupt;       // Segment files discarded on open
+    };
+
+    // Run of rows in one segment, pointing into the mapping
+    struct Span {
+        const uint64_t* timestamps;
+        const float* values;
+        size_t count;
+    };
+
+    struct Aggregate {
+        uint64_t start;         // Window start (Unix ms)
+        uint32_t count;
+        float min;
+        float max;
+        double sum;
+
+        double mean() const { return count > 0 ? sum / count : 0.0; }
+    };
+
+public:
+    TimeSeriesStore();
+    ~TimeSeriesStore();
+
+    TimeSeriesStore(const TimeSeriesStore&) = delete;
+    TimeSeriesStore& operator=(const TimeSeriesStore&) = delete;
+
+    /**
+     * Open or create the store in `directory` (created if missing)
+     * @param maxBytes    Retention limit for all segment files
+     * @param segmentRows Rows per new segment
+     * @param partitionMs Time span of a segment
+     */
+    bool open(const std::string& directory, size_t maxBytes, size_t segmentRows, uint64_t partitionMs);
+    void close();
+    bool isOpen() const { return m_open; }
+
+    /**
+     * Append one row; false if the store is closed, the timestamp is older
+     * than the newest row, or a segment cannot be created
+     */
+    bool append(uint64_t timestamp, const float (&row)[COLUMNS]);
+    bool append(const SkinSensor::SensorData& data);
+
+    /**
+     * Rows with from <= timestamp < to, oldest first, as one span per
+     * segment (valid until the next append or close)
+     * @return Number of rows
+     */
+    size_t scan(Column column, uint64_t from, uint64_t to, std::vector<Span>& spans) const;
+
+    /**
+     * min/max/sum per window of `windowMs` over [from, to); windows start
+     * at `from` and empty ones are left out
+     */
+    std::vector<Aggregate> aggregate(Column column, uint64_t from, uint64_t to, uint64_t windowMs) const;
+
+    /**
+     * Flush the newest segment's dirty pages to storage
+     * @param wait true for MS_SYNC, false to only schedule write-back
+     */
+    void sync(bool wait = false);
+
+    Stats getStats() const;
+
+    static const char* columnName(Column column);
+    static bool parseColumn(const std::string& name, Column& column);
+
+private:
+    struct Header;
+
+    struct Segment {
+        uint64_t sequence;
+        std::string path;
+        int fd;
+        uint8_t* base;
+        size_t size;
+    };
+
+    static Header* header(const Segment& segment);
+    static uint64_t* timestamps(const Segment& segment);
+    static float* values(const Segment& segment, size_t column);
+
+    bool loadSegment(uint64_t sequence);
+    void recoverNewest();
+    bool createSegment(uint64_t partition);
+    void removeSegment(Segment& segment);
+    void enforceRetention();
+
+    std::string m_directory;
+    size_t m_maxBytes;
+    size_t m_segmentRows;
+    uint64_t m_partitionMs;
+    bool m_open;
+
+    std::deque<Segment> m_segments;     // Oldest first; the last one is appended to
+    uint64_t m_bytes;
+    Stats m_stats;
+};
+
+#endif // TIME_SERIES_STORE_H
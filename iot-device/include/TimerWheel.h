@@ -0,0 +1,134 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Clock.h"
+
+/**
+ * TimerWheel - 계층형 타이머 휠
+ *
+ * One-shot and periodic timers for a single event-loop thread. Deadlines
+ * are kept in ticks since construction (Config::DAEMON_TIMER_TICK_MS by
+ * default) in LEVELS wheels of SLOTS slots: level 0 holds the next 64
+ * ticks one tick per slot, level n spans 64^n ticks per slot. Scheduling
+ * and cancelling are O(1); when a wheel wraps, the next slot of the level
+ * above is re-filed into the lower levels (cascade), so a timer is moved
+ * at most LEVELS - 1 times. Timers beyond the top level's range (64^4
+ * ticks, about 4.6 h at 1 ms) are parked in its last slot and re-filed.
+ *
+ * Periodic timers are re-armed at their previous deadline + period, not
+ * at the time their callback ran, so the schedule does not drift. A
+ * callback that starts more than `slack` after its deadline counts as
+ * late; when a run ends after the next deadline has passed, the periods
+ * that can no longer run are skipped (counted as missed) and the timer
+ * stays on its original phase instead of bursting to catch up.
+ *
+ * Not thread-safe; call everything from the loop thread.
+ */
+class TimerWheel {
+public:
+    using TimerId = uint64_t;               // 0 = no timer
+    using Callback = std::function<void()>;
+
+    struct TimerStats {
+        std::string name;
+        Clock::Duration period;             // Zero for one-shot timers
+        uint64_t runs;
+        uint64_t late;                      // Started more than `slack` after the deadline
+        uint64_t missed;                    // Periods skipped after an overrun
+        Clock::Duration maxLateness;
+        Clock::Duration totalRunTime;
+        Clock::Duration maxRunTime;
+    };
+
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+
+public:
+    TimerWheel(Clock& clock, Clock::Duration tick, Clock::Duration slack);
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    TimerId schedule(Clock::TimePoint deadline, Callback callback, const std::string& name = "");
+    TimerId schedulePeriodic(Clock::TimePoint first, Clock::Duration period, Callback callback,
+                             const std::string& name = "");
+
+    /**
+     * @return false if the timer already fired (one-shot) or was cancelled
+     */
+    bool cancel(TimerId id);
+
+    /**
+     * Run every timer that is due at the clock's current time, in deadline
+     * order per tick. Callbacks may schedule and cancel timers.
+     * @return Number of callbacks run
+     */
+    size_t runDue();
+
+    /**
+     * Earliest time a timer can become due (a lower bound: waking then may
+     * only cascade); TimePoint::max() if no timers are pending
+     */
+    Clock::TimePoint nextDeadline() const;
+
+    size_t size() const { return m_active; }
+    bool empty() const { return m_active == 0; }
+
+    /**
+     * Statistics of a timer that is still pending or periodic
+     */
+    bool getStats(TimerId id, TimerStats& stats) const;
+
+    /**
+     * Statistics of every pending timer
+     */
+    std::vector<TimerStats> getAllStats() const;
+
+private:
+    struct Timer {
+        Callback callback;
+        Clock::TimePoint deadline;
+        Clock::Duration period;
+        uint64_t expiry;                    // Tick at which the timer is due
+        uint32_t generation;                // Bumped when the entry is reused
+        bool active;
+        TimerStats stats;
+    };
+
+    // Slot entry; stale once the timer is cancelled or its entry reused
+    struct Ref {
+        uint32_t index;
+        uint32_t generation;
+    };
+
+    TimerId add(Clock::TimePoint deadline, Clock::Duration period, Callback callback, const std::string& name);
+    const Timer* find(TimerId id) const;
+    uint64_t tickFor(Clock::TimePoint deadline) const;      // First tick at or after the deadline
+    bool current(const Ref& ref) const;
+    void place(uint32_t index);
+    void cascade(int level);
+    size_t runList();
+    void fire(const Ref& ref);
+    void release(uint32_t index);
+
+    Clock& m_clock;
+    const Clock::TimePoint m_start;
+    const Clock::Duration m_tick;
+    const Clock::Duration m_slack;
+
+    uint64_t m_now;                         // Last tick processed
+    size_t m_active;
+
+    std::vector<Timer> m_timers;
+    std::vector<uint32_t> m_free;
+    std::vector<Ref> m_wheel[LEVELS][SLOTS];
+    std::vector<Ref> m_due;                 // Expired, run by the next runDue()
+    std::vector<Ref> m_running;
+};
+
+#endif // TIMER_WHEEL_H
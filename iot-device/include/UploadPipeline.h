@@ -0,0 +1,103 @@
+#ifndef UPLOAD_PIPELINE_H
+#define UPLOAD_PIPELINE_H
+
+#include <cstddef>
+#include <string>
+#include "BatchReplay.h"
+#include "ChangeFilter.h"
+#include "Clock.h"
+#include "HttpClient.h"
+#include "PersistentQueue.h"
+#include "SensorRecordBuffer.h"
+#include "SkinSensor.h"
+#include "TelemetryBatcher.h"
+#include "TimeSeriesStore.h"
+#include "WindowAggregator.h"
+
+/**
+ * UploadPipeline - 측정 레코드 업로드 경로 (자동 모드와 데몬 공용)
+ *
+ * Owns everything between the acquisition thread and the network:
+ *
+ *   records() -> add() -> history
+ *                      -> raw / aggregator (summary) / change filter (changes)
+ *                      -> batcher -> on failure, the store-and-forward queue
+ *
+ * The acquisition thread pushes into records() (THE3_RECORD_OVERFLOW
+ * policy); the consumer pops and passes each sample to add(). Batches
+ * that fail with a RETRY outcome are stored with their endpoint for
+ * BatchReplay; REJECTED ones are dropped with a warning. How the queue
+ * is replayed (synchronously in auto mode, one async request at a time
+ * in the daemon) is up to the caller, against outbound() and
+ * replayStats().
+ *
+ * Not thread-safe apart from records(): the batcher, queue and history
+ * belong to the consumer thread.
+ */
+class UploadPipeline {
+public:
+    UploadPipeline(HttpClient& client, Clock& clock, TimeSeriesStore& history, const std::string& deviceId);
+
+    UploadPipeline(const UploadPipeline&) = delete;
+    UploadPipeline& operator=(const UploadPipeline&) = delete;
+
+    /**
+     * Open the store-and-forward queue and the spill file, apply
+     * THE3_UPLOAD_MODE; reports what is pending and warns about what is
+     * unavailable (the pipeline runs without either file)
+     */
+    void open();
+
+    /**
+     * Take one sample: append it to the history, then to the batch as the
+     * upload mode dictates
+     * @return false if the batcher refused the record
+     */
+    bool add(const SkinSensor::SensorData& data);
+
+    /**
+     * Summarize the open window (summary mode) and upload the pending batch
+     */
+    void flush();
+
+    /**
+     * Force the queue and history to disk
+     */
+    void sync();
+
+    /**
+     * Sample / upload / buffer / mode counters, one line each
+     */
+    void printStats() const;
+
+    SensorRecordBuffer& records() { return m_records; }
+    TelemetryBatcher& batcher() { return m_batcher; }
+    PersistentQueue& outbound() { return m_outbound; }
+    bool outboundOpen() const { return m_outboundOpen; }
+    BatchReplay::Stats& replayStats() { return m_replay; }
+
+private:
+    void storeFailedBatch(const std::string& body, const HttpClient::Response& response);
+
+    TimeSeriesStore& m_history;
+    std::string m_deviceId;
+
+    TelemetryBatcher m_batcher;
+    PersistentQueue m_outbound;
+    bool m_outboundOpen;
+    size_t m_storedBatches;
+    BatchReplay::Stats m_replay;
+
+    SensorRecordBuffer::OverflowPolicy m_overflow;  // As configured (SPILL until openSpill())
+    SensorRecordBuffer m_records;
+
+    WindowAggregator::Mode m_uploadMode;
+    WindowAggregator m_aggregator;              // Summary mode only
+    ChangeFilter m_changes;                     // Changes mode only
+
+    std::string m_json;                         // Reused per sample
+    size_t m_samples;
+    size_t m_historyRows;
+};
+
+#endif // UPLOAD_PIPELINE_H
@@ -0,0 +1,178 @@
+#ifndef WINDOW_AGGREGATOR_H
+#define WINDOW_AGGREGATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SkinSensor.h"
+
+/**
+ * P2Quantile - 스트리밍 분위수 추정 (P² 알고리즘)
+ *
+ * Jain & Chlamtac's P² estimator: five markers track the minimum, the
+ * p/2, p and (1+p)/2 quantiles and the maximum, and are moved by
+ * piecewise-parabolic interpolation as observations arrive. O(1) time
+ * and memory per observation, no samples kept. Below five observations
+ * the exact nearest-rank quantile is returned. The estimate assumes a
+ * roughly stationary stream; after a step change the markers lag.
+ */
+class P2Quantile {
+public:
+    explicit P2Quantile(double p = 0.5);
+
+    void reset();
+    void add(double x);
+
+    /**
+     * Current estimate (0 before the first observation)
+     */
+    double value() const;
+
+    double probability() const { return m_p; }
+    size_t count() const { return m_count; }
+
+private:
+    double parabolic(int i, double d) const;
+    double linear(int i, int d) const;
+
+    double m_p;
+    size_t m_count;
+    double m_q[5];          // Marker heights
+    double m_n[5];          // Marker positions (1-based)
+    double m_desired[5];    // Desired positions
+    double m_increment[5];  // Desired position increment per observation
+};
+
+/**
+ * WindowAggregator - 측정 구간 요약 (엣지 집계)
+ *
+ * Sits between SkinSensor::readSensorData() and the uploader and reduces
+ * the samples of each time window to one summary: per numeric channel
+ * count, min, max, mean, standard deviation and P² estimates of the
+ * QUANTILE_P quantiles, and per result field the count of each category
+ * ("dry", "normal", ...).
+ *
+ * Windows are aligned to multiples of the window length in Unix time,
+ * so the summaries of a fleet line up. A window is closed by the first
+ * sample past its end, a sample older than its start (clock stepped
+ * back) or a change of patient; add() then returns true and summary()
+ * holds the closed window. flush() closes the current window early (end
+ * of a session).
+ *
+ * Category values are kept across windows, so a steady state with a
+ * fixed set of result strings does not allocate. Not thread-safe.
+ */
+class WindowAggregator {
+public:
+    enum class Mode {
+        RAW,                // Upload every sample
+        SUMMARY,            // Upload one summary per window
+        CHANGES             // Upload significant changes only (ChangeFilter)
+    };
+
+    static constexpr size_t CHANNELS = 7;       // pd1, pd2, s1, s2, s3, moistureLevel, temperatureC
+    static constexpr size_t CATEGORIES = 3;     // moistureLevelResult, elasticityResult, thicknessResult
+    static constexpr size_t QUANTILES = 3;
+    static const double QUANTILE_P[QUANTILES];  // 0.1, 0.5, 0.9
+
+    struct ChannelSummary {
+        const char* name;   // SensorData / JSON field name
+        float min;
+        float max;
+        double mean;
+        double stddev;      // Sample standard deviation (0 for one sample)
+        double quantiles[QUANTILES];
+    };
+
+    struct CategoryCount {
+        std::string value;
+        uint32_t count;
+    };
+
+    struct CategorySummary {
+        const char* name;
+        std::vector<CategoryCount> counts;  // Values seen in the window, first seen first
+    };
+
+    struct Summary {
+        uint64_t windowStart;   // Unix ms, aligned to the window length
+        uint64_t windowEnd;     // windowStart + window length
+        uint64_t first;         // First and last sample timestamps
+        uint64_t last;
+        uint32_t samples;
+        std::string patientName;
+        std::string birthDate;
+        ChannelSummary channels[CHANNELS];
+        CategorySummary categories[CATEGORIES];
+    };
+
+    struct Stats {
+        uint64_t samples;       // Samples added
+        uint64_t windows;       // Summaries produced
+    };
+
+public:
+    explicit WindowAggregator(uint64_t windowMs);
+
+    /**
+     * Add one sample
+     * @return true if the sample closed the previous window (see summary())
+     */
+    bool add(const SkinSensor::SensorData& data);
+
+    /**
+     * Close the current window if it has samples
+     * @return true if a summary was produced
+     */
+    bool flush();
+
+    /**
+     * The last closed window; valid until the next add() or flush()
+     */
+    const Summary& summary() const { return m_summary; }
+
+    size_t pendingSamples() const { return m_samples; }
+    uint64_t windowMs() const { return m_windowMs; }
+    Stats getStats() const { return m_stats; }
+
+    /**
+     * Parse "raw", "summary" or "changes"
+     * @return false for an unknown name; `mode` is left unchanged
+     */
+    static bool parseMode(const std::string& name, Mode& mode);
+    static const char* modeName(Mode mode);
+
+private:
+    struct Accumulator {
+        uint32_t count;
+        float min;
+        float max;
+        double mean;        // Welford running mean and sum of squared deviations
+        double m2;
+        P2Quantile quantiles[QUANTILES];
+    };
+
+    struct Category {
+        std::string value;
+        uint32_t count;
+    };
+
+    void close();
+    void start(const SkinSensor::SensorData& data);
+
+    uint64_t m_windowMs;
+    uint64_t m_windowStart;
+    uint64_t m_first;
+    uint64_t m_last;
+    uint32_t m_samples;
+    std::string m_patientName;
+    std::string m_birthDate;
+    Accumulator m_channels[CHANNELS];
+    std::vector<Category> m_categories[CATEGORIES];
+
+    Summary m_summary;
+    Stats m_stats;
+};
+
+#endif // WINDOW_AGGREGATOR_H
@@ -0,0 +1,99 @@
+#include "BatchReplay.h"
+#include "Config.h"
+#include <cstring>
+#include <iostream>
+
+namespace BatchReplay {
+
+bool store(PersistentQueue& queue, const std::string& endpoint, const std::string& body)
+{
+    // Written straight into the mapped ring, no temporary copy
+    size_t length = endpoint.size() + 1 + body.size();
+    uint8_t* out = queue.reserve(length);
+    if (!out) {
+        return false;
+    }
+    std::memcpy(out, endpoint.data(), endpoint.size());
+    out[endpoint.size()] = '\n';
+    std::memcpy(out + endpoint.size() + 1, body.data(), body.size());
+    return queue.commit(length);
+}
+
+Record decode(const uint8_t* data, size_t length)
+{
+    const char* text = reinterpret_cast<const char*>(data);
+    const char* newline = (length > 0 && text[0] == '/')
+                              ? static_cast<const char*>(std::memchr(text, '\n', length))
+                              : nullptr;
+
+    Record record;
+    if (newline) {
+        record.endpoint.assign(text, newline);
+        record.body.assign(newline + 1, text + length);
+    } else {
+        // Body only: queued before records carried their endpoint
+        record.endpoint = Config::API_ENDPOINT_TELEMETRY;
+        record.body.assign(text, length);
+    }
+    return record;
+}
+
+Outcome classify(const HttpClient::Response& response)
+{
+    if (!response.success) {
+        return Outcome::RETRY;
+    }
+
+    int status = response.statusCode;
+    if (status >= 200 && status < 300) {
+        return Outcome::SENT;
+    }
+    if (status == 408 || status == 429 || status >= 500) {
+        return Outcome::RETRY;
+    }
+    return Outcome::REJECTED;
+}
+
+Outcome complete(PersistentQueue& queue, const HttpClient::Response& response, Stats& stats)
+{
+    Outcome outcome = classify(response);
+    switch (outcome) {
+        case Outcome::SENT:
+            queue.pop();
+            stats.replayed++;
+            break;
+
+        case Outcome::REJECTED:
+            std::cout << "[WARN] Stored batch rejected with HTTP " << response.statusCode << ", dropped\n";
+            queue.pop();
+            stats.rejected++;
+            break;
+
+        case Outcome::RETRY:
+            break;
+    }
+    return outcome;
+}
+
+size_t replay(PersistentQueue& queue, HttpClient& client, int maxBatches, Stats& stats)
+{
+    size_t removed = 0;
+    const uint8_t* data;
+    size_t length;
+
+    while (removed < static_cast<size_t>(maxBatches) && queue.peek(data, length)) {
+        Record record = decode(data, length);
+        auto response = client.post(record.endpoint, record.body);
+        if (complete(queue, response, stats) == Outcome::RETRY) {
+            break;
+        }
+        removed++;
+    }
+
+    if (removed > 0) {
+        queue.sync();
+    }
+    return removed;
+}
+
+} // namespace BatchReplay
@@ -0,0 +1,178 @@
+#include "ChangeFilter.h"
+#include "Config.h"
+#include <algorithm>
+#include <cmath>
+
+constexpr size_t ChangeFilter::CHANNELS;
+constexpr size_t ChangeFilter::REASONS;
+constexpr double ChangeFilter::CUSUM_DRIFT;
+constexpr double ChangeFilter::CUSUM_THRESHOLD;
+constexpr uint32_t ChangeFilter::CUSUM_WARMUP;
+
+namespace {
+
+using SensorData = SkinSensor::SensorData;
+
+struct ChannelField {
+    const char* name;
+    float SensorData::* member;
+    float deadband;
+};
+
+// Same channels as WindowAggregator
+const ChannelField CHANNEL_FIELDS[ChangeFilter::CHANNELS] = {
+    { "pd1", &SensorData::pd1, Config::CHANGE_DEADBAND_PD },
+    { "pd2", &SensorData::pd2, Config::CHANGE_DEADBAND_PD },
+    { "s1", &SensorData::s1, Config::CHANGE_DEADBAND_MOISTURE },
+    { "s2", &SensorData::s2, Config::CHANGE_DEADBAND_ELASTICITY },
+    { "s3", &SensorData::s3, Config::CHANGE_DEADBAND_THICKNESS },
+    { "moistureLevel", &SensorData::moistureLevel, Config::CHANGE_DEADBAND_MOISTURE_LEVEL },
+    { "temperatureC", &SensorData::temperatureC, Config::CHANGE_DEADBAND_TEMPERATURE },
+};
+
+const std::string SensorData::* const CATEGORY_FIELDS[] = {
+    &SensorData::moistureLevelResult, &SensorData::elasticityResult, &SensorData::thicknessResult
+};
+
+} // namespace
+
+ChangeFilter::ChangeFilter(uint64_t heartbeatMs)
+    : m_heartbeatMs(heartbeatMs)
+    , m_started(false)
+    , m_lastUpload(0)
+    , m_stats()
+{
+    for (size_t c = 0; c < CHANNELS; c++) {
+        m_channels[c] = Channel();
+        m_channels[c].deadband = CHANNEL_FIELDS[c].deadband;
+    }
+}
+
+void ChangeFilter::setDeadband(size_t channel, float deadband)
+{
+    if (channel < CHANNELS) {
+        m_channels[channel].deadband = std::max(deadband, 0.0f);
+    }
+}
+
+void ChangeFilter::reset()
+{
+    m_started = false;
+}
+
+ChangeFilter::Reason ChangeFilter::detect(const SensorData& data, size_t& channel)
+{
+    if (!m_started) {
+        return Reason::FIRST;
+    }
+    if (data.patientName != m_patientName || data.birthDate != m_birthDate) {
+        return Reason::PATIENT;
+    }
+    for (size_t c = 0; c < 3; c++) {
+        if (data.*(CATEGORY_FIELDS[c]) != m_categories[c]) {
+            return Reason::CATEGORY;
+        }
+    }
+
+    // Every channel's CUSUM advances, even once one has decided
+    Reason reason = Reason::NONE;
+    for (size_t c = 0; c < CHANNELS; c++) {
+        Channel& state = m_channels[c];
+        float value = data.*(CHANNEL_FIELDS[c].member);
+
+        if (std::fabs(value - state.reference) > state.deadband) {
+            if (reason != Reason::DEADBAND) {
+                reason = Reason::DEADBAND;
+                channel = c;
+            }
+            continue;
+        }
+        if (state.warmup < CUSUM_WARMUP) {
+            state.warmup++;
+            state.baseline += (value - state.baseline) / state.warmup;
+            continue;
+        }
+
+        double deviation = value - state.baseline;
+        double drift = CUSUM_DRIFT * state.deadband;
+        state.high = std::max(0.0, state.high + deviation - drift);
+        state.low = std::max(0.0, state.low - deviation - drift);
+        if (reason == Reason::NONE &&
+            std::max(state.high, state.low) > CUSUM_THRESHOLD * state.deadband) {
+            reason = Reason::CUSUM;
+            channel = c;
+        }
+    }
+    if (reason != Reason::NONE) {
+        return reason;
+    }
+
+    if ((m_heartbeatMs > 0 && data.timestamp >= m_lastUpload + m_heartbeatMs) ||
+        data.timestamp < m_lastUpload) {
+        return Reason::HEARTBEAT;
+    }
+    return Reason::NONE;
+}
+
+void ChangeFilter::accept(const SensorData& data)
+{
+    m_started = true;
+    m_lastUpload = data.timestamp;
+    m_patientName = data.patientName;
+    m_birthDate = data.birthDate;
+    for (size_t c = 0; c < 3; c++) {
+        m_categories[c] = data.*(CATEGORY_FIELDS[c]);
+    }
+
+    for (size_t c = 0; c < CHANNELS; c++) {
+        Channel& state = m_channels[c];
+        state.reference = data.*(CHANNEL_FIELDS[c].member);
+        state.baseline = state.reference;
+        state.warmup = 1;
+        state.high = 0.0;
+        state.low = 0.0;
+    }
+}
+
+ChangeFilter::Reason ChangeFilter::add(const SensorData& data)
+{
+    size_t channel = CHANNELS;
+    Reason reason = detect(data, channel);
+
+    m_stats.samples++;
+    m_stats.byReason[static_cast<size_t>(reason)]++;
+    if (reason == Reason::NONE) {
+        m_stats.suppressed++;
+        return reason;
+    }
+
+    if (channel < CHANNELS) {
+        m_stats.byChannel[channel]++;
+    }
+    m_stats.uploaded++;
+    accept(data);
+    return reason;
+}
+
+//==============================================================================
+// Names
+//==============================================================================
+
+const char* ChangeFilter::channelName(size_t channel)
+{
+    return channel < CHANNELS ? CHANNEL_FIELDS[channel].name : "?";
+}
+
+const char* ChangeFilter::reasonName(Reason reason)
+{
+    switch (reason) {
+        case Reason::NONE:      return "suppressed";
+        case Reason::FIRST:     return "first";
+        case Reason::DEADBAND:  return "deadband";
+        case Reason::CUSUM:     return "cusum";
+        case Reason::CATEGORY:  return "category";
+        case Reason::PATIENT:   return "patient";
+        case Reason::HEARTBEAT: return "heartbeat";
+    }
+    return "?";
+}
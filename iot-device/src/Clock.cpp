@@ -0,0 +1,242 @@
+#include "Clock.h"
+#include <algorithm>
+
+Clock& Clock::system()
+{
+    static SystemClock clock;
+    return clock;
+}
+
+//==============================================================================
+// SystemClock
+//==============================================================================
+
+SystemClock::SystemClock()
+    : m_running(false)
+{
+}
+
+SystemClock::~SystemClock()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_timerMutex);
+        if (!m_running) {
+            return;
+        }
+        m_running = false;
+        m_timers.clear();
+    }
+    m_timerCv.notify_one();
+    m_timerThread.join();
+}
+
+uint64_t SystemClock::unixTimeMs() const
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+void SystemClock::sleepUntil(TimePoint deadline)
+{
+    std::this_thread::sleep_until(deadline);
+}
+
+void SystemClock::blockUntil(std::unique_lock<std::mutex>& lock, std::condition_variable& cv,
+                             TimePoint deadline)
+{
+    cv.wait_until(lock, deadline);
+}
+
+void SystemClock::schedule(TimePoint when, Callback callback)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_timerMutex);
+        if (!m_running) {
+            m_running = true;
+            m_timerThread = std::thread(&SystemClock::timerLoop, this);
+        }
+        m_timers.emplace(when, std::move(callback));
+    }
+    m_timerCv.notify_one();
+}
+
+void SystemClock::timerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_timerMutex);
+    while (m_running) {
+        if (m_timers.empty()) {
+            m_timerCv.wait(lock);
+            continue;
+        }
+
+        auto next = m_timers.begin();
+        if (std::chrono::steady_clock::now() < next->first) {
+            m_timerCv.wait_until(lock, next->first);
+            continue;
+        }
+
+        Callback callback = std::move(next->second);
+        m_timers.erase(next);
+
+        lock.unlock();
+        callback();
+        lock.lock();
+    }
+}
+
+//==============================================================================
+// VirtualClock
+//==============================================================================
+
+VirtualClock::VirtualClock(uint64_t startUnixMs)
+    : m_now()
+    , m_startUnixMs(startUnixMs != 0 ? startUnixMs : Clock::system().unixTimeMs())
+    , m_participants(0)
+    , m_blocked(0)
+    , m_advancing(false)
+{
+}
+
+Clock::TimePoint VirtualClock::now() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_now;
+}
+
+Clock::Duration VirtualClock::elapsed() const
+{
+    return now() - TimePoint();
+}
+
+uint64_t VirtualClock::unixTimeMs() const
+{
+    return m_startUnixMs + static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(elapsed()).count());
+}
+
+void VirtualClock::attach()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_participants++;
+}
+
+void VirtualClock::detach()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_participants--;
+    }
+    // The remaining threads may all be blocked now
+    m_cv.notify_all();
+}
+
+void VirtualClock::sleepUntil(TimePoint deadline)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    waitLocked(lock, deadline, false);
+}
+
+void VirtualClock::blockUntil(std::unique_lock<std::mutex>& userLock, std::condition_variable&,
+                              TimePoint deadline)
+{
+    // Registered as a waiter before the caller's lock is released, so a
+    // notify() issued after the caller checked its predicate is not lost
+    std::unique_lock<std::mutex> lock(m_mutex);
+    userLock.unlock();
+    waitLocked(lock, deadline, true);
+    lock.unlock();
+    userLock.lock();
+}
+
+void VirtualClock::notify(std::condition_variable& cv)
+{
+    cv.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Waiter* waiter : m_waiters) {
+            if (waiter->wakeable && !waiter->woken) {
+                waiter->woken = true;
+                m_blocked--;        // Runnable from now on: time must not move past it
+            }
+        }
+    }
+    m_cv.notify_all();
+}
+
+void VirtualClock::schedule(TimePoint when, Callback callback)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_timers.emplace(std::max(when, m_now), std::move(callback));
+    }
+    m_cv.notify_all();
+}
+
+void VirtualClock::waitLocked(std::unique_lock<std::mutex>& lock, TimePoint deadline, bool wakeable)
+{
+    if (m_now >= deadline) {
+        return;
+    }
+
+    Waiter waiter{deadline, wakeable, false};
+    m_waiters.push_back(&waiter);
+    m_blocked++;
+
+    // With nothing attached the caller is the only thread using the clock
+    while (!waiter.woken) {
+        if (!m_advancing && m_blocked >= std::max(m_participants, 1)) {
+            advanceLocked(lock);
+        } else {
+            m_cv.wait(lock);
+        }
+    }
+
+    m_waiters.erase(std::find(m_waiters.begin(), m_waiters.end(), &waiter));
+}
+
+void VirtualClock::advanceLocked(std::unique_lock<std::mutex>& lock)
+{
+    TimePoint next = TimePoint::max();
+    for (const Waiter* waiter : m_waiters) {
+        if (!waiter->woken) {
+            next = std::min(next, waiter->deadline);
+        }
+    }
+
+    // Timers due no later than the earliest sleeper run first
+    if (!m_timers.empty() && m_timers.begin()->first <= next) {
+        auto due = m_timers.begin();
+        m_now = std::max(m_now, due->first);
+        Callback callback = std::move(due->second);
+        m_timers.erase(due);
+
+        m_advancing = true;
+        lock.unlock();
+        callback();
+        lock.lock();
+        m_advancing = false;
+        releaseDueLocked();
+        return;
+    }
+
+    if (next == TimePoint::max()) {
+        // Everyone waits without a deadline: only a real-time event can help
+        m_cv.wait(lock);
+        return;
+    }
+
+    m_now = std::max(m_now, next);
+    releaseDueLocked();
+}
+
+void VirtualClock::releaseDueLocked()
+{
+    // Due sleepers are runnable at once, so time cannot move again before they run
+    for (Waiter* waiter : m_waiters) {
+        if (!waiter->woken && waiter->deadline <= m_now) {
+            waiter->woken = true;
+            m_blocked--;
+        }
+    }
+    m_cv.notify_all();
+}
@@ -0,0 +1,137 @@
+#include "Crc.h"
+
+namespace {
+    constexpr uint16_t CRC16_POLY = 0x1021;
+    constexpr uint8_t CRC8_POLY = 0x31;
+
+    /**
+     * Lookup tables, built at compile time
+     *
+     * crc16[0][b] is the CRC register after shifting byte b through a zero
+     * register; crc16[k][b] is the same followed by k zero bytes, so one
+     * input byte's contribution k bytes before the end of an 8-byte block
+     * is a single lookup.
+     */
+    struct Tables {
+        uint16_t crc16[8][256];
+        uint8_t crc8[256];
+
+        constexpr Tables() : crc16(), crc8()
+        {
+            for (int b = 0; b < 256; b++) {
+                uint16_t crc = static_cast<uint16_t>(b << 8);
+                for (int bit = 0; bit < 8; bit++) {
+                    crc = static_cast<uint16_t>((crc & 0x8000) ? (crc << 1) ^ CRC16_POLY : crc << 1);
+                }
+                crc16[0][b] = crc;
+
+                uint8_t crc8Value = static_cast<uint8_t>(b);
+                for (int bit = 0; bit < 8; bit++) {
+                    crc8Value = static_cast<uint8_t>((crc8Value & 0x80) ? (crc8Value << 1) ^ CRC8_POLY : crc8Value << 1);
+                }
+                crc8[b] = crc8Value;
+            }
+
+            for (int k = 1; k < 8; k++) {
+                for (int b = 0; b < 256; b++) {
+                    uint16_t previous = crc16[k - 1][b];
+                    crc16[k][b] = static_cast<uint16_t>((previous << 8) ^ crc16[0][previous >> 8]);
+                }
+            }
+        }
+    };
+
+    constexpr Tables TABLES;
+
+    uint16_t crc16Bitwise(uint16_t crc, const uint8_t* data, size_t length)
+    {
+        for (size_t i = 0; i < length; i++) {
+            crc ^= static_cast<uint16_t>(data[i]) << 8;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = static_cast<uint16_t>((crc & 0x8000) ? (crc << 1) ^ CRC16_POLY : crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    inline uint16_t crc16Byte(uint16_t crc, uint8_t byte)
+    {
+        return static_cast<uint16_t>((crc << 8) ^ TABLES.crc16[0][(crc >> 8) ^ byte]);
+    }
+
+    uint16_t crc16Table(uint16_t crc, const uint8_t* data, size_t length)
+    {
+        for (size_t i = 0; i < length; i++) {
+            crc = crc16Byte(crc, data[i]);
+        }
+        return crc;
+    }
+
+    uint16_t crc16Slice8(uint16_t crc, const uint8_t* data, size_t length)
+    {
+        const auto& t = TABLES.crc16;
+        while (length >= 8) {
+            // The register only overlaps the first two bytes of the block
+            crc = static_cast<uint16_t>(t[7][data[0] ^ (crc >> 8)] ^ t[6][data[1] ^ (crc & 0xFF)] ^
+                                        t[5][data[2]] ^ t[4][data[3]] ^
+                                        t[3][data[4]] ^ t[2][data[5]] ^
+                                        t[1][data[6]] ^ t[0][data[7]]);
+            data += 8;
+            length -= 8;
+        }
+        return crc16Table(crc, data, length);
+    }
+}
+
+constexpr uint16_t Crc16::INIT;
+constexpr uint8_t Crc8::INIT;
+
+//==============================================================================
+// Crc16
+//==============================================================================
+
+uint16_t Crc16::update(uint16_t crc, const void* data, size_t length, Method method)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    switch (method) {
+        case Method::BITWISE: return crc16Bitwise(crc, bytes, length);
+        case Method::TABLE:   return crc16Table(crc, bytes, length);
+        case Method::SLICE8:  return crc16Slice8(crc, bytes, length);
+    }
+    return crc;
+}
+
+const char* Crc16::methodName(Method method)
+{
+    switch (method) {
+        case Method::BITWISE: return "bitwise";
+        case Method::TABLE:   return "table";
+        case Method::SLICE8:  return "slice-by-8";
+    }
+    return "?";
+}
+
+//==============================================================================
+// Crc8
+//==============================================================================
+
+uint8_t Crc8::compute(const uint8_t* data, size_t length)
+{
+    uint8_t crc = INIT;
+    for (size_t i = 0; i < length; i++) {
+        crc = TABLES.crc8[crc ^ data[i]];
+    }
+    return crc;
+}
+
+uint8_t Crc8::computeBitwise(const uint8_t* data, size_t length)
+{
+    uint8_t crc = INIT;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = static_cast<uint8_t>((crc & 0x80) ? (crc << 1) ^ CRC8_POLY : crc << 1);
+        }
+    }
+    return crc;
+}
@@ -0,0 +1,391 @@
+#include "Daemon.h"
+#include "Config.h"
+#include "Payload.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    double toSeconds(Clock::Duration duration)
+    {
+        return std::chrono::duration<double>(duration).count();
+    }
+
+    double toMillis(Clock::Duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    int treatmentDefaultSec(SkinSensor::TreatmentMode mode)
+    {
+        switch (mode) {
+            case SkinSensor::TreatmentMode::VIBRATION:      return Config::Treatment::V_DEFAULT_TIME_SEC;
+            case SkinSensor::TreatmentMode::IONTOPHORESIS:  return Config::Treatment::I_DEFAULT_TIME_SEC;
+            case SkinSensor::TreatmentMode::HIGH_FREQUENCY: return Config::Treatment::T_DEFAULT_TIME_SEC;
+            case SkinSensor::TreatmentMode::LED_THERAPY:    return Config::Treatment::L_DEFAULT_TIME_SEC;
+        }
+        return 0;
+    }
+}
+
+Daemon::Daemon(SkinSensor& sensor, HttpClient& client, Clock& clock, const std::string& deviceId)
+    : m_sensor(sensor)
+    , m_client(client)
+    , m_clock(clock)
+    , m_deviceId(deviceId)
+    , m_mailbox(std::make_shared<Mailbox>(clock))
+    , m_wheel(clock, std::chrono::milliseconds(Config::DAEMON_TIMER_TICK_MS),
+              std::chrono::milliseconds(Config::DAEMON_TIMER_SLACK_MS))
+    , m_pipeline(client, clock, m_history, deviceId)
+    , m_acquiring(false)
+    , m_drainPosted(false)
+    , m_duration(Clock::Duration::max())
+    , m_idle(Clock::Duration::zero())
+    , m_totalIdle(Clock::Duration::zero())
+    , m_requestsInFlight(0)
+    , m_serverOnline(true)
+    , m_healthInFlight(false)
+    , m_healthProbes(0)
+    , m_healthFailures(0)
+    , m_replayInFlight(false)
+    , m_treatment(false)
+    , m_treatmentMode(SkinSensor::TreatmentMode::VIBRATION)
+    , m_treatmentLength(Clock::Duration::zero())
+    , m_treatmentTimer(0)
+    , m_treatmentTicks(0)
+{
+    std::shared_ptr<Mailbox> mailbox = m_mailbox;
+    m_pipeline.batcher().setDispatcher([mailbox](std::function<void()> completion) {
+        post(mailbox, std::move(completion));
+    });
+}
+
+Daemon::~Daemon()
+{
+    // Completions still on their way reference this object: drop them
+    std::lock_guard<std::mutex> lock(m_mailbox->mutex);
+    m_mailbox->open = false;
+    m_mailbox->tasks.clear();
+}
+
+void Daemon::setTreatment(SkinSensor::TreatmentMode mode)
+{
+    m_treatment = true;
+    m_treatmentMode = mode;
+    int seconds = std::min(treatmentDefaultSec(mode), Config::TREATMENT_MAX_DURATION_SEC);
+    m_treatmentLength = std::chrono::seconds(seconds);
+}
+
+//==============================================================================
+// Event Loop
+//==============================================================================
+
+void Daemon::post(std::function<void()> task)
+{
+    post(m_mailbox, std::move(task));
+}
+
+void Daemon::post(const std::shared_ptr<Mailbox>& mailbox, std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mailbox->mutex);
+        if (!mailbox->open) {
+            return;
+        }
+        mailbox->tasks.push_back(std::move(task));
+    }
+    mailbox->clock.notify(mailbox->cv);
+}
+
+size_t Daemon::runPosted()
+{
+    size_t ran = 0;
+    while (true) {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(m_mailbox->mutex);
+            if (m_mailbox->tasks.empty()) {
+                break;
+            }
+            task = std::move(m_mailbox->tasks.front());
+            m_mailbox->tasks.pop_front();
+        }
+        task();
+        ran++;
+    }
+    return ran;
+}
+
+void Daemon::wait(Clock::TimePoint deadline)
+{
+    auto before = m_clock.now();
+    {
+        std::unique_lock<std::mutex> lock(m_mailbox->mutex);
+        m_clock.waitUntil(lock, m_mailbox->cv, deadline, [this]() { return !m_mailbox->tasks.empty(); });
+    }
+    m_idle += m_clock.now() - before;
+}
+
+void Daemon::run(const std::atomic<bool>& running)
+{
+    Clock::Participant participant(m_clock);
+
+    if (!m_history.open(Config::getHistoryDir(), Config::HISTORY_MAX_BYTES, Config::HISTORY_SEGMENT_ROWS,
+                        Config::HISTORY_PARTITION_MS)) {
+        std::cout << "[WARN] Measurement history unavailable, samples will not be kept locally\n";
+    }
+    m_pipeline.open();
+
+    m_started = m_clock.now();
+    m_reportStarted = m_started;
+    auto end = (m_duration == Clock::Duration::max()) ? Clock::TimePoint::max() : m_started + m_duration;
+
+    // The acquisition thread waits on the clock too (detaches when it ends)
+    m_acquiring = true;
+    m_clock.attach();
+    m_acquisition = std::thread(&Daemon::acquisitionLoop, this, std::cref(running));
+
+    // Each job keeps its own phase: run n is due at first + n * period
+    m_wheel.schedulePeriodic(m_started + std::chrono::milliseconds(Config::DATA_SEND_INTERVAL_MS),
+                             std::chrono::milliseconds(Config::DATA_SEND_INTERVAL_MS),
+                             [this]() { m_pipeline.batcher().flush(); }, "flush");
+    m_wheel.schedulePeriodic(m_started, std::chrono::milliseconds(Config::HEALTH_CHECK_INTERVAL_MS),
+                             [this]() { probeHealth(); }, "health");
+    m_wheel.schedulePeriodic(m_started + std::chrono::milliseconds(Config::DAEMON_STATS_INTERVAL_MS),
+                             std::chrono::milliseconds(Config::DAEMON_STATS_INTERVAL_MS),
+                             [this]() { printReport(false); }, "stats");
+    if (m_treatment) {
+        m_treatmentStarted = m_started;
+        m_treatmentTimer = m_wheel.schedulePeriodic(m_started,
+                                                    std::chrono::milliseconds(Config::DAEMON_TREATMENT_TICK_MS),
+                                                    [this]() { treatmentTick(); }, "treatment");
+        std::cout << "[Treatment started: " << toSeconds(m_treatmentLength) << " s]\n";
+    }
+
+    // A signal cannot wake the wait; the acquisition thread's posts bound
+    // how long a stop request goes unnoticed
+    while (running && m_clock.now() < end) {
+        m_wheel.runDue();
+        runPosted();
+        wait(std::min(m_wheel.nextDeadline(), end));
+    }
+
+    // Waiting on the clock, not in join(): on virtual time the acquisition
+    // thread only wakes from its sleep while this thread is blocked too
+    m_acquiring = false;
+    while (!m_pipeline.records().finished()) {
+        runPosted();
+        drainRecords();
+        if (!m_pipeline.records().finished()) {
+            wait(m_clock.now() + std::chrono::milliseconds(Config::SENSOR_READ_INTERVAL_MS));
+        }
+    }
+    m_acquisition.join();
+
+    drain();
+    printReport(true);
+}
+
+void Daemon::drain()
+{
+    m_pipeline.flush();
+
+    // In-flight requests complete on real time even when the device runs
+    // on virtual time, so this wait is not on the clock
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(Config::DAEMON_DRAIN_TIMEOUT_MS);
+    auto busy = [this]() { return m_pipeline.batcher().inFlight() > 0 || m_requestsInFlight > 0; };
+    while (busy()) {
+        runPosted();
+        if (!busy()) {
+            break;
+        }
+        std::unique_lock<std::mutex> lock(m_mailbox->mutex);
+        if (!m_mailbox->cv.wait_until(lock, deadline, [this]() { return !m_mailbox->tasks.empty(); })) {
+            std::cout << "[WARN] " << m_pipeline.batcher().inFlight() + m_requestsInFlight
+                      << " requests still in flight at shutdown\n";
+            break;
+        }
+    }
+
+    m_pipeline.sync();
+}
+
+//==============================================================================
+// Jobs
+//==============================================================================
+
+void Daemon::acquisitionLoop(const std::atomic<bool>& running)
+{
+    const auto interval = std::chrono::milliseconds(Config::SENSOR_READ_INTERVAL_MS);
+    auto next = m_started;
+
+    while (running && m_acquiring) {
+        m_pipeline.records().push(SensorRecord::fromSensorData(m_sensor.readSensorData()));
+        if (!m_drainPosted.exchange(true)) {
+            post([this]() { drainRecords(); });
+        }
+
+        // Fixed cadence; after an overrun, restart from now instead of bursting
+        next += interval;
+        auto now = m_clock.now();
+        if (next < now) {
+            next = now;
+        }
+        m_clock.sleepUntil(next);
+    }
+
+    // Wakes the loop so it sees the stop and takes the last records
+    m_pipeline.records().close();
+    post([this]() { drainRecords(); });
+    m_clock.detach();
+}
+
+void Daemon::drainRecords()
+{
+    // Cleared first: a record pushed after the last pop posts a new task
+    m_drainPosted = false;
+
+    SensorRecord record;
+    while (m_pipeline.records().pop(record, std::chrono::milliseconds(0))) {
+        m_pipeline.add(record.toSensorData());
+    }
+}
+
+void Daemon::probeHealth()
+{
+    // A probe still waiting for its answer covers this period
+    if (m_healthInFlight) {
+        return;
+    }
+    m_healthInFlight = true;
+    m_requestsInFlight++;
+    m_healthProbes++;
+
+    std::shared_ptr<Mailbox> mailbox = m_mailbox;
+    m_client.getAsync(Config::API_ENDPOINT_HEALTH, [this, mailbox](const HttpClient::Response& response) {
+        post(mailbox, [this, response]() { onHealth(response); });
+    });
+}
+
+void Daemon::onHealth(const HttpClient::Response& response)
+{
+    m_healthInFlight = false;
+    m_requestsInFlight--;
+
+    bool online = response.success && response.statusCode == 200;
+    if (!online) {
+        m_healthFailures++;
+    }
+    if (online && !m_serverOnline) {
+        std::cout << "[HEALTH] Server online\n";
+        std::cout.flush();
+    } else if (!online && m_serverOnline) {
+        std::cout << "[HEALTH] Server offline: " << response.errorMessage << "\n";
+        std::cout.flush();
+    }
+    m_serverOnline = online;
+
+    if (online) {
+        replayQueued();
+    }
+}
+
+void Daemon::treatmentTick()
+{
+    m_treatmentTicks++;
+    if (m_clock.now() - m_treatmentStarted < m_treatmentLength) {
+        return;
+    }
+
+    m_wheel.cancel(m_treatmentTimer);
+    m_treatmentTimer = 0;
+    m_treatment = false;
+
+    auto data = m_sensor.createTreatmentData(m_treatmentMode);
+    std::string json = Payload::buildTreatmentJson(data, m_deviceId);
+    m_requestsInFlight++;
+
+    std::shared_ptr<Mailbox> mailbox = m_mailbox;
+    m_client.postAsync(Config::API_ENDPOINT_TREATMENT, json, [this, mailbox](const HttpClient::Response& response) {
+        post(mailbox, [this, response]() {
+            m_requestsInFlight--;
+            if (response.success && response.statusCode == 200) {
+                std::cout << "[Treatment finished, record sent]\n";
+            } else {
+                std::cout << "[ERROR] Failed to send treatment data: " << response.errorMessage << "\n";
+            }
+            std::cout.flush();
+        });
+    });
+}
+
+void Daemon::replayQueued()
+{
+    // One stored batch at a time; the next goes when this one is sent or rejected
+    const uint8_t* data;
+    size_t length;
+    PersistentQueue& outbound = m_pipeline.outbound();
+    if (m_replayInFlight || !m_pipeline.outboundOpen() || !outbound.peek(data, length)) {
+        return;
+    }
+    m_replayInFlight = true;
+    m_requestsInFlight++;
+
+    BatchReplay::Record record = BatchReplay::decode(data, length);
+    std::shared_ptr<Mailbox> mailbox = m_mailbox;
+    m_client.postAsync(record.endpoint, record.body, [this, mailbox](const HttpClient::Response& response) {
+        post(mailbox, [this, response]() {
+            m_replayInFlight = false;
+            m_requestsInFlight--;
+            PersistentQueue& outbound = m_pipeline.outbound();
+            if (BatchReplay::complete(outbound, response, m_pipeline.replayStats()) ==
+                BatchReplay::Outcome::RETRY) {
+                return;
+            }
+            if (outbound.empty()) {
+                outbound.sync();
+            } else {
+                replayQueued();
+            }
+        });
+    });
+}
+
+//==============================================================================
+// Report
+//==============================================================================
+
+void Daemon::printReport(bool final)
+{
+    auto now = m_clock.now();
+    m_totalIdle += m_idle;
+    double utilization = 1.0 - toSeconds(m_idle) / std::max(toSeconds(now - m_reportStarted), 1e-9);
+    double totalUtilization = 1.0 - toSeconds(m_totalIdle) / std::max(toSeconds(now - m_started), 1e-9);
+
+    std::cout << (final ? "\n[Daemon stopped]" : "\n[Daemon]")
+              << " t=" << std::fixed << std::setprecision(1) << toSeconds(now - m_started) << " s"
+              << ", loop utilization " << std::setprecision(2) << utilization * 100.0 << "% (period), "
+              << totalUtilization * 100.0 << "% (total)\n";
+    m_pipeline.printStats();
+    std::cout << "  Health: " << m_healthProbes << " probes, " << m_healthFailures << " failed\n";
+
+    // Deadline statistics are cumulative over the run
+    for (const auto& task : m_wheel.getAllStats()) {
+        std::cout << "  " << std::left << std::setw(12) << task.name << std::right
+                  << " runs " << std::setw(6) << task.runs
+                  << "  late " << std::setw(4) << task.late
+                  << "  missed " << std::setw(4) << task.missed
+                  << "  max late " << std::setw(7) << toMillis(task.maxLateness) << " ms"
+                  << "  max run " << std::setw(7) << toMillis(task.maxRunTime) << " ms\n";
+    }
+    if (m_treatment) {
+        std::cout << "  Treatment: " << m_treatmentTicks << " ticks, "
+                  << std::setprecision(0) << toSeconds(now - m_treatmentStarted) << "/"
+                  << toSeconds(m_treatmentLength) << " s\n";
+    }
+    std::cout << std::defaultfloat;
+    std::cout.flush();
+
+    m_reportStarted = now;
+    m_idle = Clock::Duration::zero();
+}
@@ -0,0 +1,130 @@
+#include "DecimationFilter.h"
+#include <algorithm>
+
+constexpr int DecimationFilter::CIC_ORDER;
+
+DecimationFilter::DecimationFilter(Type type)
+    : m_type(type)
+    , m_cicBlockSize(0)
+    , m_cicGain(1)
+{
+}
+
+float DecimationFilter::decimate(const int16_t* samples, size_t count)
+{
+    if (count == 0) {
+        return 0.0f;
+    }
+
+    switch (m_type) {
+        case Type::BOXCAR: return boxcar(samples, count);
+        case Type::CIC:    return cic(samples, count);
+        case Type::MEDIAN: return median(samples, count);
+    }
+    return boxcar(samples, count);
+}
+
+//==============================================================================
+// Kernels
+//==============================================================================
+
+float DecimationFilter::boxcar(const int16_t* samples, size_t count)
+{
+    if (count == 0) {
+        return 0.0f;
+    }
+
+    // int32 accumulation is exact for up to 65536 samples
+    int32_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+    return static_cast<float>(sum) / static_cast<float>(count);
+}
+
+void DecimationFilter::buildCicWeights(size_t count)
+{
+    // Largest ratio whose equivalent FIR fits the block
+    size_t ratio = (count - 1) / CIC_ORDER + 1;
+
+    // Impulse response of an order-M CIC: a length-R box convolved M times
+    std::vector<int32_t> weights(1, 1);
+    for (int stage = 0; stage < CIC_ORDER; stage++) {
+        std::vector<int32_t> next(weights.size() + ratio - 1, 0);
+        for (size_t i = 0; i < weights.size(); i++) {
+            for (size_t j = 0; j < ratio; j++) {
+                next[i + j] += weights[i];
+            }
+        }
+        weights.swap(next);
+    }
+
+    // Center the kernel in the block; samples outside it get weight 0
+    m_cicWeights.assign(count, 0);
+    size_t offset = (count - weights.size()) / 2;
+    std::copy(weights.begin(), weights.end(), m_cicWeights.begin() + offset);
+
+    m_cicGain = 1;
+    for (int stage = 0; stage < CIC_ORDER; stage++) {
+        m_cicGain *= static_cast<int64_t>(ratio);
+    }
+    m_cicBlockSize = count;
+}
+
+float DecimationFilter::cic(const int16_t* samples, size_t count)
+{
+    if (count == 0) {
+        return 0.0f;
+    }
+    if (count != m_cicBlockSize) {
+        buildCicWeights(count);
+    }
+
+    const int32_t* weights = m_cicWeights.data();
+    int64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += static_cast<int64_t>(weights[i]) * samples[i];
+    }
+    return static_cast<float>(static_cast<double>(sum) / static_cast<double>(m_cicGain));
+}
+
+float DecimationFilter::median(const int16_t* samples, size_t count)
+{
+    if (count == 0) {
+        return 0.0f;
+    }
+
+    m_scratch.assign(samples, samples + count);
+    auto middle = m_scratch.begin() + count / 2;
+    std::nth_element(m_scratch.begin(), middle, m_scratch.end());
+
+    if (count % 2 == 1) {
+        return static_cast<float>(*middle);
+    }
+
+    // Even count: mean of the two middle samples
+    int16_t lower = *std::max_element(m_scratch.begin(), middle);
+    return (static_cast<float>(lower) + static_cast<float>(*middle)) / 2.0f;
+}
+
+//==============================================================================
+// Names
+//==============================================================================
+
+bool DecimationFilter::parseType(const std::string& name, Type& type)
+{
+    if (name == "boxcar") { type = Type::BOXCAR; return true; }
+    if (name == "cic")    { type = Type::CIC;    return true; }
+    if (name == "median") { type = Type::MEDIAN; return true; }
+    return false;
+}
+
+const char* DecimationFilter::typeName(Type type)
+{
+    switch (type) {
+        case Type::BOXCAR: return "boxcar";
+        case Type::CIC:    return "cic";
+        case Type::MEDIAN: return "median";
+    }
+    return "?";
+}
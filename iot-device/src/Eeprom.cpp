@@ -0,0 +1,309 @@
+#include "Eeprom.h"
+#include "Clock.h"
+#include "Config.h"
+#include "Crc.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    // i2c-dev rejects messages over 8192 bytes
+    constexpr size_t MAX_READ = 4096;
+
+    constexpr uint16_t SLOT_MAGIC = 0x5354;     // "TS"
+}
+
+constexpr size_t EepromSlotTable::HEADER_SIZE;
+
+//==============================================================================
+// Eeprom
+//==============================================================================
+
+Eeprom::Eeprom(HAL::I2CInterface& bus, Clock& clock, uint8_t deviceAddr)
+    : m_bus(bus)
+    , m_clock(clock)
+    , m_address(deviceAddr)
+    , m_data(HAL::EEPROM::SIZE, 0xFF)
+    , m_pages(HAL::EEPROM::PAGES, PAGE_ABSENT)
+    , m_writeCycle(false)
+    , m_stats()
+{
+}
+
+Eeprom::~Eeprom()
+{
+    if (dirtyPages() > 0) {
+        flush();
+    }
+}
+
+bool Eeprom::read(size_t address, void* buffer, size_t length)
+{
+    if (!load(address, length)) {
+        return false;
+    }
+    std::memcpy(buffer, &m_data[address], length);
+    return true;
+}
+
+bool Eeprom::write(size_t address, const void* data, size_t length)
+{
+    if (address > HAL::EEPROM::SIZE || length > HAL::EEPROM::SIZE - address) {
+        return false;
+    }
+    if (length == 0) {
+        return true;
+    }
+
+    // Pages are written whole, so the rest of each page must be cached too
+    size_t first = address / HAL::EEPROM::PAGE_SIZE * HAL::EEPROM::PAGE_SIZE;
+    size_t end = (address + length + HAL::EEPROM::PAGE_SIZE - 1) / HAL::EEPROM::PAGE_SIZE * HAL::EEPROM::PAGE_SIZE;
+    if (!load(first, end - first)) {
+        return false;
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    if (std::memcmp(&m_data[address], bytes, length) == 0) {
+        m_stats.unchangedWrites++;
+        return true;
+    }
+
+    size_t offset = 0;
+    while (offset < length) {
+        size_t position = address + offset;
+        size_t chunk = std::min(length - offset, HAL::EEPROM::PAGE_SIZE - position % HAL::EEPROM::PAGE_SIZE);
+        if (std::memcmp(&m_data[position], bytes + offset, chunk) != 0) {
+            std::memcpy(&m_data[position], bytes + offset, chunk);
+            m_pages[position / HAL::EEPROM::PAGE_SIZE] = PAGE_DIRTY;
+        }
+        offset += chunk;
+    }
+    return true;
+}
+
+bool Eeprom::flush()
+{
+    bool ok = true;
+    for (size_t page = 0; page < m_pages.size(); page++) {
+        if (m_pages[page] == PAGE_DIRTY) {
+            ok = writePage(page) && ok;
+        }
+    }
+    return waitReady() && ok;
+}
+
+void Eeprom::invalidate()
+{
+    for (auto& state : m_pages) {
+        if (state == PAGE_CLEAN) {
+            state = PAGE_ABSENT;
+        }
+    }
+}
+
+size_t Eeprom::dirtyPages() const
+{
+    return static_cast<size_t>(std::count(m_pages.begin(), m_pages.end(), PAGE_DIRTY));
+}
+
+bool Eeprom::load(size_t address, size_t length)
+{
+    if (address > HAL::EEPROM::SIZE || length > HAL::EEPROM::SIZE - address) {
+        return false;
+    }
+    if (length == 0) {
+        return true;
+    }
+
+    // One sequential read per run of missing pages
+    size_t lastPage = (address + length - 1) / HAL::EEPROM::PAGE_SIZE;
+    for (size_t page = address / HAL::EEPROM::PAGE_SIZE; page <= lastPage; page++) {
+        if (m_pages[page] != PAGE_ABSENT) {
+            continue;
+        }
+        size_t runEnd = page;
+        while (runEnd < lastPage && m_pages[runEnd + 1] == PAGE_ABSENT) {
+            runEnd++;
+        }
+        if (!loadPages(page, runEnd)) {
+            return false;
+        }
+        page = runEnd;
+    }
+    return true;
+}
+
+bool Eeprom::loadPages(size_t first, size_t last)
+{
+    if (!waitReady()) {
+        return false;
+    }
+
+    size_t address = first * HAL::EEPROM::PAGE_SIZE;
+    size_t end = (last + 1) * HAL::EEPROM::PAGE_SIZE;
+    while (address < end) {
+        size_t length = std::min(end - address, MAX_READ);
+        const uint8_t wordAddress[2] = {static_cast<uint8_t>(address >> 8), static_cast<uint8_t>(address & 0xFF)};
+        if (!m_bus.writeRead(m_address, wordAddress, sizeof(wordAddress), &m_data[address], length)) {
+            return false;
+        }
+        m_stats.bytesRead += length;
+        std::fill(m_pages.begin() + address / HAL::EEPROM::PAGE_SIZE,
+                  m_pages.begin() + (address + length) / HAL::EEPROM::PAGE_SIZE, PAGE_CLEAN);
+        address += length;
+    }
+    return true;
+}
+
+bool Eeprom::writePage(size_t page)
+{
+    if (!waitReady()) {
+        return false;
+    }
+
+    size_t address = page * HAL::EEPROM::PAGE_SIZE;
+    uint8_t buffer[2 + HAL::EEPROM::PAGE_SIZE];
+    buffer[0] = static_cast<uint8_t>(address >> 8);
+    buffer[1] = static_cast<uint8_t>(address & 0xFF);
+    std::memcpy(&buffer[2], &m_data[address], HAL::EEPROM::PAGE_SIZE);
+
+    if (!m_bus.write(m_address, buffer, sizeof(buffer))) {
+        return false;
+    }
+    m_pages[page] = PAGE_CLEAN;
+    m_writeCycle = true;
+    m_stats.pageWrites++;
+    return true;
+}
+
+bool Eeprom::waitReady()
+{
+    if (!m_writeCycle) {
+        return true;
+    }
+
+    // The device ignores its address until the write cycle is over
+    auto deadline = m_clock.now() + std::chrono::milliseconds(Config::Hardware::EEPROM_WRITE_TIMEOUT_MS);
+    uint8_t none = 0;
+    while (!m_bus.write(m_address, &none, 0)) {
+        m_stats.ackPolls++;
+        if (m_clock.now() >= deadline) {
+            m_stats.writeTimeouts++;
+            m_writeCycle = false;
+            return false;
+        }
+        m_clock.sleepFor(std::chrono::microseconds(Config::Hardware::EEPROM_ACK_POLL_US));
+    }
+    m_writeCycle = false;
+    return true;
+}
+
+//==============================================================================
+// EepromSlotTable
+//==============================================================================
+
+EepromSlotTable::EepromSlotTable(Eeprom& eeprom, size_t base, size_t slotSize, size_t slots)
+    : m_eeprom(eeprom)
+    , m_base(base)
+    , m_slotSize(slotSize)
+    , m_slots(slots)
+{
+    static_assert(sizeof(Header) == HEADER_SIZE, "slot header layout");
+}
+
+bool EepromSlotTable::scan()
+{
+    m_history.clear();
+
+    std::vector<uint8_t> slots(m_slotSize * m_slots);
+    if (!m_eeprom.read(m_base, slots.data(), slots.size())) {
+        return false;
+    }
+
+    for (size_t slot = 0; slot < m_slots; slot++) {
+        const uint8_t* data = &slots[slot * m_slotSize];
+        Header header;
+        std::memcpy(&header, data, sizeof(header));
+        // Erased slots read 0xFF
+        if (header.magic != SLOT_MAGIC || header.length > capacity() ||
+            checksum(header, data + HEADER_SIZE) != header.crc) {
+            continue;
+        }
+        m_history.push_back(Entry{header.sequence, slot, header.length});
+    }
+
+    std::sort(m_history.begin(), m_history.end(),
+              [](const Entry& a, const Entry& b) { return a.sequence > b.sequence; });
+    return true;
+}
+
+bool EepromSlotTable::load(const Entry& entry, void* record, size_t length)
+{
+    if (length != entry.length || entry.slot >= m_slots) {
+        return false;
+    }
+
+    std::vector<uint8_t> data(HEADER_SIZE + length);
+    if (!m_eeprom.read(m_base + entry.slot * m_slotSize, data.data(), data.size())) {
+        return false;
+    }
+    Header header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != SLOT_MAGIC || header.sequence != entry.sequence || header.length != length ||
+        checksum(header, &data[HEADER_SIZE]) != header.crc) {
+        return false;
+    }
+    std::memcpy(record, &data[HEADER_SIZE], length);
+    return true;
+}
+
+bool EepromSlotTable::save(const void* record, size_t length)
+{
+    if (length > capacity() || m_slots == 0) {
+        return false;
+    }
+
+    // The newest version already holds this record
+    if (!m_history.empty() && m_history.front().length == length) {
+        std::vector<uint8_t> newest(length);
+        if (load(m_history.front(), newest.data(), length) && std::memcmp(newest.data(), record, length) == 0) {
+            return true;
+        }
+    }
+
+    Entry entry{1, 0, length};
+    if (!m_history.empty()) {
+        entry.sequence = m_history.front().sequence + 1;
+        entry.slot = (m_history.front().slot + 1) % m_slots;
+    }
+
+    Header header;
+    header.magic = SLOT_MAGIC;
+    header.length = static_cast<uint16_t>(length);
+    header.sequence = entry.sequence;
+    header.reserved = 0;
+
+    std::vector<uint8_t> data(m_slotSize, 0xFF);
+    std::memcpy(&data[HEADER_SIZE], record, length);
+    header.crc = checksum(header, &data[HEADER_SIZE]);
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    if (!m_eeprom.write(m_base + entry.slot * m_slotSize, data.data(), data.size()) || !m_eeprom.flush()) {
+        return false;
+    }
+
+    // The slot's previous record is gone
+    m_history.erase(std::remove_if(m_history.begin(), m_history.end(),
+                                   [&](const Entry& e) { return e.slot == entry.slot; }),
+                    m_history.end());
+    m_history.insert(m_history.begin(), entry);
+    return true;
+}
+
+uint16_t EepromSlotTable::checksum(Header header, const uint8_t* record)
+{
+    header.crc = 0;
+    Crc16 crc;
+    crc.update(&header, sizeof(header));
+    crc.update(record, header.length);
+    return crc.value();
+}
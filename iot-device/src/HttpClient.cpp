@@ -1,11 +1,44 @@
 #include "HttpClient.h"
+#include "Config.h"
 #include <curl/curl.h>
 #include <iostream>
 #include <thread>
+#include <algorithm>
+
+/**
+ * One async request owned by the event loop.
+ * The body and response buffers live here so libcurl can reference them
+ * without copies until the transfer completes.
+ */
+struct HttpClient::AsyncRequest {
+    RequestId id;
+    std::string endpoint;
+    std::string url;
+    std::string method;
+    std::string body;
+    std::string poolKey;
+    std::string responseBody;
+    curl_slist* headers;
+    CURL* handle;
+    ResponseCallback callback;
+    std::shared_ptr<std::promise<Response>> promise;
+    int attempts;
+    bool probe;                 // Holds the breaker's HALF_OPEN probe slot, no outcome recorded yet
+    Response lastResponse;      // Outcome of the previous attempt while waiting to retry
+};
 
 HttpClient::HttpClient()
     : m_timeout(30)
+    , m_connectTimeout(Config::HTTP_CONNECT_TIMEOUT_SEC)
     , m_initialized(false)
+    , m_maxIdleHandles(Config::HTTP_POOL_MAX_IDLE_HANDLES)
+    , m_idleTimeout(Config::HTTP_POOL_IDLE_TIMEOUT_SEC)
+    , m_poolStats()
+    , m_multi(nullptr)
+    , m_asyncQueueCapacity(Config::HTTP_ASYNC_QUEUE_CAPACITY)
+    , m_asyncMaxConnections(Config::HTTP_ASYNC_MAX_CONNECTIONS)
+    , m_nextRequestId(1)
+    , m_stopping(false)
 {
 }
 
@@ -13,7 +46,16 @@ HttpClient::HttpClient(const std::string& baseUrl, const std::string& apiKey)
     : m_baseUrl(baseUrl)
     , m_apiKey(apiKey)
     , m_timeout(30)
+    , m_connectTimeout(Config::HTTP_CONNECT_TIMEOUT_SEC)
     , m_initialized(false)
+    , m_maxIdleHandles(Config::HTTP_POOL_MAX_IDLE_HANDLES)
+    , m_idleTimeout(Config::HTTP_POOL_IDLE_TIMEOUT_SEC)
+    , m_poolStats()
+    , m_multi(nullptr)
+    , m_asyncQueueCapacity(Config::HTTP_ASYNC_QUEUE_CAPACITY)
+    , m_asyncMaxConnections(Config::HTTP_ASYNC_MAX_CONNECTIONS)
+    , m_nextRequestId(1)
+    , m_stopping(false)
 {
 }
 
@@ -40,12 +82,39 @@ bool HttpClient::initialize()
         m_headers["X-API-Key"] = m_apiKey;
     }
 
+    // 비동기 이벤트 루프 시작
+    m_multi = curl_multi_init();
+    if (!m_multi) {
+        std::cerr << "Failed to create CURL multi handle" << std::endl;
+        m_initialized = false;
+        curl_global_cleanup();
+        return false;
+    }
+    curl_multi_setopt(m_multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, static_cast<long>(m_asyncMaxConnections));
+
+    m_stopping = false;
+    m_loopThread = std::thread(&HttpClient::eventLoop, this);
+
     return true;
 }
 
 void HttpClient::cleanup()
 {
     if (m_initialized) {
+        // Stop accepting async work and let the loop drain what was submitted
+        {
+            std::lock_guard<std::mutex> lock(m_asyncMutex);
+            m_stopping = true;
+        }
+        curl_multi_wakeup(m_multi);
+        if (m_loopThread.joinable()) {
+            m_loopThread.join();
+        }
+        curl_multi_cleanup(m_multi);
+        m_multi = nullptr;
+
+        // Pooled handles must be closed before libcurl is torn down
+        clearPool();
         curl_global_cleanup();
         m_initialized = false;
     }
@@ -72,6 +141,150 @@ void HttpClient::setTimeout(int seconds)
     m_timeout = seconds;
 }
 
+void HttpClient::setConnectTimeout(int seconds)
+{
+    m_connectTimeout = seconds;
+}
+
+void HttpClient::setPoolSize(size_t maxIdleHandles)
+{
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    m_maxIdleHandles = maxIdleHandles;
+
+    // Shrink immediately, closing the least recently used handles first
+    while (m_poolStats.idleHandles > m_maxIdleHandles) {
+        auto oldest = m_idleHandles.end();
+        for (auto it = m_idleHandles.begin(); it != m_idleHandles.end(); ++it) {
+            if (it->second.empty()) continue;
+            if (oldest == m_idleHandles.end() ||
+                it->second.front().lastUsed < oldest->second.front().lastUsed) {
+                oldest = it;
+            }
+        }
+        if (oldest == m_idleHandles.end()) break;
+
+        curl_easy_cleanup(oldest->second.front().handle);
+        oldest->second.erase(oldest->second.begin());
+        m_poolStats.idleHandles--;
+        m_poolStats.handlesEvicted++;
+    }
+}
+
+void HttpClient::setIdleTimeout(int seconds)
+{
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    m_idleTimeout = std::chrono::seconds(seconds);
+}
+
+void HttpClient::evictIdleConnections()
+{
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    evictIdleLocked(std::chrono::steady_clock::now());
+}
+
+HttpClient::PoolStats HttpClient::getPoolStats()
+{
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    return m_poolStats;
+}
+
+//==============================================================================
+// Connection Pool
+//==============================================================================
+
+std::string HttpClient::poolKey(const std::string& url)
+{
+    // scheme://host:port - everything up to the first path/query character
+    size_t authority = url.find("://");
+    authority = (authority == std::string::npos) ? 0 : authority + 3;
+
+    size_t end = url.find_first_of("/?#", authority);
+    return url.substr(0, end);
+}
+
+void* HttpClient::acquireHandle(const std::string& key)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        evictIdleLocked(std::chrono::steady_clock::now());
+
+        auto it = m_idleHandles.find(key);
+        if (it != m_idleHandles.end() && !it->second.empty()) {
+            // LIFO: the most recently used handle is the most likely to still
+            // hold a live connection
+            void* handle = it->second.back().handle;
+            it->second.pop_back();
+            m_poolStats.idleHandles--;
+            m_poolStats.handlesReused++;
+            return handle;
+        }
+        m_poolStats.handlesCreated++;
+    }
+
+    return curl_easy_init();
+}
+
+void HttpClient::releaseHandle(const std::string& key, void* handle)
+{
+    if (!handle) {
+        return;
+    }
+
+    // Drop per-request options; the connection cache, DNS cache and TLS
+    // session IDs survive curl_easy_reset
+    curl_easy_reset(handle);
+
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    auto now = std::chrono::steady_clock::now();
+    evictIdleLocked(now);
+
+    if (!m_initialized || m_poolStats.idleHandles >= m_maxIdleHandles) {
+        curl_easy_cleanup(handle);
+        m_poolStats.handlesEvicted++;
+        return;
+    }
+
+    m_idleHandles[key].push_back(PooledHandle{handle, now});
+    m_poolStats.idleHandles++;
+}
+
+void HttpClient::evictIdleLocked(std::chrono::steady_clock::time_point now)
+{
+    for (auto it = m_idleHandles.begin(); it != m_idleHandles.end();) {
+        auto& handles = it->second;
+
+        // Handles are appended in release order, so the stale ones are at the front
+        size_t stale = 0;
+        while (stale < handles.size() && now - handles[stale].lastUsed > m_idleTimeout) {
+            curl_easy_cleanup(handles[stale].handle);
+            stale++;
+        }
+        if (stale > 0) {
+            handles.erase(handles.begin(), handles.begin() + stale);
+            m_poolStats.idleHandles -= stale;
+            m_poolStats.handlesEvicted += stale;
+        }
+
+        if (handles.empty()) {
+            it = m_idleHandles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void HttpClient::clearPool()
+{
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    for (auto& entry : m_idleHandles) {
+        for (auto& pooled : entry.second) {
+            curl_easy_cleanup(pooled.handle);
+        }
+    }
+    m_idleHandles.clear();
+    m_poolStats.idleHandles = 0;
+}
+
 size_t HttpClient::writeCallback(void* contents, size_t size, size_t nmemb, std::string* userp)
 {
     size_t totalSize = size * nmemb;
@@ -79,48 +292,47 @@ size_t HttpClient::writeCallback(void* contents, size_t size, size_t nmemb, std:
     return totalSize;
 }
 
-HttpClient::Response HttpClient::performRequest(const std::string& url, const std::string& method, const std::string& body)
+curl_slist* HttpClient::buildHeaderList()
 {
-    Response response;
-    response.success = false;
-    response.statusCode = 0;
-
-    if (!m_initialized) {
-        response.errorMessage = "HttpClient not initialized";
-        return response;
-    }
-
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        response.errorMessage = "Failed to create CURL handle";
-        return response;
+    curl_slist* headers = nullptr;
+    for (const auto& header : m_headers) {
+        std::string headerStr = header.first + ": " + header.second;
+        headers = curl_slist_append(headers, headerStr.c_str());
     }
+    return headers;
+}
 
-    std::string responseBody;
+void HttpClient::configureHandle(void* handle, const std::string& url, const std::string& method,
+                                 const std::string& body, std::string* responseBody, curl_slist* headers)
+{
+    CURL* curl = handle;
 
     // URL 설정
     curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
 
     // 타임아웃 설정
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, m_timeout);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, static_cast<long>(m_timeout));
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, static_cast<long>(m_connectTimeout));
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+
+    // Keep-alive: reuse the pooled connection instead of a fresh TCP/TLS handshake
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPIDLE, static_cast<long>(Config::HTTP_KEEPALIVE_IDLE_SEC));
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPINTVL, static_cast<long>(Config::HTTP_KEEPALIVE_INTERVAL_SEC));
+    curl_easy_setopt(curl, CURLOPT_MAXAGE_CONN, static_cast<long>(m_idleTimeout.count()));
 
     // 응답 콜백 설정
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, responseBody);
 
     // 헤더 설정
-    struct curl_slist* headers = nullptr;
-    for (const auto& header : m_headers) {
-        std::string headerStr = header.first + ": " + header.second;
-        headers = curl_slist_append(headers, headerStr.c_str());
-    }
     curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
 
     // 메서드별 설정
     if (method == "POST") {
         curl_easy_setopt(curl, CURLOPT_POST, 1L);
         curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, body.length());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(body.length()));
     } else if (method == "GET") {
         curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
     }
@@ -128,58 +340,149 @@ HttpClient::Response HttpClient::performRequest(const std::string& url, const st
     // SSL 검증 (개발 환경에서는 비활성화 가능)
     curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
     curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+}
 
-    // 요청 수행
-    CURLcode res = curl_easy_perform(curl);
+void HttpClient::completeResponse(void* handle, int curlCode, std::string& responseBody, Response& response)
+{
+    CURLcode res = static_cast<CURLcode>(curlCode);
 
     if (res != CURLE_OK) {
         response.errorMessage = curl_easy_strerror(res);
+
+        // Bytes of request written: 0 means it failed before reaching the server
+        long requestSize = 0;
+        curl_easy_getinfo(handle, CURLINFO_REQUEST_SIZE, &requestSize);
+        response.requestSent = requestSize > 0;
     } else {
+        response.requestSent = true;
         response.success = true;
-        response.body = responseBody;
+        response.body.swap(responseBody);
 
         long httpCode = 0;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
+        curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &httpCode);
         response.statusCode = static_cast<int>(httpCode);
     }
+}
+
+HttpClient::Response HttpClient::circuitOpenResponse()
+{
+    Response response;
+    response.success = false;
+    response.statusCode = 0;
+    response.errorMessage = "Circuit open: server unavailable";
+    return response;
+}
+
+bool HttpClient::recordOutcome(const std::string& endpoint, const Response& response)
+{
+    // Only outcomes that indicate the backend is unhealthy trip the breaker;
+    // a 4xx means the server is up and rejected this particular request
+    bool serverFailure = !response.success || response.statusCode >= 500 || response.statusCode == 429;
+    if (serverFailure) {
+        m_breaker.recordFailure();
+    } else {
+        m_breaker.recordSuccess();
+    }
+
+    bool succeeded = response.success && response.statusCode >= 200 && response.statusCode < 300;
+    return !succeeded &&
+           m_retryPolicy.isRetryable(endpoint, response.success, response.statusCode, response.requestSent);
+}
+
+HttpClient::Response HttpClient::executeRequest(const std::string& endpoint, const std::string& method, const std::string& body)
+{
+    if (!m_breaker.allowRequest()) {
+        return circuitOpenResponse();
+    }
+    m_retryPolicy.onRequest();
+
+    // The caller is blocked for the whole request: fewer retries than async,
+    // within a total deadline
+    const std::string url = m_baseUrl + endpoint;
+    const int maxRetries = std::min(m_retryPolicy.maxRetries(), Config::HTTP_SYNC_MAX_RETRIES);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(Config::HTTP_SYNC_DEADLINE_MS);
+    for (int attempt = 1; ; attempt++) {
+        Response response = performRequest(url, method, body);
+        response.attempts = attempt;
+
+        bool retryable = recordOutcome(endpoint, response);
+        if (!retryable || attempt > maxRetries || m_breaker.state() == CircuitBreaker::State::OPEN) {
+            return response;
+        }
+        auto delay = m_retryPolicy.backoffDelay(attempt);
+        if (std::chrono::steady_clock::now() + delay >= deadline || !m_retryPolicy.tryAcquireRetry()) {
+            return response;
+        }
+
+        std::this_thread::sleep_for(delay);
+
+        // The breaker may have opened while we were backing off
+        if (!m_breaker.allowRequest()) {
+            return response;
+        }
+    }
+}
+
+HttpClient::Response HttpClient::performRequest(const std::string& url, const std::string& method, const std::string& body)
+{
+    Response response;
+    response.success = false;
+    response.statusCode = 0;
 
-    // 정리
+    if (!m_initialized) {
+        response.errorMessage = "HttpClient not initialized";
+        return response;
+    }
+
+    // 풀에서 handle 대여 (없으면 새로 생성)
+    const std::string key = poolKey(url);
+    CURL* curl = acquireHandle(key);
+    if (!curl) {
+        response.errorMessage = "Failed to create CURL handle";
+        return response;
+    }
+
+    std::string responseBody;
+    curl_slist* headers = buildHeaderList();
+    configureHandle(curl, url, method, body, &responseBody, headers);
+
+    // 요청 수행
+    CURLcode res = curl_easy_perform(curl);
+    completeResponse(curl, res, responseBody, response);
+
+    // 정리 (handle은 풀로 반환하여 연결 유지)
     curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+    releaseHandle(key, curl);
 
     return response;
 }
 
 HttpClient::Response HttpClient::get(const std::string& endpoint)
 {
-    std::string url = m_baseUrl + endpoint;
-    return performRequest(url, "GET");
+    return executeRequest(endpoint, "GET");
 }
 
-void HttpClient::getAsync(const std::string& endpoint, ResponseCallback callback)
+HttpClient::RequestId HttpClient::getAsync(const std::string& endpoint, ResponseCallback callback)
 {
-    std::thread([this, endpoint, callback]() {
-        Response response = get(endpoint);
-        if (callback) {
-            callback(response);
-        }
-    }).detach();
+    return submitAsync(endpoint, "GET", "", std::move(callback), nullptr);
 }
 
 HttpClient::Response HttpClient::post(const std::string& endpoint, const std::string& jsonBody)
 {
-    std::string url = m_baseUrl + endpoint;
-    return performRequest(url, "POST", jsonBody);
+    return executeRequest(endpoint, "POST", jsonBody);
 }
 
-void HttpClient::postAsync(const std::string& endpoint, const std::string& jsonBody, ResponseCallback callback)
+HttpClient::RequestId HttpClient::postAsync(const std::string& endpoint, const std::string& jsonBody, ResponseCallback callback)
 {
-    std::thread([this, endpoint, jsonBody, callback]() {
-        Response response = post(endpoint, jsonBody);
-        if (callback) {
-            callback(response);
-        }
-    }).detach();
+    return submitAsync(endpoint, "POST", jsonBody, std::move(callback), nullptr);
+}
+
+std::future<HttpClient::Response> HttpClient::postAsync(const std::string& endpoint, const std::string& jsonBody)
+{
+    auto promise = std::make_shared<std::promise<Response>>();
+    std::future<Response> future = promise->get_future();
+    submitAsync(endpoint, "POST", jsonBody, nullptr, promise);
+    return future;
 }
 
 bool HttpClient::checkConnection()
@@ -187,3 +490,297 @@ bool HttpClient::checkConnection()
     Response response = get("/api/iot/health");
     return response.success && response.statusCode == 200;
 }
+
+//==============================================================================
+// Async Engine
+//==============================================================================
+
+void HttpClient::setAsyncQueueCapacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(m_asyncMutex);
+    m_asyncQueueCapacity = capacity;
+}
+
+void HttpClient::setAsyncMaxConnections(size_t maxConnections)
+{
+    m_asyncMaxConnections = maxConnections;
+}
+
+size_t HttpClient::getPendingAsyncCount()
+{
+    std::lock_guard<std::mutex> lock(m_asyncMutex);
+    return m_outstanding.size();
+}
+
+void HttpClient::deliver(AsyncRequest& request, const Response& response)
+{
+    if (request.callback) {
+        request.callback(response);
+    }
+    if (request.promise) {
+        request.promise->set_value(response);
+    }
+}
+
+HttpClient::RequestId HttpClient::submitAsync(const std::string& endpoint, const std::string& method, const std::string& body,
+                                              ResponseCallback callback, std::shared_ptr<std::promise<Response>> promise)
+{
+    std::unique_ptr<AsyncRequest> request(new AsyncRequest());
+    request->endpoint = endpoint;
+    request->url = m_baseUrl + endpoint;
+    request->method = method;
+    request->body = body;
+    request->headers = nullptr;
+    request->handle = nullptr;
+    request->callback = std::move(callback);
+    request->promise = std::move(promise);
+    request->attempts = 0;
+    request->probe = false;
+
+    Response rejected;
+    rejected.success = false;
+    rejected.statusCode = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_asyncMutex);
+        if (!m_initialized || m_stopping) {
+            rejected.errorMessage = "HttpClient not initialized";
+        } else if (m_outstanding.size() >= m_asyncQueueCapacity) {
+            rejected.errorMessage = "Async queue full";
+        } else if (!m_breaker.allowRequest(&request->probe)) {
+            rejected = circuitOpenResponse();
+        } else {
+            m_retryPolicy.onRequest();
+            request->id = m_nextRequestId++;
+            RequestId id = request->id;
+            m_outstanding.insert(id);
+            m_submitQueue.push_back(std::move(request));
+            curl_multi_wakeup(m_multi);
+            return id;
+        }
+    }
+
+    // Rejected requests complete synchronously so memory stays bounded
+    deliver(*request, rejected);
+    return 0;
+}
+
+bool HttpClient::cancel(RequestId id)
+{
+    std::unique_ptr<AsyncRequest> queued;
+    {
+        std::lock_guard<std::mutex> lock(m_asyncMutex);
+        if (m_outstanding.find(id) == m_outstanding.end()) {
+            return false;
+        }
+
+        auto it = std::find_if(m_submitQueue.begin(), m_submitQueue.end(),
+                               [id](const std::unique_ptr<AsyncRequest>& r) { return r->id == id; });
+        if (it != m_submitQueue.end()) {
+            // Not handed to curl yet: complete it right here
+            queued = std::move(*it);
+            m_submitQueue.erase(it);
+            m_outstanding.erase(id);
+            if (queued->probe) {
+                m_breaker.releaseProbe();
+            }
+        } else {
+            // In flight or waiting to retry: only the loop thread may touch those
+            m_cancelQueue.push_back(id);
+            curl_multi_wakeup(m_multi);
+            return true;
+        }
+    }
+
+    Response response;
+    response.success = false;
+    response.statusCode = 0;
+    response.errorMessage = "Request cancelled";
+    deliver(*queued, response);
+    return true;
+}
+
+void HttpClient::startAsyncRequest(std::unique_ptr<AsyncRequest> request)
+{
+    request->poolKey = poolKey(request->url);
+    request->handle = static_cast<CURL*>(acquireHandle(request->poolKey));
+
+    if (!request->handle) {
+        Response response;
+        response.success = false;
+        response.statusCode = 0;
+        response.errorMessage = "Failed to create CURL handle";
+        completeAsyncRequest(std::move(request), response);
+        return;
+    }
+
+    request->attempts++;
+    request->responseBody.clear();
+    request->headers = buildHeaderList();
+    configureHandle(request->handle, request->url, request->method, request->body,
+                    &request->responseBody, request->headers);
+
+    CURL* handle = request->handle;
+    m_inFlight[handle] = std::move(request);
+    curl_multi_add_handle(m_multi, handle);
+}
+
+std::unique_ptr<HttpClient::AsyncRequest> HttpClient::detachAsyncRequest(void* handle)
+{
+    auto it = m_inFlight.find(handle);
+    if (it == m_inFlight.end()) {
+        return nullptr;
+    }
+
+    std::unique_ptr<AsyncRequest> request = std::move(it->second);
+    m_inFlight.erase(it);
+
+    curl_multi_remove_handle(m_multi, request->handle);
+    curl_slist_free_all(request->headers);
+    releaseHandle(request->poolKey, request->handle);
+    request->headers = nullptr;
+    request->handle = nullptr;
+
+    return request;
+}
+
+void HttpClient::completeAsyncRequest(std::unique_ptr<AsyncRequest> request, const Response& response)
+{
+    // Cancelled or never started: the breaker got no outcome for its probe
+    if (request->probe) {
+        m_breaker.releaseProbe();
+        request->probe = false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_asyncMutex);
+        m_outstanding.erase(request->id);
+    }
+    deliver(*request, response);
+}
+
+void HttpClient::startDueRetries(bool flushAll)
+{
+    auto now = std::chrono::steady_clock::now();
+
+    while (!m_retryTimers.empty() && (flushAll || m_retryTimers.begin()->first <= now)) {
+        std::unique_ptr<AsyncRequest> request = std::move(m_retryTimers.begin()->second);
+        m_retryTimers.erase(m_retryTimers.begin());
+
+        if (flushAll) {
+            // Shutting down: report the last failure instead of waiting out the backoff
+            Response response = request->lastResponse;
+            completeAsyncRequest(std::move(request), response);
+        } else if (!m_breaker.allowRequest(&request->probe)) {
+            completeAsyncRequest(std::move(request), circuitOpenResponse());
+        } else {
+            startAsyncRequest(std::move(request));
+        }
+    }
+}
+
+bool HttpClient::cancelInLoop(RequestId id)
+{
+    Response response;
+    response.success = false;
+    response.statusCode = 0;
+    response.errorMessage = "Request cancelled";
+
+    for (auto it = m_inFlight.begin(); it != m_inFlight.end(); ++it) {
+        if (it->second->id == id) {
+            completeAsyncRequest(detachAsyncRequest(it->first), response);
+            return true;
+        }
+    }
+
+    for (auto it = m_retryTimers.begin(); it != m_retryTimers.end(); ++it) {
+        if (it->second->id == id) {
+            std::unique_ptr<AsyncRequest> request = std::move(it->second);
+            m_retryTimers.erase(it);
+            completeAsyncRequest(std::move(request), response);
+            return true;
+        }
+    }
+    return false;
+}
+
+void HttpClient::eventLoop()
+{
+    std::deque<std::unique_ptr<AsyncRequest>> submissions;
+    std::vector<RequestId> cancellations;
+
+    while (true) {
+        bool stopping;
+        {
+            std::lock_guard<std::mutex> lock(m_asyncMutex);
+            submissions.swap(m_submitQueue);
+            cancellations.swap(m_cancelQueue);
+            stopping = m_stopping;
+        }
+
+        for (auto& request : submissions) {
+            startAsyncRequest(std::move(request));
+        }
+        submissions.clear();
+
+        for (RequestId id : cancellations) {
+            cancelInLoop(id);
+        }
+        cancellations.clear();
+
+        startDueRetries(stopping);
+
+        // Drain: exit only once everything accepted before cleanup() has completed
+        if (stopping && m_inFlight.empty()) {
+            std::lock_guard<std::mutex> lock(m_asyncMutex);
+            if (m_submitQueue.empty()) {
+                break;
+            }
+            continue;
+        }
+
+        int running = 0;
+        curl_multi_perform(m_multi, &running);
+
+        int pending = 0;
+        while (CURLMsg* msg = curl_multi_info_read(m_multi, &pending)) {
+            if (msg->msg != CURLMSG_DONE) {
+                continue;
+            }
+
+            CURL* handle = msg->easy_handle;
+            CURLcode result = msg->data.result;
+            auto it = m_inFlight.find(handle);
+            if (it == m_inFlight.end()) {
+                continue;
+            }
+
+            Response response;
+            response.success = false;
+            response.statusCode = 0;
+            completeResponse(handle, result, it->second->responseBody, response);
+
+            std::unique_ptr<AsyncRequest> request = detachAsyncRequest(handle);
+            response.attempts = request->attempts;
+
+            bool retryable = recordOutcome(request->endpoint, response);
+            request->probe = false;
+            if (retryable && !stopping && m_breaker.state() != CircuitBreaker::State::OPEN &&
+                request->attempts <= m_retryPolicy.maxRetries() && m_retryPolicy.tryAcquireRetry()) {
+                auto due = std::chrono::steady_clock::now() + m_retryPolicy.backoffDelay(request->attempts);
+                request->lastResponse = response;
+                m_retryTimers.emplace(due, std::move(request));
+            } else {
+                completeAsyncRequest(std::move(request), response);
+            }
+        }
+
+        // Sleep until socket activity, a wakeup, or the next scheduled retry
+        int timeoutMs = Config::HTTP_ASYNC_POLL_TIMEOUT_MS;
+        if (!m_retryTimers.empty()) {
+            auto untilRetry = std::chrono::duration_cast<std::chrono::milliseconds>(
+                m_retryTimers.begin()->first - std::chrono::steady_clock::now()).count();
+            timeoutMs = static_cast<int>(std::max<long long>(0, std::min<long long>(timeoutMs, untilRetry)));
+        }
+        curl_multi_poll(m_multi, nullptr, 0, timeoutMs, nullptr);
+    }
+}
@@ -0,0 +1,517 @@
+#include "I2CTrace.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace HAL {
+
+namespace {
+    const char MAGIC[4] = {'I', '2', 'C', 'T'};
+    constexpr size_t HEADER_SIZE = 4 + 1 + 8;
+
+    constexpr uint8_t RECORD_TRANSACTION = 1;
+    constexpr uint8_t RECORD_EDGE = 2;
+
+    // Buffered records are written out past this size (and by flush())
+    constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+
+    int64_t toMicros(Clock::Duration duration) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    }
+
+    /**
+     * Bounds-checked reader over a loaded trace
+     */
+    class TraceReader {
+    public:
+        TraceReader(const std::vector<uint8_t>& data, size_t offset)
+            : m_data(data), m_offset(offset) {}
+
+        bool atEnd() const { return m_offset >= m_data.size(); }
+        size_t offset() const { return m_offset; }
+
+        bool byte(uint8_t& value) {
+            if (m_offset >= m_data.size()) {
+                return false;
+            }
+            value = m_data[m_offset++];
+            return true;
+        }
+
+        bool varint(uint64_t& value) {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                uint8_t b;
+                if (!byte(b)) {
+                    return false;
+                }
+                value |= static_cast<uint64_t>(b & 0x7F) << shift;
+                if (!(b & 0x80)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool signedVarint(int64_t& value) {
+            uint64_t zigzag;
+            if (!varint(zigzag)) {
+                return false;
+            }
+            value = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+            return true;
+        }
+
+        bool bytes(std::vector<uint8_t>& out, size_t length) {
+            if (m_data.size() - m_offset < length) {
+                return false;
+            }
+            out.assign(m_data.begin() + m_offset, m_data.begin() + m_offset + length);
+            m_offset += length;
+            return true;
+        }
+
+    private:
+        const std::vector<uint8_t>& m_data;
+        size_t m_offset;
+    };
+}
+
+constexpr uint8_t I2CTraceWriter::VERSION;
+
+//==============================================================================
+// I2CTraceWriter
+//==============================================================================
+
+std::shared_ptr<I2CTraceWriter> I2CTraceWriter::open(const std::string& path, Clock& clock)
+{
+    static std::mutex registryMutex;
+    static std::map<std::string, std::weak_ptr<I2CTraceWriter>> registry;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::shared_ptr<I2CTraceWriter> writer = registry[path].lock();
+    if (writer) {
+        return writer;
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "[I2C] Cannot create trace file " << path << std::endl;
+        return nullptr;
+    }
+
+    writer.reset(new I2CTraceWriter(file, clock));
+    registry[path] = writer;
+    return writer;
+}
+
+I2CTraceWriter::I2CTraceWriter(std::FILE* file, Clock& clock)
+    : m_file(file)
+    , m_clock(clock)
+    , m_origin(clock.now())
+    , m_lastUs(0)
+    , m_records(0)
+{
+    m_buffer.reserve(FLUSH_THRESHOLD + 256);
+    m_buffer.insert(m_buffer.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    m_buffer.push_back(VERSION);
+
+    uint64_t unixMs = clock.unixTimeMs();
+    for (int i = 0; i < 8; i++) {
+        m_buffer.push_back(static_cast<uint8_t>(unixMs >> (8 * i)));
+    }
+}
+
+I2CTraceWriter::~I2CTraceWriter()
+{
+    flush();
+    std::fclose(m_file);
+}
+
+void I2CTraceWriter::transaction(Clock::TimePoint start, Clock::TimePoint end,
+                                 const I2CMessage* messages, size_t count, bool ok)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    putByte(RECORD_TRANSACTION);
+    putTime(start);
+    putVarint(static_cast<uint64_t>(std::max<int64_t>(toMicros(end - start), 0)));
+    putByte(ok ? 1 : 0);
+    putByte(static_cast<uint8_t>(count));
+
+    for (size_t i = 0; i < count; i++) {
+        const I2CMessage& message = messages[i];
+        putByte(message.address);
+        putByte(static_cast<uint8_t>(message.flags & I2CMessage::READ));
+        putVarint(message.length);
+        m_buffer.insert(m_buffer.end(), message.buffer, message.buffer + message.length);
+    }
+
+    m_records++;
+    flushIfFull();
+}
+
+void I2CTraceWriter::edge(int pin, Clock::TimePoint when)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    putByte(RECORD_EDGE);
+    putTime(when);
+    putByte(static_cast<uint8_t>(pin));
+
+    m_records++;
+    flushIfFull();
+}
+
+void I2CTraceWriter::flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_buffer.empty()) {
+        std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+        m_buffer.clear();
+    }
+    std::fflush(m_file);
+}
+
+uint64_t I2CTraceWriter::getRecords() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_records;
+}
+
+void I2CTraceWriter::putTime(Clock::TimePoint when)
+{
+    int64_t us = toMicros(when - m_origin);
+    int64_t delta = us - m_lastUs;
+    m_lastUs = us;
+    putVarint((static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63));
+}
+
+void I2CTraceWriter::putVarint(uint64_t value)
+{
+    while (value >= 0x80) {
+        m_buffer.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    m_buffer.push_back(static_cast<uint8_t>(value));
+}
+
+void I2CTraceWriter::flushIfFull()
+{
+    if (m_buffer.size() >= FLUSH_THRESHOLD) {
+        std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+        m_buffer.clear();
+    }
+}
+
+//==============================================================================
+// TracingI2C
+//==============================================================================
+
+TracingI2C::TracingI2C(I2CInterface* inner, std::shared_ptr<I2CTraceWriter> writer, Clock& clock)
+    : m_writer(std::move(writer))
+    , m_clock(clock)
+    , m_inner(inner)
+{
+}
+
+bool TracingI2C::initialize(int busNumber)
+{
+    return m_inner->initialize(busNumber);
+}
+
+void TracingI2C::cleanup()
+{
+    m_inner->cleanup();
+    m_writer->flush();
+    std::cout << "[I2C] Trace: " << m_writer->getRecords() << " records" << std::endl;
+}
+
+bool TracingI2C::transfer(I2CMessage* messages, size_t count)
+{
+    Clock::TimePoint start = m_clock.now();
+    bool ok = m_inner->transfer(messages, count);
+    m_writer->transaction(start, m_clock.now(), messages, count, ok);
+    return ok;
+}
+
+//==============================================================================
+// TracingGPIO
+//==============================================================================
+
+TracingGPIO::TracingGPIO(GPIOInterface* inner, std::shared_ptr<I2CTraceWriter> writer, Clock& clock)
+    : m_writer(std::move(writer))
+    , m_clock(clock)
+    , m_inner(inner)
+{
+}
+
+void TracingGPIO::cleanup()
+{
+    m_inner->cleanup();
+    m_writer->flush();
+}
+
+bool TracingGPIO::setInterrupt(int pin, Edge edge, void (*callback)(int, void*), void* userData)
+{
+    if (edge == Edge::NONE || !callback) {
+        bool ok = m_inner->setInterrupt(pin, edge, callback, userData);
+        m_hooks.erase(pin);
+        return ok;
+    }
+
+    std::unique_ptr<Hook> hook(new Hook{this, callback, userData});
+    if (!m_inner->setInterrupt(pin, edge, &TracingGPIO::onEdge, hook.get())) {
+        return false;
+    }
+    // The inner GPIO no longer uses the previous hook
+    m_hooks[pin] = std::move(hook);
+    return true;
+}
+
+void TracingGPIO::onEdge(int pin, void* userData)
+{
+    Hook* hook = static_cast<Hook*>(userData);
+    hook->self->m_writer->edge(pin, hook->self->m_clock.now());
+    hook->callback(pin, hook->userData);
+}
+
+I2CInterface* traceI2C(I2CInterface* bus, const std::string& path, Clock& clock)
+{
+    std::shared_ptr<I2CTraceWriter> writer = path.empty() ? nullptr : I2CTraceWriter::open(path, clock);
+    if (!writer) {
+        return bus;
+    }
+    std::cout << "[I2C] Recording bus trace to " << path << std::endl;
+    return new TracingI2C(bus, writer, clock);
+}
+
+GPIOInterface* traceGPIO(GPIOInterface* gpio, const std::string& path, Clock& clock)
+{
+    std::shared_ptr<I2CTraceWriter> writer = path.empty() ? nullptr : I2CTraceWriter::open(path, clock);
+    return writer ? new TracingGPIO(gpio, writer, clock) : gpio;
+}
+
+//==============================================================================
+// ReplayI2C
+//==============================================================================
+
+ReplayI2C::ReplayI2C(Clock& clock, EdgeSink edgeSink)
+    : m_clock(clock)
+    , m_edgeSink(std::move(edgeSink))
+    , m_edgeCount(0)
+    , m_stats()
+{
+}
+
+bool ReplayI2C::load(const std::string& path, std::string& error)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = path + ": cannot open";
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (data.size() < HEADER_SIZE || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        error = path + ": not an I2C trace";
+        return false;
+    }
+    if (data[4] != I2CTraceWriter::VERSION) {
+        error = path + ": unsupported trace version " + std::to_string(data[4]);
+        return false;
+    }
+
+    std::vector<Record> records;
+    std::map<uint8_t, Device> devices;
+    size_t edgeCount = 0;
+
+    // Last transaction overall and per device, for anchoring edges
+    const size_t NONE = static_cast<size_t>(-1);
+    size_t lastTransaction = NONE;
+    std::map<uint8_t, size_t> lastByDevice;
+
+    TraceReader reader(data, HEADER_SIZE);
+    int64_t timeUs = 0;
+
+    while (!reader.atEnd()) {
+        size_t start = reader.offset();
+        Record record{};
+        int64_t delta = 0;
+        bool ok = reader.byte(record.type) && reader.signedVarint(delta);
+        timeUs += delta;
+        record.timeUs = timeUs;
+
+        if (ok && record.type == RECORD_TRANSACTION) {
+            uint64_t duration = 0;
+            uint8_t result = 0, count = 0;
+            ok = reader.varint(duration) && reader.byte(result) && reader.byte(count) && count > 0;
+            record.durationUs = static_cast<uint32_t>(duration);
+            record.ok = result != 0;
+
+            for (uint8_t i = 0; ok && i < count; i++) {
+                Message message{};
+                uint64_t length = 0;
+                ok = reader.byte(message.address) && reader.byte(message.flags) &&
+                     reader.varint(length) && length <= 0xFFFF &&
+                     reader.bytes(message.data, static_cast<size_t>(length));
+                record.messages.push_back(std::move(message));
+            }
+        } else if (ok && record.type == RECORD_EDGE) {
+            uint8_t pin = 0;
+            ok = reader.byte(pin);
+            record.pin = pin;
+        } else if (ok) {
+            error = path + ": unknown record type at offset " + std::to_string(start);
+            return false;
+        }
+
+        if (!ok) {
+            error = path + ": truncated record at offset " + std::to_string(start);
+            return false;
+        }
+
+        size_t index = records.size();
+        if (record.type == RECORD_TRANSACTION) {
+            uint8_t address = record.messages[0].address;
+            devices[address].transactions.push_back(index);
+            lastByDevice[address] = index;
+            lastTransaction = index;
+        } else {
+            auto source = m_edgeSources.find(record.pin);
+            size_t anchor = lastTransaction;
+            if (source != m_edgeSources.end()) {
+                auto last = lastByDevice.find(source->second);
+                anchor = (last != lastByDevice.end()) ? last->second : NONE;
+            }
+            // An edge before any transaction of its device has nothing to follow
+            if (anchor != NONE) {
+                records[anchor].edges.push_back(index);
+                edgeCount++;
+            }
+        }
+        records.push_back(std::move(record));
+    }
+
+    m_records = std::move(records);
+    m_devices = std::move(devices);
+    m_edgeCount = edgeCount;
+    m_stats = Stats();
+    return true;
+}
+
+bool ReplayI2C::initialize(int busNumber)
+{
+    std::cout << "[Replay] I2C bus " << busNumber << ": " << getStats().remaining << " transactions to "
+              << m_devices.size() << " devices, " << m_edgeCount << " edges" << std::endl;
+    return true;
+}
+
+void ReplayI2C::cleanup()
+{
+    Stats stats = getStats();
+    std::cout << "[Replay] " << stats.replayed << " transactions replayed (" << stats.repeated
+              << " repeated, " << stats.mismatched << " mismatched), " << stats.exhausted
+              << " past the end of the trace, " << stats.remaining << " left" << std::endl;
+}
+
+bool ReplayI2C::transfer(I2CMessage* messages, size_t count)
+{
+    auto it = (count > 0) ? m_devices.find(messages[0].address) : m_devices.end();
+    if (it == m_devices.end()) {
+        m_stats.mismatched++;
+        return false;
+    }
+
+    Device& device = it->second;
+    bool hasNext = device.next < device.transactions.size();
+    const Record* record = nullptr;
+    bool advance = false;
+
+    if (hasNext && matches(m_records[device.transactions[device.next]], messages, count)) {
+        advance = true;
+    } else if (device.next > 0 && matches(m_records[device.transactions[device.next - 1]], messages, count)) {
+        record = &m_records[device.transactions[device.next - 1]];
+        m_stats.repeated++;
+    } else if (hasNext) {
+        advance = true;
+        if (m_stats.mismatched++ == 0) {
+            std::cerr << "[Replay] Transaction " << m_stats.replayed
+                      << " differs from the recording" << std::endl;
+        }
+    } else {
+        if (m_stats.exhausted++ == 0) {
+            std::cerr << "[Replay] End of trace for device 0x" << std::hex << static_cast<int>(it->first)
+                      << std::dec << ", further transfers fail" << std::endl;
+        }
+        return false;
+    }
+
+    if (advance) {
+        record = &m_records[device.transactions[device.next++]];
+    }
+    m_stats.replayed++;
+
+    // Read data only where the request has the recorded shape
+    for (size_t i = 0; i < std::min(count, record->messages.size()); i++) {
+        const Message& recorded = record->messages[i];
+        if ((recorded.flags & I2CMessage::READ) && messages[i].isRead()) {
+            std::copy_n(recorded.data.begin(), std::min<size_t>(recorded.data.size(), messages[i].length),
+                        messages[i].buffer);
+        }
+    }
+
+    m_clock.sleepFor(std::chrono::microseconds(record->durationUs));
+    if (advance) {
+        raiseEdges(*record, m_clock.now());
+    }
+    return record->ok;
+}
+
+bool ReplayI2C::matches(const Record& record, const I2CMessage* messages, size_t count) const
+{
+    if (record.messages.size() != count) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        const Message& recorded = record.messages[i];
+        bool read = (recorded.flags & I2CMessage::READ) != 0;
+        if (recorded.address != messages[i].address || read != messages[i].isRead() ||
+            recorded.data.size() != messages[i].length ||
+            (!read && !std::equal(recorded.data.begin(), recorded.data.end(), messages[i].buffer))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ReplayI2C::raiseEdges(const Record& record, Clock::TimePoint replayedEnd)
+{
+    int64_t recordedEndUs = record.timeUs + record.durationUs;
+    for (size_t index : record.edges) {
+        const Record& edge = m_records[index];
+        if (m_edgeSink) {
+            m_edgeSink(edge.pin, replayedEnd + std::chrono::microseconds(edge.timeUs - recordedEndUs));
+        }
+        m_stats.edges++;
+    }
+}
+
+ReplayI2C::Stats ReplayI2C::getStats() const
+{
+    Stats stats = m_stats;
+    stats.remaining = 0;
+    for (const auto& entry : m_devices) {
+        stats.remaining += entry.second.transactions.size() - entry.second.next;
+    }
+    return stats;
+}
+
+bool ReplayI2C::finished() const
+{
+    return getStats().remaining == 0;
+}
+
+} // namespace HAL
@@ -0,0 +1,196 @@
+#include "JsonWriter.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    const char HEX_DIGITS[] = "0123456789abcdef";
+
+    const int64_t POW10[] = {
+        1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL
+    };
+    constexpr int MAX_FAST_DECIMALS = 8;
+
+    // Largest magnitude whose scaled value still fits the integer fast path
+    constexpr double FAST_PATH_LIMIT = 9.0e15;
+
+    // Writes digits of value right-aligned ending at `end`, returns start
+    inline char* formatUnsigned(uint64_t value, char* end)
+    {
+        char* p = end;
+        do {
+            *--p = static_cast<char>('0' + (value % 10));
+            value /= 10;
+        } while (value != 0);
+        return p;
+    }
+}
+
+//==============================================================================
+// Formatting Primitives
+//==============================================================================
+
+void JsonWriter::appendEscaped(std::string& out, const char* str, size_t length)
+{
+    out.push_back('"');
+
+    // Copy runs of characters that need no escaping in one append
+    size_t runStart = 0;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = static_cast<unsigned char>(str[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        out.append(str + runStart, i - runStart);
+        runStart = i + 1;
+
+        switch (c) {
+            case '"':  out.append("\\\"", 2); break;
+            case '\\': out.append("\\\\", 2); break;
+            case '\b': out.append("\\b", 2); break;
+            case '\f': out.append("\\f", 2); break;
+            case '\n': out.append("\\n", 2); break;
+            case '\r': out.append("\\r", 2); break;
+            case '\t': out.append("\\t", 2); break;
+            default: {
+                char escape[6] = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0x0F]};
+                out.append(escape, sizeof(escape));
+                break;
+            }
+        }
+    }
+    out.append(str + runStart, length - runStart);
+
+    out.push_back('"');
+}
+
+void JsonWriter::appendInt(std::string& out, int64_t number)
+{
+    char buffer[24];
+    char* end = buffer + sizeof(buffer);
+
+    uint64_t magnitude = (number < 0) ? (0 - static_cast<uint64_t>(number)) : static_cast<uint64_t>(number);
+    char* start = formatUnsigned(magnitude, end);
+    if (number < 0) {
+        *--start = '-';
+    }
+    out.append(start, static_cast<size_t>(end - start));
+}
+
+void JsonWriter::appendFixed(std::string& out, double number, int decimals)
+{
+    if (!std::isfinite(number)) {
+        out.append("null", 4);
+        return;
+    }
+
+    if (decimals < 0) decimals = 0;
+
+    if (decimals > MAX_FAST_DECIMALS || std::fabs(number) * POW10[decimals] >= FAST_PATH_LIMIT) {
+        // Out of fast-path range: fall back to printf into a stack buffer
+        char buffer[64];
+        int n = std::snprintf(buffer, sizeof(buffer), "%.*f", decimals, number);
+        if (n > 0) {
+            out.append(buffer, static_cast<size_t>(n < static_cast<int>(sizeof(buffer)) ? n : sizeof(buffer) - 1));
+        }
+        return;
+    }
+
+    // Round once to an integer count of 10^-decimals units
+    bool negative = number < 0;
+    uint64_t scaled = static_cast<uint64_t>(std::fabs(number) * POW10[decimals] + 0.5);
+    uint64_t integerPart = scaled / static_cast<uint64_t>(POW10[decimals]);
+    uint64_t fraction = scaled % static_cast<uint64_t>(POW10[decimals]);
+
+    char buffer[40];
+    char* end = buffer + sizeof(buffer);
+    char* start = end;
+
+    if (decimals > 0) {
+        for (int i = 0; i < decimals; i++) {
+            *--start = static_cast<char>('0' + (fraction % 10));
+            fraction /= 10;
+        }
+        *--start = '.';
+    }
+    start = formatUnsigned(integerPart, start);
+    if (negative && scaled != 0) {
+        *--start = '-';
+    }
+    out.append(start, static_cast<size_t>(end - start));
+}
+
+//==============================================================================
+// Writer
+//==============================================================================
+
+JsonWriter& JsonWriter::key(const char* name)
+{
+    separator();
+    appendEscaped(m_out, name, std::strlen(name));
+    m_out.push_back(':');
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const char* str, size_t length)
+{
+    separator();
+    appendEscaped(m_out, str, length);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const char* str)
+{
+    return value(str, std::strlen(str));
+}
+
+JsonWriter& JsonWriter::field(const char* name, const char* str)
+{
+    key(name);
+    return value(str);
+}
+
+JsonWriter& JsonWriter::value(int64_t number)
+{
+    separator();
+    if (m_style == NumberStyle::QUOTED) {
+        m_out.push_back('"');
+        appendInt(m_out, number);
+        m_out.push_back('"');
+    } else {
+        appendInt(m_out, number);
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double number, int decimals)
+{
+    separator();
+    if (m_style == NumberStyle::QUOTED && std::isfinite(number)) {
+        m_out.push_back('"');
+        appendFixed(m_out, number, decimals);
+        m_out.push_back('"');
+    } else {
+        appendFixed(m_out, number, decimals);
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool flag)
+{
+    separator();
+    if (flag) {
+        m_out.append("true", 4);
+    } else {
+        m_out.append("false", 5);
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::null()
+{
+    separator();
+    m_out.append("null", 4);
+    return *this;
+}
@@ -0,0 +1,295 @@
+#include "LinuxHAL.h"
+
+#ifdef __linux__
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <unistd.h>
+
+#include "Config.h"
+#include "I2CTrace.h"
+#include "SensorBus.h"
+
+namespace HAL {
+
+namespace {
+    const char* GPIO_ROOT = "/sys/class/gpio";
+
+    // Interrupt threads recheck their stop flag this often (ms)
+    constexpr int WATCH_POLL_TIMEOUT_MS = 100;
+
+    std::string pinPath(int pin, const char* attribute) {
+        return std::string(GPIO_ROOT) + "/gpio" + std::to_string(pin) + "/" + attribute;
+    }
+
+    bool writeFile(const std::string& path, const std::string& value) {
+        int fd = ::open(path.c_str(), O_WRONLY);
+        if (fd < 0) {
+            return false;
+        }
+        bool ok = ::write(fd, value.data(), value.size()) == static_cast<ssize_t>(value.size());
+        ::close(fd);
+        return ok;
+    }
+}
+
+//==============================================================================
+// LinuxI2C
+//==============================================================================
+
+LinuxI2C::LinuxI2C()
+    : m_fd(-1)
+{
+}
+
+LinuxI2C::~LinuxI2C()
+{
+    cleanup();
+}
+
+bool LinuxI2C::initialize(int busNumber)
+{
+    m_path = "/dev/i2c-" + std::to_string(busNumber);
+    m_fd = ::open(m_path.c_str(), O_RDWR);
+    if (m_fd < 0) {
+        std::cerr << "[I2C] Cannot open " << m_path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    unsigned long funcs = 0;
+    if (::ioctl(m_fd, I2C_FUNCS, &funcs) < 0 || !(funcs & I2C_FUNC_I2C)) {
+        std::cerr << "[I2C] " << m_path << " does not support combined transfers (I2C_RDWR)" << std::endl;
+        cleanup();
+        return false;
+    }
+
+    std::cout << "[I2C] " << m_path << " opened" << std::endl;
+    return true;
+}
+
+void LinuxI2C::cleanup()
+{
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool LinuxI2C::isDevicePresent(uint8_t deviceAddr)
+{
+    // Address-only write: the device ACKs its address or the ioctl fails
+    uint8_t none = 0;
+    I2CMessage probe = I2CMessage::write(deviceAddr, &none, 0);
+    return transfer(&probe, 1);
+}
+
+//==============================================================================
+// LinuxGPIO
+//==============================================================================
+
+LinuxGPIO::LinuxGPIO()
+{
+}
+
+LinuxGPIO::~LinuxGPIO()
+{
+    cleanup();
+}
+
+bool LinuxGPIO::initialize()
+{
+    if (::access((std::string(GPIO_ROOT) + "/export").c_str(), W_OK) != 0) {
+        std::cerr << "[GPIO] " << GPIO_ROOT << " is not writable" << std::endl;
+        return false;
+    }
+    std::cout << "[GPIO] sysfs GPIO initialized" << std::endl;
+    return true;
+}
+
+void LinuxGPIO::cleanup()
+{
+    while (!m_watchers.empty()) {
+        stopWatcher(m_watchers.begin()->first);
+    }
+    for (int pin : m_exported) {
+        writeFile(std::string(GPIO_ROOT) + "/unexport", std::to_string(pin));
+    }
+    m_exported.clear();
+}
+
+bool LinuxGPIO::exportPin(int pin)
+{
+    if (::access(pinPath(pin, "value").c_str(), F_OK) == 0) {
+        return true;
+    }
+    if (!writeFile(std::string(GPIO_ROOT) + "/export", std::to_string(pin))) {
+        std::cerr << "[GPIO] Cannot export pin " << pin << std::endl;
+        return false;
+    }
+    m_exported.insert(pin);
+
+    // udev may still be fixing the permissions of the new attributes
+    for (int i = 0; i < 20 && ::access(pinPath(pin, "direction").c_str(), W_OK) != 0; i++) {
+        ::usleep(5000);
+    }
+    return true;
+}
+
+bool LinuxGPIO::writeAttribute(int pin, const char* attribute, const std::string& value)
+{
+    return exportPin(pin) && writeFile(pinPath(pin, attribute), value);
+}
+
+bool LinuxGPIO::setDirection(int pin, Direction dir)
+{
+    return writeAttribute(pin, "direction", dir == Direction::OUTPUT ? "out" : "in");
+}
+
+bool LinuxGPIO::setPullMode(int /*pin*/, PullMode mode)
+{
+    // sysfs has no pull control; the board's own resistors apply
+    return mode == PullMode::NONE;
+}
+
+bool LinuxGPIO::write(int pin, bool value)
+{
+    return writeAttribute(pin, "value", value ? "1" : "0");
+}
+
+bool LinuxGPIO::read(int pin)
+{
+    if (!exportPin(pin)) {
+        return false;
+    }
+    int fd = ::open(pinPath(pin, "value").c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    char value = '0';
+    bool ok = ::read(fd, &value, 1) == 1;
+    ::close(fd);
+    return ok && value == '1';
+}
+
+bool LinuxGPIO::setPWM(int /*pin*/, int /*frequency*/, int /*dutyCycle*/)
+{
+    return false;
+}
+
+bool LinuxGPIO::stopPWM(int /*pin*/)
+{
+    return false;
+}
+
+bool LinuxGPIO::setInterrupt(int pin, Edge edge, void (*callback)(int, void*), void* userData)
+{
+    stopWatcher(pin);
+    if (edge == Edge::NONE || !callback) {
+        return m_exported.count(pin) == 0 || writeAttribute(pin, "edge", "none");
+    }
+
+    const char* edgeName = (edge == Edge::RISING) ? "rising" : (edge == Edge::FALLING) ? "falling" : "both";
+    if (!writeAttribute(pin, "direction", "in") || !writeAttribute(pin, "edge", edgeName)) {
+        return false;
+    }
+
+    int fd = ::open(pinPath(pin, "value").c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    // Consume the current state so only later edges report POLLPRI
+    char value;
+    if (::read(fd, &value, 1) < 0) {
+        ::close(fd);
+        return false;
+    }
+
+    std::unique_ptr<Watcher> watcher(new Watcher);
+    watcher->fd = fd;
+    watcher->running = true;
+    watcher->thread = std::thread(&LinuxGPIO::watch, watcher.get(), pin, callback, userData);
+    m_watchers[pin] = std::move(watcher);
+    return true;
+}
+
+void LinuxGPIO::stopWatcher(int pin)
+{
+    auto it = m_watchers.find(pin);
+    if (it == m_watchers.end()) {
+        return;
+    }
+    it->second->running = false;
+    it->second->thread.join();
+    ::close(it->second->fd);
+    m_watchers.erase(it);
+}
+
+void LinuxGPIO::watch(Watcher* watcher, int pin, void (*callback)(int, void*), void* userData)
+{
+    struct pollfd pfd;
+    pfd.fd = watcher->fd;
+    pfd.events = POLLPRI | POLLERR;
+
+    while (watcher->running) {
+        pfd.revents = 0;
+        int ready = ::poll(&pfd, 1, WATCH_POLL_TIMEOUT_MS);
+        if (ready <= 0 || !(pfd.revents & POLLPRI)) {
+            continue;
+        }
+
+        // Reading the value re-arms POLLPRI; a pin that cannot be read
+        // would report the same edge forever
+        char value;
+        ::lseek(watcher->fd, 0, SEEK_SET);
+        if (::read(watcher->fd, &value, 1) < 0) {
+            std::cerr << "[GPIO] Pin " << pin << " value unreadable, edge watch stopped" << std::endl;
+            break;
+        }
+        if (watcher->running) {
+            callback(pin, userData);
+        }
+    }
+}
+
+#ifdef PLATFORM_RPI
+
+//==============================================================================
+// Factory functions
+//==============================================================================
+
+I2CInterface* createI2CInterface(Clock& clock)
+{
+    return traceI2C(new LinuxI2C(), Config::Hardware::getI2CTraceFile(), clock);
+}
+
+GPIOInterface* createGPIOInterface(Clock& clock)
+{
+#ifdef THE3_STATIC_HAL
+    // The bus cannot be traced, and a GPIO-only trace would not replay
+    (void)clock;
+    return new LinuxGPIO();
+#else
+    return traceGPIO(new LinuxGPIO(), Config::Hardware::getI2CTraceFile(), clock);
+#endif
+}
+
+bool isSimulationMode() { return false; }
+
+#ifdef THE3_STATIC_HAL
+PlatformBus* createPlatformBus(Clock& /*clock*/)
+{
+    if (!Config::Hardware::getI2CTraceFile().empty()) {
+        std::cerr << "[I2C] THE3_I2C_TRACE needs a build without THE3_STATIC_HAL, not recording I2C or GPIO" << std::endl;
+    }
+    return new LinuxI2C();
+}
+#endif
+
+#endif // PLATFORM_RPI
+
+} // namespace HAL
+
+#endif // __linux__
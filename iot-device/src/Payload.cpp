@@ -0,0 +1,180 @@
+#include "Payload.h"
+#include "SensorSchema.h"
+
+namespace Payload {
+
+//==============================================================================
+// JSON
+//==============================================================================
+
+void appendSkinAnalysisJson(std::string& out,
+                            const SkinSensor::SensorData& data,
+                            const std::string& deviceId,
+                            JsonWriter::NumberStyle style)
+{
+    JsonWriter json(out, style);
+    json.beginObject().field("deviceId", deviceId);
+    Schema::appendJsonFields(json, data, Schema::sensorFields());
+    json.endObject();
+}
+
+void appendTreatmentJson(std::string& out,
+                         const SkinSensor::TreatmentData& data,
+                         const std::string& deviceId,
+                         JsonWriter::NumberStyle style)
+{
+    JsonWriter json(out, style);
+    json.beginObject().field("deviceId", deviceId);
+    Schema::appendJsonFields(json, data, Schema::treatmentCommonFields());
+
+    Schema::visitTreatmentMode(data.mode, [&](const char* code, const auto& fields) {
+        json.field("treatmentType", code);
+        Schema::appendJsonFields(json, data, fields);
+    });
+
+    json.endObject();
+}
+
+void appendWindowSummaryJson(std::string& out,
+                             const WindowAggregator::Summary& summary,
+                             const std::string& deviceId,
+                             JsonWriter::NumberStyle style)
+{
+    static const char* const QUANTILE_NAMES[WindowAggregator::QUANTILES] = { "p10", "p50", "p90" };
+
+    JsonWriter json(out, style);
+    json.beginObject()
+        .field("deviceId", deviceId)
+        .field("recordType", "summary")
+        .field("patientName", summary.patientName)
+        .field("birthDate", summary.birthDate)
+        .field("windowStart", static_cast<int64_t>(summary.windowStart))
+        .field("windowEnd", static_cast<int64_t>(summary.windowEnd))
+        .field("first", static_cast<int64_t>(summary.first))
+        .field("last", static_cast<int64_t>(summary.last))
+        .field("samples", static_cast<int64_t>(summary.samples));
+
+    for (const auto& channel : summary.channels) {
+        json.key(channel.name).beginObject()
+            .field("min", static_cast<double>(channel.min))
+            .field("max", static_cast<double>(channel.max))
+            .field("mean", channel.mean)
+            .field("stddev", channel.stddev);
+        for (size_t q = 0; q < WindowAggregator::QUANTILES; q++) {
+            json.field(QUANTILE_NAMES[q], channel.quantiles[q]);
+        }
+        json.endObject();
+    }
+
+    for (const auto& category : summary.categories) {
+        json.key(category.name).beginObject();
+        for (const auto& count : category.counts) {
+            json.field(count.value.c_str(), static_cast<int64_t>(count.count));
+        }
+        json.endObject();
+    }
+
+    json.endObject();
+}
+
+std::string buildSkinAnalysisJson(const SkinSensor::SensorData& data, const std::string& deviceId)
+{
+    std::string out;
+    out.reserve(512);
+    appendSkinAnalysisJson(out, data, deviceId);
+    return out;
+}
+
+std::string buildTreatmentJson(const SkinSensor::TreatmentData& data, const std::string& deviceId)
+{
+    std::string out;
+    out.reserve(256);
+    appendTreatmentJson(out, data, deviceId);
+    return out;
+}
+
+//==============================================================================
+// Binary
+//==============================================================================
+
+void appendSkinAnalysisBinary(std::string& out, const SkinSensor::SensorData& data)
+{
+    Schema::appendBinary(out, data, Schema::sensorFields());
+}
+
+void appendTreatmentBinary(std::string& out, const SkinSensor::TreatmentData& data)
+{
+    out.push_back(static_cast<char>(data.mode));
+    Schema::appendBinary(out, data, Schema::treatmentCommonFields());
+    Schema::visitTreatmentMode(data.mode, [&](const char*, const auto& fields) {
+        Schema::appendBinary(out, data, fields);
+    });
+}
+
+bool readSkinAnalysisBinary(const uint8_t* data, size_t length, SkinSensor::SensorData& out)
+{
+    const uint8_t* p = data;
+    return Schema::readBinary(p, data + length, out, Schema::sensorFields());
+}
+
+bool readTreatmentBinary(const uint8_t* data, size_t length, SkinSensor::TreatmentData& out)
+{
+    if (length < 1) {
+        return false;
+    }
+
+    const uint8_t* p = data + 1;
+    const uint8_t* end = data + length;
+    out.mode = static_cast<SkinSensor::TreatmentMode>(data[0]);
+
+    if (!Schema::readBinary(p, end, out, Schema::treatmentCommonFields())) {
+        return false;
+    }
+
+    bool ok = false;
+    bool known = Schema::visitTreatmentMode(out.mode, [&](const char*, const auto& fields) {
+        ok = Schema::readBinary(p, end, out, fields);
+    });
+    return known && ok;
+}
+
+//==============================================================================
+// CSV
+//==============================================================================
+
+void appendSkinAnalysisCsvHeader(std::string& out)
+{
+    bool first = true;
+    Schema::appendCsvHeader(out, Schema::sensorFields(), first);
+}
+
+void appendSkinAnalysisCsvRow(std::string& out, const SkinSensor::SensorData& data)
+{
+    bool first = true;
+    Schema::appendCsvRow(out, data, Schema::sensorFields(), first);
+}
+
+void appendTreatmentCsvHeader(std::string& out, SkinSensor::TreatmentMode mode)
+{
+    out.append("treatmentType");
+    bool first = false;
+    Schema::appendCsvHeader(out, Schema::treatmentCommonFields(), first);
+    Schema::visitTreatmentMode(mode, [&](const char*, const auto& fields) {
+        Schema::appendCsvHeader(out, fields, first);
+    });
+}
+
+void appendTreatmentCsvRow(std::string& out, const SkinSensor::TreatmentData& data)
+{
+    bool first = true;
+    Schema::visitTreatmentMode(data.mode, [&](const char* code, const auto&) {
+        out.append(code);
+        first = false;
+    });
+    Schema::appendCsvRow(out, data, Schema::treatmentCommonFields(), first);
+    Schema::visitTreatmentMode(data.mode, [&](const char*, const auto& fields) {
+        Schema::appendCsvRow(out, data, fields, first);
+    });
+}
+
+} // namespace Payload
@@ -0,0 +1,388 @@
+#include "PersistentQueue.h"
+#include "Crc.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+    constexpr uint32_t QUEUE_MAGIC = 0x51483330;    // "TH0Q"
+    constexpr uint16_t QUEUE_VERSION = 1;
+    constexpr size_t HEADER_SIZE = 4096;            // Ring starts on its own page
+    constexpr size_t FRAME_ALIGN = 8;
+
+    constexpr uint16_t FLAG_DATA = 0xDA7A;
+    constexpr uint16_t FLAG_PAD  = 0xFAD0;
+
+    inline size_t alignUp(size_t value)
+    {
+        return (value + FRAME_ALIGN - 1) & ~(FRAME_ALIGN - 1);
+    }
+}
+
+struct PersistentQueue::Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint64_t capacity;
+    uint64_t head;          // Logical offset of the oldest frame
+    uint64_t tail;          // Logical offset one past the newest published frame
+};
+
+struct PersistentQueue::Frame {
+    uint32_t length;        // Payload bytes (PAD: bytes skipped after the frame)
+    uint16_t crc;           // CRC16-CCITT of the payload
+    uint16_t flags;         // FLAG_DATA or FLAG_PAD
+};
+
+PersistentQueue::PersistentQueue()
+    : m_fd(-1)
+    , m_base(nullptr)
+    , m_mappedSize(0)
+    , m_capacity(0)
+    , m_reservedAt(0)
+    , m_reservedLength(0)
+    , m_reserved(false)
+    , m_records(0)
+    , m_stats()
+{
+}
+
+PersistentQueue::~PersistentQueue()
+{
+    close();
+}
+
+//==============================================================================
+// File Mapping
+//==============================================================================
+
+bool PersistentQueue::open(const std::string& path, size_t capacityBytes)
+{
+    close();
+
+#ifdef _WIN32
+    (void)path;
+    (void)capacityBytes;
+    std::cerr << "[PersistentQueue] Memory-mapped queue is not supported on this platform" << std::endl;
+    return false;
+#else
+    m_capacity = alignUp(capacityBytes);
+    if (m_capacity < 4 * 64) {
+        std::cerr << "[PersistentQueue] Capacity too small: " << capacityBytes << std::endl;
+        return false;
+    }
+    m_mappedSize = HEADER_SIZE + m_capacity;
+
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (m_fd < 0) {
+        std::cerr << "[PersistentQueue] Cannot open " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    bool fresh = (fstat(m_fd, &st) != 0) || static_cast<size_t>(st.st_size) != m_mappedSize;
+    if (fresh && ftruncate(m_fd, static_cast<off_t>(m_mappedSize)) != 0) {
+        std::cerr << "[PersistentQueue] Cannot size " << path << ": " << std::strerror(errno) << std::endl;
+        ::close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, m_mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "[PersistentQueue] mmap failed: " << std::strerror(errno) << std::endl;
+        ::close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+    m_base = static_cast<uint8_t*>(mapping);
+
+    Header* h = header();
+    if (fresh || h->magic != QUEUE_MAGIC || h->version != QUEUE_VERSION || h->capacity != m_capacity) {
+        initializeHeader();
+    }
+
+    m_stats = Stats();
+    recover();
+    return true;
+#endif
+}
+
+void PersistentQueue::close()
+{
+#ifndef _WIN32
+    if (m_base) {
+        msync(m_base, m_mappedSize, MS_ASYNC);
+        munmap(m_base, m_mappedSize);
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+#endif
+    m_base = nullptr;
+    m_fd = -1;
+    m_reserved = false;
+    m_records = 0;
+}
+
+void PersistentQueue::sync(bool wait)
+{
+#ifndef _WIN32
+    if (m_base) {
+        msync(m_base, m_mappedSize, wait ? MS_SYNC : MS_ASYNC);
+    }
+#else
+    (void)wait;
+#endif
+}
+
+//==============================================================================
+// Ring Helpers
+//==============================================================================
+
+PersistentQueue::Header* PersistentQueue::header() const
+{
+    return reinterpret_cast<Header*>(m_base);
+}
+
+uint8_t* PersistentQueue::ring() const
+{
+    return m_base + HEADER_SIZE;
+}
+
+size_t PersistentQueue::physical(uint64_t offset) const
+{
+    return static_cast<size_t>(offset % m_capacity);
+}
+
+PersistentQueue::Frame* PersistentQueue::frameAt(uint64_t offset) const
+{
+    return reinterpret_cast<Frame*>(ring() + physical(offset));
+}
+
+size_t PersistentQueue::frameSpan(const Frame* frame) const
+{
+    if (frame->flags == FLAG_PAD) {
+        return sizeof(Frame) + frame->length;
+    }
+    return alignUp(sizeof(Frame) + frame->length);
+}
+
+void PersistentQueue::initializeHeader()
+{
+    Header* h = header();
+    h->magic = QUEUE_MAGIC;
+    h->version = QUEUE_VERSION;
+    h->reserved = 0;
+    h->capacity = m_capacity;
+    h->head = 0;
+    h->tail = 0;
+}
+
+void PersistentQueue::recover()
+{
+    Header* h = header();
+    m_records = 0;
+
+    if (h->tail < h->head || h->tail - h->head > m_capacity ||
+        (h->head % FRAME_ALIGN) != 0 || (h->tail % FRAME_ALIGN) != 0) {
+        std::cerr << "[PersistentQueue] Inconsistent head/tail, resetting queue" << std::endl;
+        initializeHeader();
+        return;
+    }
+
+    // Walk every published frame; truncate at the first one that does not validate
+    uint64_t pos = h->head;
+    while (pos < h->tail) {
+        const Frame* frame = frameAt(pos);
+        size_t contiguous = m_capacity - physical(pos);
+
+        bool valid = (frame->flags == FLAG_DATA || frame->flags == FLAG_PAD) &&
+                     sizeof(Frame) + frame->length <= contiguous &&
+                     pos + frameSpan(frame) <= h->tail;
+
+        if (valid && frame->flags == FLAG_DATA) {
+            const uint8_t* payload = reinterpret_cast<const uint8_t*>(frame + 1);
+            valid = Crc16::compute(payload, frame->length) == frame->crc;
+            if (valid) {
+                m_records++;
+            }
+        }
+
+        if (!valid) {
+            m_stats.corrupt++;
+            h->tail = pos;
+            std::cerr << "[PersistentQueue] Truncated at corrupt record (offset " << pos << ")" << std::endl;
+            break;
+        }
+        pos += frameSpan(frame);
+    }
+}
+
+bool PersistentQueue::dropOldest()
+{
+    Header* h = header();
+    if (h->head == h->tail) {
+        return false;
+    }
+
+    const Frame* frame = frameAt(h->head);
+    if (frame->flags == FLAG_DATA) {
+        m_records--;
+        m_stats.dropped++;
+    }
+    h->head += frameSpan(frame);
+    return true;
+}
+
+//==============================================================================
+// Producer
+//==============================================================================
+
+uint8_t* PersistentQueue::reserve(size_t length)
+{
+    if (!m_base) {
+        return nullptr;
+    }
+
+    size_t span = alignUp(sizeof(Frame) + length);
+    if (span > m_capacity / 4) {
+        return nullptr;
+    }
+
+    Header* h = header();
+    size_t contiguous = m_capacity - physical(h->tail);
+    size_t padding = (contiguous < span) ? contiguous : 0;
+
+    // Make room by discarding the oldest records
+    while (h->tail + padding + span - h->head > m_capacity) {
+        if (!dropOldest()) {
+            break;
+        }
+    }
+
+    if (padding > 0) {
+        // Records never wrap: skip the tail end of the ring with a pad frame
+        Frame* pad = frameAt(h->tail);
+        pad->length = static_cast<uint32_t>(padding - sizeof(Frame));
+        pad->crc = 0;
+        pad->flags = FLAG_PAD;
+        std::atomic_thread_fence(std::memory_order_release);
+        h->tail += padding;
+    }
+
+    m_reservedAt = h->tail;
+    m_reservedLength = length;
+    m_reserved = true;
+
+    return reinterpret_cast<uint8_t*>(frameAt(m_reservedAt) + 1);
+}
+
+bool PersistentQueue::commit(size_t length)
+{
+    if (!m_base || !m_reserved || length > m_reservedLength) {
+        return false;
+    }
+
+    Frame* frame = frameAt(m_reservedAt);
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>(frame + 1);
+    frame->length = static_cast<uint32_t>(length);
+    frame->crc = Crc16::compute(payload, length);
+    frame->flags = FLAG_DATA;
+
+    // Payload and frame must land before the tail that publishes them
+    std::atomic_thread_fence(std::memory_order_release);
+    header()->tail = m_reservedAt + alignUp(sizeof(Frame) + length);
+
+    m_reserved = false;
+    m_records++;
+    m_stats.appended++;
+    return true;
+}
+
+bool PersistentQueue::append(const void* data, size_t length)
+{
+    uint8_t* dest = reserve(length);
+    if (!dest) {
+        return false;
+    }
+    std::memcpy(dest, data, length);
+    return commit(length);
+}
+
+//==============================================================================
+// Consumer
+//==============================================================================
+
+bool PersistentQueue::peek(const uint8_t*& data, size_t& length)
+{
+    if (!m_base) {
+        return false;
+    }
+
+    Header* h = header();
+    while (h->head != h->tail) {
+        const Frame* frame = frameAt(h->head);
+
+        if (frame->flags == FLAG_DATA) {
+            const uint8_t* payload = reinterpret_cast<const uint8_t*>(frame + 1);
+            if (Crc16::compute(payload, frame->length) == frame->crc) {
+                data = payload;
+                length = frame->length;
+                return true;
+            }
+            // Damaged after open (e.g. media error): skip it
+            m_stats.corrupt++;
+            m_records--;
+        } else if (frame->flags != FLAG_PAD) {
+            // Unreadable frame chain: nothing after it can be trusted
+            m_stats.corrupt += m_records;
+            m_records = 0;
+            h->head = h->tail;
+            return false;
+        }
+        h->head += frameSpan(frame);
+    }
+    return false;
+}
+
+void PersistentQueue::pop()
+{
+    if (!m_base) {
+        return;
+    }
+
+    Header* h = header();
+    while (h->head != h->tail) {
+        const Frame* frame = frameAt(h->head);
+        h->head += frameSpan(frame);
+
+        if (frame->flags == FLAG_DATA) {
+            m_records--;
+            m_stats.consumed++;
+            return;
+        }
+    }
+}
+
+bool PersistentQueue::empty() const
+{
+    return !m_base || m_records == 0;
+}
+
+PersistentQueue::Stats PersistentQueue::getStats() const
+{
+    Stats stats = m_stats;
+    stats.records = m_records;
+    stats.capacity = m_capacity;
+    stats.bytesUsed = m_base ? static_cast<size_t>(header()->tail - header()->head) : 0;
+    return stats;
+}
@@ -0,0 +1,220 @@
+#include "RetryPolicy.h"
+#include "Config.h"
+#include <algorithm>
+
+//==============================================================================
+// RetryPolicy
+//==============================================================================
+
+RetryPolicy::RetryPolicy()
+    : m_maxRetries(Config::MAX_RETRY_COUNT)
+    , m_baseDelay(Config::RETRY_INTERVAL_MS)
+    , m_maxDelay(Config::RETRY_MAX_INTERVAL_MS)
+    , m_budgetTokens(Config::RETRY_BUDGET_MAX_TOKENS)
+    , m_rng(std::random_device{}())
+{
+    // Transient server/proxy conditions
+    m_defaultRule.retryableStatuses = {408, 429, 500, 502, 503, 504};
+    m_defaultRule.retryTransportErrors = true;
+    m_defaultRule.retryAfterSend = true;
+
+    // Measurement, treatment and telemetry batch POSTs insert rows per request;
+    // a 500 or a reply that never came may mean they were stored already, so
+    // only retry when the request was not processed
+    EndpointRule insertRule;
+    insertRule.retryableStatuses = {429, 502, 503, 504};
+    insertRule.retryTransportErrors = true;
+    insertRule.retryAfterSend = false;
+    m_rules[Config::API_ENDPOINT_SKIN] = insertRule;
+    m_rules[Config::API_ENDPOINT_TREATMENT] = insertRule;
+    m_rules[Config::API_ENDPOINT_TELEMETRY] = insertRule;
+    m_rules[Config::API_ENDPOINT_TELEMETRY_SUMMARY] = insertRule;
+
+    // Health probes report state; retrying them only delays the answer
+    EndpointRule probeRule;
+    probeRule.retryTransportErrors = false;
+    probeRule.retryAfterSend = false;
+    m_rules[Config::API_ENDPOINT_HEALTH] = probeRule;
+}
+
+void RetryPolicy::setEndpointRule(const std::string& endpoint, const EndpointRule& rule)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_rules[endpoint] = rule;
+}
+
+void RetryPolicy::setMaxRetries(int maxRetries)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxRetries = std::max(0, maxRetries);
+}
+
+int RetryPolicy::maxRetries() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxRetries;
+}
+
+void RetryPolicy::setBackoff(std::chrono::milliseconds base, std::chrono::milliseconds max)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_baseDelay = base;
+    m_maxDelay = std::max(base, max);
+}
+
+const RetryPolicy::EndpointRule& RetryPolicy::ruleFor(const std::string& endpoint) const
+{
+    auto it = m_rules.find(endpoint);
+    return (it != m_rules.end()) ? it->second : m_defaultRule;
+}
+
+bool RetryPolicy::isRetryable(const std::string& endpoint, bool transportOk, int statusCode,
+                              bool requestSent) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const EndpointRule& rule = ruleFor(endpoint);
+
+    if (!transportOk) {
+        return rule.retryTransportErrors && (!requestSent || rule.retryAfterSend);
+    }
+    return rule.retryableStatuses.count(statusCode) > 0;
+}
+
+std::chrono::milliseconds RetryPolicy::backoffDelay(int retry)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // base * 2^(retry-1), capped
+    long long delay = m_baseDelay.count();
+    for (int i = 1; i < retry && delay < m_maxDelay.count(); i++) {
+        delay *= 2;
+    }
+    delay = std::min<long long>(delay, m_maxDelay.count());
+
+    // Equal jitter: [delay/2, delay]
+    long long half = delay / 2;
+    std::uniform_int_distribution<long long> jitter(0, delay - half);
+    return std::chrono::milliseconds(half + jitter(m_rng));
+}
+
+void RetryPolicy::onRequest()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budgetTokens = std::min<double>(m_budgetTokens + Config::RETRY_BUDGET_RATIO,
+                                      Config::RETRY_BUDGET_MAX_TOKENS);
+}
+
+bool RetryPolicy::tryAcquireRetry()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_budgetTokens < 1.0) {
+        return false;
+    }
+    m_budgetTokens -= 1.0;
+    return true;
+}
+
+//==============================================================================
+// CircuitBreaker
+//==============================================================================
+
+CircuitBreaker::CircuitBreaker()
+    : CircuitBreaker(Config::CIRCUIT_FAILURE_THRESHOLD,
+                     std::chrono::milliseconds(Config::CIRCUIT_OPEN_MS))
+{
+}
+
+CircuitBreaker::CircuitBreaker(int failureThreshold, std::chrono::milliseconds openDuration)
+    : m_failureThreshold(failureThreshold)
+    , m_openDuration(openDuration)
+    , m_state(State::CLOSED)
+    , m_consecutiveFailures(0)
+    , m_probeInFlight(false)
+    , m_rejected(0)
+{
+}
+
+bool CircuitBreaker::allowRequest(bool* probe)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (probe) {
+        *probe = false;
+    }
+
+    switch (m_state) {
+        case State::CLOSED:
+            return true;
+
+        case State::OPEN:
+            if (std::chrono::steady_clock::now() - m_openedAt < m_openDuration) {
+                m_rejected++;
+                return false;
+            }
+            // Open period over: let exactly one probe through
+            m_state = State::HALF_OPEN;
+            m_probeInFlight = true;
+            if (probe) {
+                *probe = true;
+            }
+            return true;
+
+        case State::HALF_OPEN:
+            if (m_probeInFlight) {
+                m_rejected++;
+                return false;
+            }
+            m_probeInFlight = true;
+            if (probe) {
+                *probe = true;
+            }
+            return true;
+    }
+    return true;
+}
+
+void CircuitBreaker::setFailureThreshold(int failureThreshold)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_failureThreshold = failureThreshold;
+}
+
+void CircuitBreaker::recordSuccess()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_state = State::CLOSED;
+    m_consecutiveFailures = 0;
+    m_probeInFlight = false;
+}
+
+void CircuitBreaker::recordFailure()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_consecutiveFailures++;
+    m_probeInFlight = false;
+
+    if (m_failureThreshold <= 0) {
+        return;
+    }
+    if (m_state == State::HALF_OPEN || m_consecutiveFailures >= m_failureThreshold) {
+        m_state = State::OPEN;
+        m_openedAt = std::chrono::steady_clock::now();
+    }
+}
+
+void CircuitBreaker::releaseProbe()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_probeInFlight = false;
+}
+
+CircuitBreaker::State CircuitBreaker::state() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_state;
+}
+
+size_t CircuitBreaker::rejectedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_rejected;
+}
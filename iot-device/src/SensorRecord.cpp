@@ -0,0 +1,80 @@
+#include "SensorRecord.h"
+#include <cstring>
+
+constexpr uint16_t SensorRecord::VERSION;
+constexpr size_t SensorRecord::RESULT_LEN;
+constexpr size_t SensorRecord::NAME_LEN;
+constexpr size_t SensorRecord::DATE_LEN;
+
+namespace {
+
+template <size_t N>
+void copyString(char (&dst)[N], const std::string& src)
+{
+    size_t length = src.size();
+    if (length > N - 1) {
+        // Do not split a multi-byte UTF-8 sequence (patient names are often Korean)
+        length = N - 1;
+        while (length > 0 && (static_cast<uint8_t>(src[length]) & 0xC0) == 0x80) {
+            length--;
+        }
+    }
+    std::memcpy(dst, src.data(), length);
+    std::memset(dst + length, 0, N - length);
+}
+
+template <size_t N>
+std::string readString(const char (&src)[N])
+{
+    return std::string(src, strnlen(src, N));
+}
+
+} // namespace
+
+SensorRecord SensorRecord::fromSensorData(const SkinSensor::SensorData& data, uint32_t sequence)
+{
+    SensorRecord record;
+    record.version = VERSION;
+    record.reserved = 0;
+    record.sequence = sequence;
+
+    record.pd1 = data.pd1;
+    record.pd2 = data.pd2;
+    record.hz = data.hz;
+    record.s1 = data.s1;
+    record.s2 = data.s2;
+    record.s3 = data.s3;
+    record.moistureLevel = data.moistureLevel;
+    record.temperatureC = data.temperatureC;
+    std::memcpy(record.adcRaw, data.adcRaw, sizeof(record.adcRaw));
+    record.timestamp = data.timestamp;
+
+    copyString(record.thicknessResult, data.thicknessResult);
+    copyString(record.elasticityResult, data.elasticityResult);
+    copyString(record.moistureLevelResult, data.moistureLevelResult);
+    copyString(record.patientName, data.patientName);
+    copyString(record.birthDate, data.birthDate);
+    return record;
+}
+
+SkinSensor::SensorData SensorRecord::toSensorData() const
+{
+    SkinSensor::SensorData data;
+    data.pd1 = pd1;
+    data.pd2 = pd2;
+    data.hz = hz;
+    data.s1 = s1;
+    data.s2 = s2;
+    data.s3 = s3;
+    data.moistureLevel = moistureLevel;
+    data.temperatureC = temperatureC;
+    std::memcpy(data.adcRaw, adcRaw, sizeof(data.adcRaw));
+    data.timestamp = timestamp;
+
+    data.thicknessResult = readString(thicknessResult);
+    data.elasticityResult = readString(elasticityResult);
+    data.moistureLevelResult = readString(moistureLevelResult);
+    data.patientName = readString(patientName);
+    data.birthDate = readString(birthDate);
+    return data;
+}
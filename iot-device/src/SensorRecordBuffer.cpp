@@ -0,0 +1,270 @@
+#include "SensorRecordBuffer.h"
+#include <cstring>
+#include <iostream>
+
+namespace {
+    // BLOCK: recheck period while the producer waits for space
+    constexpr auto BLOCK_RECHECK = std::chrono::seconds(1);
+}
+
+SensorRecordBuffer::SensorRecordBuffer(size_t capacity, OverflowPolicy policy, Clock& clock)
+    : m_ring(capacity)
+    , m_policy(policy)
+    , m_clock(clock)
+    , m_closed(false)
+    , m_sequence(0)
+    , m_spillActive(false)
+    , m_spillRecords(0)
+    , m_consumerWaiting(false)
+    , m_producerWaiting(false)
+    , m_pushed(0)
+    , m_popped(0)
+    , m_dropped(0)
+    , m_spilled(0)
+    , m_unspilled(0)
+    , m_blocked(0)
+    , m_highWater(0)
+{
+    if (m_policy == OverflowPolicy::SPILL) {
+        // No spill file until openSpill() succeeds
+        m_policy = OverflowPolicy::DROP_OLDEST;
+    }
+}
+
+SensorRecordBuffer::~SensorRecordBuffer()
+{
+    if (m_spill.isOpen()) {
+        m_spill.sync(true);
+    }
+}
+
+bool SensorRecordBuffer::openSpill(const std::string& path, size_t capacityBytes)
+{
+    if (!m_spill.open(path, capacityBytes)) {
+        std::cerr << "[RecordBuffer] Cannot open spill file " << path << ", dropping oldest on overflow" << std::endl;
+        m_policy = OverflowPolicy::DROP_OLDEST;
+        return false;
+    }
+
+    // Records spilled before a restart are older than anything produced now
+    m_spillRecords = m_spill.size();
+    m_spillActive = !m_spill.empty();
+    m_policy = OverflowPolicy::SPILL;
+    return true;
+}
+
+//==============================================================================
+// Producer
+//==============================================================================
+
+bool SensorRecordBuffer::push(const SensorRecord& input)
+{
+    if (m_closed.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    SensorRecord record = input;
+    record.sequence = m_sequence++;
+    bool queued = true;
+
+    switch (m_policy) {
+        case OverflowPolicy::DROP_OLDEST:
+            if (m_ring.pushOverwrite(record)) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+
+        case OverflowPolicy::BLOCK:
+            if (!m_ring.tryPush(record)) {
+                m_blocked.fetch_add(1, std::memory_order_relaxed);
+                while (!m_ring.tryPush(record)) {
+                    std::unique_lock<std::mutex> lock(m_waitMutex);
+                    m_producerWaiting = true;
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    m_clock.waitUntil(lock, m_spaceCv, m_clock.now() + BLOCK_RECHECK,
+                                      [this]() { return !m_ring.full() || m_closed; });
+                    m_producerWaiting = false;
+
+                    if (m_closed) {
+                        return false;
+                    }
+                }
+            }
+            break;
+
+        case OverflowPolicy::SPILL:
+            // Keep spilling until the file is drained so records stay in order
+            if (m_spillActive.load(std::memory_order_acquire) || !m_ring.tryPush(record)) {
+                queued = spill(record);
+            }
+            break;
+    }
+
+    if (queued) {
+        m_pushed.fetch_add(1, std::memory_order_relaxed);
+        size_t size = m_ring.size();
+        if (size > m_highWater.load(std::memory_order_relaxed)) {
+            m_highWater.store(size, std::memory_order_relaxed);
+        }
+    }
+
+    wakeConsumer();
+    return queued;
+}
+
+bool SensorRecordBuffer::spill(const SensorRecord& record)
+{
+    std::lock_guard<std::mutex> lock(m_spillMutex);
+
+    // The spill ring drops its own oldest records when full
+    uint64_t droppedBefore = m_spill.getStats().dropped;
+    if (!m_spill.append(&record, sizeof(record))) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_dropped.fetch_add(m_spill.getStats().dropped - droppedBefore, std::memory_order_relaxed);
+
+    m_spilled.fetch_add(1, std::memory_order_relaxed);
+    m_spillRecords = m_spill.size();
+    m_spillActive.store(true, std::memory_order_release);
+    return true;
+}
+
+void SensorRecordBuffer::close()
+{
+    m_closed = true;
+    {
+        std::lock_guard<std::mutex> lock(m_waitMutex);
+    }
+    m_clock.notify(m_dataCv);
+    m_clock.notify(m_spaceCv);
+}
+
+void SensorRecordBuffer::wakeConsumer()
+{
+    // Pairs with the fence in pop(): either the consumer sees the record
+    // or we see its flag. Taking the mutex orders the notify after its wait.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_consumerWaiting.load()) {
+        { std::lock_guard<std::mutex> lock(m_waitMutex); }
+        m_clock.notify(m_dataCv);
+    }
+}
+
+//==============================================================================
+// Consumer
+//==============================================================================
+
+bool SensorRecordBuffer::tryPop(SensorRecord& record)
+{
+    // The ring only ever holds records older than the spilled ones
+    if (m_ring.tryPop(record) || (m_spillActive.load(std::memory_order_acquire) && unspill(record))) {
+        m_popped.fetch_add(1, std::memory_order_relaxed);
+        wakeProducer();
+        return true;
+    }
+    return false;
+}
+
+bool SensorRecordBuffer::unspill(SensorRecord& record)
+{
+    std::lock_guard<std::mutex> lock(m_spillMutex);
+
+    const uint8_t* data;
+    size_t length;
+    while (m_spill.peek(data, length)) {
+        bool valid = length == sizeof(record);
+        if (valid) {
+            std::memcpy(&record, data, sizeof(record));
+            valid = record.version == SensorRecord::VERSION;
+        }
+        m_spill.pop();
+
+        if (valid) {
+            m_unspilled.fetch_add(1, std::memory_order_relaxed);
+            m_spillRecords = m_spill.size();
+            if (m_spill.empty()) {
+                m_spillActive.store(false, std::memory_order_release);
+            }
+            return true;
+        }
+        m_dropped.fetch_add(1, std::memory_order_relaxed);    // Left by an older firmware
+    }
+
+    m_spillRecords = 0;
+    m_spillActive.store(false, std::memory_order_release);
+    return false;
+}
+
+bool SensorRecordBuffer::pop(SensorRecord& record, std::chrono::milliseconds timeout)
+{
+    const auto deadline = m_clock.now() + timeout;
+
+    while (!tryPop(record)) {
+        if (m_closed || m_clock.now() >= deadline) {
+            // A record pushed just before close() may still be there
+            return tryPop(record);
+        }
+
+        std::unique_lock<std::mutex> lock(m_waitMutex);
+        m_consumerWaiting = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        m_clock.waitUntil(lock, m_dataCv, deadline, [this]() {
+            return !m_ring.empty() || m_spillActive.load(std::memory_order_acquire) || m_closed;
+        });
+        m_consumerWaiting = false;
+    }
+    return true;
+}
+
+void SensorRecordBuffer::wakeProducer()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_producerWaiting.load()) {
+        { std::lock_guard<std::mutex> lock(m_waitMutex); }
+        m_clock.notify(m_spaceCv);
+    }
+}
+
+bool SensorRecordBuffer::finished() const
+{
+    return m_closed && m_ring.empty() && !m_spillActive.load(std::memory_order_acquire);
+}
+
+SensorRecordBuffer::Stats SensorRecordBuffer::getStats() const
+{
+    Stats stats;
+    stats.pushed = m_pushed;
+    stats.popped = m_popped;
+    stats.dropped = m_dropped;
+    stats.spilled = m_spilled;
+    stats.unspilled = m_unspilled;
+    stats.blocked = m_blocked;
+    stats.highWater = m_highWater;
+    stats.size = m_ring.size();
+    stats.spillPending = m_spillRecords;
+    stats.capacity = m_ring.capacity();
+    return stats;
+}
+
+//==============================================================================
+// Names
+//==============================================================================
+
+bool SensorRecordBuffer::parsePolicy(const std::string& name, OverflowPolicy& policy)
+{
+    if (name == "drop-oldest") { policy = OverflowPolicy::DROP_OLDEST; return true; }
+    if (name == "block")       { policy = OverflowPolicy::BLOCK;       return true; }
+    if (name == "spill")       { policy = OverflowPolicy::SPILL;       return true; }
+    return false;
+}
+
+const char* SensorRecordBuffer::policyName(OverflowPolicy policy)
+{
+    switch (policy) {
+        case OverflowPolicy::DROP_OLDEST: return "drop-oldest";
+        case OverflowPolicy::BLOCK:       return "block";
+        case OverflowPolicy::SPILL:       return "spill";
+    }
+    return "?";
+}
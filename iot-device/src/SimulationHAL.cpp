@@ -0,0 +1,891 @@
+#include "SimulationHAL.h"
+#include "Config.h"
+#include "Clock.h"
+#include "Crc.h"
+#include "I2CTrace.h"
+#include <algorithm>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace HAL {
+
+//==============================================================================
+// Configuration
+//==============================================================================
+
+constexpr int SimulationConfig::ADC_CHANNELS;
+
+namespace {
+    // Random stream ids: one per signal, then the device-level streams
+    constexpr uint32_t STREAM_ADC = 0;              // + channel
+    constexpr uint32_t STREAM_TEMPERATURE = 4;
+    constexpr uint32_t STREAM_HUMIDITY = 5;
+    constexpr uint32_t STREAM_RANGE = 6;
+    constexpr uint32_t STREAM_LATENCY = 7;
+    constexpr uint32_t STREAM_BUS_ERRORS = 8;
+    constexpr uint32_t STREAM_EEPROM = 9;          // Write cycle times
+
+    SignalModel signal(double base, double driftPerHour, double noise, double stepSize,
+                       double stepsPerHour, double amplitude)
+    {
+        return SignalModel{base, driftPerHour, noise, stepSize, stepsPerHour, amplitude,
+                           Config::Hardware::MEASUREMENT_HZ};
+    }
+
+    std::string trim(const std::string& text)
+    {
+        size_t first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos) {
+            return "";
+        }
+        size_t last = text.find_last_not_of(" \t\r");
+        return text.substr(first, last - first + 1);
+    }
+
+    bool parseNumber(const std::string& text, double& value)
+    {
+        char* end = nullptr;
+        value = std::strtod(text.c_str(), &end);
+        return !text.empty() && end == text.c_str() + text.size() && std::isfinite(value);
+    }
+}
+
+SimulationConfig SimulationConfig::defaults()
+{
+    SimulationConfig config;
+    config.seed = 1;
+
+    // Photodiodes: slow drift, an occasional step when the probe moves,
+    // and mains-rate ripple from ambient light
+    config.adc[0] = signal(24000.0, 300.0, 60.0, 400.0, 2.0, 200.0);
+    config.adc[1] = signal(22000.0, -200.0, 60.0, 400.0, 2.0, 150.0);
+    config.adc[2] = signal(26000.0, 0.0, 40.0, 0.0, 0.0, 0.0);     // Thickness
+    config.adc[3] = signal(0.0, 0.0, 5.0, 0.0, 0.0, 0.0);          // Unconnected
+
+    config.temperature = signal(23.5, 0.5, 0.05, 0.0, 0.0, 0.0);
+    config.humidity = signal(50.0, 0.0, 0.3, 3.0, 1.0, 0.0);
+    config.range = signal(65.0, 0.0, 1.5, 5.0, 1.0, 0.0);
+
+    // Datasheet spreads: ADS1115 oscillator, VL6180X reflectance-dependent
+    // ranging time; no bus errors unless configured
+    config.ads1115 = DeviceModel{1.0, 0.05, 0.0};
+    config.sht31 = DeviceModel{1.0, 0.0, 0.0};
+    config.vl6180x = DeviceModel{1.0, 0.25, 0.0};
+    config.at24c256 = DeviceModel{1.0, 0.2, 0.0};
+    return config;
+}
+
+bool SimulationConfig::set(const std::string& key, const std::string& value)
+{
+    double number;
+    if (!parseNumber(value, number)) {
+        return false;
+    }
+
+    if (key == "seed") {
+        if (number < 0 || number > 4294967295.0 || number != std::floor(number)) {
+            return false;
+        }
+        seed = static_cast<uint32_t>(number);
+        return true;
+    }
+
+    size_t dot = key.find('.');
+    if (dot == std::string::npos) {
+        return false;
+    }
+    std::string object = key.substr(0, dot);
+    std::string field = key.substr(dot + 1);
+
+    DeviceModel* device = object == "ads1115" ? &ads1115 :
+                          object == "sht31"   ? &sht31 :
+                          object == "vl6180x" ? &vl6180x :
+                          object == "at24c256" ? &at24c256 : nullptr;
+    if (device) {
+        if (field == "latency_scale" && number > 0)                    { device->latencyScale = number; return true; }
+        if (field == "latency_jitter" && number >= 0 && number < 1)    { device->latencyJitter = number; return true; }
+        if (field == "error_rate" && number >= 0 && number <= 1)       { device->errorRate = number; return true; }
+        return false;
+    }
+
+    SignalModel* model = object == "temperature" ? &temperature :
+                         object == "humidity"    ? &humidity :
+                         object == "range"       ? &range : nullptr;
+    if (object.size() == 4 && object.compare(0, 3, "adc") == 0 &&
+        object[3] >= '0' && object[3] < '0' + ADC_CHANNELS) {
+        model = &adc[object[3] - '0'];
+    }
+    if (!model) {
+        return false;
+    }
+
+    if (field == "base")                        { model->base = number; return true; }
+    if (field == "drift")                       { model->driftPerHour = number; return true; }
+    if (field == "noise" && number >= 0)        { model->noise = number; return true; }
+    if (field == "step" && number >= 0)         { model->stepSize = number; return true; }
+    if (field == "step_rate" && number >= 0)    { model->stepsPerHour = number; return true; }
+    if (field == "amplitude")                   { model->amplitude = number; return true; }
+    if (field == "hz" && number >= 0)           { model->frequencyHz = number; return true; }
+    return false;
+}
+
+bool SimulationConfig::load(const std::string& path, std::string& error)
+{
+    std::ifstream file(path);
+    if (!file) {
+        error = path + ": cannot open";
+        return false;
+    }
+
+    SimulationConfig updated = *this;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos ||
+            !updated.set(trim(line.substr(0, equals)), trim(line.substr(equals + 1)))) {
+            std::ostringstream message;
+            message << path << ":" << lineNumber << ": invalid setting '" << line << "'";
+            error = message.str();
+            return false;
+        }
+    }
+
+    *this = updated;
+    return true;
+}
+
+//==============================================================================
+// Random source and signals
+//==============================================================================
+
+SimulationRandom::SimulationRandom(uint32_t seed, uint32_t stream)
+    : m_hasSpare(false)
+    , m_spare(0.0)
+{
+    std::seed_seq sequence{seed, stream};
+    m_engine.seed(sequence);
+}
+
+double SimulationRandom::uniform()
+{
+    return (static_cast<double>(m_engine()) + 0.5) / 4294967296.0;
+}
+
+double SimulationRandom::gaussian()
+{
+    if (m_hasSpare) {
+        m_hasSpare = false;
+        return m_spare;
+    }
+
+    const double twoPi = 6.283185307179586;
+    double radius = std::sqrt(-2.0 * std::log(uniform()));
+    double angle = twoPi * uniform();
+    m_spare = radius * std::sin(angle);
+    m_hasSpare = true;
+    return radius * std::cos(angle);
+}
+
+double SimulationRandom::exponential(double mean)
+{
+    return -mean * std::log(uniform());
+}
+
+SimulationSignal::SimulationSignal(const SignalModel& model, uint32_t seed, uint32_t stream)
+    : m_model(model)
+    , m_stepRandom(seed, stream * 2)
+    , m_noiseRandom(seed, stream * 2 + 1)
+    , m_stepOffset(0.0)
+    , m_nextStepAt(0.0)
+{
+    if (m_model.stepsPerHour > 0) {
+        m_nextStepAt = m_stepRandom.exponential(3600.0 / m_model.stepsPerHour);
+    }
+}
+
+double SimulationSignal::sample(double seconds)
+{
+    if (m_model.stepsPerHour > 0) {
+        while (seconds >= m_nextStepAt) {
+            m_stepOffset += m_model.stepSize * m_stepRandom.gaussian();
+            m_nextStepAt += m_stepRandom.exponential(3600.0 / m_model.stepsPerHour);
+        }
+    }
+
+    const double twoPi = 6.283185307179586;
+    double value = m_model.base + m_model.driftPerHour * seconds / 3600.0 + m_stepOffset;
+    if (m_model.amplitude != 0.0) {
+        value += m_model.amplitude * std::sin(twoPi * m_model.frequencyHz * seconds);
+    }
+    if (m_model.noise > 0.0) {
+        value += m_model.noise * m_noiseRandom.gaussian();
+    }
+    return value;
+}
+
+} // namespace HAL
+
+#ifdef PLATFORM_SIMULATION
+
+namespace HAL {
+
+//==============================================================================
+// Simulated devices
+//==============================================================================
+
+/**
+ * Simulation GPIO Interface
+ *
+ * Simulated devices drive interrupt lines through scheduleEdge(); each
+ * edge is a Clock timer that calls the handler registered with
+ * setInterrupt() at the scheduled (real or virtual) time. The bus and the
+ * GPIO of one simulated board share a clock, which is how an edge finds
+ * its GPIO when several boards run in one process.
+ */
+class SimulationGPIO : public GPIOInterface {
+public:
+    explicit SimulationGPIO(Clock& clock)
+        : m_clock(clock)
+        , m_edges(std::make_shared<EdgeState>())
+    {
+        std::lock_guard<std::mutex> lock(boardsMutex());
+        boards()[&clock] = this;
+    }
+
+    ~SimulationGPIO() override
+    {
+        cleanup();
+        std::lock_guard<std::mutex> lock(boardsMutex());
+        auto it = boards().find(&m_clock);
+        if (it != boards().end() && it->second == this) {
+            boards().erase(it);
+        }
+    }
+
+    bool initialize() override {
+        std::cout << "[SIM] GPIO initialized" << std::endl;
+        return true;
+    }
+
+    void cleanup() override {
+        // Waits for an edge being delivered; timers still pending become no-ops
+        std::lock_guard<std::mutex> lock(m_edges->mutex);
+        m_edges->closed = true;
+        m_edges->handlers.clear();
+    }
+
+    bool setDirection(int /*pin*/, Direction /*dir*/) override { return true; }
+    bool setPullMode(int /*pin*/, PullMode /*mode*/) override { return true; }
+    bool write(int /*pin*/, bool /*value*/) override { return true; }
+    bool read(int /*pin*/) override { return false; }
+    bool setPWM(int /*pin*/, int /*frequency*/, int /*dutyCycle*/) override { return true; }
+    bool stopPWM(int /*pin*/) override { return true; }
+
+    bool setInterrupt(int pin, Edge edge, void (*callback)(int, void*), void* userData) override {
+        std::lock_guard<std::mutex> lock(m_edges->mutex);
+        if (edge == Edge::NONE || !callback) {
+            m_edges->handlers.erase(pin);
+            return true;
+        }
+        m_edges->handlers[pin] = Handler{edge, callback, userData};
+        return true;
+    }
+
+    /**
+     * Deliver an active-low pulse (falling edge) on `pin` of the board
+     * running on `clock` at `when`, repeating every `period` if it is non-zero
+     */
+    static void scheduleEdge(Clock& clock, int pin, Clock::TimePoint when,
+                             std::chrono::microseconds period = std::chrono::microseconds(0)) {
+        std::lock_guard<std::mutex> lock(boardsMutex());
+        auto it = boards().find(&clock);
+        if (it != boards().end()) {
+            it->second->pushEdge(pin, when, period);
+        }
+    }
+
+    /**
+     * Drop pending and repeating edges on `pin` of the board running on `clock`
+     */
+    static void cancelEdges(Clock& clock, int pin) {
+        std::lock_guard<std::mutex> lock(boardsMutex());
+        auto it = boards().find(&clock);
+        if (it != boards().end()) {
+            std::lock_guard<std::mutex> edgesLock(it->second->m_edges->mutex);
+            it->second->m_edges->generation[pin]++;
+        }
+    }
+
+private:
+    struct Handler {
+        Edge edge;
+        void (*callback)(int, void*);
+        void* userData;
+    };
+
+    // Shared with pending timers, which may fire after this object is gone
+    struct EdgeState {
+        std::mutex mutex;               // Held while a handler runs
+        bool closed = false;
+        std::map<int, Handler> handlers;
+        std::map<int, uint64_t> generation;     // Bumped by cancelEdges()
+    };
+
+    void pushEdge(int pin, Clock::TimePoint when, std::chrono::microseconds period) {
+        uint64_t generation;
+        {
+            std::lock_guard<std::mutex> lock(m_edges->mutex);
+            if (m_edges->closed) {
+                return;
+            }
+            generation = m_edges->generation[pin];
+        }
+        armEdge(m_clock, m_edges, pin, when, period, generation);
+    }
+
+    static void armEdge(Clock& clock, std::weak_ptr<EdgeState> state, int pin, Clock::TimePoint when,
+                        std::chrono::microseconds period, uint64_t generation) {
+        clock.schedule(when, [&clock, state, pin, when, period, generation]() {
+            std::shared_ptr<EdgeState> edges = state.lock();
+            if (!edges) {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(edges->mutex);
+            if (edges->closed || edges->generation[pin] != generation) {
+                return;
+            }
+            if (period.count() > 0) {
+                armEdge(clock, state, pin, when + period, period, generation);
+            }
+
+            auto it = edges->handlers.find(pin);
+            if (it != edges->handlers.end() &&
+                (it->second.edge == Edge::FALLING || it->second.edge == Edge::BOTH)) {
+                it->second.callback(pin, it->second.userData);
+            }
+        });
+    }
+
+    static std::mutex& boardsMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    // GPIO of each simulated board, by the clock it runs on
+    static std::map<const Clock*, SimulationGPIO*>& boards() {
+        static std::map<const Clock*, SimulationGPIO*> boards;
+        return boards;
+    }
+
+    Clock& m_clock;
+    std::shared_ptr<EdgeState> m_edges;
+};
+
+/**
+ * Simulation I2C Interface
+ * Devices driven by the signal and device models in SimulationConfig
+ *
+ * The SHT31 NACKs reads until its measurement time has passed and returns
+ * frames with valid CRC-8 bytes.
+ *
+ * The VL6180X is addressed through its 16-bit register index and
+ * completes a single-shot range after about RANGE_TIME_TYPICAL_MS.
+ *
+ * The AT24C256 takes a 16-bit word address, wraps page writes within the
+ * page and NACKs everything for its write cycle (about
+ * WRITE_CYCLE_TYPICAL_US, jittered from its own random stream).
+ *
+ * The ADS1115 is modelled with its conversion latency: a single-shot
+ * conversion completes 1/DR after the config write (+/- the oscillator
+ * spread), the config OS bit reads 0 until then, the conversion register
+ * keeps the previous result, and in conversion-ready mode ALERT/RDY
+ * pulses PIN_ADC_DRDY when the result lands. In continuous mode a new
+ * result (and pulse) arrives every conversion period.
+ *
+ * Devices decode the raw bytes of each message (register pointers,
+ * commands, auto-incrementing indices), and every transaction takes its
+ * wire time at I2C_SPEED_HZ on the clock. Each value is the channel's
+ * signal at the moment the conversion completes. A failed message ends
+ * the transaction like a NACK.
+ */
+class SimulationI2C : public I2CInterface {
+public:
+    SimulationI2C(Clock& clock, const SimulationConfig& config)
+        : m_clock(clock)
+        , m_config(config)
+        , m_start(clock.now())
+        , m_temperature(config.temperature, config.seed, STREAM_TEMPERATURE)
+        , m_humidity(config.humidity, config.seed, STREAM_HUMIDITY)
+        , m_range(config.range, config.seed, STREAM_RANGE)
+        , m_latencyRandom(config.seed, STREAM_LATENCY)
+        , m_busRandom(config.seed, STREAM_BUS_ERRORS)
+        , m_eepromRandom(config.seed, STREAM_EEPROM)
+        , m_busErrors(0)
+        , m_eeprom(EEPROM::SIZE, 0xFF)
+        , m_eepromFile(Config::Simulation::getEepromFile())
+    {
+        for (int i = 0; i < SimulationConfig::ADC_CHANNELS; i++) {
+            m_adcSignals.emplace_back(config.adc[i], config.seed, STREAM_ADC + i);
+        }
+        if (!m_eepromFile.empty()) {
+            std::ifstream image(m_eepromFile, std::ios::binary);
+            image.read(reinterpret_cast<char*>(m_eeprom.data()), static_cast<std::streamsize>(m_eeprom.size()));
+        }
+    }
+
+    bool initialize(int busNumber) override {
+        std::cout << "[SIM] I2C bus " << busNumber << " initialized (seed " << m_config.seed << ")" << std::endl;
+        return true;
+    }
+
+    void cleanup() override {
+        std::cout << "[SIM] I2C cleanup";
+        if (m_busErrors > 0) {
+            std::cout << " (" << m_busErrors << " injected bus errors)";
+        }
+        std::cout << std::endl;
+    }
+
+    bool transfer(I2CMessage* messages, size_t count) override {
+        // Wire time at the bus clock: START + address + data, 9 bits per byte
+        size_t bits = 1;    // STOP
+        for (size_t i = 0; i < count; i++) {
+            bits += 1 + 9 * (1 + static_cast<size_t>(messages[i].length));
+        }
+        m_clock.sleepFor(std::chrono::microseconds(bits * 1000000 / Config::Hardware::I2C_SPEED_HZ));
+
+        for (size_t i = 0; i < count; i++) {
+            I2CMessage& message = messages[i];
+            if (transferFails(message.address)) {
+                return false;
+            }
+            bool acked = message.isRead() ? deviceRead(message.address, message.buffer, message.length)
+                                          : deviceWrite(message.address, message.buffer, message.length);
+            if (!acked) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool isDevicePresent(uint8_t /*deviceAddr*/) override {
+        // All simulated devices are present
+        return true;
+    }
+
+private:
+    struct AdcState {
+        uint16_t config = 0x8583;           // Power-on reset value
+        uint16_t loThresh = 0x8000;
+        uint16_t hiThresh = 0x7FFF;
+        uint16_t result = 0;
+        uint16_t pendingResult = 0;
+        bool converting = false;
+        Clock::TimePoint readyAt;
+
+        // Continuous conversion mode
+        bool continuous = false;
+        std::chrono::microseconds period{0};
+        Clock::TimePoint cycleStart;
+        uint64_t completed = 0;
+    };
+
+    const DeviceModel* deviceModel(uint8_t deviceAddr) const {
+        switch (deviceAddr) {
+            case I2C::ADDR_PHOTODIODE_ADC:    return &m_config.ads1115;
+            case I2C::ADDR_MOISTURE_SENSOR:   return &m_config.sht31;
+            case I2C::ADDR_ELASTICITY_SENSOR: return &m_config.vl6180x;
+            case I2C::ADDR_EEPROM:            return &m_config.at24c256;
+        }
+        return nullptr;
+    }
+
+    bool transferFails(uint8_t deviceAddr) {
+        const DeviceModel* device = deviceModel(deviceAddr);
+        if (!device || device->errorRate <= 0.0 || m_busRandom.uniform() >= device->errorRate) {
+            return false;
+        }
+        m_busErrors++;
+        return true;
+    }
+
+    bool deviceWrite(uint8_t deviceAddr, const uint8_t* data, size_t length) {
+        switch (deviceAddr) {
+            case I2C::ADDR_PHOTODIODE_ADC:
+                // Pointer byte, then an optional 16-bit register value (MSB first)
+                if (length >= 1) {
+                    m_adcPointer = data[0] & 0x03;
+                }
+                if (length >= 3) {
+                    writeAdcRegister(m_adcPointer, static_cast<uint16_t>((data[1] << 8) | data[2]));
+                }
+                return true;
+
+            case I2C::ADDR_MOISTURE_SENSOR:
+                // 16-bit command, MSB first
+                if (length >= 2) {
+                    startClimateMeasurement(static_cast<uint16_t>((data[0] << 8) | data[1]));
+                }
+                return true;
+
+            case I2C::ADDR_ELASTICITY_SENSOR:
+                // 16-bit index, then data bytes at auto-incrementing indices
+                if (length >= 2) {
+                    m_tofIndex = static_cast<uint16_t>((data[0] << 8) | data[1]);
+                }
+                for (size_t i = 2; i < length; i++) {
+                    writeTofRegister(m_tofIndex++, data[i]);
+                }
+                return true;
+
+            case I2C::ADDR_EEPROM:
+                return writeEeprom(data, length);
+        }
+        return true;
+    }
+
+    bool deviceRead(uint8_t deviceAddr, uint8_t* buffer, size_t length) {
+        switch (deviceAddr) {
+            case I2C::ADDR_PHOTODIODE_ADC: {
+                // The register at the pointer, repeated for longer reads
+                uint16_t value = readAdcRegister(m_adcPointer);
+                for (size_t i = 0; i < length; i++) {
+                    buffer[i] = (i % 2 == 0) ? static_cast<uint8_t>(value >> 8) : static_cast<uint8_t>(value & 0xFF);
+                }
+                return true;
+            }
+
+            case I2C::ADDR_MOISTURE_SENSOR:
+                return readClimateFrame(buffer, length);
+
+            case I2C::ADDR_ELASTICITY_SENSOR:
+                for (size_t i = 0; i < length; i++) {
+                    buffer[i] = readTofRegister(m_tofIndex++);
+                }
+                return true;
+
+            case I2C::ADDR_EEPROM:
+                // Sequential read, wrapping at the end of the array
+                if (m_clock.now() < m_eepromBusyUntil) {
+                    return false;
+                }
+                for (size_t i = 0; i < length; i++) {
+                    buffer[i] = m_eeprom[m_eepromAddress];
+                    m_eepromAddress = (m_eepromAddress + 1) % EEPROM::SIZE;
+                }
+                return true;
+        }
+        std::fill(buffer, buffer + length, 0);
+        return true;
+    }
+
+    /**
+     * Typical conversion time scaled and jittered by the device model
+     */
+    std::chrono::microseconds conversionTime(const DeviceModel& device, int typicalUs) {
+        return conversionTime(device, typicalUs, m_latencyRandom);
+    }
+
+    std::chrono::microseconds conversionTime(const DeviceModel& device, int typicalUs, SimulationRandom& random) {
+        double spread = device.latencyJitter * (2.0 * random.uniform() - 1.0);
+        double us = typicalUs * device.latencyScale * (1.0 + spread);
+        return std::chrono::microseconds(std::max<int64_t>(1, static_cast<int64_t>(us)));
+    }
+
+    double secondsAt(Clock::TimePoint when) const {
+        return std::chrono::duration<double>(when - m_start).count();
+    }
+
+    static uint16_t toRaw(double value, double scale, double offset) {
+        // SHT31 encoding: value = offset + scale * raw / 65535
+        double raw = std::round((value - offset) / scale * 65535.0);
+        return static_cast<uint16_t>(std::min(65535.0, std::max(0.0, raw)));
+    }
+
+    void startClimateMeasurement(uint16_t cmd) {
+        // Typical measurement durations (datasheet table 4)
+        int typicalUs;
+        switch (cmd) {
+            case MoistureSensor::CMD_MEASURE_HIGH_REP: typicalUs = 12500; break;
+            case MoistureSensor::CMD_MEASURE_MED_REP:  typicalUs = 4500; break;
+            case MoistureSensor::CMD_MEASURE_LOW_REP:  typicalUs = 2500; break;
+            default: return;
+        }
+        m_climatePending = true;
+        m_climateReadyAt = m_clock.now() + conversionTime(m_config.sht31, typicalUs);
+    }
+
+    bool readClimateFrame(uint8_t* buffer, size_t length) {
+        // Without clock stretching the sensor NACKs a read until the measurement is done
+        if (!m_climatePending || m_clock.now() < m_climateReadyAt || length < 6) {
+            return false;
+        }
+        m_climatePending = false;
+
+        double seconds = secondsAt(m_climateReadyAt);
+        uint16_t rawTemp = toRaw(m_temperature.sample(seconds), 175.0, -45.0);
+        uint16_t rawHumidity = toRaw(m_humidity.sample(seconds), 100.0, 0.0);
+
+        buffer[0] = static_cast<uint8_t>(rawTemp >> 8);
+        buffer[1] = static_cast<uint8_t>(rawTemp & 0xFF);
+        buffer[3] = static_cast<uint8_t>(rawHumidity >> 8);
+        buffer[4] = static_cast<uint8_t>(rawHumidity & 0xFF);
+        buffer[2] = Crc8::compute(&buffer[0], 2);
+        buffer[5] = Crc8::compute(&buffer[3], 2);
+        return true;
+    }
+
+    void writeTofRegister(uint16_t index, uint8_t value) {
+        if (index == ToFSensor::REG_SYSRANGE_START && (value & ToFSensor::RANGE_START_SINGLE)) {
+            m_tofReadyAt = m_clock.now() + conversionTime(m_config.vl6180x, ToFSensor::RANGE_TIME_TYPICAL_MS * 1000);
+            m_tofRanging = true;
+
+            double range = std::round(m_range.sample(secondsAt(m_tofReadyAt)));
+            m_tofRange = static_cast<uint8_t>(std::min(255.0, std::max(0.0, range)));
+        } else if (index == ToFSensor::REG_INTERRUPT_CLEAR) {
+            m_tofSampleReady = false;
+        }
+    }
+
+    uint8_t readTofRegister(uint16_t index) {
+        if (m_tofRanging && m_clock.now() >= m_tofReadyAt) {
+            m_tofRanging = false;
+            m_tofSampleReady = true;
+        }
+        switch (index) {
+            case ToFSensor::REG_RESULT_INTERRUPT_STATUS:
+                return m_tofSampleReady ? ToFSensor::INT_CONFIG_NEW_SAMPLE : 0x00;
+            case ToFSensor::REG_RESULT_RANGE_VAL:
+                return m_tofRange;
+        }
+        return 0x00;
+    }
+
+    void writeAdcRegister(uint8_t regAddr, uint16_t value) {
+        switch (regAddr) {
+            case ADC::REG_CONFIG:
+                updateAdc();
+                m_adc.config = value & ~ADC::CFG_OS_SINGLE;
+
+                // A config write restarts the conversion cycle
+                SimulationGPIO::cancelEdges(m_clock, GPIO::PIN_ADC_DRDY);
+                m_adc.continuous = false;
+
+                if (!(value & ADC::CFG_MODE_SINGLE)) {
+                    startContinuous();
+                } else if (value & ADC::CFG_OS_SINGLE) {
+                    startConversion();
+                }
+                break;
+            case ADC::REG_LO_THRESH: m_adc.loThresh = value; break;
+            case ADC::REG_HI_THRESH: m_adc.hiThresh = value; break;
+        }
+    }
+
+    uint16_t readAdcRegister(uint8_t regAddr) {
+        updateAdc();
+        switch (regAddr) {
+            case ADC::REG_CONVERSION: return m_adc.result;
+            case ADC::REG_CONFIG:     return m_adc.config | (m_adc.converting ? 0 : ADC::CFG_OS_IDLE);
+            case ADC::REG_LO_THRESH:  return m_adc.loThresh;
+            case ADC::REG_HI_THRESH:  return m_adc.hiThresh;
+        }
+        return 0x0000;
+    }
+
+    bool readyPinMode() const {
+        return (m_adc.hiThresh & 0x8000) && !(m_adc.loThresh & 0x8000) &&
+               (m_adc.config & 0x0003) != ADC::CFG_COMP_QUE_DISABLE;
+    }
+
+    /**
+     * Conversion result of the selected input at `when`, two's complement
+     */
+    uint16_t adcSample(Clock::TimePoint when) {
+        // Single-ended inputs are MUX 100..111; differential pairs read as AIN0
+        uint16_t mux = (m_adc.config & ADC::CFG_MUX_MASK) >> 12;
+        int channel = mux >= 4 ? mux - 4 : 0;
+
+        double counts = std::round(m_adcSignals[channel].sample(secondsAt(when)));
+        counts = std::min(32767.0, std::max(-32768.0, counts));
+        return static_cast<uint16_t>(static_cast<int16_t>(counts));
+    }
+
+    void startContinuous() {
+        // Free-running at 1/DR (+/- oscillator spread); a new result and
+        // an ALERT/RDY pulse every period
+        m_adc.period = conversionTime(m_config.ads1115, ADC::conversionTimeUs(m_adc.config));
+        m_adc.continuous = true;
+        m_adc.converting = false;
+        m_adc.cycleStart = m_clock.now();
+        m_adc.completed = 0;
+
+        if (readyPinMode()) {
+            SimulationGPIO::scheduleEdge(m_clock, GPIO::PIN_ADC_DRDY, m_adc.cycleStart + m_adc.period, m_adc.period);
+        }
+    }
+
+    void startConversion() {
+        m_adc.converting = true;
+        m_adc.readyAt = m_clock.now() + conversionTime(m_config.ads1115, ADC::conversionTimeUs(m_adc.config));
+        m_adc.pendingResult = adcSample(m_adc.readyAt);
+
+        if (readyPinMode()) {
+            SimulationGPIO::scheduleEdge(m_clock, GPIO::PIN_ADC_DRDY, m_adc.readyAt);
+        }
+    }
+
+    void updateAdc() {
+        if (m_adc.continuous) {
+            auto elapsed = m_clock.now() - m_adc.cycleStart;
+            uint64_t completed = static_cast<uint64_t>(elapsed / m_adc.period);
+            if (completed > m_adc.completed) {
+                m_adc.completed = completed;
+                m_adc.result = adcSample(m_adc.cycleStart + m_adc.period * completed);
+            }
+            return;
+        }
+        if (m_adc.converting && m_clock.now() >= m_adc.readyAt) {
+            m_adc.result = m_adc.pendingResult;
+            m_adc.converting = false;
+        }
+    }
+
+    /**
+     * AT24C256: 16-bit word address, then data that wraps within the page.
+     * Data starts a write cycle, during which the device NACKs everything.
+     */
+    bool writeEeprom(const uint8_t* data, size_t length) {
+        if (m_clock.now() < m_eepromBusyUntil) {
+            return false;
+        }
+        if (length >= 2) {
+            m_eepromAddress = static_cast<size_t>((data[0] << 8) | data[1]) % EEPROM::SIZE;
+        }
+        if (length <= 2) {
+            return true;
+        }
+
+        size_t page = m_eepromAddress - m_eepromAddress % EEPROM::PAGE_SIZE;
+        for (size_t i = 2; i < length; i++) {
+            m_eeprom[m_eepromAddress] = data[i];
+            m_eepromAddress = page + (m_eepromAddress + 1) % EEPROM::PAGE_SIZE;
+        }
+        m_eepromBusyUntil = m_clock.now() + conversionTime(m_config.at24c256, EEPROM::WRITE_CYCLE_TYPICAL_US, m_eepromRandom);
+
+        if (!m_eepromFile.empty()) {
+            std::ofstream image(m_eepromFile, std::ios::binary | std::ios::trunc);
+            image.write(reinterpret_cast<const char*>(m_eeprom.data()), static_cast<std::streamsize>(m_eeprom.size()));
+        }
+        return true;
+    }
+
+    Clock& m_clock;
+    const SimulationConfig m_config;
+    const Clock::TimePoint m_start;
+
+    std::vector<SimulationSignal> m_adcSignals;
+    SimulationSignal m_temperature;
+    SimulationSignal m_humidity;
+    SimulationSignal m_range;
+    SimulationRandom m_latencyRandom;
+    SimulationRandom m_busRandom;
+    SimulationRandom m_eepromRandom;
+    uint64_t m_busErrors;
+
+    AdcState m_adc;
+
+    bool m_climatePending = false;
+    Clock::TimePoint m_climateReadyAt;
+
+    uint8_t m_adcPointer = ADC::REG_CONVERSION;
+
+    uint16_t m_tofIndex = 0;
+    bool m_tofRanging = false;
+    bool m_tofSampleReady = false;
+    uint8_t m_tofRange = 0;
+    Clock::TimePoint m_tofReadyAt;
+
+    std::vector<uint8_t> m_eeprom;
+    size_t m_eepromAddress = 0;
+    Clock::TimePoint m_eepromBusyUntil;
+    const std::string m_eepromFile;     // THE3_SIM_EEPROM image, rewritten per page write
+};
+
+SimulationConfig loadSimulationConfig()
+{
+    SimulationConfig config = SimulationConfig::defaults();
+
+    std::string path = Config::Simulation::getConfigFile();
+    std::string error;
+    if (!path.empty() && !config.load(path, error)) {
+        std::cerr << "[SIM] " << error << ", using default models" << std::endl;
+    }
+
+    std::string seed = Config::Simulation::getSeed();
+    if (!seed.empty() && !config.set("seed", seed)) {
+        std::cerr << "[SIM] Invalid THE3_SIM_SEED '" << seed << "', using " << config.seed << std::endl;
+    }
+    return config;
+}
+
+/**
+ * Bus answered from THE3_I2C_REPLAY; recorded edges arrive on the
+ * simulated GPIO. nullptr if the trace cannot be loaded.
+ */
+I2CInterface* createReplayI2C(Clock& clock, const std::string& path)
+{
+    ReplayI2C* bus = new ReplayI2C(clock, [&clock](int pin, Clock::TimePoint when) {
+        SimulationGPIO::scheduleEdge(clock, pin, when);
+    });
+    bus->setEdgeSource(GPIO::PIN_ADC_DRDY, I2C::ADDR_PHOTODIODE_ADC);
+
+    std::string error;
+    if (!bus->load(path, error)) {
+        std::cerr << "[SIM] Cannot replay " << error << ", using the simulated devices" << std::endl;
+        delete bus;
+        return nullptr;
+    }
+    return bus;
+}
+
+// Factory functions
+I2CInterface* createSimulationI2C(Clock& clock, const SimulationConfig& config) { return new SimulationI2C(clock, config); }
+
+I2CInterface* createI2CInterface(Clock& clock)
+{
+    std::string replay = Config::Simulation::getReplayFile();
+    I2CInterface* bus = replay.empty() ? nullptr : createReplayI2C(clock, replay);
+    if (!bus) {
+        bus = new SimulationI2C(clock, loadSimulationConfig());
+    }
+    return traceI2C(bus, Config::Hardware::getI2CTraceFile(), clock);
+}
+
+GPIOInterface* createGPIOInterface(Clock& clock)
+{
+    return traceGPIO(new SimulationGPIO(clock), Config::Hardware::getI2CTraceFile(), clock);
+}
+
+bool isSimulationMode() { return true; }
+
+} // namespace HAL
+
+#endif // PLATFORM_SIMULATION
@@ -1,108 +1,12 @@
 #include "SkinSensor.h"
 #include "Config.h"
-#include <cstdlib>
-#include <ctime>
+#include "Crc.h"
+#include "Eeprom.h"
 #include <chrono>
 #include <cmath>
 #include <cstring>
-#include <thread>
 #include <iostream>
-
-//==============================================================================
-// Platform-specific simulation implementation
-// In production: Replace with actual HAL implementation (bcm2835, wiringPi, etc.)
-//==============================================================================
-
-#ifdef PLATFORM_SIMULATION
-
-namespace HAL {
-
-/**
- * Simulation I2C Interface
- * Generates realistic sensor values for testing without hardware
- */
-class SimulationI2C : public I2CInterface {
-public:
-    bool initialize(int busNumber) override {
-        std::cout << "[SIM] I2C bus " << busNumber << " initialized" << std::endl;
-        return true;
-    }
-
-    void cleanup() override {
-        std::cout << "[SIM] I2C cleanup" << std::endl;
-    }
-
-    bool writeRegister(uint8_t deviceAddr, uint8_t regAddr, uint8_t value) override {
-        // Simulate successful write
-        return true;
-    }
-
-    bool writeRegister16(uint8_t deviceAddr, uint8_t regAddr, uint16_t value) override {
-        return true;
-    }
-
-    uint8_t readRegister(uint8_t deviceAddr, uint8_t regAddr) override {
-        // Return simulated values based on device address
-        return 0x00;
-    }
-
-    uint16_t readRegister16(uint8_t deviceAddr, uint8_t regAddr) override {
-        // Simulate ADC values (ADS1115)
-        if (deviceAddr == I2C::ADDR_PHOTODIODE_ADC && regAddr == ADC::REG_CONVERSION) {
-            // Return random ADC value in realistic range
-            return 20000 + (std::rand() % 10000);
-        }
-        return 0x0000;
-    }
-
-    bool readBytes(uint8_t deviceAddr, uint8_t* buffer, size_t length) override {
-        // Simulate SHT31 humidity/temperature response
-        if (deviceAddr == I2C::ADDR_MOISTURE_SENSOR && length >= 6) {
-            // Temperature: ~25°C, Humidity: ~50%
-            buffer[0] = 0x64; buffer[1] = 0x00; buffer[2] = 0x00;  // Temp
-            buffer[3] = 0x80; buffer[4] = 0x00; buffer[5] = 0x00;  // Humidity
-            return true;
-        }
-        return true;
-    }
-
-    bool isDevicePresent(uint8_t deviceAddr) override {
-        // All simulated devices are present
-        return true;
-    }
-};
-
-/**
- * Simulation GPIO Interface
- */
-class SimulationGPIO : public GPIOInterface {
-public:
-    bool initialize() override {
-        std::cout << "[SIM] GPIO initialized" << std::endl;
-        return true;
-    }
-
-    void cleanup() override {}
-
-    bool setDirection(int pin, Direction dir) override { return true; }
-    bool setPullMode(int pin, PullMode mode) override { return true; }
-    bool write(int pin, bool value) override { return true; }
-    bool read(int pin) override { return false; }
-    bool setPWM(int pin, int frequency, int dutyCycle) override { return true; }
-    bool stopPWM(int pin) override { return true; }
-    bool setInterrupt(int pin, Edge edge, void (*callback)(int, void*), void* userData) override {
-        return true;
-    }
-};
-
-// Factory functions
-I2CInterface* createI2CInterface() { return new SimulationI2C(); }
-GPIOInterface* createGPIOInterface() { return new SimulationGPIO(); }
-bool isSimulationMode() { return true; }
-
-} // namespace HAL
-
-#endif // PLATFORM_SIMULATION
+#include <algorithm>
 
 //==============================================================================
 // SkinSensor Implementation
@@ -110,10 +14,17 @@ bool isSimulationMode() { return true; }
 
 SkinSensor::SkinSensor()
     : m_initialized(false)
+    , m_clock(&Clock::system())
     , m_lastTemperature(25.0f)
+    , m_lastHumidity(50.0f)
+    , m_climateRepeatability(Repeatability::HIGH)
+    , m_adcReadyMode(AdcReadyMode::DRDY_INTERRUPT)
+    , m_adcDataRate(HAL::ADC::dataRateBits(Config::Hardware::ADC_DATA_RATE_SPS))
+    , m_adcReadySequence(0)
+    , m_adcFilter(DecimationFilter::Type::BOXCAR)
+    , m_adcSampleBuffer(static_cast<size_t>(std::max(1, Config::Hardware::ADC_SAMPLES_PER_READ)))
+    , m_lastTiming()
 {
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
-
     // Initialize calibration with defaults
     std::memset(&m_calibration, 0, sizeof(m_calibration));
     m_calibration.magic = 0x54483330;  // "TH30"
@@ -131,10 +42,14 @@ SkinSensor::SkinSensor()
 SkinSensor::~SkinSensor()
 {
     if (m_gpio) {
+        m_gpio->setInterrupt(HAL::GPIO::PIN_ADC_DRDY, HAL::GPIOInterface::Edge::NONE, nullptr, nullptr);
+
         // Disable sensor power
         m_gpio->write(HAL::GPIO::PIN_SENSOR_POWER, false);
         m_gpio->cleanup();
     }
+    m_calibrationSlots.reset();
+    m_eeprom.reset();
     if (m_i2c) {
         m_i2c->cleanup();
     }
@@ -144,9 +59,12 @@ bool SkinSensor::initialize()
 {
     std::cout << "[SkinSensor] Initializing..." << std::endl;
 
-    // Create HAL interfaces
-    m_i2c.reset(HAL::createI2CInterface());
-    m_gpio.reset(HAL::createGPIOInterface());
+    // Create HAL interfaces (the EEPROM driver refers to the old bus)
+    m_calibrationSlots.reset();
+    m_eeprom.reset();
+    m_i2c.reset(HAL::createPlatformBus(*m_clock));
+    m_bus.attach(m_i2c.get());
+    m_gpio.reset(HAL::createGPIOInterface(*m_clock));
 
     // Initialize GPIO
     if (!m_gpio->initialize()) {
@@ -161,7 +79,7 @@ bool SkinSensor::initialize()
 
     // Enable sensor power
     m_gpio->write(HAL::GPIO::PIN_SENSOR_POWER, true);
-    std::this_thread::sleep_for(std::chrono::milliseconds(Config::Hardware::SENSOR_WARMUP_MS));
+    m_clock->sleepFor(std::chrono::milliseconds(Config::Hardware::SENSOR_WARMUP_MS));
 
     // Initialize I2C bus
     if (!m_i2c->initialize(Config::Hardware::I2C_BUS)) {
@@ -190,22 +108,34 @@ bool SkinSensor::initialize()
     }
     std::cout << "  [OK] ToF sensor (VL6180X) at 0x29" << std::endl;
 
+    // VL6180X: report "new sample ready" in the range interrupt status
+    // and acknowledge the fresh-out-of-reset flag
+    m_bus.tofWriteRegister(HAL::ToFSensor::REG_GPIO_INTERRUPT_CONFIG, HAL::ToFSensor::INT_CONFIG_NEW_SAMPLE);
+    m_bus.tofWriteRegister(HAL::ToFSensor::REG_FRESH_OUT_OF_RESET, 0x00);
+
     // Load calibration from EEPROM
     if (m_i2c->isDevicePresent(HAL::I2C::ADDR_EEPROM)) {
         std::cout << "  [OK] EEPROM (AT24C256) at 0x50" << std::endl;
+        m_eeprom.reset(new Eeprom(*m_i2c, *m_clock));
+        m_calibrationSlots.reset(new EepromSlotTable(*m_eeprom, Config::Hardware::CALIBRATION_SLOT_BASE,
+                                                     Config::Hardware::CALIBRATION_SLOT_SIZE,
+                                                     Config::Hardware::CALIBRATION_SLOTS));
         loadCalibration();
     } else {
         std::cout << "  [WARN] EEPROM not found, using default calibration" << std::endl;
     }
 
     // Configure ADC (ADS1115)
-    // Config: Single-shot, AIN0, +/-4.096V, 128 SPS
+    // Config: Single-shot, AIN0, +/-4.096V, Config::Hardware::ADC_DATA_RATE_SPS
+    configureAdcReady();
     uint16_t adcConfig = HAL::ADC::CFG_OS_SINGLE |
                          HAL::ADC::CFG_MUX_AIN0 |
                          HAL::ADC::CFG_PGA_4V |
                          HAL::ADC::CFG_MODE_SINGLE |
-                         HAL::ADC::CFG_DR_128SPS;
-    i2cWriteRegister16(HAL::I2C::ADDR_PHOTODIODE_ADC, HAL::ADC::REG_CONFIG, adcConfig);
+                         m_adcDataRate |
+                         (m_adcReadyMode == AdcReadyMode::DRDY_INTERRUPT ?
+                              HAL::ADC::CFG_COMP_QUE_1CONV : HAL::ADC::CFG_COMP_QUE_DISABLE);
+    m_bus.adcWriteRegister(HAL::ADC::REG_CONFIG, adcConfig);
 
     // Status LED on
     m_gpio->write(HAL::GPIO::PIN_LED_STATUS, true);
@@ -216,6 +146,28 @@ bool SkinSensor::initialize()
     return true;
 }
 
+void SkinSensor::setAdcReadyMode(AdcReadyMode mode)
+{
+    m_adcReadyMode = mode;
+}
+
+void SkinSensor::setAdcOversampling(int samplesPerRead, DecimationFilter::Type filter)
+{
+    int samples = std::min(std::max(samplesPerRead, 1), Config::Hardware::ADC_MAX_SAMPLES_PER_READ);
+    m_adcSampleBuffer.assign(static_cast<size_t>(samples), 0);
+    m_adcFilter.setType(filter);
+}
+
+void SkinSensor::setClimateRepeatability(Repeatability repeatability)
+{
+    m_climateRepeatability = repeatability;
+}
+
+void SkinSensor::setAdcDataRate(int samplesPerSecond)
+{
+    m_adcDataRate = HAL::ADC::dataRateBits(samplesPerSecond);
+}
+
 void SkinSensor::setPatientInfo(const std::string& name, const std::string& birthDate)
 {
     m_patientName = name;
@@ -238,7 +190,7 @@ bool SkinSensor::calibrate()
     for (int i = 0; i < numSamples; i++) {
         pd1Sum += readADC(0);
         pd2Sum += readADC(1);
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        m_clock->sleepFor(std::chrono::milliseconds(100));
     }
 
     // Calculate offsets (assuming reference surface gives known values)
@@ -246,7 +198,7 @@ bool SkinSensor::calibrate()
     m_calibration.pdOffset2 = 100.0f - (pd2Sum / numSamples);
 
     // Update calibration timestamp
-    m_calibration.lastCalibrationDate = static_cast<uint32_t>(std::time(nullptr));
+    m_calibration.lastCalibrationDate = static_cast<uint32_t>(m_clock->unixTimeMs() / 1000);
 
     // Save to EEPROM
     if (!saveCalibration()) {
@@ -262,52 +214,80 @@ bool SkinSensor::calibrate()
 
 bool SkinSensor::loadCalibration()
 {
-    // Read calibration data from EEPROM
-    uint8_t buffer[sizeof(CalibrationData)];
-
-    if (!m_i2c->readBytes(HAL::I2C::ADDR_EEPROM, buffer, sizeof(buffer))) {
+    if (!m_eeprom) {
         return false;
     }
 
-    CalibrationData* data = reinterpret_cast<CalibrationData*>(buffer);
+    // Newest valid version in the history slots
+    CalibrationData data;
+    if (m_calibrationSlots->scan()) {
+        for (const auto& entry : m_calibrationSlots->history()) {
+            if (m_calibrationSlots->load(entry, &data, sizeof(data)) && isValidCalibration(data)) {
+                m_calibration = data;
+                std::cout << "[SkinSensor] Calibration loaded from EEPROM (version " << entry.sequence << ")" << std::endl;
+                return true;
+            }
+        }
+    }
 
-    // Validate magic number
-    if (data->magic != 0x54483330) {
+    // Never recalibrated: the factory record
+    if (!m_eeprom->read(Config::Hardware::CALIBRATION_FACTORY_ADDR, &data, sizeof(data))) {
+        return false;
+    }
+    if (data.magic != 0x54483330) {
         std::cout << "[SkinSensor] No valid calibration data in EEPROM" << std::endl;
         return false;
     }
-
-    // Validate CRC
-    uint16_t storedCRC = data->checksum;
-    data->checksum = 0;
-    uint16_t calculatedCRC = calculateCRC16(buffer, sizeof(buffer));
-
-    if (storedCRC != calculatedCRC) {
+    if (!isValidCalibration(data)) {
         std::cout << "[SkinSensor] Calibration data CRC mismatch" << std::endl;
         return false;
     }
 
-    // Copy validated data
-    std::memcpy(&m_calibration, data, sizeof(CalibrationData));
-    std::cout << "[SkinSensor] Calibration loaded from EEPROM" << std::endl;
-
+    m_calibration = data;
+    std::cout << "[SkinSensor] Factory calibration loaded from EEPROM" << std::endl;
     return true;
 }
 
 bool SkinSensor::saveCalibration()
 {
+    static_assert(sizeof(CalibrationData) + EepromSlotTable::HEADER_SIZE <= Config::Hardware::CALIBRATION_SLOT_SIZE,
+                  "CalibrationData does not fit a calibration slot");
+
     // Calculate CRC
     m_calibration.checksum = 0;
-    m_calibration.checksum = calculateCRC16(
-        reinterpret_cast<uint8_t*>(&m_calibration),
-        sizeof(CalibrationData)
-    );
+    m_calibration.checksum = Crc16::compute(&m_calibration, sizeof(CalibrationData));
 
-    // Write to EEPROM (in real implementation, handle page boundaries)
-    // EEPROM write is typically done byte-by-byte or in pages
+    // Next history slot; only pages that changed are written
+    if (!m_calibrationSlots || !m_calibrationSlots->save(&m_calibration, sizeof(CalibrationData))) {
+        return false;
+    }
+    std::cout << "[SkinSensor] Calibration saved to EEPROM (version "
+              << m_calibrationSlots->history().front().sequence << ")" << std::endl;
     return true;
 }
 
+std::vector<SkinSensor::CalibrationData> SkinSensor::getCalibrationHistory()
+{
+    std::vector<CalibrationData> history;
+    if (!m_calibrationSlots) {
+        return history;
+    }
+    for (const auto& entry : m_calibrationSlots->history()) {
+        CalibrationData data;
+        if (m_calibrationSlots->load(entry, &data, sizeof(data)) && isValidCalibration(data)) {
+            history.push_back(data);
+        }
+    }
+    return history;
+}
+
+bool SkinSensor::isValidCalibration(const CalibrationData& data)
+{
+    CalibrationData copy = data;
+    copy.checksum = 0;
+    return data.magic == 0x54483330 && Crc16::compute(&copy, sizeof(copy)) == data.checksum;
+}
+
 bool SkinSensor::isReady() const
 {
     return m_initialized;
@@ -318,43 +298,52 @@ SkinSensor::SensorData SkinSensor::readSensorData()
     SensorData data;
 
     // Timestamp
-    auto now = std::chrono::system_clock::now();
-    data.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()).count();
+    data.timestamp = m_clock->unixTimeMs();
 
     // Patient info
     data.patientName = m_patientName;
     data.birthDate = m_birthDate;
 
-    // Read temperature first for compensation
-    data.temperatureC = readTemperature();
-    m_lastTemperature = data.temperatureC;
+    // All devices convert in parallel; see acquireFrame()
+    RawFrame frame;
+    acquireFrame(frame);
 
-    // Read photodiode sensors via ADC
+    // One SHT31 measurement gives temperature (for compensation) and humidity
+    ClimateReading climate = frame.climate;
+    if (frame.climateValid) {
+        m_lastTemperature = climate.temperatureC;
+        m_lastHumidity = climate.humidityRH;
+    } else {
+        climate.temperatureC = m_lastTemperature;
+        climate.humidityRH = m_lastHumidity;
+    }
+    data.temperatureC = climate.temperatureC;
+
+    // Photodiode sensors via ADC
     // ADS1115 channels: AIN0=PD1, AIN1=PD2, AIN2=Thickness
-    data.pd1 = readADC(0) + m_calibration.pdOffset1;
-    data.pd2 = readADC(1) + m_calibration.pdOffset2;
+    data.pd1 = frame.adc[0] + m_calibration.pdOffset1;
+    data.pd2 = frame.adc[1] + m_calibration.pdOffset2;
 
     // Store raw ADC values for debugging
     data.adcRaw[0] = static_cast<uint16_t>(data.pd1);
     data.adcRaw[1] = static_cast<uint16_t>(data.pd2);
 
     // Measurement frequency (from system configuration)
-    data.hz = 50.0f;
+    data.hz = Config::Hardware::MEASUREMENT_HZ;
 
-    // Read moisture sensor (SHT31)
-    float rawMoisture = readMoisture();
+    // Map humidity to skin moisture scale (typically 30-80% RH maps to skin moisture)
+    float rawMoisture = climate.humidityRH * 0.8f + 10.0f;
     data.s1 = (rawMoisture * m_calibration.moistureScale) + m_calibration.moistureOffset;
 
     // Apply temperature compensation
     data.s1 = compensateTemperature(data.s1, data.temperatureC);
 
-    // Read elasticity via ToF sensor (VL6180X)
-    float rawElasticity = readElasticity();
+    // Elasticity via ToF sensor (VL6180X)
+    float rawElasticity = frame.range;
     data.s2 = (rawElasticity * m_calibration.elasticityScale) + m_calibration.elasticityOffset;
 
-    // Read thickness via ADC channel 2
-    float rawThickness = readADC(2);
+    // Thickness via ADC channel 2
+    float rawThickness = frame.adc[2];
     data.s3 = (rawThickness * m_calibration.thicknessScale) + m_calibration.thicknessOffset;
     data.adcRaw[2] = static_cast<uint16_t>(rawThickness);
 
@@ -371,29 +360,9 @@ SkinSensor::SensorData SkinSensor::readSensorData()
 }
 
 //==============================================================================
-// Hardware Communication
+// ADS1115 Conversions
 //==============================================================================
 
-bool SkinSensor::i2cWriteRegister(uint8_t addr, uint8_t reg, uint8_t value)
-{
-    return m_i2c ? m_i2c->writeRegister(addr, reg, value) : false;
-}
-
-bool SkinSensor::i2cWriteRegister16(uint8_t addr, uint8_t reg, uint16_t value)
-{
-    return m_i2c ? m_i2c->writeRegister16(addr, reg, value) : false;
-}
-
-uint8_t SkinSensor::i2cReadRegister(uint8_t addr, uint8_t reg)
-{
-    return m_i2c ? m_i2c->readRegister(addr, reg) : 0;
-}
-
-uint16_t SkinSensor::i2cReadRegister16(uint8_t addr, uint8_t reg)
-{
-    return m_i2c ? m_i2c->readRegister16(addr, reg) : 0;
-}
-
 float SkinSensor::readADC(uint8_t channel)
 {
     /**
@@ -405,97 +374,507 @@ float SkinSensor::readADC(uint8_t channel)
      *
      * Reference: TI ADS1115 Datasheet Section 8.5
      */
+    if (channel > 2) {
+        return 0.0f;
+    }
 
+    // Oversampling: the ADC free-runs in continuous mode for the whole block
+    const size_t samples = m_adcSampleBuffer.size();
+    uint64_t readySequence = startAdcConversion(channel);
+
+    for (size_t i = 0; i < samples; i++) {
+        if (!waitForConversion(readySequence)) {
+            std::cerr << "[SkinSensor] ADC conversion timeout (AIN" << static_cast<int>(channel) << ")" << std::endl;
+        }
+        m_adcSampleBuffer[i] = readAdcRaw();
+    }
+
+    if (adcContinuous()) {
+        stopAdcConversion();
+    }
+
+    return adcToSensorUnits(m_adcFilter.decimate(m_adcSampleBuffer.data(), samples));
+}
+
+uint16_t SkinSensor::adcConversionConfig(uint8_t channel) const
+{
     // Select channel via MUX bits
-    uint16_t config = HAL::ADC::CFG_OS_SINGLE |
-                      HAL::ADC::CFG_PGA_4V |
-                      HAL::ADC::CFG_MODE_SINGLE |
-                      HAL::ADC::CFG_DR_128SPS;
+    uint16_t config = HAL::ADC::CFG_PGA_4V |
+                      m_adcDataRate |
+                      (m_adcReadyMode == AdcReadyMode::DRDY_INTERRUPT ?
+                           HAL::ADC::CFG_COMP_QUE_1CONV : HAL::ADC::CFG_COMP_QUE_DISABLE);
+
+    // Continuous mode restarts conversions on the new channel immediately
+    if (adcContinuous()) {
+        config |= HAL::ADC::CFG_MODE_CONTINUOUS;
+    } else {
+        config |= HAL::ADC::CFG_OS_SINGLE | HAL::ADC::CFG_MODE_SINGLE;
+    }
 
     switch (channel) {
         case 0: config |= HAL::ADC::CFG_MUX_AIN0; break;
         case 1: config |= HAL::ADC::CFG_MUX_AIN1; break;
-        case 2: config |= HAL::ADC::CFG_MUX_AIN2; break;
-        default: return 0.0f;
+        default: config |= HAL::ADC::CFG_MUX_AIN2; break;
     }
+    return config;
+}
+
+uint64_t SkinSensor::adcReadySnapshot()
+{
+    // Taken before the config write so a pulse arriving before we wait is not lost
+    std::lock_guard<std::mutex> lock(m_adcMutex);
+    return m_adcReadySequence;
+}
 
-    // Write config and start conversion
-    i2cWriteRegister16(HAL::I2C::ADDR_PHOTODIODE_ADC, HAL::ADC::REG_CONFIG, config);
+uint64_t SkinSensor::startAdcConversion(uint8_t channel)
+{
+    uint64_t readySequence = adcReadySnapshot();
+    m_bus.adcWriteRegister(HAL::ADC::REG_CONFIG, adcConversionConfig(channel));
+    return readySequence;
+}
 
-    // Wait for conversion (128 SPS = ~8ms per conversion)
-    std::this_thread::sleep_for(std::chrono::milliseconds(Config::Hardware::ADC_SETTLING_MS));
+uint64_t SkinSensor::queueAdcConversion(HAL::I2CBatch& batch, uint8_t channel)
+{
+    uint64_t readySequence = adcReadySnapshot();
+    m_bus.queueAdcWrite(batch, HAL::ADC::REG_CONFIG, adcConversionConfig(channel));
+    return readySequence;
+}
 
-    // Read result
-    uint16_t rawValue = i2cReadRegister16(HAL::I2C::ADDR_PHOTODIODE_ADC, HAL::ADC::REG_CONVERSION);
+uint16_t SkinSensor::adcStopConfig() const
+{
+    // Back to single-shot: the ADS1115 powers down after the current conversion
+    return HAL::ADC::CFG_PGA_4V |
+           HAL::ADC::CFG_MODE_SINGLE |
+           m_adcDataRate |
+           HAL::ADC::CFG_COMP_QUE_DISABLE;
+}
 
+void SkinSensor::stopAdcConversion()
+{
+    m_bus.adcWriteRegister(HAL::ADC::REG_CONFIG, adcStopConfig());
+}
+
+int16_t SkinSensor::readAdcRaw()
+{
+    // Conversion register is two's complement
+    return static_cast<int16_t>(m_bus.adcReadRegister(HAL::ADC::REG_CONVERSION));
+}
+
+float SkinSensor::adcToSensorUnits(float counts) const
+{
     // Convert to voltage: LSB = VREF / 2^15 (for single-ended)
-    float voltage = static_cast<float>(rawValue) * HAL::ADC::VREF / 32768.0f;
+    float voltage = counts * HAL::ADC::VREF / 32768.0f;
 
     // Convert voltage to sensor units (device-specific scaling)
     return voltage * 30.0f + 100.0f;  // Scale to ~100-220 range
 }
 
-float SkinSensor::readMoisture()
+//==============================================================================
+// ADC Conversion Completion
+//==============================================================================
+
+bool SkinSensor::configureAdcReady()
+{
+    if (m_adcReadyMode != AdcReadyMode::DRDY_INTERRUPT) {
+        return true;
+    }
+
+    // Conversion-ready mode: ALERT/RDY pulses low once per completed conversion
+    bool ok = m_bus.adcWriteRegister(HAL::ADC::REG_HI_THRESH, HAL::ADC::THRESH_RDY_HI) &&
+              m_bus.adcWriteRegister(HAL::ADC::REG_LO_THRESH, HAL::ADC::THRESH_RDY_LO);
+
+    if (ok) {
+        m_gpio->setPullMode(HAL::GPIO::PIN_ADC_DRDY, HAL::GPIOInterface::PullMode::UP);
+        ok = m_gpio->setInterrupt(HAL::GPIO::PIN_ADC_DRDY, HAL::GPIOInterface::Edge::FALLING,
+                                  &SkinSensor::onAdcReady, this);
+    }
+
+    if (!ok) {
+        std::cerr << "[SkinSensor] ADC DRDY interrupt unavailable, polling status register" << std::endl;
+        m_adcReadyMode = AdcReadyMode::POLL_STATUS;
+        return false;
+    }
+    return true;
+}
+
+void SkinSensor::onAdcReady(int /*pin*/, void* userData)
+{
+    SkinSensor* self = static_cast<SkinSensor*>(userData);
+    {
+        std::lock_guard<std::mutex> lock(self->m_adcMutex);
+        self->m_adcReadySequence++;
+    }
+    self->m_clock->notify(self->m_adcReadyCv);
+}
+
+std::chrono::microseconds SkinSensor::adcCheckDelay() const
+{
+    const int conversionUs = HAL::ADC::conversionTimeUs(m_adcDataRate);
+
+    switch (m_adcReadyMode) {
+        case AdcReadyMode::FIXED_DELAY:
+            // Legacy behaviour, stretched if the data rate is slower than the fixed wait
+            return std::chrono::microseconds(
+                std::max(Config::Hardware::ADC_SETTLING_MS * 1000, conversionUs + conversionUs / 10));
+
+        case AdcReadyMode::POLL_STATUS:
+            // Single-shot: sleep through the fastest possible conversion (-10%), then
+            // poll OS. Continuous: OS never reads idle, so pace by the slowest (+10%)
+            return std::chrono::microseconds(adcContinuous() ? conversionUs + conversionUs / 10
+                                                             : conversionUs - conversionUs / 10);
+
+        case AdcReadyMode::DRDY_INTERRUPT:
+            break;
+    }
+    return std::chrono::microseconds(0);
+}
+
+bool SkinSensor::waitForConversion(uint64_t& readySequence)
+{
+    const auto timeout = std::chrono::milliseconds(Config::Hardware::ADC_READY_TIMEOUT_MS);
+
+    switch (m_adcReadyMode) {
+        case AdcReadyMode::FIXED_DELAY:
+            m_clock->sleepFor(adcCheckDelay());
+            return true;
+
+        case AdcReadyMode::POLL_STATUS: {
+            auto deadline = m_clock->now() + timeout;
+            m_clock->sleepFor(adcCheckDelay());
+            while (!isConversionReady(readySequence)) {
+                if (m_clock->now() >= deadline) {
+                    return false;
+                }
+                m_clock->sleepFor(std::chrono::microseconds(Config::Hardware::ADC_POLL_INTERVAL_US));
+            }
+            return true;
+        }
+
+        case AdcReadyMode::DRDY_INTERRUPT: {
+            std::unique_lock<std::mutex> lock(m_adcMutex);
+            bool ready = m_clock->waitUntil(lock, m_adcReadyCv, m_clock->now() + timeout, [&]() {
+                return m_adcReadySequence != readySequence;
+            });
+            readySequence = m_adcReadySequence;
+            return ready;
+        }
+    }
+    return false;
+}
+
+//==============================================================================
+// SHT31 / VL6180X
+//==============================================================================
+
+int SkinSensor::queueClimateMeasurement(HAL::I2CBatch& batch)
 {
     /**
-     * SHT31 humidity reading sequence:
-     * 1. Send measurement command
-     * 2. Wait for measurement (clock stretching or delay)
+     * SHT31 single-shot measurement (clock stretching disabled):
+     * 1. Send measurement command for the selected repeatability
+     * 2. Wait for measurement
      * 3. Read 6 bytes: Temp MSB, Temp LSB, Temp CRC, Hum MSB, Hum LSB, Hum CRC
      *
-     * Reference: Sensirion SHT31 Datasheet Section 4.5
+     * Reference: Sensirion SHT31 Datasheet Section 4.3 - 4.5
      */
+    uint16_t cmd;
+    int delayMs;
+    switch (m_climateRepeatability) {
+        case Repeatability::LOW:
+            cmd = HAL::MoistureSensor::CMD_MEASURE_LOW_REP;
+            delayMs = HAL::MoistureSensor::MEASURE_DELAY_LOW_MS;
+            break;
+        case Repeatability::MEDIUM:
+            cmd = HAL::MoistureSensor::CMD_MEASURE_MED_REP;
+            delayMs = HAL::MoistureSensor::MEASURE_DELAY_MED_MS;
+            break;
+        case Repeatability::HIGH:
+        default:
+            cmd = HAL::MoistureSensor::CMD_MEASURE_HIGH_REP;
+            delayMs = HAL::MoistureSensor::MEASURE_DELAY_HIGH_MS;
+            break;
+    }
 
-    // Send high repeatability measurement command
-    uint16_t cmd = HAL::MoistureSensor::CMD_MEASURE_HIGH_REP;
-    i2cWriteRegister16(HAL::I2C::ADDR_MOISTURE_SENSOR, (cmd >> 8), (cmd & 0xFF));
-
-    // Wait for measurement
-    std::this_thread::sleep_for(std::chrono::milliseconds(HAL::MoistureSensor::MEASURE_DELAY_HIGH_MS));
+    // 16-bit command, MSB first
+    batch.write(HAL::I2C::ADDR_MOISTURE_SENSOR, {static_cast<uint8_t>(cmd >> 8), static_cast<uint8_t>(cmd & 0xFF)});
+    return delayMs;
+}
 
-    // Read response
+bool SkinSensor::collectClimate(ClimateReading& reading)
+{
     uint8_t buffer[6];
-    m_i2c->readBytes(HAL::I2C::ADDR_MOISTURE_SENSOR, buffer, 6);
+    if (!m_bus.read(HAL::I2C::ADDR_MOISTURE_SENSOR, buffer, sizeof(buffer))) {
+        std::cerr << "[SkinSensor] SHT31 read failed" << std::endl;
+        return false;
+    }
+
+    if (Crc8::compute(&buffer[0], 2) != buffer[2] || Crc8::compute(&buffer[3], 2) != buffer[5]) {
+        std::cerr << "[SkinSensor] SHT31 CRC mismatch" << std::endl;
+        return false;
+    }
 
-    // Parse humidity (bytes 3-4)
-    uint16_t rawHumidity = (buffer[3] << 8) | buffer[4];
+    uint16_t rawTemp = static_cast<uint16_t>((buffer[0] << 8) | buffer[1]);
+    uint16_t rawHumidity = static_cast<uint16_t>((buffer[3] << 8) | buffer[4]);
+
+    // Convert to °C: T = -45 + 175 * rawTemp / 65535
+    reading.temperatureC = -45.0f + 175.0f * static_cast<float>(rawTemp) / 65535.0f;
 
     // Convert to %RH: RH = 100 * rawHumidity / 65535
-    float humidity = 100.0f * static_cast<float>(rawHumidity) / 65535.0f;
+    reading.humidityRH = 100.0f * static_cast<float>(rawHumidity) / 65535.0f;
 
-    // Map humidity to skin moisture scale (typically 30-80% RH maps to skin moisture)
-    return humidity * 0.8f + 10.0f;
+    return true;
 }
 
-float SkinSensor::readTemperature()
+void SkinSensor::queueRange(HAL::I2CBatch& batch)
 {
-    // Temperature is also read from SHT31 (bytes 0-1 of moisture reading)
-    uint16_t cmd = HAL::MoistureSensor::CMD_MEASURE_HIGH_REP;
-    i2cWriteRegister16(HAL::I2C::ADDR_MOISTURE_SENSOR, (cmd >> 8), (cmd & 0xFF));
+    /**
+     * VL6180X ToF reading for elasticity measurement:
+     * Measures skin deformation depth under controlled pressure
+     *
+     * Single-shot ranging: write SYSRANGE__START, poll the interrupt status
+     * for a new sample, read RESULT__RANGE_VAL, clear the interrupt.
+     *
+     * Reference: ST VL6180X Datasheet Section 2.4, AN4545
+     */
+    const uint16_t index = HAL::ToFSensor::REG_SYSRANGE_START;
+    batch.write(HAL::I2C::ADDR_ELASTICITY_SENSOR,
+                {static_cast<uint8_t>(index >> 8), static_cast<uint8_t>(index & 0xFF),
+                 HAL::ToFSensor::RANGE_START_SINGLE});
+}
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(HAL::MoistureSensor::MEASURE_DELAY_HIGH_MS));
+bool SkinSensor::isRangeReady()
+{
+    uint8_t status = m_bus.tofReadRegister(HAL::ToFSensor::REG_RESULT_INTERRUPT_STATUS);
+    return (status & HAL::ToFSensor::INT_STATUS_RANGE_MASK) == HAL::ToFSensor::INT_CONFIG_NEW_SAMPLE;
+}
 
-    uint8_t buffer[6];
-    m_i2c->readBytes(HAL::I2C::ADDR_MOISTURE_SENSOR, buffer, 6);
+bool SkinSensor::collectRange(float& range)
+{
+    // Result read and interrupt clear in one submission
+    const uint16_t rangeIndex = HAL::ToFSensor::REG_RESULT_RANGE_VAL;
+    const uint16_t clearIndex = HAL::ToFSensor::REG_INTERRUPT_CLEAR;
+    uint8_t value = 0;
+
+    HAL::I2CBatch batch;
+    batch.writeRead(HAL::I2C::ADDR_ELASTICITY_SENSOR,
+                    {static_cast<uint8_t>(rangeIndex >> 8), static_cast<uint8_t>(rangeIndex & 0xFF)}, &value, 1);
+    batch.write(HAL::I2C::ADDR_ELASTICITY_SENSOR,
+                {static_cast<uint8_t>(clearIndex >> 8), static_cast<uint8_t>(clearIndex & 0xFF),
+                 HAL::ToFSensor::INT_CLEAR_ALL});
+    m_bus.submit(batch);
+
+    range = static_cast<float>(value);
+    return batch.ok(0);
+}
 
-    uint16_t rawTemp = (buffer[0] << 8) | buffer[1];
+//==============================================================================
+// Pipelined Acquisition
+//==============================================================================
 
-    // Convert to °C: T = -45 + 175 * rawTemp / 65535
-    return -45.0f + 175.0f * static_cast<float>(rawTemp) / 65535.0f;
+bool SkinSensor::isConversionReady(uint64_t& readySequence)
+{
+    switch (m_adcReadyMode) {
+        case AdcReadyMode::DRDY_INTERRUPT: {
+            std::lock_guard<std::mutex> lock(m_adcMutex);
+            if (m_adcReadySequence == readySequence) {
+                return false;
+            }
+            readySequence = m_adcReadySequence;
+            return true;
+        }
+        case AdcReadyMode::POLL_STATUS:
+            if (adcContinuous()) {
+                return true;    // Paced by adcCheckDelay()
+            }
+            return (m_bus.adcReadRegister(HAL::ADC::REG_CONFIG) & HAL::ADC::CFG_OS_IDLE) != 0;
+        case AdcReadyMode::FIXED_DELAY:
+            return true;    // Caller schedules the check after the fixed wait
+    }
+    return true;
 }
 
-float SkinSensor::readElasticity()
+void SkinSensor::acquireFrame(RawFrame& frame)
 {
     /**
-     * VL6180X ToF reading for elasticity measurement:
-     * Measures skin deformation depth under controlled pressure
+     * The ADS1115, SHT31 and VL6180X convert independently. Every
+     * conversion is started up front, then this loop sleeps until the
+     * earliest device is due (or the ADS1115 ALERT/RDY pulse arrives) and
+     * collects it. All bus traffic stays on this thread, so I2C accesses
+     * remain serialized; a frame takes about as long as the slowest device
+     * (SHT31, or the three back-to-back ADS1115 conversions at low rates).
+     *
+     * With oversampling each ADS1115 channel free-runs in continuous mode
+     * for ADC_SAMPLES_PER_READ conversions and the block is decimated.
      *
-     * Reference: ST VL6180X Datasheet Section 2.4
+     * Bus round trips are kept down by submitting the three start commands
+     * as one batch, reading the last sample of a channel together with the
+     * config write that starts the next one, and reading repeated samples
+     * without rewriting the ADS1115 pointer register.
      */
+    using TimePoint = Clock::TimePoint;
+    const auto start = m_clock->now();
+
+    // ADS1115 wait before each readiness check, per mode
+    const std::chrono::microseconds adcDelay = adcCheckDelay();
+    const size_t adcSamples = m_adcSampleBuffer.size();
+
+    // Oversampling with long fixed waits can legitimately exceed the frame budget
+    const auto giveUp = start + std::max<std::chrono::microseconds>(
+        std::chrono::milliseconds(Config::Hardware::ACQUISITION_TIMEOUT_MS),
+        adcDelay * static_cast<int>(3 * adcSamples) + std::chrono::milliseconds(Config::Hardware::ADC_READY_TIMEOUT_MS));
+
+    auto elapsedUs = [&start](TimePoint t) {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(t - start).count());
+    };
+
+    frame.climate.temperatureC = m_lastTemperature;
+    frame.climate.humidityRH = m_lastHumidity;
+    frame.climateValid = false;
+    frame.range = 0.0f;
+    frame.rangeValid = false;
+    AcquisitionTiming timing = AcquisitionTiming();
+    const uint32_t busTransactionsBefore = m_bus.getTransactions();
+    const uint32_t busCallsBefore = m_bus.getCalls();
+
+    // A DRDY pulse sooner than this after a channel switch belongs to the previous channel
+    const auto adcMinConversion = std::chrono::microseconds(HAL::ADC::conversionTimeUs(m_adcDataRate) * 9 / 10);
+
+    // 1. Start every conversion with one submission
+    HAL::I2CBatch startBatch;
+    int climateDelayMs = queueClimateMeasurement(startBatch);
+    queueRange(startBatch);
+    uint64_t adcSequence = queueAdcConversion(startBatch, 0);
+    m_bus.submit(startBatch);
+
+    const TimePoint started = m_clock->now();
+    bool climatePending = startBatch.ok(0);
+    TimePoint climateDue = started + std::chrono::milliseconds(climateDelayMs);
+    if (!climatePending) {
+        std::cerr << "[SkinSensor] SHT31 command failed" << std::endl;
+    }
+
+    bool rangePending = startBatch.ok(1);
+    TimePoint rangeDue = started + std::chrono::milliseconds(HAL::ToFSensor::RANGE_TIME_TYPICAL_MS);
+
+    int adcChannel = 0;
+    size_t adcSample = 0;
+    TimePoint adcStarted = started;
+    TimePoint adcDue = adcStarted + adcDelay;
+
+    // 2. Collect each device as it becomes ready
+    while (climatePending || rangePending || adcChannel < 3) {
+        auto now = m_clock->now();
 
-    // In actual implementation: read range from VL6180X registers
-    // Simulated: return value in range for elasticity measurement
-    return 50.0f + (std::rand() % 30);
+        if (climatePending && now >= climateDue) {
+            frame.climateValid = collectClimate(frame.climate);
+            timing.climateUs = elapsedUs(m_clock->now());
+            climatePending = false;
+        }
+
+        if (rangePending && now >= rangeDue) {
+            if (isRangeReady()) {
+                frame.rangeValid = collectRange(frame.range);
+                timing.rangeUs = elapsedUs(m_clock->now());
+                rangePending = false;
+            } else {
+                rangeDue = now + std::chrono::microseconds(Config::Hardware::TOF_POLL_INTERVAL_US);
+            }
+        }
+
+        if (adcChannel < 3 && now >= adcDue) {
+            bool timedOut = now - adcStarted >= std::chrono::milliseconds(Config::Hardware::ADC_READY_TIMEOUT_MS);
+            bool ready = isConversionReady(adcSequence);
+            if (ready && adcSample == 0 && m_adcReadyMode == AdcReadyMode::DRDY_INTERRUPT &&
+                now - adcStarted < adcMinConversion) {
+                ready = false;      // Stale pulse; adcSequence has moved past it
+            }
+
+            if (ready || timedOut) {
+                if (timedOut) {
+                    std::cerr << "[SkinSensor] ADC conversion timeout (AIN" << adcChannel << ")" << std::endl;
+                }
+
+                if (adcSample + 1 < adcSamples) {
+                    m_adcSampleBuffer[adcSample++] = readAdcRaw();
+                } else {
+                    // Last sample of the block, read together with the next config
+                    // write (the next channel, or back to single-shot)
+                    uint8_t raw[2] = {0xFF, 0xFF};
+                    HAL::I2CBatch batch;
+                    m_bus.queueAdcRead(batch, raw);
+                    if (adcChannel + 1 < 3) {
+                        adcSequence = queueAdcConversion(batch, static_cast<uint8_t>(adcChannel + 1));
+                    } else if (adcContinuous()) {
+                        m_bus.queueAdcWrite(batch, HAL::ADC::REG_CONFIG, adcStopConfig());
+                    }
+                    m_bus.submit(batch);
+                    m_adcSampleBuffer[adcSample++] = static_cast<int16_t>((raw[0] << 8) | raw[1]);
+                }
+                adcStarted = m_clock->now();
+                adcDue = adcStarted + adcDelay;
+
+                if (adcSample == adcSamples) {
+                    frame.adc[adcChannel] = adcToSensorUnits(
+                        m_adcFilter.decimate(m_adcSampleBuffer.data(), adcSamples));
+                    timing.adcUs[adcChannel] = elapsedUs(adcStarted);
+                    adcSample = 0;
+
+                    // One multiplexer: the next channel was started by the read above
+                    adcChannel++;
+                }
+            } else if (m_adcReadyMode == AdcReadyMode::POLL_STATUS) {
+                adcDue = now + std::chrono::microseconds(Config::Hardware::ADC_POLL_INTERVAL_US);
+            }
+        }
+
+        if (!climatePending && !rangePending && adcChannel >= 3) {
+            break;
+        }
+
+        if (now >= giveUp) {
+            if (climatePending || rangePending || adcChannel < 3) {
+                std::cerr << "[SkinSensor] Acquisition timeout" << std::endl;
+            }
+            for (; adcChannel < 3; adcChannel++) {
+                frame.adc[adcChannel] = adcToSensorUnits(readAdcRaw());
+            }
+            if (adcContinuous()) {
+                stopAdcConversion();
+            }
+            break;
+        }
+
+        // Sleep until the next device is due
+        TimePoint next = giveUp;
+        if (climatePending) next = std::min(next, climateDue);
+        if (rangePending) next = std::min(next, rangeDue);
+        bool adcByEvent = adcChannel < 3 && m_adcReadyMode == AdcReadyMode::DRDY_INTERRUPT;
+        if (adcChannel < 3 && !adcByEvent) next = std::min(next, adcDue);
+        if (adcByEvent) {
+            next = std::min(next, adcStarted + std::chrono::milliseconds(Config::Hardware::ADC_READY_TIMEOUT_MS));
+        }
+
+        auto waitStart = m_clock->now();
+        if (next <= waitStart) {
+            continue;
+        }
+        if (adcByEvent) {
+            std::unique_lock<std::mutex> lock(m_adcMutex);
+            m_clock->waitUntil(lock, m_adcReadyCv, next, [&]() { return m_adcReadySequence != adcSequence; });
+        } else {
+            m_clock->sleepUntil(next);
+        }
+        timing.busWaitUs += elapsedUs(m_clock->now()) - elapsedUs(waitStart);
+    }
+
+    if (climatePending || rangePending) {
+        std::cerr << "[SkinSensor] Sensor not ready:"
+                  << (climatePending ? " SHT31" : "") << (rangePending ? " VL6180X" : "") << std::endl;
+    }
+
+    timing.totalUs = elapsedUs(m_clock->now());
+    timing.busTransactions = m_bus.getTransactions() - busTransactionsBefore;
+    timing.busCalls = m_bus.getCalls() - busCallsBefore;
+    m_lastTiming = timing;
 }
 
 float SkinSensor::compensateTemperature(float value, float tempC)
@@ -514,9 +893,7 @@ SkinSensor::TreatmentData SkinSensor::createTreatmentData(TreatmentMode mode)
 {
     TreatmentData data;
 
-    auto now = std::chrono::system_clock::now();
-    data.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()).count();
+    data.timestamp = m_clock->unixTimeMs();
 
     data.mode = mode;
     data.patientName = m_patientName;
@@ -615,22 +992,3 @@ uint8_t SkinSensor::selfTest()
 
     return status;
 }
-
-uint16_t SkinSensor::calculateCRC16(const uint8_t* data, size_t length)
-{
-    // CRC-16-CCITT implementation
-    uint16_t crc = 0xFFFF;
-
-    for (size_t i = 0; i < length; i++) {
-        crc ^= static_cast<uint16_t>(data[i]) << 8;
-        for (int j = 0; j < 8; j++) {
-            if (crc & 0x8000) {
-                crc = (crc << 1) ^ 0x1021;
-            } else {
-                crc <<= 1;
-            }
-        }
-    }
-
-    return crc;
-}
@@ -0,0 +1,133 @@
+#include "TelemetryBatcher.h"
+#include "BatchReplay.h"
+#include "Config.h"
+#include <memory>
+
+TelemetryBatcher::TelemetryBatcher(HttpClient& client)
+    : TelemetryBatcher(client,
+                       Config::TELEMETRY_BATCH_MAX_RECORDS,
+                       Config::TELEMETRY_BATCH_MAX_BYTES,
+                       Config::DATA_SEND_INTERVAL_MS)
+{
+}
+
+TelemetryBatcher::TelemetryBatcher(HttpClient& client, size_t maxRecords, size_t maxBytes, int maxAgeMs)
+    : m_client(client)
+    , m_clock(&Clock::system())
+    , m_endpoint(Config::API_ENDPOINT_TELEMETRY)
+    , m_maxRecords(maxRecords > 0 ? maxRecords : 1)
+    , m_maxBytes(maxBytes)
+    , m_maxAge(maxAgeMs)
+    , m_pendingRecords(0)
+    , m_inFlight(0)
+    , m_stats()
+{
+    // Reserve once; the buffer is reused for every batch
+    m_body.reserve(m_maxBytes);
+    resetBody();
+}
+
+void TelemetryBatcher::resetBody()
+{
+    m_body.clear();
+    m_body.push_back('[');
+    m_pendingRecords = 0;
+}
+
+bool TelemetryBatcher::add(const std::string& recordJson)
+{
+    bool ok = true;
+
+    // +2: separator and closing bracket
+    if (m_pendingRecords > 0 && m_body.size() + recordJson.size() + 2 > m_maxBytes) {
+        ok = flush();
+    }
+
+    if (m_pendingRecords == 0) {
+        m_oldestRecord = m_clock->now();
+    } else {
+        m_body.push_back(',');
+    }
+    m_body.append(recordJson);
+    m_pendingRecords++;
+    m_stats.recordsAdded++;
+
+    if (m_pendingRecords >= m_maxRecords || m_body.size() + 1 >= m_maxBytes) {
+        ok = flush() && ok;
+    }
+
+    return ok;
+}
+
+bool TelemetryBatcher::poll()
+{
+    if (m_pendingRecords == 0) {
+        return true;
+    }
+    if (m_clock->now() - m_oldestRecord < m_maxAge) {
+        return true;
+    }
+    return flush();
+}
+
+bool TelemetryBatcher::flush()
+{
+    if (m_pendingRecords == 0) {
+        return true;
+    }
+
+    m_body.push_back(']');
+    size_t count = m_pendingRecords;
+
+    if (m_dispatch) {
+        // The body goes with the request; the next batch starts a new buffer
+        auto body = std::make_shared<std::string>();
+        body->swap(m_body);
+        m_body.reserve(m_maxBytes);
+        resetBody();
+
+        m_inFlight++;
+        Dispatcher dispatch = m_dispatch;
+        m_client.postAsync(m_endpoint, *body,
+                           [this, dispatch, body, count](const HttpClient::Response& response) {
+            dispatch([this, response, body, count]() {
+                m_inFlight--;
+                complete(response, *body, count);
+            });
+        });
+        return true;
+    }
+
+    auto response = m_client.post(m_endpoint, m_body);
+    complete(response, m_body, count);
+
+    resetBody();
+    return BatchReplay::classify(response) == BatchReplay::Outcome::SENT;
+}
+
+void TelemetryBatcher::complete(const HttpClient::Response& response, const std::string& body, size_t count)
+{
+    // Same test as replay: any 2xx was accepted and must not be stored again
+    if (BatchReplay::classify(response) == BatchReplay::Outcome::SENT) {
+        m_stats.batchesSent++;
+        m_stats.recordsSent += count;
+        m_stats.bytesSent += body.size();
+    } else {
+        m_stats.batchesFailed++;
+        m_stats.recordsFailed += count;
+        if (m_onFailure) {
+            m_onFailure(body, count, response);
+        }
+    }
+}
+
+std::chrono::milliseconds TelemetryBatcher::timeUntilDeadline() const
+{
+    if (m_pendingRecords == 0) {
+        return std::chrono::milliseconds::max();
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        m_clock->now() - m_oldestRecord);
+    return elapsed >= m_maxAge ? std::chrono::milliseconds(0) : m_maxAge - elapsed;
+}
@@ -0,0 +1,431 @@
+#include "TelemetryCodec.h"
+#include "SensorSchema.h"
+#include <cstring>
+#include <tuple>
+
+namespace TelemetryCodec {
+
+static_assert(std::tuple_size<decltype(Schema::sensorFields())>::value == FIELDS,
+              "TelemetryCodec::FIELDS must match Schema::sensorFields()");
+
+namespace {
+
+const char MAGIC[3] = { 'T', '3', 'G' };
+
+inline uint64_t mask(unsigned bits)
+{
+    return bits >= 64 ? ~0ULL : (1ULL << bits) - 1;
+}
+
+inline unsigned leadingZeros(uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_clz(x));
+#else
+    unsigned n = 0;
+    while (!(x & 0x80000000u)) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+inline unsigned trailingZeros(uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(x));
+#else
+    unsigned n = 0;
+    while (!(x & 1u)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+// Sign-extend the low `bits` of value (two's complement, modulo 2^64)
+inline uint64_t signExtend(uint64_t value, unsigned bits)
+{
+    uint64_t sign = 1ULL << (bits - 1);
+    return (value ^ sign) - sign;
+}
+
+inline uint32_t floatBits(float v)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+void resetChannels(Channel (&channels)[FIELDS])
+{
+    for (auto& channel : channels) {
+        channel.previous = 0;
+        channel.delta = 0;
+        channel.lead = 32;
+        channel.trail = 0;
+        channel.text.clear();
+    }
+}
+
+} // namespace
+
+//==============================================================================
+// Encoder
+//==============================================================================
+
+Encoder::Encoder()
+    : m_out(nullptr)
+    , m_bits(0)
+    , m_fill(0)
+    , m_records(0)
+{
+    resetChannels(m_channels);
+}
+
+void Encoder::begin(std::string& out, const std::string& deviceId)
+{
+    m_out = &out;
+    m_bits = 0;
+    m_fill = 0;
+    m_records = 0;
+    resetChannels(m_channels);
+
+    out.append(MAGIC, sizeof(MAGIC));
+    out.push_back(static_cast<char>(VERSION));
+    Schema::detail::writeBinary(out, deviceId);
+}
+
+void Encoder::put(uint64_t value, unsigned bits)
+{
+    if (bits > 32) {
+        put(value >> 32, bits - 32);
+        bits = 32;
+    }
+
+    // At most 7 pending bits before, so 39 after
+    m_bits = (m_bits << bits) | (value & mask(bits));
+    m_fill += bits;
+    while (m_fill >= 8) {
+        m_fill -= 8;
+        m_out->push_back(static_cast<char>(m_bits >> m_fill));
+    }
+}
+
+void Encoder::encode(Channel& channel, uint64_t value)
+{
+    // Modulo 2^64: any timestamp sequence round-trips
+    uint64_t delta = value - channel.previous;
+    uint64_t bits = delta - channel.delta;
+    int64_t dod = static_cast<int64_t>(bits);
+
+    if (dod == 0) {
+        put(0x0, 1);
+    } else if (dod >= -64 && dod < 64) {
+        put(0x2, 2);
+        put(bits, 7);
+    } else if (dod >= -256 && dod < 256) {
+        put(0x6, 3);
+        put(bits, 9);
+    } else if (dod >= -2048 && dod < 2048) {
+        put(0xE, 4);
+        put(bits, 12);
+    } else if (dod >= INT32_MIN && dod <= INT32_MAX) {
+        put(0x1E, 5);
+        put(bits, 32);
+    } else {
+        put(0x1F, 5);
+        put(bits, 64);
+    }
+
+    // The first record's "interval" is its absolute timestamp
+    channel.delta = (m_records == 0) ? 0 : delta;
+    channel.previous = value;
+}
+
+void Encoder::encode(Channel& channel, float value)
+{
+    uint32_t bits = floatBits(value);
+    uint32_t x = bits ^ static_cast<uint32_t>(channel.previous);
+    channel.previous = bits;
+
+    if (x == 0) {
+        put(0x0, 1);
+        return;
+    }
+
+    unsigned lead = leadingZeros(x);
+    unsigned trail = trailingZeros(x);
+    if (lead >= channel.lead && trail >= channel.trail) {
+        put(0x2, 2);
+        put(x >> channel.trail, 32 - channel.lead - channel.trail);
+        return;
+    }
+
+    unsigned length = 32 - lead - trail;
+    put(0x3, 2);
+    put(lead, 5);
+    put(length - 1, 5);
+    put(x >> trail, length);
+    channel.lead = static_cast<uint8_t>(lead);
+    channel.trail = static_cast<uint8_t>(trail);
+}
+
+void Encoder::encode(Channel& channel, const std::string& value)
+{
+    size_t length = value.size() < 255 ? value.size() : 255;
+    if (channel.text.size() == length && value.compare(0, length, channel.text) == 0) {
+        put(0x0, 1);
+        return;
+    }
+
+    put(0x1, 1);
+    put(length, 8);
+    for (size_t i = 0; i < length; i++) {
+        put(static_cast<uint8_t>(value[i]), 8);
+    }
+    channel.text.assign(value, 0, length);
+}
+
+void Encoder::add(const SkinSensor::SensorData& data)
+{
+    put(0x1, 1);
+
+    size_t i = 0;
+    Schema::forEach(Schema::sensorFields(), [&](const auto& f) {
+        encode(m_channels[i++], data.*(f.member));
+    });
+    m_records++;
+}
+
+void Encoder::finish()
+{
+    put(0x0, 1);
+    if (m_fill > 0) {
+        put(0x0, 8 - m_fill);
+    }
+}
+
+size_t Encoder::size() const
+{
+    return (m_out ? m_out->size() : 0) + (m_fill > 0 ? 1 : 0);
+}
+
+//==============================================================================
+// Decoder
+//==============================================================================
+
+Decoder::Decoder()
+    : m_data(nullptr)
+    , m_end(nullptr)
+    , m_bits(0)
+    , m_fill(0)
+    , m_done(true)
+    , m_failed(false)
+    , m_records(0)
+{
+    resetChannels(m_channels);
+}
+
+bool Decoder::open(const uint8_t* data, size_t length)
+{
+    m_bits = 0;
+    m_fill = 0;
+    m_records = 0;
+    m_deviceId.clear();
+    resetChannels(m_channels);
+
+    const uint8_t* p = data;
+    const uint8_t* end = data + length;
+    if (length < sizeof(MAGIC) + 1 || std::memcmp(p, MAGIC, sizeof(MAGIC)) != 0 ||
+        p[sizeof(MAGIC)] != VERSION) {
+        m_done = m_failed = true;
+        return false;
+    }
+    p += sizeof(MAGIC) + 1;
+    if (!Schema::detail::readBinary(p, end, m_deviceId)) {
+        m_done = m_failed = true;
+        return false;
+    }
+
+    m_data = p;
+    m_end = end;
+    m_done = m_failed = false;
+    return true;
+}
+
+bool Decoder::get(unsigned bits, uint64_t& value)
+{
+    if (bits > 32) {
+        uint64_t high;
+        if (!get(bits - 32, high) || !get(32, value)) {
+            return false;
+        }
+        value |= high << 32;
+        return true;
+    }
+
+    while (m_fill < bits) {
+        if (m_data == m_end) {
+            return false;
+        }
+        m_bits = (m_bits << 8) | *m_data++;
+        m_fill += 8;
+    }
+    m_fill -= bits;
+    value = (m_bits >> m_fill) & mask(bits);
+    return true;
+}
+
+bool Decoder::decode(Channel& channel, uint64_t& value)
+{
+    // Count the leading ones of the prefix, up to five
+    unsigned ones = 0;
+    uint64_t bit = 1;
+    while (ones < 5) {
+        if (!get(1, bit)) {
+            return false;
+        }
+        if (!bit) {
+            break;
+        }
+        ones++;
+    }
+
+    static const unsigned WIDTH[] = { 0, 7, 9, 12, 32, 64 };
+    uint64_t dod = 0;
+    if (ones > 0) {
+        if (!get(WIDTH[ones], dod)) {
+            return false;
+        }
+        if (ones < 5) {
+            dod = signExtend(dod, WIDTH[ones]);
+        }
+    }
+
+    uint64_t delta = channel.delta + dod;
+    value = channel.previous + delta;
+    channel.delta = (m_records == 0) ? 0 : delta;
+    channel.previous = value;
+    return true;
+}
+
+bool Decoder::decode(Channel& channel, float& value)
+{
+    uint64_t control;
+    if (!get(1, control)) {
+        return false;
+    }
+
+    uint32_t x = 0;
+    if (control) {
+        if (!get(1, control)) {
+            return false;
+        }
+        uint64_t bits;
+        if (control) {
+            uint64_t lead, length;
+            if (!get(5, lead) || !get(5, length)) {
+                return false;
+            }
+            length += 1;
+            if (lead + length > 32) {
+                return false;
+            }
+            channel.lead = static_cast<uint8_t>(lead);
+            channel.trail = static_cast<uint8_t>(32 - lead - length);
+        } else if (channel.lead >= 32) {
+            return false;   // No window yet
+        }
+
+        if (!get(32 - channel.lead - channel.trail, bits)) {
+            return false;
+        }
+        x = static_cast<uint32_t>(bits << channel.trail);
+    }
+
+    uint32_t bits = static_cast<uint32_t>(channel.previous) ^ x;
+    channel.previous = bits;
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+bool Decoder::decode(Channel& channel, std::string& value)
+{
+    uint64_t changed;
+    if (!get(1, changed)) {
+        return false;
+    }
+
+    if (changed) {
+        uint64_t length;
+        if (!get(8, length)) {
+            return false;
+        }
+        channel.text.resize(length);
+        for (size_t i = 0; i < length; i++) {
+            uint64_t c;
+            if (!get(8, c)) {
+                return false;
+            }
+            channel.text[i] = static_cast<char>(c);
+        }
+    }
+    value = channel.text;
+    return true;
+}
+
+bool Decoder::next(SkinSensor::SensorData& out)
+{
+    if (m_done) {
+        return false;
+    }
+
+    uint64_t more;
+    if (!get(1, more)) {
+        m_done = m_failed = true;
+        return false;
+    }
+    if (!more) {
+        m_done = true;
+        return false;
+    }
+
+    bool ok = true;
+    size_t i = 0;
+    Schema::forEach(Schema::sensorFields(), [&](const auto& f) {
+        if (ok) ok = decode(m_channels[i++], out.*(f.member));
+    });
+    if (!ok) {
+        m_done = m_failed = true;
+        return false;
+    }
+
+    std::memset(out.adcRaw, 0, sizeof(out.adcRaw));
+    m_records++;
+    return true;
+}
+
+//==============================================================================
+// Whole Batch
+//==============================================================================
+
+bool decodeBatch(const uint8_t* data, size_t length, std::string& deviceId,
+                 std::vector<SkinSensor::SensorData>& out)
+{
+    Decoder decoder;
+    if (!decoder.open(data, length)) {
+        return false;
+    }
+    deviceId = decoder.deviceId();
+
+    SkinSensor::SensorData record = SkinSensor::SensorData();
+    while (decoder.next(record)) {
+        out.push_back(record);
+    }
+    return !decoder.failed();
+}
+
+} // namespace TelemetryCodec
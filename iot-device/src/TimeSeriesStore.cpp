@@ -0,0 +1,482 @@
+#include "TimeSeriesStore.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+    constexpr uint32_t STORE_MAGIC = 0x54483354;    // "T3HT"
+    constexpr uint16_t STORE_VERSION = 1;
+    constexpr size_t SEGMENT_PAGE = 4096;           // Header page; every column starts on a page
+
+    inline size_t alignPage(size_t value)
+    {
+        return (value + SEGMENT_PAGE - 1) & ~(SEGMENT_PAGE - 1);
+    }
+
+    inline size_t columnOffset(size_t capacity, size_t column)
+    {
+        return SEGMENT_PAGE + alignPage(capacity * sizeof(uint64_t)) + column * alignPage(capacity * sizeof(float));
+    }
+
+    inline size_t segmentSize(size_t capacity)
+    {
+        return columnOffset(capacity, TimeSeriesStore::COLUMNS);
+    }
+
+    std::string segmentName(uint64_t sequence)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "seg-%010llu.tss", static_cast<unsigned long long>(sequence));
+        return name;
+    }
+
+    // Sequence of a file named by segmentName(), 0 for any other name
+    uint64_t parseSegmentName(const char* name)
+    {
+        if (std::strncmp(name, "seg-", 4) != 0) {
+            return 0;
+        }
+        uint64_t sequence = std::strtoull(name + 4, nullptr, 10);
+        return (sequence != 0 && segmentName(sequence) == name) ? sequence : 0;
+    }
+
+    const char* const COLUMN_NAMES[TimeSeriesStore::COLUMNS] = {
+        "pd1", "pd2", "s1", "s2", "s3", "moistureLevel", "temperatureC"
+    };
+}
+
+constexpr size_t TimeSeriesStore::COLUMNS;
+
+struct TimeSeriesStore::Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t columns;
+    uint32_t capacity;      // Rows
+    uint32_t rows;          // Published rows
+    uint64_t partition;     // Partition start (Unix ms)
+    uint64_t first;         // Timestamp of row 0
+    uint64_t last;          // Timestamp of the newest row
+};
+
+TimeSeriesStore::TimeSeriesStore()
+    : m_maxBytes(0)
+    , m_segmentRows(0)
+    , m_partitionMs(0)
+    , m_open(false)
+    , m_bytes(0)
+    , m_stats()
+{
+}
+
+TimeSeriesStore::~TimeSeriesStore()
+{
+    close();
+}
+
+//==============================================================================
+// Segment Files
+//==============================================================================
+
+bool TimeSeriesStore::open(const std::string& directory, size_t maxBytes, size_t segmentRows, uint64_t partitionMs)
+{
+    close();
+
+#ifdef _WIN32
+    (void)directory;
+    (void)maxBytes;
+    (void)segmentRows;
+    (void)partitionMs;
+    std::cerr << "[TimeSeriesStore] Memory-mapped store is not supported on this platform" << std::endl;
+    return false;
+#else
+    if (segmentRows == 0 || segmentRows > std::numeric_limits<uint32_t>::max() || partitionMs == 0) {
+        std::cerr << "[TimeSeriesStore] Invalid segment size" << std::endl;
+        return false;
+    }
+    m_directory = directory;
+    m_maxBytes = maxBytes;
+    m_segmentRows = segmentRows;
+    m_partitionMs = partitionMs;
+    m_stats = Stats();
+
+    if (::mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        std::cerr << "[TimeSeriesStore] Cannot create " << directory << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    DIR* dir = ::opendir(directory.c_str());
+    if (!dir) {
+        std::cerr << "[TimeSeriesStore] Cannot open " << directory << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    std::vector<uint64_t> sequences;
+    while (struct dirent* entry = ::readdir(dir)) {
+        uint64_t sequence = parseSegmentName(entry->d_name);
+        if (sequence != 0) {
+            sequences.push_back(sequence);
+        }
+    }
+    ::closedir(dir);
+
+    std::sort(sequences.begin(), sequences.end());
+    for (uint64_t sequence : sequences) {
+        loadSegment(sequence);
+    }
+    recoverNewest();
+
+    m_open = true;
+    enforceRetention();
+    return true;
+#endif
+}
+
+void TimeSeriesStore::close()
+{
+#ifndef _WIN32
+    for (auto& segment : m_segments) {
+        msync(segment.base, segment.size, MS_ASYNC);
+        munmap(segment.base, segment.size);
+        ::close(segment.fd);
+    }
+#endif
+    m_segments.clear();
+    m_bytes = 0;
+    m_open = false;
+}
+
+void TimeSeriesStore::sync(bool wait)
+{
+#ifndef _WIN32
+    if (!m_segments.empty()) {
+        const Segment& newest = m_segments.back();
+        msync(newest.base, newest.size, wait ? MS_SYNC : MS_ASYNC);
+    }
+#else
+    (void)wait;
+#endif
+}
+
+TimeSeriesStore::Header* TimeSeriesStore::header(const Segment& segment)
+{
+    return reinterpret_cast<Header*>(segment.base);
+}
+
+uint64_t* TimeSeriesStore::timestamps(const Segment& segment)
+{
+    return reinterpret_cast<uint64_t*>(segment.base + SEGMENT_PAGE);
+}
+
+float* TimeSeriesStore::values(const Segment& segment, size_t column)
+{
+    return reinterpret_cast<float*>(segment.base + columnOffset(header(segment)->capacity, column));
+}
+
+bool TimeSeriesStore::loadSegment(uint64_t sequence)
+{
+#ifdef _WIN32
+    (void)sequence;
+    return false;
+#else
+    Segment segment{sequence, m_directory + "/" + segmentName(sequence), -1, nullptr, 0};
+
+    bool valid = false;
+    segment.fd = ::open(segment.path.c_str(), O_RDWR);
+    struct stat st;
+    if (segment.fd >= 0 && fstat(segment.fd, &st) == 0 && static_cast<size_t>(st.st_size) >= SEGMENT_PAGE) {
+        segment.size = static_cast<size_t>(st.st_size);
+        void* mapping = mmap(nullptr, segment.size, PROT_READ | PROT_WRITE, MAP_SHARED, segment.fd, 0);
+        if (mapping != MAP_FAILED) {
+            segment.base = static_cast<uint8_t*>(mapping);
+            const Header* h = header(segment);
+            valid = h->magic == STORE_MAGIC && h->version == STORE_VERSION && h->columns == COLUMNS &&
+                    h->capacity > 0 && segment.size == segmentSize(h->capacity) && h->rows <= h->capacity &&
+                    (h->rows == 0 || h->first <= h->last);
+
+            // Segments never overlap in time
+            if (valid && h->rows > 0 && !m_segments.empty()) {
+                const Header* previous = header(m_segments.back());
+                valid = previous->rows == 0 || previous->last <= h->first;
+            }
+        }
+    }
+
+    if (!valid) {
+        std::cerr << "[TimeSeriesStore] Discarding invalid segment " << segment.path << std::endl;
+        if (segment.base) {
+            munmap(segment.base, segment.size);
+        }
+        if (segment.fd >= 0) {
+            ::close(segment.fd);
+        }
+        ::unlink(segment.path.c_str());
+        m_stats.corrupt++;
+        return false;
+    }
+
+    m_segments.push_back(segment);
+    m_bytes += segment.size;
+    return true;
+#endif
+}
+
+void TimeSeriesStore::recoverNewest()
+{
+    if (m_segments.empty()) {
+        return;
+    }
+
+    // Only the newest segment can hold rows whose pages never reached storage
+    Segment& newest = m_segments.back();
+    Header* h = header(newest);
+    const uint64_t* ts = timestamps(newest);
+    uint64_t floor = (m_segments.size() > 1) ? header(m_segments[m_segments.size() - 2])->last : 0;
+
+    uint32_t rows = 0;
+    while (rows < h->rows && ts[rows] >= floor && ts[rows] <= h->last &&
+           ts[rows] - ts[rows] % m_partitionMs == h->partition) {
+        floor = ts[rows];
+        rows++;
+    }
+    if (rows < h->rows) {
+        std::cerr << "[TimeSeriesStore] Truncated " << (h->rows - rows) << " damaged rows in "
+                  << newest.path << std::endl;
+        h->rows = rows;
+    }
+
+    if (rows == 0) {
+        // Appends always go to a segment that already has rows
+        removeSegment(newest);
+        m_segments.pop_back();
+    } else {
+        h->first = ts[0];
+        h->last = ts[rows - 1];
+    }
+}
+
+bool TimeSeriesStore::createSegment(uint64_t partition)
+{
+#ifdef _WIN32
+    (void)partition;
+    return false;
+#else
+    // Seal the previous segment: only the newest one is checked on open
+    if (!m_segments.empty()) {
+        msync(m_segments.back().base, m_segments.back().size, MS_SYNC);
+    }
+
+    uint64_t sequence = m_segments.empty() ? 1 : m_segments.back().sequence + 1;
+    Segment segment{sequence, m_directory + "/" + segmentName(sequence), -1, nullptr, segmentSize(m_segmentRows)};
+
+    segment.fd = ::open(segment.path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (segment.fd < 0) {
+        std::cerr << "[TimeSeriesStore] Cannot create " << segment.path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    void* mapping = MAP_FAILED;
+    if (ftruncate(segment.fd, static_cast<off_t>(segment.size)) == 0) {
+        mapping = mmap(nullptr, segment.size, PROT_READ | PROT_WRITE, MAP_SHARED, segment.fd, 0);
+    }
+    if (mapping == MAP_FAILED) {
+        std::cerr << "[TimeSeriesStore] Cannot map " << segment.path << ": " << std::strerror(errno) << std::endl;
+        ::close(segment.fd);
+        ::unlink(segment.path.c_str());
+        return false;
+    }
+    segment.base = static_cast<uint8_t*>(mapping);
+
+    Header* h = header(segment);
+    h->magic = STORE_MAGIC;
+    h->version = STORE_VERSION;
+    h->columns = static_cast<uint16_t>(COLUMNS);
+    h->capacity = static_cast<uint32_t>(m_segmentRows);
+    h->rows = 0;
+    h->partition = partition;
+    h->first = 0;
+    h->last = 0;
+
+    m_segments.push_back(segment);
+    m_bytes += segment.size;
+    enforceRetention();
+    return true;
+#endif
+}
+
+void TimeSeriesStore::removeSegment(Segment& segment)
+{
+#ifndef _WIN32
+    munmap(segment.base, segment.size);
+    ::close(segment.fd);
+    ::unlink(segment.path.c_str());
+#endif
+    m_bytes -= segment.size;
+}
+
+void TimeSeriesStore::enforceRetention()
+{
+    // The newest segment is kept even if it alone exceeds the limit
+    while (m_bytes > m_maxBytes && m_segments.size() > 1) {
+        removeSegment(m_segments.front());
+        m_segments.pop_front();
+        m_stats.retired++;
+    }
+}
+
+//==============================================================================
+// Append
+//==============================================================================
+
+bool TimeSeriesStore::append(uint64_t timestamp, const float (&row)[COLUMNS])
+{
+    if (!m_open) {
+        return false;
+    }
+    if (!m_segments.empty() && timestamp < header(m_segments.back())->last) {
+        m_stats.rejected++;
+        return false;
+    }
+
+    uint64_t partition = timestamp - timestamp % m_partitionMs;
+    if (m_segments.empty() || header(m_segments.back())->rows >= header(m_segments.back())->capacity ||
+        header(m_segments.back())->partition != partition) {
+        if (!createSegment(partition)) {
+            return false;
+        }
+    }
+
+    const Segment& segment = m_segments.back();
+    Header* h = header(segment);
+    uint32_t index = h->rows;
+    timestamps(segment)[index] = timestamp;
+    for (size_t column = 0; column < COLUMNS; column++) {
+        values(segment, column)[index] = row[column];
+    }
+    if (index == 0) {
+        h->first = timestamp;
+    }
+    h->last = timestamp;
+
+    // Values must land before the row count that publishes them
+    std::atomic_thread_fence(std::memory_order_release);
+    h->rows = index + 1;
+    m_stats.appended++;
+    return true;
+}
+
+bool TimeSeriesStore::append(const SkinSensor::SensorData& data)
+{
+    const float row[COLUMNS] = {
+        data.pd1, data.pd2, data.s1, data.s2, data.s3, data.moistureLevel, data.temperatureC
+    };
+    return append(data.timestamp, row);
+}
+
+//==============================================================================
+// Queries
+//==============================================================================
+
+size_t TimeSeriesStore::scan(Column column, uint64_t from, uint64_t to, std::vector<Span>& spans) const
+{
+    spans.clear();
+    size_t rows = 0;
+    for (const auto& segment : m_segments) {
+        const Header* h = header(segment);
+        if (h->rows == 0 || h->last < from || h->first >= to) {
+            continue;
+        }
+        const uint64_t* ts = timestamps(segment);
+        size_t begin = static_cast<size_t>(std::lower_bound(ts, ts + h->rows, from) - ts);
+        size_t end = static_cast<size_t>(std::lower_bound(ts + begin, ts + h->rows, to) - ts);
+        if (end > begin) {
+            spans.push_back(Span{ts + begin, values(segment, static_cast<size_t>(column)) + begin, end - begin});
+            rows += end - begin;
+        }
+    }
+    return rows;
+}
+
+std::vector<TimeSeriesStore::Aggregate> TimeSeriesStore::aggregate(Column column, uint64_t from, uint64_t to,
+                                                                   uint64_t windowMs) const
+{
+    std::vector<Aggregate> windows;
+    if (windowMs == 0 || from >= to) {
+        return windows;
+    }
+
+    std::vector<Span> spans;
+    scan(column, from, to, spans);
+    for (const auto& span : spans) {
+        size_t i = 0;
+        while (i < span.count) {
+            // Rows of one window are contiguous: find its end, then reduce the value run
+            uint64_t start = from + (span.timestamps[i] - from) / windowMs * windowMs;
+            uint64_t end = (to - start > windowMs) ? start + windowMs : to;
+            size_t j = static_cast<size_t>(
+                std::lower_bound(span.timestamps + i, span.timestamps + span.count, end) - span.timestamps);
+
+            if (windows.empty() || windows.back().start != start) {
+                windows.push_back(Aggregate{start, 0, std::numeric_limits<float>::infinity(),
+                                            -std::numeric_limits<float>::infinity(), 0.0});
+            }
+            Aggregate& window = windows.back();
+            float lo = window.min;
+            float hi = window.max;
+            double sum = 0.0;
+            for (size_t k = i; k < j; k++) {
+                float value = span.values[k];
+                lo = std::min(lo, value);
+                hi = std::max(hi, value);
+                sum += value;
+            }
+            window.count += static_cast<uint32_t>(j - i);
+            window.min = lo;
+            window.max = hi;
+            window.sum += sum;
+            i = j;
+        }
+    }
+    return windows;
+}
+
+TimeSeriesStore::Stats TimeSeriesStore::getStats() const
+{
+    Stats stats = m_stats;
+    stats.segments = m_segments.size();
+    stats.bytes = m_bytes;
+    stats.rows = 0;
+    for (const auto& segment : m_segments) {
+        stats.rows += header(segment)->rows;
+    }
+    if (!m_segments.empty()) {
+        stats.oldest = header(m_segments.front())->first;
+        stats.newest = header(m_segments.back())->last;
+    }
+    return stats;
+}
+
+const char* TimeSeriesStore::columnName(Column column)
+{
+    return COLUMN_NAMES[static_cast<size_t>(column)];
+}
+
+bool TimeSeriesStore::parseColumn(const std::string& name, Column& column)
+{
+    for (size_t i = 0; i < COLUMNS; i++) {
+        if (name == COLUMN_NAMES[i]) {
+            column = static_cast<Column>(i);
+            return true;
+        }
+    }
+    return false;
+}
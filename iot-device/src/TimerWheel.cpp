@@ -0,0 +1,291 @@
+#include "TimerWheel.h"
+#include <algorithm>
+
+namespace {
+    // Furthest a timer is filed ahead; later ones are re-filed on cascade
+    constexpr uint64_t MAX_SPAN = (uint64_t(1) << (TimerWheel::SLOT_BITS * TimerWheel::LEVELS)) - 1;
+}
+
+constexpr int TimerWheel::LEVELS;
+constexpr int TimerWheel::SLOT_BITS;
+constexpr int TimerWheel::SLOTS;
+
+TimerWheel::TimerWheel(Clock& clock, Clock::Duration tick, Clock::Duration slack)
+    : m_clock(clock)
+    , m_start(clock.now())
+    , m_tick(tick > Clock::Duration::zero() ? tick : Clock::Duration(1))
+    , m_slack(slack)
+    , m_now(0)
+    , m_active(0)
+{
+}
+
+TimerWheel::TimerId TimerWheel::schedule(Clock::TimePoint deadline, Callback callback, const std::string& name)
+{
+    return add(deadline, Clock::Duration::zero(), std::move(callback), name);
+}
+
+TimerWheel::TimerId TimerWheel::schedulePeriodic(Clock::TimePoint first, Clock::Duration period,
+                                                 Callback callback, const std::string& name)
+{
+    if (period <= Clock::Duration::zero()) {
+        return 0;
+    }
+    return add(first, period, std::move(callback), name);
+}
+
+TimerWheel::TimerId TimerWheel::add(Clock::TimePoint deadline, Clock::Duration period, Callback callback,
+                                    const std::string& name)
+{
+    uint32_t index;
+    if (!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+    } else {
+        index = static_cast<uint32_t>(m_timers.size());
+        m_timers.emplace_back();
+        m_timers.back().generation = 0;
+    }
+
+    Timer& timer = m_timers[index];
+    timer.callback = std::move(callback);
+    timer.deadline = deadline;
+    timer.period = period;
+    timer.expiry = tickFor(deadline);
+    timer.generation++;
+    timer.active = true;
+    timer.stats = TimerStats();
+    timer.stats.name = name;
+    timer.stats.period = period;
+    m_active++;
+
+    place(index);
+    return (static_cast<uint64_t>(timer.generation) << 32) | (index + 1);
+}
+
+bool TimerWheel::cancel(TimerId id)
+{
+    if (find(id) == nullptr) {
+        return false;
+    }
+    // Slot entries are skipped lazily
+    release(static_cast<uint32_t>((id & 0xFFFFFFFF) - 1));
+    return true;
+}
+
+const TimerWheel::Timer* TimerWheel::find(TimerId id) const
+{
+    uint64_t index = (id & 0xFFFFFFFF);
+    if (index == 0 || index > m_timers.size()) {
+        return nullptr;
+    }
+    const Timer& timer = m_timers[index - 1];
+    if (!timer.active || timer.generation != static_cast<uint32_t>(id >> 32)) {
+        return nullptr;
+    }
+    return &timer;
+}
+
+void TimerWheel::release(uint32_t index)
+{
+    Timer& timer = m_timers[index];
+    timer.active = false;
+    timer.callback = nullptr;
+    m_free.push_back(index);
+    m_active--;
+}
+
+bool TimerWheel::current(const Ref& ref) const
+{
+    const Timer& timer = m_timers[ref.index];
+    return timer.active && timer.generation == ref.generation;
+}
+
+uint64_t TimerWheel::tickFor(Clock::TimePoint deadline) const
+{
+    if (deadline <= m_start) {
+        return 0;
+    }
+    if (deadline == Clock::TimePoint::max()) {
+        return UINT64_MAX;
+    }
+    auto elapsed = deadline - m_start;
+    return static_cast<uint64_t>((elapsed + m_tick - Clock::Duration(1)) / m_tick);
+}
+
+void TimerWheel::place(uint32_t index)
+{
+    const Timer& timer = m_timers[index];
+    Ref ref{index, timer.generation};
+
+    if (timer.expiry <= m_now) {
+        m_due.push_back(ref);
+        return;
+    }
+
+    // Level by distance, slot by the expiry's own bits: a slot is cascaded
+    // when the current tick enters the span that contains the expiry
+    uint64_t delta = std::min(timer.expiry - m_now, MAX_SPAN);
+    uint64_t expiry = m_now + delta;
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    size_t slot = static_cast<size_t>((expiry >> (SLOT_BITS * level)) & (SLOTS - 1));
+    m_wheel[level][slot].push_back(ref);
+}
+
+void TimerWheel::cascade(int level)
+{
+    size_t slot = static_cast<size_t>((m_now >> (SLOT_BITS * level)) & (SLOTS - 1));
+    std::vector<Ref> refs;
+    refs.swap(m_wheel[level][slot]);
+    for (const auto& ref : refs) {
+        if (current(ref)) {
+            place(ref.index);
+        }
+    }
+}
+
+size_t TimerWheel::runDue()
+{
+    auto now = m_clock.now();
+    uint64_t target = now > m_start ? static_cast<uint64_t>((now - m_start) / m_tick) : 0;
+
+    size_t ran = runList();
+    while (m_now < target) {
+        if (m_active == 0) {
+            m_now = target;
+            break;
+        }
+
+        m_now++;
+        for (int level = 1; level < LEVELS; level++) {
+            if ((m_now & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0) {
+                break;
+            }
+            cascade(level);
+        }
+
+        // Timers expiring on a span boundary come due in the cascade itself
+        auto& slot = m_wheel[0][m_now & (SLOTS - 1)];
+        m_due.insert(m_due.end(), slot.begin(), slot.end());
+        slot.clear();
+        if (!m_due.empty()) {
+            ran += runList();
+        }
+    }
+    return ran;
+}
+
+size_t TimerWheel::runList()
+{
+    size_t ran = 0;
+    // Callbacks may add expired timers to m_due while it is being run
+    while (!m_due.empty()) {
+        m_running.clear();
+        m_running.swap(m_due);
+        std::stable_sort(m_running.begin(), m_running.end(), [this](const Ref& a, const Ref& b) {
+            return m_timers[a.index].deadline < m_timers[b.index].deadline;
+        });
+        for (const auto& ref : m_running) {
+            if (current(ref)) {
+                fire(ref);
+                ran++;
+            }
+        }
+    }
+    return ran;
+}
+
+void TimerWheel::fire(const Ref& ref)
+{
+    Timer& timer = m_timers[ref.index];
+    auto start = m_clock.now();
+    auto lateness = start - timer.deadline;
+    timer.stats.runs++;
+    if (lateness > m_slack) {
+        timer.stats.late++;
+    }
+    timer.stats.maxLateness = std::max(timer.stats.maxLateness, lateness);
+
+    if (timer.period == Clock::Duration::zero()) {
+        Callback callback = std::move(timer.callback);
+        release(ref.index);
+        callback();
+        return;
+    }
+
+    // Copied: the callback may add timers (reallocating m_timers) or cancel itself
+    Callback callback = timer.callback;
+    callback();
+
+    auto end = m_clock.now();
+    Timer& self = m_timers[ref.index];
+    if (!current(ref)) {
+        return;
+    }
+    self.stats.totalRunTime += end - start;
+    self.stats.maxRunTime = std::max(self.stats.maxRunTime, end - start);
+
+    // Stay on phase; periods whose deadline already passed are dropped
+    auto next = self.deadline + self.period;
+    if (next < end) {
+        auto skipped = (end - next + self.period - Clock::Duration(1)) / self.period;
+        self.stats.missed += static_cast<uint64_t>(skipped);
+        next += skipped * self.period;
+    }
+    self.deadline = next;
+    self.expiry = tickFor(next);
+    place(ref.index);
+}
+
+Clock::TimePoint TimerWheel::nextDeadline() const
+{
+    if (!m_due.empty()) {
+        return m_clock.now();
+    }
+    if (m_active == 0) {
+        return Clock::TimePoint::max();
+    }
+
+    // First non-empty slot per level; a higher-level slot is only a wake-up
+    // to cascade, so this is a lower bound
+    uint64_t best = UINT64_MAX;
+    for (int level = 0; level < LEVELS; level++) {
+        int shift = SLOT_BITS * level;
+        uint64_t base = m_now >> shift;
+        for (uint64_t offset = 1; offset <= SLOTS; offset++) {
+            uint64_t span = base + offset;
+            if (!m_wheel[level][span & (SLOTS - 1)].empty()) {
+                best = std::min(best, span << shift);
+                break;
+            }
+        }
+    }
+    if (best == UINT64_MAX) {
+        return Clock::TimePoint::max();
+    }
+    return m_start + m_tick * static_cast<Clock::Duration::rep>(best);
+}
+
+bool TimerWheel::getStats(TimerId id, TimerStats& stats) const
+{
+    const Timer* timer = find(id);
+    if (timer == nullptr) {
+        return false;
+    }
+    stats = timer->stats;
+    return true;
+}
+
+std::vector<TimerWheel::TimerStats> TimerWheel::getAllStats() const
+{
+    std::vector<TimerStats> all;
+    for (const auto& timer : m_timers) {
+        if (timer.active) {
+            all.push_back(timer.stats);
+        }
+    }
+    return all;
+}
@@ -0,0 +1,161 @@
+#include "UploadPipeline.h"
+#include "Config.h"
+#include "Payload.h"
+#include <iostream>
+
+namespace {
+    SensorRecordBuffer::OverflowPolicy overflowPolicy()
+    {
+        auto policy = SensorRecordBuffer::OverflowPolicy::DROP_OLDEST;
+        if (!SensorRecordBuffer::parsePolicy(Config::getRecordOverflowPolicy(), policy)) {
+            std::cout << "[WARN] Unknown THE3_RECORD_OVERFLOW, using drop-oldest\n";
+        }
+        return policy;
+    }
+}
+
+UploadPipeline::UploadPipeline(HttpClient& client, Clock& clock, TimeSeriesStore& history,
+                               const std::string& deviceId)
+    : m_history(history)
+    , m_deviceId(deviceId)
+    , m_batcher(client)
+    , m_outboundOpen(false)
+    , m_storedBatches(0)
+    , m_replay()
+    , m_overflow(overflowPolicy())
+    , m_records(Config::RECORD_BUFFER_CAPACITY, m_overflow, clock)
+    , m_uploadMode(WindowAggregator::Mode::RAW)
+    , m_aggregator(static_cast<uint64_t>(Config::getAggregationWindowSec()) * 1000)
+    , m_changes(static_cast<uint64_t>(Config::getChangeHeartbeatSec()) * 1000)
+    , m_samples(0)
+    , m_historyRows(0)
+{
+    // Reused per sample: no allocation once grown to payload size
+    m_json.reserve(512);
+
+    m_batcher.setClock(clock);
+    m_batcher.setFailureHandler([this](const std::string& body, size_t, const HttpClient::Response& response) {
+        storeFailedBatch(body, response);
+    });
+}
+
+void UploadPipeline::open()
+{
+    if (m_outbound.open(Config::getQueueFile(), Config::STORE_FORWARD_QUEUE_BYTES)) {
+        m_outboundOpen = true;
+        if (!m_outbound.empty()) {
+            std::cout << "  " << m_outbound.size() << " stored batches pending replay\n";
+        }
+    } else {
+        std::cout << "[WARN] Store-and-forward queue unavailable, failed batches will be dropped\n";
+    }
+
+    if (m_overflow == SensorRecordBuffer::OverflowPolicy::SPILL &&
+        m_records.openSpill(Config::getSpillFile(), Config::RECORD_SPILL_BYTES) &&
+        m_records.getStats().spillPending > 0) {
+        std::cout << "  " << m_records.getStats().spillPending << " spilled records pending upload\n";
+    }
+
+    if (!WindowAggregator::parseMode(Config::getUploadMode(), m_uploadMode)) {
+        std::cout << "[WARN] Unknown THE3_UPLOAD_MODE, using raw\n";
+    }
+    if (m_uploadMode == WindowAggregator::Mode::SUMMARY) {
+        m_batcher.setEndpoint(Config::API_ENDPOINT_TELEMETRY_SUMMARY);
+        std::cout << "  Uploading one summary per " << m_aggregator.windowMs() / 1000 << " s window\n";
+    } else if (m_uploadMode == WindowAggregator::Mode::CHANGES) {
+        std::cout << "  Uploading changes only, heartbeat every " << m_changes.heartbeatMs() / 1000 << " s\n";
+    }
+}
+
+bool UploadPipeline::add(const SkinSensor::SensorData& data)
+{
+    m_samples++;
+    if (m_history.append(data) && ++m_historyRows % Config::HISTORY_SYNC_INTERVAL == 0) {
+        m_history.sync();
+    }
+
+    // In summary mode only a sample that closes a window yields a record,
+    // in changes mode only a sample the filter lets through
+    m_json.clear();
+    if (m_uploadMode == WindowAggregator::Mode::SUMMARY) {
+        if (m_aggregator.add(data)) {
+            Payload::appendWindowSummaryJson(m_json, m_aggregator.summary(), m_deviceId);
+        }
+    } else if (m_uploadMode == WindowAggregator::Mode::CHANGES) {
+        if (m_changes.add(data) != ChangeFilter::Reason::NONE) {
+            Payload::appendSkinAnalysisJson(m_json, data, m_deviceId);
+        }
+    } else {
+        Payload::appendSkinAnalysisJson(m_json, data, m_deviceId);
+    }
+    return m_json.empty() || m_batcher.add(m_json);
+}
+
+void UploadPipeline::flush()
+{
+    // The open window is summarized as it stands
+    if (m_uploadMode == WindowAggregator::Mode::SUMMARY && m_aggregator.flush()) {
+        m_json.clear();
+        Payload::appendWindowSummaryJson(m_json, m_aggregator.summary(), m_deviceId);
+        m_batcher.add(m_json);
+    }
+    m_batcher.flush();
+}
+
+void UploadPipeline::sync()
+{
+    if (m_outboundOpen) {
+        m_outbound.sync(true);
+    }
+    m_history.sync(true);
+}
+
+void UploadPipeline::storeFailedBatch(const std::string& body, const HttpClient::Response& response)
+{
+    // Replaying a batch the server rejected (4xx) would only fail again
+    if (BatchReplay::classify(response) == BatchReplay::Outcome::REJECTED) {
+        std::cout << "[WARN] Batch rejected with HTTP " << response.statusCode << ", dropped\n";
+        m_replay.rejected++;
+        return;
+    }
+    if (m_outboundOpen && BatchReplay::store(m_outbound, m_batcher.getEndpoint(), body) &&
+        ++m_storedBatches % Config::STORE_FORWARD_SYNC_INTERVAL == 0) {
+        m_outbound.sync();
+    }
+}
+
+void UploadPipeline::printStats() const
+{
+    auto batch = m_batcher.getStats();
+    std::cout << "  Samples: " << m_samples << ", Sent: " << batch.recordsSent << " records in "
+              << batch.batchesSent << " batches, Failed: " << batch.recordsFailed << "\n";
+    std::cout << "  Stored: " << m_storedBatches << " batches, Replayed: " << m_replay.replayed
+              << ", Rejected: " << m_replay.rejected
+              << ", Pending: " << (m_outboundOpen ? m_outbound.size() : 0) << "\n";
+
+    auto buffer = m_records.getStats();
+    std::cout << "  Buffer (" << SensorRecordBuffer::policyName(m_records.getPolicy()) << "): "
+              << buffer.pushed << " records, high water " << buffer.highWater << "/" << buffer.capacity
+              << ", dropped " << buffer.dropped << ", spilled " << buffer.spilled << "\n";
+    if (m_history.isOpen()) {
+        auto history = m_history.getStats();
+        std::cout << "  History: " << history.rows << " rows in " << history.segments << " segments"
+                  << ", " << history.rejected << " rejected\n";
+    }
+
+    if (m_uploadMode == WindowAggregator::Mode::SUMMARY) {
+        auto aggregation = m_aggregator.getStats();
+        std::cout << "  Summaries: " << aggregation.windows << " windows of " << aggregation.samples
+                  << " samples, " << m_aggregator.pendingSamples() << " in the open window\n";
+    }
+    if (m_uploadMode == WindowAggregator::Mode::CHANGES) {
+        auto filter = m_changes.getStats();
+        std::cout << "  Changes: " << filter.uploaded << " of " << filter.samples
+                  << " samples uploaded, " << filter.suppressed << " suppressed (";
+        for (size_t r = 1; r < ChangeFilter::REASONS; r++) {
+            std::cout << (r > 1 ? ", " : "") << ChangeFilter::reasonName(static_cast<ChangeFilter::Reason>(r))
+                      << " " << filter.byReason[r];
+        }
+        std::cout << ")\n";
+    }
+}
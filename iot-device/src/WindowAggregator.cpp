@@ -0,0 +1,320 @@
+#include "WindowAggregator.h"
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+// P2Quantile
+//==============================================================================
+
+P2Quantile::P2Quantile(double p)
+    : m_p(p)
+{
+    reset();
+}
+
+void P2Quantile::reset()
+{
+    m_count = 0;
+    for (int i = 0; i < 5; i++) {
+        m_q[i] = 0.0;
+        m_n[i] = i + 1;
+    }
+    m_desired[0] = 1.0;
+    m_desired[1] = 1.0 + 2.0 * m_p;
+    m_desired[2] = 1.0 + 4.0 * m_p;
+    m_desired[3] = 3.0 + 2.0 * m_p;
+    m_desired[4] = 5.0;
+    m_increment[0] = 0.0;
+    m_increment[1] = m_p / 2.0;
+    m_increment[2] = m_p;
+    m_increment[3] = (1.0 + m_p) / 2.0;
+    m_increment[4] = 1.0;
+}
+
+void P2Quantile::add(double x)
+{
+    // The first five observations become the initial markers
+    if (m_count < 5) {
+        m_q[m_count++] = x;
+        if (m_count == 5) {
+            std::sort(m_q, m_q + 5);
+        }
+        return;
+    }
+
+    // Cell k with q[k] <= x < q[k+1]; the extremes follow x
+    int k;
+    if (x < m_q[0]) {
+        m_q[0] = x;
+        k = 0;
+    } else if (x >= m_q[4]) {
+        m_q[4] = x;
+        k = 3;
+    } else {
+        k = 0;
+        while (k < 3 && x >= m_q[k + 1]) {
+            k++;
+        }
+    }
+
+    for (int i = k + 1; i < 5; i++) {
+        m_n[i] += 1.0;
+    }
+    for (int i = 0; i < 5; i++) {
+        m_desired[i] += m_increment[i];
+    }
+    m_count++;
+
+    // Move the middle markers one position towards their desired positions
+    for (int i = 1; i <= 3; i++) {
+        double d = m_desired[i] - m_n[i];
+        if ((d >= 1.0 && m_n[i + 1] - m_n[i] > 1.0) || (d <= -1.0 && m_n[i - 1] - m_n[i] < -1.0)) {
+            int step = d > 0.0 ? 1 : -1;
+            double q = parabolic(i, step);
+            if (!(m_q[i - 1] < q && q < m_q[i + 1])) {
+                q = linear(i, step);
+            }
+            m_q[i] = q;
+            m_n[i] += step;
+        }
+    }
+}
+
+double P2Quantile::parabolic(int i, double d) const
+{
+    return m_q[i] + d / (m_n[i + 1] - m_n[i - 1]) *
+           ((m_n[i] - m_n[i - 1] + d) * (m_q[i + 1] - m_q[i]) / (m_n[i + 1] - m_n[i]) +
+            (m_n[i + 1] - m_n[i] - d) * (m_q[i] - m_q[i - 1]) / (m_n[i] - m_n[i - 1]));
+}
+
+double P2Quantile::linear(int i, int d) const
+{
+    return m_q[i] + d * (m_q[i + d] - m_q[i]) / (m_n[i + d] - m_n[i]);
+}
+
+double P2Quantile::value() const
+{
+    if (m_count == 0) {
+        return 0.0;
+    }
+    if (m_count >= 5) {
+        return m_q[2];
+    }
+
+    // Nearest rank over the stored observations
+    double sorted[5];
+    std::copy(m_q, m_q + m_count, sorted);
+    std::sort(sorted, sorted + m_count);
+    size_t rank = static_cast<size_t>(std::lround(m_p * static_cast<double>(m_count - 1)));
+    return sorted[rank];
+}
+
+//==============================================================================
+// WindowAggregator
+//==============================================================================
+
+const double WindowAggregator::QUANTILE_P[WindowAggregator::QUANTILES] = { 0.1, 0.5, 0.9 };
+constexpr size_t WindowAggregator::CHANNELS;
+constexpr size_t WindowAggregator::CATEGORIES;
+constexpr size_t WindowAggregator::QUANTILES;
+
+namespace {
+
+using SensorData = SkinSensor::SensorData;
+
+struct ChannelField {
+    const char* name;
+    float SensorData::* member;
+};
+
+// Field names as in SensorSchema.h
+const ChannelField CHANNEL_FIELDS[WindowAggregator::CHANNELS] = {
+    { "pd1", &SensorData::pd1 },
+    { "pd2", &SensorData::pd2 },
+    { "s1", &SensorData::s1 },
+    { "s2", &SensorData::s2 },
+    { "s3", &SensorData::s3 },
+    { "moistureLevel", &SensorData::moistureLevel },
+    { "temperatureC", &SensorData::temperatureC },
+};
+
+struct CategoryField {
+    const char* name;
+    std::string SensorData::* member;
+};
+
+const CategoryField CATEGORY_FIELDS[WindowAggregator::CATEGORIES] = {
+    { "moistureLevelResult", &SensorData::moistureLevelResult },
+    { "elasticityResult", &SensorData::elasticityResult },
+    { "thicknessResult", &SensorData::thicknessResult },
+};
+
+} // namespace
+
+WindowAggregator::WindowAggregator(uint64_t windowMs)
+    : m_windowMs(windowMs > 0 ? windowMs : 1)
+    , m_windowStart(0)
+    , m_first(0)
+    , m_last(0)
+    , m_samples(0)
+    , m_summary()
+    , m_stats()
+{
+    for (size_t c = 0; c < CHANNELS; c++) {
+        for (size_t q = 0; q < QUANTILES; q++) {
+            m_channels[c].quantiles[q] = P2Quantile(QUANTILE_P[q]);
+        }
+        m_summary.channels[c].name = CHANNEL_FIELDS[c].name;
+    }
+    for (size_t c = 0; c < CATEGORIES; c++) {
+        m_summary.categories[c].name = CATEGORY_FIELDS[c].name;
+    }
+}
+
+void WindowAggregator::start(const SensorData& data)
+{
+    m_windowStart = data.timestamp / m_windowMs * m_windowMs;
+    m_first = data.timestamp;
+    m_samples = 0;
+    m_patientName = data.patientName;
+    m_birthDate = data.birthDate;
+
+    for (auto& channel : m_channels) {
+        channel.count = 0;
+        channel.mean = 0.0;
+        channel.m2 = 0.0;
+        for (auto& quantile : channel.quantiles) {
+            quantile.reset();
+        }
+    }
+    for (auto& categories : m_categories) {
+        for (auto& category : categories) {
+            category.count = 0;
+        }
+    }
+}
+
+bool WindowAggregator::add(const SensorData& data)
+{
+    bool closed = false;
+    if (m_samples > 0 &&
+        (data.timestamp >= m_windowStart + m_windowMs || data.timestamp < m_windowStart ||
+         data.patientName != m_patientName || data.birthDate != m_birthDate)) {
+        close();
+        closed = true;
+    }
+    if (m_samples == 0) {
+        start(data);
+    }
+
+    for (size_t c = 0; c < CHANNELS; c++) {
+        Accumulator& channel = m_channels[c];
+        float value = data.*(CHANNEL_FIELDS[c].member);
+        if (channel.count == 0) {
+            channel.min = channel.max = value;
+        } else {
+            channel.min = std::min(channel.min, value);
+            channel.max = std::max(channel.max, value);
+        }
+        channel.count++;
+        double delta = value - channel.mean;
+        channel.mean += delta / channel.count;
+        channel.m2 += delta * (value - channel.mean);
+        for (auto& quantile : channel.quantiles) {
+            quantile.add(value);
+        }
+    }
+
+    for (size_t c = 0; c < CATEGORIES; c++) {
+        const std::string& value = data.*(CATEGORY_FIELDS[c].member);
+        auto& categories = m_categories[c];
+        auto it = std::find_if(categories.begin(), categories.end(),
+                               [&](const Category& category) { return category.value == value; });
+        if (it == categories.end()) {
+            categories.push_back(Category{value, 0});
+            it = categories.end() - 1;
+        }
+        it->count++;
+    }
+
+    m_last = data.timestamp;
+    m_samples++;
+    m_stats.samples++;
+    return closed;
+}
+
+bool WindowAggregator::flush()
+{
+    if (m_samples == 0) {
+        return false;
+    }
+    close();
+    return true;
+}
+
+void WindowAggregator::close()
+{
+    Summary& summary = m_summary;
+    summary.windowStart = m_windowStart;
+    summary.windowEnd = m_windowStart + m_windowMs;
+    summary.first = m_first;
+    summary.last = m_last;
+    summary.samples = m_samples;
+    summary.patientName = m_patientName;
+    summary.birthDate = m_birthDate;
+
+    for (size_t c = 0; c < CHANNELS; c++) {
+        const Accumulator& channel = m_channels[c];
+        ChannelSummary& out = summary.channels[c];
+        out.min = channel.min;
+        out.max = channel.max;
+        out.mean = channel.mean;
+        out.stddev = channel.count > 1 ? std::sqrt(channel.m2 / (channel.count - 1)) : 0.0;
+        for (size_t q = 0; q < QUANTILES; q++) {
+            out.quantiles[q] = channel.quantiles[q].value();
+        }
+    }
+
+    // Reuse the summary's entries: no allocation once the values are known
+    for (size_t c = 0; c < CATEGORIES; c++) {
+        auto& counts = summary.categories[c].counts;
+        size_t n = 0;
+        for (const auto& category : m_categories[c]) {
+            if (category.count == 0) {
+                continue;
+            }
+            if (n == counts.size()) {
+                counts.emplace_back();
+            }
+            counts[n].value = category.value;
+            counts[n].count = category.count;
+            n++;
+        }
+        counts.resize(n);
+    }
+
+    m_samples = 0;
+    m_stats.windows++;
+}
+
+//==============================================================================
+// Names
+//==============================================================================
+
+bool WindowAggregator::parseMode(const std::string& name, Mode& mode)
+{
+    if (name == "raw")     { mode = Mode::RAW;     return true; }
+    if (name == "summary") { mode = Mode::SUMMARY; return true; }
+    if (name == "changes") { mode = Mode::CHANGES; return true; }
+    return false;
+}
+
+const char* WindowAggregator::modeName(Mode mode)
+{
+    switch (mode) {
+        case Mode::RAW:     return "raw";
+        case Mode::SUMMARY: return "summary";
+        case Mode::CHANGES: return "changes";
+    }
+    return "?";
+}
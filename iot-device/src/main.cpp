@@ -11,94 +11,157 @@
  * - THE3_API_KEY: API authentication key (REQUIRED)
  * - THE3_SERVER_URL: Backend server URL (optional, default: http://localhost:8080)
  * - THE3_DEVICE_ID: Device identifier (optional, default: THE3-SKIN-DEVICE-001)
+ *
+ * Measurements are also kept in a local history (THE3_HISTORY_DIR),
+ * queried with menu command 9.
+ *
+ * Headless mode (no menu, no patient prompt):
+ *   THE3_SkinAnalyzer --daemon [--duration SEC] [--treatment V|I|T|L]
  */
 
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
 #include <iostream>
-#include <string>
 #include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
+#include <atomic>
 #include <chrono>
 #include <csignal>
-#include <iomanip>
 #include <stdexcept>
 
 #include "Config.h"
+#include "Clock.h"
+#include "Daemon.h"
 #include "HttpClient.h"
 #include "SkinSensor.h"
+#include "Payload.h"
+#include "TelemetryBatcher.h"
+#include "BatchReplay.h"
+#include "SensorRecordBuffer.h"
+#include "TimeSeriesStore.h"
+#include "UploadPipeline.h"
 
-// 전역 변수 (종료 플래그)
-volatile bool g_running = true;
+// 전역 변수 (종료 플래그, 측정 스레드와 공유)
+std::atomic<bool> g_running(true);
 
 // 시그널 핸들러
-void signalHandler(int signum)
+void signalHandler(int /*signum*/)
 {
     std::cout << "\nShutdown signal received. Exiting..." << std::endl;
     g_running = false;
 }
 
-// JSON 빌더 헬퍼 함수
-std::string buildSkinAnalysisJson(const SkinSensor::SensorData& data, const std::string& deviceId)
+// 로컬 시각 "YYYY-MM-DD HH:MM:SS" (Unix ms)
+std::string formatTime(uint64_t unixMs, const char* format = "%Y-%m-%d %H:%M:%S")
 {
-    std::ostringstream json;
-    json << "{"
-         << "\"deviceId\":\"" << deviceId << "\","
-         << "\"patientName\":\"" << data.patientName << "\","
-         << "\"birthDate\":\"" << data.birthDate << "\","
-         << "\"pd1\":\"" << std::fixed << std::setprecision(2) << data.pd1 << "\","
-         << "\"pd2\":\"" << data.pd2 << "\","
-         << "\"hz\":\"" << data.hz << "\","
-         << "\"s1\":\"" << data.s1 << "\","
-         << "\"s2\":\"" << data.s2 << "\","
-         << "\"s3\":\"" << data.s3 << "\","
-         << "\"moistureLevel\":\"" << data.moistureLevel << "\","
-         << "\"thicknessResult\":\"" << data.thicknessResult << "\","
-         << "\"elasticityResult\":\"" << data.elasticityResult << "\","
-         << "\"moistureLevelResult\":\"" << data.moistureLevelResult << "\""
-         << "}";
-    return json.str();
+    std::time_t seconds = static_cast<std::time_t>(unixMs / 1000);
+    char text[32];
+    std::strftime(text, sizeof(text), format, std::localtime(&seconds));
+    return text;
 }
 
-std::string buildTreatmentJson(const SkinSensor::TreatmentData& data, const std::string& deviceId)
+// 측정 이력 조회: 최근 `minutes`분을 12개 구간으로 나눠 구간별 평균과 전체 범위 출력
+void printHistory(const TimeSeriesStore& history, int minutes)
 {
-    std::ostringstream json;
-    json << "{"
-         << "\"deviceId\":\"" << deviceId << "\","
-         << "\"patientName\":\"" << data.patientName << "\","
-         << "\"birthDate\":\"" << data.birthDate << "\",";
-
-    switch (data.mode) {
-        case SkinSensor::TreatmentMode::VIBRATION:
-            json << "\"treatmentType\":\"V\","
-                 << "\"vMode\":\"" << data.vMode << "\","
-                 << "\"vSensitivity\":\"" << data.vSensitivity << "\","
-                 << "\"vTime\":\"" << data.vTime << "\","
-                 << "\"vHz\":\"" << data.vHz << "\"";
-            break;
-
-        case SkinSensor::TreatmentMode::IONTOPHORESIS:
-            json << "\"treatmentType\":\"I\","
-                 << "\"iTime\":\"" << data.iTime << "\","
-                 << "\"iCurrent\":\"" << std::fixed << std::setprecision(2) << data.iCurrent << "\"";
-            break;
-
-        case SkinSensor::TreatmentMode::HIGH_FREQUENCY:
-            json << "\"treatmentType\":\"T\","
-                 << "\"tTime\":\"" << data.tTime << "\","
-                 << "\"tVoltage\":\"" << data.tVoltage << "\","
-                 << "\"tHz\":\"" << data.tHz << "\"";
-            break;
-
-        case SkinSensor::TreatmentMode::LED_THERAPY:
-            json << "\"treatmentType\":\"L\","
-                 << "\"lMode\":\"" << data.lMode << "\","
-                 << "\"lBrightness\":\"" << data.lBrightness << "\","
-                 << "\"lTime\":\"" << data.lTime << "\","
-                 << "\"lHz\":\"" << data.lHz << "\"";
-            break;
+    using Column = TimeSeriesStore::Column;
+
+    auto stats = history.getStats();
+    if (stats.rows == 0) {
+        std::cout << "  No measurements stored\n";
+        return;
     }
 
-    json << "}";
-    return json.str();
+    const int windows = 12;
+    uint64_t to = stats.newest + 1;
+    uint64_t span = static_cast<uint64_t>(minutes) * 60 * 1000;
+    uint64_t from = (span < to - stats.oldest) ? to - span : stats.oldest;
+    uint64_t windowMs = std::max<uint64_t>((to - from + windows - 1) / windows, 1000);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<TimeSeriesStore::Aggregate> columns[TimeSeriesStore::COLUMNS];
+    for (size_t c = 0; c < TimeSeriesStore::COLUMNS; c++) {
+        columns[c] = history.aggregate(static_cast<Column>(c), from, to, windowMs);
+    }
+    double queryMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  " << std::left << std::setw(10) << "Window" << std::right << std::setw(7) << "Rows";
+    for (size_t c = 0; c < TimeSeriesStore::COLUMNS; c++) {
+        std::cout << std::setw(14) << TimeSeriesStore::columnName(static_cast<Column>(c));
+    }
+    std::cout << "\n";
+
+    // Every column has a value in every row, so the windows line up
+    for (size_t w = 0; w < columns[0].size(); w++) {
+        std::cout << "  " << std::left << std::setw(10) << formatTime(columns[0][w].start, "%H:%M:%S")
+                  << std::right << std::setw(7) << columns[0][w].count;
+        for (size_t c = 0; c < TimeSeriesStore::COLUMNS; c++) {
+            std::cout << std::setw(14) << columns[c][w].mean();
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << "  " << std::left << std::setw(17) << "Range" << std::right;
+    for (size_t c = 0; c < TimeSeriesStore::COLUMNS; c++) {
+        float lo = columns[c].front().min;
+        float hi = columns[c].front().max;
+        for (const auto& window : columns[c]) {
+            lo = std::min(lo, window.min);
+            hi = std::max(hi, window.max);
+        }
+        std::ostringstream range;
+        range << std::fixed << std::setprecision(1) << lo << ".." << hi;
+        std::cout << std::setw(14) << range.str();
+    }
+    std::cout << "\n  Query: " << std::setprecision(2) << queryMs << " ms\n" << std::defaultfloat;
+}
+
+// 명령행 옵션
+struct Options {
+    bool daemon = false;
+    int durationSec = 0;                // 0 = until SIGINT/SIGTERM
+    bool treatment = false;
+    SkinSensor::TreatmentMode treatmentMode = SkinSensor::TreatmentMode::VIBRATION;
+};
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--daemon") {
+            options.daemon = true;
+        } else if (arg == "--duration" && i + 1 < argc) {
+            try {
+                options.durationSec = std::stoi(argv[++i]);
+            } catch (...) {
+                return false;
+            }
+            if (options.durationSec <= 0) {
+                return false;
+            }
+        } else if (arg == "--treatment" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            options.treatment = true;
+            if (mode == "V") {
+                options.treatmentMode = SkinSensor::TreatmentMode::VIBRATION;
+            } else if (mode == "I") {
+                options.treatmentMode = SkinSensor::TreatmentMode::IONTOPHORESIS;
+            } else if (mode == "T") {
+                options.treatmentMode = SkinSensor::TreatmentMode::HIGH_FREQUENCY;
+            } else if (mode == "L") {
+                options.treatmentMode = SkinSensor::TreatmentMode::LED_THERAPY;
+            } else {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    // The other options only apply to daemon mode
+    return options.daemon || (options.durationSec == 0 && !options.treatment);
 }
 
 void printUsage()
@@ -114,6 +177,7 @@ void printUsage()
               << "  6. Check connection  - Test server connection\n"
               << "  7. Auto mode         - Continuous measurement\n"
               << "  8. Self test         - Run sensor diagnostics\n"
+              << "  9. History           - Recent measurements stored on the device\n"
               << "  0. Exit\n"
               << std::endl;
 }
@@ -125,6 +189,14 @@ void printEnvironmentInfo()
               << "  THE3_DEVICE_ID:  " << Config::getDeviceId() << "\n"
               << "  THE3_API_KEY:    " << (std::getenv("THE3_API_KEY") ? "[SET]" : "[NOT SET]") << "\n"
               << "  THE3_LOG_LEVEL:  " << Config::Logging::getLogLevel() << "\n"
+#ifdef PLATFORM_SIMULATION
+              << "  THE3_SIM_CLOCK:  " << Config::Simulation::getClockMode() << "\n"
+              << "  THE3_SIM_CONFIG: " << (Config::Simulation::getConfigFile().empty() ? "[DEFAULT]" : Config::Simulation::getConfigFile()) << "\n"
+              << "  THE3_I2C_REPLAY: " << (Config::Simulation::getReplayFile().empty() ? "[OFF]" : Config::Simulation::getReplayFile()) << "\n"
+#endif
+              << "  THE3_I2C_TRACE:  " << (Config::Hardware::getI2CTraceFile().empty() ? "[OFF]" : Config::Hardware::getI2CTraceFile()) << "\n"
+              << "  THE3_HISTORY_DIR: " << Config::getHistoryDir() << "\n"
+              << "  THE3_UPLOAD_MODE: " << Config::getUploadMode() << "\n"
               << std::endl;
 }
 
@@ -134,6 +206,12 @@ int main(int argc, char* argv[])
     std::signal(SIGINT, signalHandler);
     std::signal(SIGTERM, signalHandler);
 
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--daemon [--duration SEC] [--treatment V|I|T|L]]" << std::endl;
+        return 1;
+    }
+
     std::cout << "========================================\n"
               << "  THE 3.0 Skin Analysis IoT Device\n"
               << "  Firmware: " << Config::FIRMWARE_VERSION << "\n"
@@ -173,8 +251,25 @@ int main(int argc, char* argv[])
     }
     std::cout << "[OK] HTTP client initialized\n";
 
+    // 시계: 시뮬레이션에서는 가상 시간 선택 가능
+#ifdef PLATFORM_SIMULATION
+    VirtualClock virtualClock;
+    Clock& clock = (Config::Simulation::getClockMode() == "virtual") ? static_cast<Clock&>(virtualClock)
+                                                                     : Clock::system();
+#else
+    Clock& clock = Clock::system();
+#endif
+
     // 센서 초기화
     SkinSensor sensor;
+    sensor.setClock(clock);
+
+    DecimationFilter::Type adcFilter = DecimationFilter::Type::BOXCAR;
+    if (!DecimationFilter::parseType(Config::Hardware::getAdcFilter(), adcFilter)) {
+        std::cerr << "[WARN] Unknown THE3_ADC_FILTER, using boxcar" << std::endl;
+    }
+    sensor.setAdcOversampling(Config::Hardware::ADC_SAMPLES_PER_READ, adcFilter);
+
     if (!sensor.initialize()) {
         std::cerr << "[ERROR] Failed to initialize sensor" << std::endl;
         return 1;
@@ -189,6 +284,23 @@ int main(int argc, char* argv[])
     }
     std::cout << "\n";
 
+    // 데몬 모드: 메뉴 없이 이벤트 루프에서 측정/전송/상태 확인
+    if (options.daemon) {
+        std::cout << "[Daemon mode started. Press Ctrl+C to stop.]\n";
+        Daemon daemon(sensor, httpClient, clock, deviceId);
+        if (options.durationSec > 0) {
+            daemon.setDuration(std::chrono::seconds(options.durationSec));
+        }
+        if (options.treatment) {
+            daemon.setTreatment(options.treatmentMode);
+        }
+        daemon.run(g_running);
+
+        std::cout << "Shutting down...\n";
+        httpClient.cleanup();
+        return 0;
+    }
+
     // 환자 정보 설정 (테스트용)
     std::string patientName, birthDate;
     std::cout << "Enter patient name: ";
@@ -198,6 +310,13 @@ int main(int argc, char* argv[])
     sensor.setPatientInfo(patientName, birthDate);
     std::cout << "\n";
 
+    // 측정 이력: 측정값을 기기에 보관 (메뉴 9로 조회)
+    TimeSeriesStore history;
+    if (!history.open(Config::getHistoryDir(), Config::HISTORY_MAX_BYTES, Config::HISTORY_SEGMENT_ROWS,
+                      Config::HISTORY_PARTITION_MS)) {
+        std::cout << "[WARN] Measurement history unavailable, measurements will not be kept locally\n\n";
+    }
+
     // 메인 루프
     while (g_running) {
         printUsage();
@@ -221,7 +340,10 @@ int main(int argc, char* argv[])
                 // 피부 측정
                 std::cout << "\n[Measuring skin...]\n";
                 auto data = sensor.readSensorData();
-                std::string json = buildSkinAnalysisJson(data, deviceId);
+                if (history.append(data)) {
+                    history.sync();
+                }
+                std::string json = Payload::buildSkinAnalysisJson(data, deviceId);
 
                 std::cout << "Sending data to server...\n";
                 auto response = httpClient.post(Config::API_ENDPOINT_SKIN, json);
@@ -253,7 +375,7 @@ int main(int argc, char* argv[])
 
                 std::cout << "\n[Starting " << modeName << " therapy...]\n";
                 auto treatmentData = sensor.createTreatmentData(mode);
-                std::string json = buildTreatmentJson(treatmentData, deviceId);
+                std::string json = Payload::buildTreatmentJson(treatmentData, deviceId);
 
                 std::cout << "Sending treatment data to server...\n";
                 auto response = httpClient.post(Config::API_ENDPOINT_TREATMENT, json);
@@ -279,31 +401,75 @@ int main(int argc, char* argv[])
             }
 
             case 7: {
-                // 자동 모드
+                // 자동 모드: 측정 스레드가 SENSOR_READ_INTERVAL_MS마다 측정, 이 스레드가 배치로 전송
                 std::cout << "\n[Auto mode started. Press Ctrl+C to stop.]\n";
-                int successCount = 0;
-                int failCount = 0;
 
-                while (g_running) {
-                    auto data = sensor.readSensorData();
-                    std::string json = buildSkinAnalysisJson(data, deviceId);
-                    auto response = httpClient.post(Config::API_ENDPOINT_SKIN, json);
+                // 측정 → 레코드 버퍼 → 이력/배치 → (실패 시) 파일 큐, 데몬과 같은 경로
+                // 요약/변화 모드는 THE3_UPLOAD_MODE, 버퍼 오버플로 정책은 THE3_RECORD_OVERFLOW
+                UploadPipeline pipeline(httpClient, clock, history, deviceId);
+                pipeline.open();
+                TelemetryBatcher& batcher = pipeline.batcher();
+                SensorRecordBuffer& records = pipeline.records();
+
+                // Both threads wait on the clock (virtual time moves only when both are idle)
+                Clock::Participant uploader(clock);
+                clock.attach();
+
+                std::thread acquisition([&]() {
+                    const auto interval = std::chrono::milliseconds(Config::SENSOR_READ_INTERVAL_MS);
+                    auto next = clock.now();
+
+                    while (g_running) {
+                        records.push(SensorRecord::fromSensorData(sensor.readSensorData()));
+
+                        // Fixed cadence; after an overrun, restart from now instead of bursting
+                        next += interval;
+                        auto now = clock.now();
+                        if (next < now) {
+                            next = now;
+                        }
+                        clock.sleepUntil(next);
+                    }
+                    records.close();
+                    clock.detach();
+                });
+
+                SensorRecord record;
+                while (!records.finished()) {
+                    // Wake for the next record or the batch age limit, whichever is first
+                    auto wait = std::min(batcher.timeUntilDeadline(),
+                                         std::chrono::milliseconds(Config::SENSOR_READ_INTERVAL_MS));
+                    if (!records.pop(record, wait)) {
+                        if (!batcher.poll()) {
+                            std::cout << "x";
+                            std::cout.flush();
+                        }
+                        continue;
+                    }
 
-                    if (response.success) {
-                        std::cout << ".";
-                        successCount++;
-                    } else {
+                    size_t batchesBefore = batcher.getStats().batchesSent;
+                    if (!pipeline.add(record.toSensorData()) || !batcher.poll()) {
                         std::cout << "x";
-                        failCount++;
+                    } else if (batcher.getStats().batchesSent != batchesBefore) {
+                        std::cout << "B";
+
+                        // Server reachable again: drain what was stored while offline
+                        if (!pipeline.outbound().empty()) {
+                            BatchReplay::replay(pipeline.outbound(), httpClient, Config::STORE_FORWARD_REPLAY_BATCHES,
+                                                pipeline.replayStats());
+                        }
+                    } else {
+                        std::cout << ".";
                     }
                     std::cout.flush();
-
-                    std::this_thread::sleep_for(
-                        std::chrono::milliseconds(Config::DATA_SEND_INTERVAL_MS));
                 }
+                acquisition.join();
+
+                pipeline.flush();
+                pipeline.sync();
 
                 std::cout << "\n[Auto mode stopped]\n";
-                std::cout << "  Sent: " << successCount << ", Failed: " << failCount << "\n";
+                pipeline.printStats();
                 break;
             }
 
@@ -326,6 +492,36 @@ int main(int argc, char* argv[])
                 break;
             }
 
+            case 9: {
+                // 측정 이력 조회
+                std::cout << "\n[Measurement history]\n";
+                if (!history.isOpen()) {
+                    std::cout << "[ERROR] Measurement history unavailable\n";
+                    break;
+                }
+                auto stats = history.getStats();
+                std::cout << "  " << stats.rows << " rows in " << stats.segments << " segments ("
+                          << stats.bytes / 1024 << " KB)";
+                if (stats.rows > 0) {
+                    std::cout << ", " << formatTime(stats.oldest) << " .. " << formatTime(stats.newest);
+                }
+                std::cout << "\n";
+
+                std::cout << "Minutes to show [60]: ";
+                std::string minutesInput;
+                std::getline(std::cin, minutesInput);
+                int minutes = 60;
+                try {
+                    if (!minutesInput.empty()) {
+                        minutes = std::max(1, std::stoi(minutesInput));
+                    }
+                } catch (...) {
+                    std::cout << "Invalid input, showing 60 minutes\n";
+                }
+                printHistory(history, minutes);
+                break;
+            }
+
             case 0:
                 g_running = false;
                 break;
@@ -0,0 +1,39 @@
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+#include <cstdio>
+
+/**
+ * Minimal assertions for the tests in tests/: each test is its own
+ * executable that exits nonzero if any check failed
+ */
+namespace Check {
+
+inline int& failures()
+{
+    static int count = 0;
+    return count;
+}
+
+inline bool check(bool ok, const char* expression, const char* file, int line)
+{
+    if (!ok) {
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+        failures()++;
+    }
+    return ok;
+}
+
+inline int exitStatus()
+{
+    if (failures() > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures());
+    }
+    return failures() > 0 ? 1 : 0;
+}
+
+} // namespace Check
+
+#define CHECK(expression) Check::check((expression), #expression, __FILE__, __LINE__)
+
+#endif // TESTS_CHECK_H
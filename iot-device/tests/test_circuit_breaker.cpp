@@ -0,0 +1,150 @@
+/**
+ * CircuitBreaker state machine test
+ *
+ * CLOSED -> OPEN after the failure threshold, fail-fast while open,
+ * exactly one HALF_OPEN probe once the open period is over, and the
+ * three ways a probe ends: success closes the circuit, failure reopens
+ * it, and a probe released without an outcome (cancelled or shut down
+ * before a response) lets the next request probe instead of leaving the
+ * circuit stuck half-open.
+ */
+
+#include <chrono>
+#include <thread>
+
+#include "Check.h"
+#include "RetryPolicy.h"
+
+namespace {
+
+using State = CircuitBreaker::State;
+
+constexpr int THRESHOLD = 3;
+const std::chrono::milliseconds OPEN_DURATION(50);
+
+void waitOpenPeriod()
+{
+    std::this_thread::sleep_for(OPEN_DURATION + std::chrono::milliseconds(20));
+}
+
+// Drive a fresh breaker to OPEN
+void open(CircuitBreaker& breaker)
+{
+    for (int i = 0; i < THRESHOLD; i++) {
+        CHECK(breaker.allowRequest());
+        breaker.recordFailure();
+    }
+}
+
+void testOpens()
+{
+    CircuitBreaker breaker(THRESHOLD, OPEN_DURATION);
+    CHECK(breaker.state() == State::CLOSED);
+
+    // A success in between resets the consecutive count
+    breaker.recordFailure();
+    breaker.recordFailure();
+    breaker.recordSuccess();
+    breaker.recordFailure();
+    CHECK(breaker.state() == State::CLOSED);
+
+    breaker.recordFailure();
+    breaker.recordFailure();
+    CHECK(breaker.state() == State::OPEN);
+
+    bool probe = true;
+    CHECK(!breaker.allowRequest(&probe));
+    CHECK(!probe);
+    CHECK(breaker.rejectedCount() == 1);
+}
+
+void testProbeSuccess()
+{
+    CircuitBreaker breaker(THRESHOLD, OPEN_DURATION);
+    open(breaker);
+    waitOpenPeriod();
+
+    bool probe = false;
+    CHECK(breaker.allowRequest(&probe));
+    CHECK(probe);
+    CHECK(breaker.state() == State::HALF_OPEN);
+
+    // Only one probe at a time
+    bool second = true;
+    CHECK(!breaker.allowRequest(&second));
+    CHECK(!second);
+
+    breaker.recordSuccess();
+    CHECK(breaker.state() == State::CLOSED);
+    CHECK(breaker.allowRequest(&probe));
+    CHECK(!probe);
+}
+
+void testProbeFailure()
+{
+    CircuitBreaker breaker(THRESHOLD, OPEN_DURATION);
+    open(breaker);
+    waitOpenPeriod();
+
+    bool probe = false;
+    CHECK(breaker.allowRequest(&probe));
+    CHECK(probe);
+
+    // One failed probe reopens the circuit for a full period
+    breaker.recordFailure();
+    CHECK(breaker.state() == State::OPEN);
+    CHECK(!breaker.allowRequest());
+
+    waitOpenPeriod();
+    CHECK(breaker.allowRequest(&probe));
+    CHECK(probe);
+    breaker.recordSuccess();
+    CHECK(breaker.state() == State::CLOSED);
+}
+
+void testCancelledProbe()
+{
+    CircuitBreaker breaker(THRESHOLD, OPEN_DURATION);
+    open(breaker);
+    waitOpenPeriod();
+
+    bool probe = false;
+    CHECK(breaker.allowRequest(&probe));
+    CHECK(probe);
+    CHECK(!breaker.allowRequest());
+
+    // Cancelled before a response: no outcome, the next request probes
+    breaker.releaseProbe();
+    CHECK(breaker.state() == State::HALF_OPEN);
+
+    bool next = false;
+    CHECK(breaker.allowRequest(&next));
+    CHECK(next);
+    CHECK(!breaker.allowRequest());
+
+    breaker.recordSuccess();
+    CHECK(breaker.state() == State::CLOSED);
+}
+
+void testDisabled()
+{
+    // Threshold 0: never opens
+    CircuitBreaker breaker(0, OPEN_DURATION);
+    for (int i = 0; i < 10; i++) {
+        breaker.recordFailure();
+    }
+    CHECK(breaker.state() == State::CLOSED);
+    CHECK(breaker.allowRequest());
+}
+
+} // namespace
+
+int main()
+{
+    testOpens();
+    testProbeSuccess();
+    testProbeFailure();
+    testCancelledProbe();
+    testDisabled();
+    return Check::exitStatus();
+}
@@ -0,0 +1,170 @@
+/**
+ * PersistentQueue recovery test
+ *
+ * Writes records, damages the file the way a crash mid-append can (a
+ * torn payload under a published frame, a frame whose length runs past
+ * the tail), reopens it and checks that recover() keeps every record
+ * before the damage, drops the rest and leaves a queue that still takes
+ * new records.
+ *
+ * File offsets follow the layout in PersistentQueue.h: a one-page header
+ * (tail at byte 24), then 8-byte aligned frames of
+ * u32 length | u16 crc | u16 flags | payload.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+#include "Check.h"
+#include "PersistentQueue.h"
+
+namespace {
+
+constexpr size_t CAPACITY = 64 * 1024;
+constexpr long RING_OFFSET = 4096;
+constexpr long TAIL_OFFSET = 24;
+constexpr long FRAME_SIZE = 8;
+
+const char* const RECORDS[] = { "first", "second", "third" };
+
+std::string tempPath(const char* name)
+{
+    return "/tmp/the3_test_" + std::to_string(::getpid()) + "_" + name + ".queue";
+}
+
+// Frame offset of record `index` in a queue written from empty
+long frameOffset(size_t index)
+{
+    long offset = RING_OFFSET;
+    for (size_t i = 0; i < index; i++) {
+        offset += FRAME_SIZE + static_cast<long>((std::strlen(RECORDS[i]) + 7) & ~size_t(7));
+    }
+    return offset;
+}
+
+bool writeRecords(const std::string& path)
+{
+    std::remove(path.c_str());
+    PersistentQueue queue;
+    if (!queue.open(path, CAPACITY)) {
+        return false;
+    }
+    for (const char* record : RECORDS) {
+        if (!queue.append(record, std::strlen(record))) {
+            return false;
+        }
+    }
+    queue.sync(true);
+    return true;
+}
+
+void patch(const std::string& path, long offset, const void* data, size_t length)
+{
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(offset);
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(length));
+}
+
+std::string popFront(PersistentQueue& queue)
+{
+    const uint8_t* data;
+    size_t length;
+    if (!queue.peek(data, length)) {
+        return "<empty>";
+    }
+    std::string record(reinterpret_cast<const char*>(data), length);
+    queue.pop();
+    return record;
+}
+
+// After the damage only the first two records may survive, in order
+void checkRecovered(const std::string& path)
+{
+    {
+        PersistentQueue queue;
+        CHECK(queue.open(path, CAPACITY));
+        CHECK(queue.size() == 2);
+        CHECK(queue.getStats().corrupt == 1);
+
+        // The truncated tail takes new records
+        CHECK(queue.append("fourth", 6));
+        queue.sync(true);
+    }
+
+    PersistentQueue queue;
+    CHECK(queue.open(path, CAPACITY));
+    CHECK(queue.getStats().corrupt == 0);
+    CHECK(queue.size() == 3);
+    CHECK(popFront(queue) == "first");
+    CHECK(popFront(queue) == "second");
+    CHECK(popFront(queue) == "fourth");
+    CHECK(queue.empty());
+}
+
+void testIntact()
+{
+    std::string path = tempPath("intact");
+    CHECK(writeRecords(path));
+
+    PersistentQueue queue;
+    CHECK(queue.open(path, CAPACITY));
+    CHECK(queue.size() == 3);
+    CHECK(queue.getStats().corrupt == 0);
+    for (const char* record : RECORDS) {
+        CHECK(popFront(queue) == record);
+    }
+    CHECK(queue.empty());
+    queue.close();
+    std::remove(path.c_str());
+}
+
+void testTornPayload()
+{
+    // Frame and tail published, payload only partly on disk: CRC mismatch
+    std::string path = tempPath("torn");
+    CHECK(writeRecords(path));
+    const char garbage = 'X';
+    patch(path, frameOffset(2) + FRAME_SIZE + 1, &garbage, 1);
+
+    checkRecovered(path);
+    std::remove(path.c_str());
+}
+
+void testTruncatedFrame()
+{
+    // The tail covers only part of the last frame
+    std::string path = tempPath("truncated");
+    CHECK(writeRecords(path));
+    uint64_t tail = static_cast<uint64_t>(frameOffset(2) - RING_OFFSET + FRAME_SIZE);
+    patch(path, TAIL_OFFSET, &tail, sizeof(tail));
+
+    checkRecovered(path);
+    std::remove(path.c_str());
+}
+
+void testOversizedLength()
+{
+    // A length field written but not the payload behind it
+    std::string path = tempPath("length");
+    CHECK(writeRecords(path));
+    const uint32_t length = 1000;
+    patch(path, frameOffset(2), &length, sizeof(length));
+
+    checkRecovered(path);
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+int main()
+{
+    testIntact();
+    testTornPayload();
+    testTruncatedFrame();
+    testOversizedLength();
+    return Check::exitStatus();
+}
@@ -0,0 +1,168 @@
+/**
+ * TelemetryCodec round-trip test
+ *
+ * Encodes batches that exercise every code of the format (steady and
+ * irregular timestamp intervals, a clock step back, unchanged, slowly
+ * drifting and jumping floats, special float values, repeated and
+ * changing strings) and checks that decoding gives back every record
+ * bit for bit. A truncated batch must fail instead of returning made-up
+ * records.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "TelemetryCodec.h"
+
+namespace {
+
+using SensorData = SkinSensor::SensorData;
+
+const std::string DEVICE_ID = "THE3-SKIN-DEVICE-001";
+
+uint32_t bits(float value)
+{
+    uint32_t out;
+    std::memcpy(&out, &value, sizeof(out));
+    return out;
+}
+
+SensorData makeRecord(size_t i)
+{
+    SensorData data = SensorData();
+    data.pd1 = 100.0f + 0.01f * static_cast<float>(i % 7);
+    data.pd2 = 98.25f;                                          // Never changes
+    data.hz = (i % 10 == 0) ? 60.0f : 50.0f;
+    data.s1 = 45.0f + std::sin(static_cast<float>(i) * 0.1f);
+    data.s2 = (i % 3 == 0) ? -12.5f : 1.0e6f;                   // Large jumps
+    data.s3 = static_cast<float>(i) * 1.5f;
+    data.moistureLevel = (i == 5) ? std::numeric_limits<float>::infinity() : 65.0f;
+    data.temperatureC = (i == 6) ? -0.0f : 31.0f + 0.001f * static_cast<float>(i);
+    data.thicknessResult = "normal";
+    data.elasticityResult = (i % 4 == 0) ? "good" : "fair";
+    data.moistureLevelResult = (i < 10) ? "slightly_dry" : "";
+    data.patientName = (i < 12) ? "홍길동" : "Kim Minji";
+    data.birthDate = "1990-01-01";
+
+    // 1 s period with jitter, a stall, a step back and a large jump
+    uint64_t timestamp = 1792120200000ULL + i * 1000;
+    if (i % 5 == 1) {
+        timestamp += 3;
+    }
+    if (i == 8) {
+        timestamp += 120000;
+    }
+    if (i == 9) {
+        timestamp -= 5000;
+    }
+    if (i == 15) {
+        timestamp += 1ULL << 40;
+    }
+    data.timestamp = timestamp;
+    return data;
+}
+
+bool sameRecord(const SensorData& a, const SensorData& b)
+{
+    return a.timestamp == b.timestamp &&
+           bits(a.pd1) == bits(b.pd1) && bits(a.pd2) == bits(b.pd2) && bits(a.hz) == bits(b.hz) &&
+           bits(a.s1) == bits(b.s1) && bits(a.s2) == bits(b.s2) && bits(a.s3) == bits(b.s3) &&
+           bits(a.moistureLevel) == bits(b.moistureLevel) && bits(a.temperatureC) == bits(b.temperatureC) &&
+           a.thicknessResult == b.thicknessResult && a.elasticityResult == b.elasticityResult &&
+           a.moistureLevelResult == b.moistureLevelResult &&
+           a.patientName == b.patientName && a.birthDate == b.birthDate;
+}
+
+std::string encode(const std::vector<SensorData>& records)
+{
+    std::string out;
+    TelemetryCodec::Encoder encoder;
+    encoder.begin(out, DEVICE_ID);
+    for (const auto& record : records) {
+        encoder.add(record);
+    }
+    encoder.finish();
+    return out;
+}
+
+void testRoundTrip(size_t count)
+{
+    std::vector<SensorData> records;
+    for (size_t i = 0; i < count; i++) {
+        records.push_back(makeRecord(i));
+    }
+    std::string batch = encode(records);
+
+    std::string deviceId;
+    std::vector<SensorData> decoded;
+    CHECK(TelemetryCodec::decodeBatch(reinterpret_cast<const uint8_t*>(batch.data()), batch.size(),
+                                      deviceId, decoded));
+    CHECK(deviceId == DEVICE_ID);
+    CHECK(decoded.size() == records.size());
+    for (size_t i = 0; i < decoded.size() && i < records.size(); i++) {
+        if (!CHECK(sameRecord(decoded[i], records[i]))) {
+            std::fprintf(stderr, "  record %zu of %zu differs\n", i, count);
+        }
+    }
+}
+
+void testNaN()
+{
+    // NaN payload bits survive, not just "some NaN"
+    SensorData data = makeRecord(0);
+    uint32_t nanBits = 0x7FC01234u;
+    std::memcpy(&data.s1, &nanBits, sizeof(nanBits));
+    std::string batch = encode({ makeRecord(1), data, makeRecord(2) });
+
+    std::string deviceId;
+    std::vector<SensorData> decoded;
+    CHECK(TelemetryCodec::decodeBatch(reinterpret_cast<const uint8_t*>(batch.data()), batch.size(),
+                                      deviceId, decoded));
+    CHECK(decoded.size() == 3);
+    if (decoded.size() == 3) {
+        CHECK(bits(decoded[1].s1) == nanBits);
+        CHECK(sameRecord(decoded[2], makeRecord(2)));
+    }
+}
+
+void testTruncated()
+{
+    std::vector<SensorData> records;
+    for (size_t i = 0; i < 10; i++) {
+        records.push_back(makeRecord(i));
+    }
+    std::string batch = encode(records);
+
+    // Every prefix short of the whole batch is malformed
+    for (size_t length = 0; length < batch.size(); length++) {
+        std::string deviceId;
+        std::vector<SensorData> decoded;
+        bool ok = TelemetryCodec::decodeBatch(reinterpret_cast<const uint8_t*>(batch.data()), length,
+                                              deviceId, decoded);
+        if (!CHECK(!ok)) {
+            std::fprintf(stderr, "  prefix of %zu of %zu bytes decoded\n", length, batch.size());
+            break;
+        }
+        for (size_t i = 0; i < decoded.size(); i++) {
+            CHECK(sameRecord(decoded[i], records[i]));
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    testRoundTrip(0);
+    testRoundTrip(1);
+    testRoundTrip(50);
+    testNaN();
+    testTruncated();
+    return Check::exitStatus();
+}
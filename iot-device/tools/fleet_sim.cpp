@@ -0,0 +1,869 @@
+/**
+ * THE 3.0 fleet load generator - 가상 기기 N대로 백엔드 부하 테스트
+ *
+ * Runs N virtual devices in one process against the backend's device API.
+ * Each device is a SkinSensor on the simulation HAL with its own device
+ * ID, patient, simulation seed and VirtualClock (sensor conversion waits
+ * take no real time; the device clock follows the device's arrivals). All
+ * devices share one HttpClient, so requests are multiplexed by its async
+ * engine over --connections keep-alive sockets.
+ *
+ * Load is open-loop: a scheduler thread fires each device's arrivals on a
+ * TimerWheel whether or not earlier requests have completed, a small
+ * worker pool builds the payloads (sensor read + JSON), and latency is
+ * measured from the scheduled arrival, so a slow backend or a saturated
+ * generator shows up as latency rather than as a lower request rate. An
+ * arrival that finds the job queue full is counted as dropped.
+ *
+ * Arrival patterns (per device, mean period --interval or --rate):
+ *   constant : fixed period, device phases spread evenly over the period
+ *   poisson  : exponential gaps (independent arrivals)
+ *   burst    : fixed period, every device on the same phase
+ *   ramp     : devices join evenly over --ramp seconds, then constant
+ *
+ * Request mix (--mix, weights): skin-analysis POST, telemetry batch POST
+ * (--batch readings), treatment POST, health GET.
+ *
+ * Usage: the3-fleet-sim [--devices 100] [--duration 60] [--interval MS | --rate REQ/S]
+ *                       [--arrival constant|poisson|burst|ramp] [--ramp SEC]
+ *                       [--mix skin=70,telemetry=20,treatment=5,health=5] [--batch 10]
+ *                       [--workers N] [--connections 64] [--max-inflight N]
+ *                       [--retries 0] [--breaker] [--timeout 10] [--report 5]
+ *                       [--seed 1] [--server URL]
+ * THE3_SERVER_URL and THE3_API_KEY are used as for the device.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Clock.h"
+#include "Config.h"
+#include "HttpClient.h"
+#include "Payload.h"
+#include "SkinSensor.h"
+#include "TimerWheel.h"
+
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+std::atomic<bool> g_running(true);
+
+void signalHandler(int)
+{
+    g_running = false;
+}
+
+//==============================================================================
+// Options
+//==============================================================================
+
+enum Kind { SKIN, TELEMETRY, TREATMENT, HEALTH, KINDS };
+
+const char* const KIND_NAMES[KINDS] = { "skin-analysis", "telemetry", "treatment", "health" };
+
+enum class Arrival { CONSTANT, POISSON, BURST, RAMP };
+
+struct Options {
+    int devices = 100;
+    int durationSec = 60;
+    double intervalMs = Config::DATA_SEND_INTERVAL_MS;
+    double rate = 0.0;                  // Total arrivals/s; overrides intervalMs
+    Arrival arrival = Arrival::CONSTANT;
+    double rampSec = -1.0;              // Default: half the duration
+    double mix[KINDS] = { 70, 20, 5, 5 };
+    int batch = 10;
+    int workers = 0;                    // Default: hardware threads
+    int connections = Config::HTTP_ASYNC_MAX_CONNECTIONS;
+    int maxInFlight = Config::HTTP_ASYNC_QUEUE_CAPACITY;
+    int retries = 0;
+    bool breaker = false;
+    int timeoutSec = 10;
+    int reportSec = 5;
+    uint32_t seed = 1;
+    std::string server;
+};
+
+bool parseArrival(const std::string& name, Arrival& arrival)
+{
+    if (name == "constant") {
+        arrival = Arrival::CONSTANT;
+    } else if (name == "poisson") {
+        arrival = Arrival::POISSON;
+    } else if (name == "burst") {
+        arrival = Arrival::BURST;
+    } else if (name == "ramp") {
+        arrival = Arrival::RAMP;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// "skin=70,telemetry=20": unnamed kinds get weight 0
+bool parseMix(const std::string& text, double mix[KINDS])
+{
+    std::fill(mix, mix + KINDS, 0.0);
+    std::stringstream stream(text);
+    std::string item;
+    double total = 0.0;
+    while (std::getline(stream, item, ',')) {
+        size_t eq = item.find('=');
+        if (eq == std::string::npos) {
+            return false;
+        }
+        std::string name = item.substr(0, eq);
+        if (name == "skin") {
+            name = KIND_NAMES[SKIN];
+        }
+        int kind = 0;
+        while (kind < KINDS && name != KIND_NAMES[kind]) {
+            kind++;
+        }
+        double weight = std::atof(item.c_str() + eq + 1);
+        if (kind == KINDS || weight < 0.0) {
+            return false;
+        }
+        mix[kind] = weight;
+        total += weight;
+    }
+    return total > 0.0;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--breaker") {
+            options.breaker = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--devices") {
+            options.devices = std::atoi(value.c_str());
+        } else if (arg == "--duration") {
+            options.durationSec = std::atoi(value.c_str());
+        } else if (arg == "--interval") {
+            options.intervalMs = std::atof(value.c_str());
+        } else if (arg == "--rate") {
+            options.rate = std::atof(value.c_str());
+        } else if (arg == "--arrival") {
+            if (!parseArrival(value, options.arrival)) {
+                return false;
+            }
+        } else if (arg == "--ramp") {
+            options.rampSec = std::atof(value.c_str());
+        } else if (arg == "--mix") {
+            if (!parseMix(value, options.mix)) {
+                return false;
+            }
+        } else if (arg == "--batch") {
+            options.batch = std::atoi(value.c_str());
+        } else if (arg == "--workers") {
+            options.workers = std::atoi(value.c_str());
+        } else if (arg == "--connections") {
+            options.connections = std::atoi(value.c_str());
+        } else if (arg == "--max-inflight") {
+            options.maxInFlight = std::atoi(value.c_str());
+        } else if (arg == "--retries") {
+            options.retries = std::atoi(value.c_str());
+        } else if (arg == "--timeout") {
+            options.timeoutSec = std::atoi(value.c_str());
+        } else if (arg == "--report") {
+            options.reportSec = std::atoi(value.c_str());
+        } else if (arg == "--seed") {
+            options.seed = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (arg == "--server") {
+            options.server = value;
+        } else {
+            return false;
+        }
+    }
+
+    if (options.rate > 0.0) {
+        options.intervalMs = 1000.0 * options.devices / options.rate;
+    }
+    if (options.rampSec < 0.0) {
+        options.rampSec = options.durationSec / 2.0;
+    }
+    if (options.workers <= 0) {
+        options.workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return options.devices > 0 && options.durationSec > 0 && options.intervalMs > 0.0 && options.batch > 0 &&
+           options.connections > 0 && options.maxInFlight > 0 && options.retries >= 0 &&
+           options.timeoutSec > 0 && options.reportSec > 0;
+}
+
+//==============================================================================
+// Statistics
+//==============================================================================
+
+/**
+ * Log-linear latency histogram (microseconds): 32 linear buckets per
+ * power of two, so a percentile is within ~3% of the recorded value
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 5;
+    static constexpr int SUB = 1 << SUB_BITS;
+    static constexpr int BUCKETS = SUB * 40;
+
+    LatencyHistogram() : m_counts(BUCKETS, 0), m_count(0), m_max(0) {}
+
+    void record(uint64_t us)
+    {
+        m_counts[index(us)]++;
+        m_count++;
+        m_max = std::max(m_max, us);
+    }
+
+    void merge(const LatencyHistogram& other)
+    {
+        for (int i = 0; i < BUCKETS; i++) {
+            m_counts[i] += other.m_counts[i];
+        }
+        m_count += other.m_count;
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    void reset()
+    {
+        std::fill(m_counts.begin(), m_counts.end(), 0);
+        m_count = 0;
+        m_max = 0;
+    }
+
+    uint64_t count() const { return m_count; }
+    uint64_t max() const { return m_max; }
+
+    // Upper edge of the bucket holding the q-quantile
+    uint64_t percentile(double q) const
+    {
+        if (m_count == 0) {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(m_count)));
+        rank = std::max<uint64_t>(rank, 1);
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKETS; i++) {
+            seen += m_counts[i];
+            if (seen >= rank) {
+                return std::min(upper(i), m_max);
+            }
+        }
+        return m_max;
+    }
+
+private:
+    static int index(uint64_t us)
+    {
+        if (us < 2 * SUB) {
+            return static_cast<int>(us);
+        }
+        int msb = 63;
+        while (!(us >> msb)) {
+            msb--;
+        }
+        int shift = msb - SUB_BITS;
+        int i = shift * SUB + static_cast<int>(us >> shift);
+        return std::min(i, BUCKETS - 1);
+    }
+
+    static uint64_t upper(int i)
+    {
+        if (i < 2 * SUB) {
+            return static_cast<uint64_t>(i);
+        }
+        int shift = i / SUB - 1;
+        uint64_t top = static_cast<uint64_t>(i % SUB + SUB);
+        return ((top + 1) << shift) - 1;
+    }
+
+    std::vector<uint64_t> m_counts;
+    uint64_t m_count;
+    uint64_t m_max;
+};
+
+struct KindStats {
+    uint64_t ok = 0;
+    uint64_t http4xx = 0;
+    uint64_t http5xx = 0;
+    uint64_t transport = 0;             // Timeouts, refused connections, ...
+    uint64_t rejected = 0;              // Failed fast: async queue full, circuit open
+    LatencyHistogram latency;           // Scheduled arrival -> response
+    LatencyHistogram service;           // Submitted -> response
+
+    uint64_t completed() const { return ok + errors(); }
+    uint64_t errors() const { return http4xx + http5xx + transport + rejected; }
+
+    void merge(const KindStats& other)
+    {
+        ok += other.ok;
+        http4xx += other.http4xx;
+        http5xx += other.http5xx;
+        transport += other.transport;
+        rejected += other.rejected;
+        latency.merge(other.latency);
+        service.merge(other.service);
+    }
+};
+
+/**
+ * Counters shared by the workers (send lag) and the HTTP event loop
+ * (completions); the reporter takes per-interval snapshots
+ */
+class FleetStats {
+public:
+    struct Snapshot {
+        KindStats kinds[KINDS];
+        LatencyHistogram lag;           // Scheduled arrival -> request submitted
+        uint64_t sent = 0;
+        uint64_t dropped = 0;
+    };
+
+    void sent(uint64_t lagUs)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_interval.sent++;
+        m_interval.lag.record(lagUs);
+    }
+
+    void dropped()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_interval.dropped++;
+    }
+
+    void completed(Kind kind, const HttpClient::Response& response, uint64_t latencyUs, uint64_t serviceUs)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        KindStats& stats = m_interval.kinds[kind];
+        if (response.statusCode >= 200 && response.statusCode < 300) {
+            stats.ok++;
+        } else if (response.statusCode >= 500) {
+            stats.http5xx++;
+        } else if (response.statusCode >= 400) {
+            stats.http4xx++;
+        } else if (response.attempts == 0) {
+            stats.rejected++;
+        } else {
+            stats.transport++;
+        }
+        stats.latency.record(latencyUs);
+        stats.service.record(serviceUs);
+    }
+
+    // Interval since the previous call; also folded into the totals
+    Snapshot takeInterval()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Snapshot interval = m_interval;
+        for (int k = 0; k < KINDS; k++) {
+            m_total.kinds[k].merge(m_interval.kinds[k]);
+            m_interval.kinds[k] = KindStats();
+        }
+        m_total.lag.merge(m_interval.lag);
+        m_total.sent += m_interval.sent;
+        m_total.dropped += m_interval.dropped;
+        m_interval.lag.reset();
+        m_interval.sent = 0;
+        m_interval.dropped = 0;
+        return interval;
+    }
+
+    Snapshot total()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_total;
+    }
+
+private:
+    std::mutex m_mutex;
+    Snapshot m_interval;
+    Snapshot m_total;
+};
+
+//==============================================================================
+// Devices and jobs
+//==============================================================================
+
+struct Device {
+    std::mutex mutex;                   // One request of a device is built at a time
+    VirtualClock clock;
+    SkinSensor sensor;
+    std::string id;
+    Clock::TimePoint epoch;             // Device clock at the fleet start
+    std::mt19937 random;
+    std::string json;
+};
+
+struct Job {
+    uint32_t device;
+    Kind kind;
+    SteadyClock::time_point scheduled;
+};
+
+class JobQueue {
+public:
+    explicit JobQueue(size_t capacity) : m_capacity(capacity), m_closed(false), m_busy(0) {}
+
+    bool push(const Job& job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_jobs.size() >= m_capacity) {
+                return false;
+            }
+            m_jobs.push_back(job);
+        }
+        m_cv.notify_one();
+        return true;
+    }
+
+    // Blocks until a job is available; false once closed and empty
+    bool pop(Job& job)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this]() { return !m_jobs.empty() || m_closed; });
+        if (m_jobs.empty()) {
+            return false;
+        }
+        job = m_jobs.front();
+        m_jobs.pop_front();
+        m_busy++;
+        return true;
+    }
+
+    void done()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_busy--;
+    }
+
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_cv.notify_all();
+    }
+
+    // Queued or being built
+    size_t backlog()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_jobs.size() + m_busy;
+    }
+
+private:
+    size_t m_capacity;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Job> m_jobs;
+    bool m_closed;
+    size_t m_busy;
+};
+
+//==============================================================================
+// Fleet
+//==============================================================================
+
+class Fleet {
+public:
+    Fleet(const Options& options, HttpClient& client)
+        : m_options(options)
+        , m_client(client)
+        , m_queue(static_cast<size_t>(options.devices) * 2)
+        , m_random(options.seed)
+        , m_interval(std::chrono::duration_cast<Clock::Duration>(
+              std::chrono::duration<double, std::milli>(options.intervalMs)))
+        , m_stop(false)
+    {
+    }
+
+    bool createDevices()
+    {
+        // Every device gets its own simulation seed through the normal
+        // configuration path; done before any other thread starts
+        for (int i = 0; i < m_options.devices; i++) {
+            std::unique_ptr<Device> device(new Device());
+            char id[32];
+            std::snprintf(id, sizeof(id), "THE3-FLEET-%06d", i + 1);
+            device->id = id;
+            device->random.seed(m_options.seed * 7919u + static_cast<uint32_t>(i));
+
+            char patient[32];
+            char birthDate[16];
+            std::snprintf(patient, sizeof(patient), "Fleet Patient %06d", i + 1);
+            std::snprintf(birthDate, sizeof(birthDate), "%04d-%02d-%02d", 1950 + i % 50, 1 + i % 12, 1 + i % 28);
+
+            setenv("THE3_SIM_SEED", std::to_string(m_options.seed * 100003u + static_cast<uint32_t>(i)).c_str(), 1);
+            device->sensor.setClock(device->clock);
+            device->sensor.setAdcOversampling(Config::Hardware::ADC_SAMPLES_PER_READ, DecimationFilter::Type::BOXCAR);
+            if (!device->sensor.initialize()) {
+                std::fprintf(stderr, "Device %s failed to initialize\n", id);
+                return false;
+            }
+            device->sensor.setPatientInfo(patient, birthDate);
+            device->json.reserve(512);
+            m_devices.push_back(std::move(device));
+        }
+        return true;
+    }
+
+    void run()
+    {
+        m_start = SteadyClock::now();
+        m_end = m_start + std::chrono::seconds(m_options.durationSec);
+        for (auto& device : m_devices) {
+            device->epoch = device->clock.now();
+        }
+
+        for (int i = 0; i < m_options.workers; i++) {
+            m_workers.emplace_back(&Fleet::workerLoop, this);
+        }
+        std::thread scheduler(&Fleet::schedulerLoop, this);
+
+        std::printf("%6s %9s %9s %7s %9s %9s %9s %9s %9s %8s %9s %8s\n", "t (s)", "sent/s", "done/s", "err %",
+                    "p50 ms", "p90 ms", "p99 ms", "p99.9 ms", "max ms", "inflight", "lag p99", "dropped");
+        auto nextReport = m_start + std::chrono::seconds(m_options.reportSec);
+        while (g_running && SteadyClock::now() < m_end) {
+            std::this_thread::sleep_until(std::min(nextReport, m_end));
+            if (SteadyClock::now() >= nextReport) {
+                printInterval(m_stats.takeInterval(), m_options.reportSec);
+                nextReport += std::chrono::seconds(m_options.reportSec);
+            }
+        }
+
+        // Stop arrivals, let the workers empty the queue, then wait for the responses
+        {
+            std::lock_guard<std::mutex> lock(m_schedulerMutex);
+            m_stop = true;
+        }
+        Clock::system().notify(m_schedulerCv);
+        scheduler.join();
+        m_queue.close();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+        auto drainDeadline = SteadyClock::now() + std::chrono::seconds(m_options.timeoutSec + 1);
+        while (m_client.getPendingAsyncCount() > 0 && SteadyClock::now() < drainDeadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        m_elapsed = SteadyClock::now() - m_start;
+        m_stats.takeInterval();
+    }
+
+    void printSummary()
+    {
+        FleetStats::Snapshot total = m_stats.total();
+        double seconds = std::chrono::duration<double>(m_elapsed).count();
+
+        std::printf("\nSummary: %d devices, %.1f s, %d workers, %d connections\n",
+                    m_options.devices, seconds, m_options.workers, m_options.connections);
+        std::printf("  %-14s %9s %9s %8s %6s %6s %6s %6s %8s %8s %8s %9s %9s\n", "endpoint", "requests", "req/s",
+                    "ok", "4xx", "5xx", "net", "rej", "p50 ms", "p99 ms", "max ms", "svc p50", "svc p99");
+        KindStats all;
+        for (int k = 0; k < KINDS; k++) {
+            if (total.kinds[k].completed() > 0) {
+                printKind(KIND_NAMES[k], total.kinds[k], seconds);
+            }
+            all.merge(total.kinds[k]);
+        }
+        printKind("total", all, seconds);
+
+        uint64_t unanswered = total.sent - all.completed();
+        std::printf("  Sent %llu, unanswered %llu, dropped (generator saturated) %llu, send lag p99 %.2f ms max %.2f ms\n",
+                    static_cast<unsigned long long>(total.sent), static_cast<unsigned long long>(unanswered),
+                    static_cast<unsigned long long>(total.dropped),
+                    total.lag.percentile(0.99) / 1000.0, total.lag.max() / 1000.0);
+        double errorRate = total.sent > 0 ? 100.0 * static_cast<double>(all.errors() + unanswered) / total.sent : 0.0;
+        std::printf("  Error rate %.3f%%\n", errorRate);
+    }
+
+private:
+    void schedulerLoop()
+    {
+        // Arrival times are kept per device so each chain stays on its own schedule
+        TimerWheel wheel(Clock::system(), std::chrono::milliseconds(1), std::chrono::milliseconds(1));
+        std::vector<SteadyClock::time_point> next(m_devices.size());
+        std::function<void(uint32_t)> arrive;
+        arrive = [&](uint32_t index) {
+            if (!m_queue.push(Job{index, drawKind(), next[index]})) {
+                m_stats.dropped();
+            }
+            next[index] += gap();
+            if (next[index] < m_end) {
+                wheel.schedule(next[index], [&arrive, index]() { arrive(index); });
+            }
+        };
+
+        size_t devices = m_devices.size();
+        for (uint32_t i = 0; i < devices; i++) {
+            double share = static_cast<double>(i) / devices;
+            switch (m_options.arrival) {
+                case Arrival::CONSTANT: next[i] = m_start + scaled(m_interval, share); break;
+                case Arrival::POISSON:  next[i] = m_start + gap(); break;
+                case Arrival::BURST:    next[i] = m_start; break;
+                case Arrival::RAMP:
+                    next[i] = m_start + std::chrono::duration_cast<Clock::Duration>(
+                                            std::chrono::duration<double>(m_options.rampSec * share));
+                    break;
+            }
+            wheel.schedule(next[i], [&arrive, i]() { arrive(i); });
+        }
+
+        while (!wheel.empty()) {
+            wheel.runDue();
+            std::unique_lock<std::mutex> lock(m_schedulerMutex);
+            if (Clock::system().waitUntil(lock, m_schedulerCv, wheel.nextDeadline(), [this]() { return m_stop; })) {
+                break;
+            }
+        }
+    }
+
+    Kind drawKind()
+    {
+        double total = 0.0;
+        for (double weight : m_options.mix) {
+            total += weight;
+        }
+        double pick = std::uniform_real_distribution<double>(0.0, total)(m_random);
+        for (int k = 0; k < KINDS; k++) {
+            if (pick < m_options.mix[k]) {
+                return static_cast<Kind>(k);
+            }
+            pick -= m_options.mix[k];
+        }
+        return SKIN;
+    }
+
+    Clock::Duration gap()
+    {
+        if (m_options.arrival == Arrival::POISSON) {
+            double mean = std::chrono::duration<double>(m_interval).count();
+            double seconds = std::exponential_distribution<double>(1.0 / mean)(m_random);
+            return std::chrono::duration_cast<Clock::Duration>(std::chrono::duration<double>(seconds));
+        }
+        return m_interval;
+    }
+
+    static Clock::Duration scaled(Clock::Duration duration, double factor)
+    {
+        return Clock::Duration(static_cast<Clock::Duration::rep>(duration.count() * factor));
+    }
+
+    void workerLoop()
+    {
+        Job job;
+        while (m_queue.pop(job)) {
+            Device& device = *m_devices[job.device];
+            std::string endpoint;
+            std::string body;
+            {
+                std::lock_guard<std::mutex> lock(device.mutex);
+                // Device time follows its arrivals
+                device.clock.sleepUntil(device.epoch + (job.scheduled - m_start));
+                buildRequest(device, job.kind, endpoint, body);
+            }
+
+            auto submitted = SteadyClock::now();
+            m_stats.sent(micros(submitted - job.scheduled));
+
+            Kind kind = job.kind;
+            auto scheduled = job.scheduled;
+            FleetStats& stats = m_stats;
+            auto callback = [&stats, kind, scheduled, submitted](const HttpClient::Response& response) {
+                auto now = SteadyClock::now();
+                stats.completed(kind, response, micros(now - scheduled), micros(now - submitted));
+            };
+            if (kind == HEALTH) {
+                m_client.getAsync(endpoint, callback);
+            } else {
+                m_client.postAsync(endpoint, body, callback);
+            }
+            m_queue.done();
+        }
+    }
+
+    void buildRequest(Device& device, Kind kind, std::string& endpoint, std::string& body)
+    {
+        switch (kind) {
+            case SKIN:
+                endpoint = Config::API_ENDPOINT_SKIN;
+                body = Payload::buildSkinAnalysisJson(device.sensor.readSensorData(), device.id);
+                break;
+
+            case TELEMETRY:
+                endpoint = Config::API_ENDPOINT_TELEMETRY;
+                body = "[";
+                for (int i = 0; i < m_options.batch; i++) {
+                    device.json.clear();
+                    Payload::appendSkinAnalysisJson(device.json, device.sensor.readSensorData(), device.id);
+                    if (i > 0) {
+                        body.push_back(',');
+                    }
+                    body.append(device.json);
+                }
+                body.push_back(']');
+                break;
+
+            case TREATMENT: {
+                static const SkinSensor::TreatmentMode modes[] = {
+                    SkinSensor::TreatmentMode::VIBRATION, SkinSensor::TreatmentMode::IONTOPHORESIS,
+                    SkinSensor::TreatmentMode::HIGH_FREQUENCY, SkinSensor::TreatmentMode::LED_THERAPY
+                };
+                endpoint = Config::API_ENDPOINT_TREATMENT;
+                body = Payload::buildTreatmentJson(device.sensor.createTreatmentData(modes[device.random() % 4]),
+                                                   device.id);
+                break;
+            }
+
+            case HEALTH:
+            case KINDS:
+                endpoint = Config::API_ENDPOINT_HEALTH;
+                break;
+        }
+    }
+
+    static uint64_t micros(Clock::Duration duration)
+    {
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        return us > 0 ? static_cast<uint64_t>(us) : 0;
+    }
+
+    void printInterval(const FleetStats::Snapshot& interval, int seconds)
+    {
+        KindStats all;
+        for (const auto& kind : interval.kinds) {
+            all.merge(kind);
+        }
+        double done = static_cast<double>(all.completed());
+        std::printf("%6.0f %9.1f %9.1f %7.2f %9.2f %9.2f %9.2f %9.2f %9.2f %8zu %9.2f %8llu\n",
+                    std::chrono::duration<double>(SteadyClock::now() - m_start).count(),
+                    static_cast<double>(interval.sent) / seconds, done / seconds,
+                    done > 0 ? 100.0 * all.errors() / done : 0.0,
+                    all.latency.percentile(0.50) / 1000.0, all.latency.percentile(0.90) / 1000.0,
+                    all.latency.percentile(0.99) / 1000.0, all.latency.percentile(0.999) / 1000.0,
+                    all.latency.max() / 1000.0, m_client.getPendingAsyncCount(),
+                    interval.lag.percentile(0.99) / 1000.0, static_cast<unsigned long long>(interval.dropped));
+        std::fflush(stdout);
+    }
+
+    static void printKind(const char* name, const KindStats& stats, double seconds)
+    {
+        std::printf("  %-14s %9llu %9.1f %8llu %6llu %6llu %6llu %6llu %8.2f %8.2f %8.2f %9.2f %9.2f\n", name,
+                    static_cast<unsigned long long>(stats.completed()), stats.completed() / seconds,
+                    static_cast<unsigned long long>(stats.ok), static_cast<unsigned long long>(stats.http4xx),
+                    static_cast<unsigned long long>(stats.http5xx), static_cast<unsigned long long>(stats.transport),
+                    static_cast<unsigned long long>(stats.rejected),
+                    stats.latency.percentile(0.50) / 1000.0, stats.latency.percentile(0.99) / 1000.0,
+                    stats.latency.max() / 1000.0,
+                    stats.service.percentile(0.50) / 1000.0, stats.service.percentile(0.99) / 1000.0);
+    }
+
+    const Options& m_options;
+    HttpClient& m_client;
+
+    std::vector<std::unique_ptr<Device>> m_devices;
+    JobQueue m_queue;
+    std::vector<std::thread> m_workers;
+    FleetStats m_stats;
+
+    std::mt19937 m_random;              // Scheduler thread only
+    Clock::Duration m_interval;
+    SteadyClock::time_point m_start;
+    SteadyClock::time_point m_end;
+    Clock::Duration m_elapsed;
+
+    std::mutex m_schedulerMutex;
+    std::condition_variable m_schedulerCv;
+    bool m_stop;
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    options.server = Config::getServerUrl();
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+                     "Usage: %s [--devices 100] [--duration 60] [--interval MS | --rate REQ/S]\n"
+                     "          [--arrival constant|poisson|burst|ramp] [--ramp SEC]\n"
+                     "          [--mix skin=70,telemetry=20,treatment=5,health=5] [--batch 10]\n"
+                     "          [--workers N] [--connections 64] [--max-inflight N]\n"
+                     "          [--retries 0] [--breaker] [--timeout 10] [--report 5]\n"
+                     "          [--seed 1] [--server URL]\n", argv[0]);
+        return 1;
+    }
+
+    std::signal(SIGINT, signalHandler);
+    std::signal(SIGTERM, signalHandler);
+
+    // Per-device files and traces would be shared by every device
+    unsetenv("THE3_SIM_EEPROM");
+    unsetenv("THE3_I2C_TRACE");
+    unsetenv("THE3_I2C_REPLAY");
+
+    static const char* const arrivalNames[] = { "constant", "poisson", "burst", "ramp" };
+    std::printf("THE 3.0 fleet load generator: %d devices -> %s\n", options.devices, options.server.c_str());
+    std::printf("  %s arrivals, %.1f ms per device (%.1f req/s total), %d s, mix skin %.0f / telemetry %.0f"
+                " (x%d) / treatment %.0f / health %.0f\n",
+                arrivalNames[static_cast<int>(options.arrival)], options.intervalMs,
+                1000.0 * options.devices / options.intervalMs, options.durationSec,
+                options.mix[SKIN], options.mix[TELEMETRY], options.batch, options.mix[TREATMENT], options.mix[HEALTH]);
+
+    HttpClient client(options.server, Config::getEnvOrDefault("THE3_API_KEY", ""));
+    client.setTimeout(options.timeoutSec);
+    client.setAsyncQueueCapacity(static_cast<size_t>(options.maxInFlight));
+    client.setAsyncMaxConnections(static_cast<size_t>(options.connections));
+    client.retryPolicy().setMaxRetries(options.retries);
+    if (!options.breaker) {
+        // One breaker for the whole fleet would fail every device at once
+        client.circuitBreaker().setFailureThreshold(0);
+    }
+    if (!client.initialize()) {
+        std::fprintf(stderr, "Failed to initialize HTTP client\n");
+        return 1;
+    }
+
+    // Keep the per-device sensor logs out of the report
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    int status = 0;
+    {
+        Fleet fleet(options, client);
+        auto initStart = SteadyClock::now();
+        if (fleet.createDevices()) {
+            std::printf("  %d devices initialized in %.2f s\n\n", options.devices,
+                        std::chrono::duration<double>(SteadyClock::now() - initStart).count());
+            fleet.run();
+            fleet.printSummary();
+        } else {
+            status = 1;
+        }
+        client.cleanup();
+    }
+    std::cout.rdbuf(saved);
+    return status;
+}
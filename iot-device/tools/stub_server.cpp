@@ -0,0 +1,605 @@
+/**
+ * THE 3.0 backend stub - 기기 API(/api/iot) 스텁 HTTP 서버
+ *
+ * Answers the device API locally so the device, the daemon mode and the
+ * fleet load generator can run without the backend:
+ *   GET  /api/iot/health              {"success":true,"status":"UP"}
+ *   POST /api/iot/skin-analysis       {"success":true}
+ *   POST /api/iot/treatment           {"success":true}
+ *   POST /api/iot/telemetry/batch     {"success":true,"records":N}
+ *   POST /api/iot/telemetry/summary   {"success":true,"records":N}
+ * Anything else is 404; a missing or wrong X-API-Key is 401 when --api-key
+ * is given. A telemetry body the backend's DTOs cannot bind is 400, as on
+ * the real server: a batch record holds only scalar (String) fields, a
+ * summary record one more level of objects (channel statistics, result
+ * counts).
+ *
+ * One thread, poll() over keep-alive HTTP/1.1 connections. Responses can
+ * be delayed (--latency, --jitter) without blocking other connections and
+ * a fraction can fail with 503 (--error-rate), to exercise client timeouts,
+ * retries and error accounting. Request counts per endpoint are printed
+ * every --stats seconds and on SIGINT/SIGTERM.
+ *
+ * Usage: the3-stub-server [--port 8080] [--bind 127.0.0.1] [--latency MS]
+ *                         [--jitter MS] [--error-rate P] [--api-key KEY]
+ *                         [--stats SEC] [--seed N]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+constexpr size_t MAX_HEADER_BYTES = 64 * 1024;
+constexpr size_t MAX_BODY_BYTES = 16 * 1024 * 1024;
+constexpr size_t READ_CHUNK = 64 * 1024;
+
+std::atomic<bool> g_running(true);
+
+void signalHandler(int)
+{
+    g_running = false;
+}
+
+/**
+ * Count the records of a telemetry body: a JSON array of objects whose
+ * values may nest objects up to `maxObjectDepth` (1: scalars only)
+ * @return false if the body is not such an array
+ */
+bool countRecords(const std::string& body, int maxObjectDepth, size_t& records)
+{
+    records = 0;
+    int depth = 0;
+    bool inString = false;
+    bool started = false;
+    for (size_t i = 0; i < body.size(); i++) {
+        char c = body[i];
+        if (inString) {
+            if (c == '\\') {
+                i++;
+            } else if (c == '"') {
+                inString = false;
+            }
+            continue;
+        }
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            continue;
+        }
+        if (!started) {
+            // The body is one array
+            if (c != '[') {
+                return false;
+            }
+            started = true;
+            depth = 1;
+        } else if (depth == 0) {
+            return false;
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == '{') {
+            // Array elements are records; inside a record only objects, and not too deep
+            if (depth == 1) {
+                records++;
+            } else if (depth > maxObjectDepth) {
+                return false;
+            }
+            depth++;
+        } else if (c == '[') {
+            return false;
+        } else if (c == '}' || c == ']') {
+            depth--;
+        }
+    }
+    return started && depth == 0;
+}
+
+struct Options {
+    int port = 8080;
+    std::string bind = "127.0.0.1";
+    int latencyMs = 0;
+    int jitterMs = 0;
+    double errorRate = 0.0;
+    std::string apiKey;
+    int statsSec = 0;
+    uint32_t seed = 1;
+};
+
+struct Response {
+    SteadyClock::time_point due;
+    std::string data;
+};
+
+struct Connection {
+    int fd;
+    std::string in;
+    std::string out;
+    size_t outPos = 0;
+    std::deque<Response> pending;       // In request order; written when due
+    bool continueSent = false;          // "100 Continue" sent for the request being read
+    bool closing = false;               // Close once `out` is written
+};
+
+struct EndpointStats {
+    uint64_t requests = 0;
+    uint64_t bytesIn = 0;
+    uint64_t injectedErrors = 0;
+    uint64_t rejected = 0;              // 400: body the backend could not bind
+};
+
+class StubServer {
+public:
+    explicit StubServer(const Options& options)
+        : m_options(options), m_listenFd(-1), m_random(options.seed), m_total(0), m_lastTotal(0)
+        , m_lastStats(SteadyClock::now())
+    {
+    }
+
+    ~StubServer()
+    {
+        for (auto& conn : m_connections) {
+            ::close(conn->fd);
+        }
+        if (m_listenFd >= 0) {
+            ::close(m_listenFd);
+        }
+    }
+
+    bool listen()
+    {
+        m_listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (m_listenFd < 0) {
+            std::perror("socket");
+            return false;
+        }
+        int one = 1;
+        ::setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(m_options.port));
+        if (::inet_pton(AF_INET, m_options.bind.c_str(), &addr.sin_addr) != 1) {
+            std::fprintf(stderr, "Invalid bind address %s\n", m_options.bind.c_str());
+            return false;
+        }
+        if (::bind(m_listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+            ::listen(m_listenFd, SOMAXCONN) < 0) {
+            std::perror("bind/listen");
+            return false;
+        }
+        setNonBlocking(m_listenFd);
+        return true;
+    }
+
+    void run()
+    {
+        auto nextStats = SteadyClock::now() + std::chrono::seconds(m_options.statsSec);
+        std::vector<pollfd> fds;
+
+        while (g_running) {
+            auto now = SteadyClock::now();
+            for (auto& conn : m_connections) {
+                flushDue(*conn, now);
+            }
+
+            fds.clear();
+            fds.push_back(pollfd{m_listenFd, POLLIN, 0});
+            for (auto& conn : m_connections) {
+                short events = POLLIN;
+                if (conn->outPos < conn->out.size()) {
+                    events |= POLLOUT;
+                }
+                fds.push_back(pollfd{conn->fd, events, 0});
+            }
+
+            // Wake for the earliest delayed response (and the stats line)
+            int timeoutMs = 1000;
+            for (auto& conn : m_connections) {
+                if (!conn->pending.empty()) {
+                    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(conn->pending.front().due - now);
+                    timeoutMs = std::min<int>(timeoutMs, std::max<int>(0, static_cast<int>(wait.count()) + 1));
+                }
+            }
+            if (m_options.statsSec > 0) {
+                auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(nextStats - now);
+                timeoutMs = std::min<int>(timeoutMs, std::max<int>(0, static_cast<int>(wait.count())));
+            }
+
+            if (::poll(fds.data(), fds.size(), timeoutMs) < 0) {
+                continue;                       // EINTR on shutdown
+            }
+
+            if (fds[0].revents & POLLIN) {
+                acceptAll();
+            }
+            // New connections were appended after the polled ones
+            for (size_t i = 1; i < fds.size(); i++) {
+                Connection& conn = *m_connections[i - 1];
+                if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                    readFrom(conn);
+                }
+                writeTo(conn);
+            }
+            m_connections.erase(std::remove_if(m_connections.begin(), m_connections.end(),
+                                               [](const std::unique_ptr<Connection>& conn) {
+                                                   bool done = conn->closing && conn->pending.empty() &&
+                                                               conn->outPos >= conn->out.size();
+                                                   if (done) {
+                                                       ::close(conn->fd);
+                                                   }
+                                                   return done;
+                                               }),
+                                m_connections.end());
+
+            if (m_options.statsSec > 0 && SteadyClock::now() >= nextStats) {
+                printStats(false);
+                nextStats += std::chrono::seconds(m_options.statsSec);
+            }
+        }
+        printStats(true);
+    }
+
+private:
+    static void setNonBlocking(int fd)
+    {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    void acceptAll()
+    {
+        while (true) {
+            int fd = ::accept(m_listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                return;
+            }
+            setNonBlocking(fd);
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            std::unique_ptr<Connection> conn(new Connection());
+            conn->fd = fd;
+            m_connections.push_back(std::move(conn));
+        }
+    }
+
+    void readFrom(Connection& conn)
+    {
+        char buffer[READ_CHUNK];
+        while (true) {
+            ssize_t n = ::read(conn.fd, buffer, sizeof(buffer));
+            if (n > 0) {
+                conn.in.append(buffer, static_cast<size_t>(n));
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            } else {
+                // Peer closed: nothing more will be read or delivered
+                conn.closing = true;
+                conn.pending.clear();
+                conn.out.clear();
+                conn.outPos = 0;
+                return;
+            }
+        }
+        parseRequests(conn);
+    }
+
+    void parseRequests(Connection& conn)
+    {
+        while (!conn.closing) {
+            size_t headerEnd = conn.in.find("\r\n\r\n");
+            if (headerEnd == std::string::npos) {
+                if (conn.in.size() > MAX_HEADER_BYTES) {
+                    reply(conn, 431, "{\"success\":false}", true);
+                }
+                return;
+            }
+
+            std::string method, path, apiKey;
+            size_t contentLength = 0;
+            bool expectContinue = false;
+            bool close = false;
+            parseHeaders(conn.in.substr(0, headerEnd), method, path, contentLength, apiKey, expectContinue, close);
+
+            if (contentLength > MAX_BODY_BYTES) {
+                reply(conn, 413, "{\"success\":false}", true);
+                return;
+            }
+            size_t total = headerEnd + 4 + contentLength;
+            if (conn.in.size() < total) {
+                if (expectContinue && !conn.continueSent) {
+                    conn.out.append("HTTP/1.1 100 Continue\r\n\r\n");
+                    conn.continueSent = true;
+                }
+                return;
+            }
+
+            handle(conn, method, path, apiKey, conn.in.substr(headerEnd + 4, contentLength), close);
+            conn.in.erase(0, total);
+            conn.continueSent = false;
+        }
+    }
+
+    static void parseHeaders(const std::string& head, std::string& method, std::string& path,
+                             size_t& contentLength, std::string& apiKey, bool& expectContinue, bool& close)
+    {
+        size_t lineEnd = head.find("\r\n");
+        std::string requestLine = head.substr(0, lineEnd);
+        size_t sp1 = requestLine.find(' ');
+        size_t sp2 = requestLine.find(' ', sp1 + 1);
+        if (sp1 != std::string::npos && sp2 != std::string::npos) {
+            method = requestLine.substr(0, sp1);
+            path = requestLine.substr(sp1 + 1, sp2 - sp1 - 1);
+            close = requestLine.compare(sp2 + 1, std::string::npos, "HTTP/1.0") == 0;
+        }
+
+        size_t pos = (lineEnd == std::string::npos) ? head.size() : lineEnd + 2;
+        while (pos < head.size()) {
+            size_t end = head.find("\r\n", pos);
+            if (end == std::string::npos) {
+                end = head.size();
+            }
+            std::string line = head.substr(pos, end - pos);
+            pos = end + 2;
+
+            size_t colon = line.find(':');
+            if (colon == std::string::npos) {
+                continue;
+            }
+            std::string name = line.substr(0, colon);
+            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+            size_t valueStart = line.find_first_not_of(' ', colon + 1);
+            std::string value = (valueStart == std::string::npos) ? "" : line.substr(valueStart);
+
+            if (name == "content-length") {
+                contentLength = static_cast<size_t>(std::strtoull(value.c_str(), nullptr, 10));
+            } else if (name == "x-api-key") {
+                apiKey = value;
+            } else if (name == "expect") {
+                expectContinue = (value == "100-continue");
+            } else if (name == "connection") {
+                std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+                close = (value == "close");
+            }
+        }
+    }
+
+    void handle(Connection& conn, const std::string& method, const std::string& path, const std::string& apiKey,
+                const std::string& body, bool close)
+    {
+        m_total++;
+        EndpointStats& stats = m_endpoints[method + " " + path];
+        stats.requests++;
+        stats.bytesIn += body.size();
+
+        if (!m_options.apiKey.empty() && apiKey != m_options.apiKey) {
+            reply(conn, 401, "{\"success\":false,\"message\":\"Invalid API key\"}", close);
+            return;
+        }
+
+        bool known = true;
+        bool valid = true;
+        std::string json;
+        if (method == "GET" && path == "/api/iot/health") {
+            json = "{\"success\":true,\"status\":\"UP\"}";
+        } else if (method == "POST" && (path == "/api/iot/skin-analysis" || path == "/api/iot/treatment")) {
+            json = "{\"success\":true}";
+        } else if (method == "POST" && (path == "/api/iot/telemetry/batch" || path == "/api/iot/telemetry/summary")) {
+            // List<SkinAnalysisRequest>: Strings only; List<WindowSummaryRequest>: one level of objects
+            size_t records = 0;
+            valid = countRecords(body, path == "/api/iot/telemetry/batch" ? 1 : 2, records);
+            json = "{\"success\":true,\"records\":" + std::to_string(records) + "}";
+        } else {
+            known = false;
+        }
+
+        if (!known) {
+            reply(conn, 404, "{\"success\":false,\"message\":\"Not found\"}", close);
+            return;
+        }
+        if (!valid) {
+            stats.rejected++;
+            reply(conn, 400, "{\"success\":false,\"message\":\"Malformed telemetry body\"}", close);
+            return;
+        }
+        if (m_options.errorRate > 0.0 && m_uniform(m_random) < m_options.errorRate) {
+            stats.injectedErrors++;
+            reply(conn, 503, "{\"success\":false,\"message\":\"Injected error\"}", close);
+            return;
+        }
+        reply(conn, 200, json, close);
+    }
+
+    void reply(Connection& conn, int status, const std::string& json, bool close)
+    {
+        const char* reason = "OK";
+        switch (status) {
+            case 400: reason = "Bad Request"; break;
+            case 401: reason = "Unauthorized"; break;
+            case 404: reason = "Not Found"; break;
+            case 413: reason = "Payload Too Large"; break;
+            case 431: reason = "Request Header Fields Too Large"; break;
+            case 503: reason = "Service Unavailable"; break;
+        }
+        m_status[status]++;
+
+        Response response;
+        response.data = "HTTP/1.1 " + std::to_string(status) + " " + reason + "\r\n"
+                        "Content-Type: application/json\r\n"
+                        "Content-Length: " + std::to_string(json.size()) + "\r\n" +
+                        (close ? "Connection: close\r\n" : "") + "\r\n" + json;
+        response.due = SteadyClock::now() + delay();
+        conn.pending.push_back(std::move(response));
+
+        if (close || status == 413 || status == 431) {
+            // Nothing after this request is read
+            conn.in.clear();
+            conn.closing = true;
+        }
+    }
+
+    std::chrono::microseconds delay()
+    {
+        double ms = m_options.latencyMs;
+        if (m_options.jitterMs > 0) {
+            ms += (m_uniform(m_random) * 2.0 - 1.0) * m_options.jitterMs;
+        }
+        return std::chrono::microseconds(static_cast<int64_t>(std::max(0.0, ms) * 1000.0));
+    }
+
+    // Responses go out in request order, each no earlier than its due time
+    static void flushDue(Connection& conn, SteadyClock::time_point now)
+    {
+        while (!conn.pending.empty() && conn.pending.front().due <= now) {
+            conn.out.append(conn.pending.front().data);
+            conn.pending.pop_front();
+        }
+    }
+
+    void writeTo(Connection& conn)
+    {
+        flushDue(conn, SteadyClock::now());
+        while (conn.outPos < conn.out.size()) {
+            ssize_t n = ::send(conn.fd, conn.out.data() + conn.outPos, conn.out.size() - conn.outPos, MSG_NOSIGNAL);
+            if (n > 0) {
+                conn.outPos += static_cast<size_t>(n);
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+                return;
+            }
+            conn.closing = true;
+            conn.pending.clear();
+            break;
+        }
+        conn.out.clear();
+        conn.outPos = 0;
+    }
+
+    void printStats(bool final)
+    {
+        auto now = SteadyClock::now();
+        double seconds = std::chrono::duration<double>(now - m_lastStats).count();
+        double rate = seconds > 0.0 ? static_cast<double>(m_total - m_lastTotal) / seconds : 0.0;
+        m_lastStats = now;
+        m_lastTotal = m_total;
+
+        std::printf("%s %llu requests (%.0f req/s), %zu connections",
+                    final ? "[stub] Stopped:" : "[stub]",
+                    static_cast<unsigned long long>(m_total), rate, m_connections.size());
+        for (const auto& status : m_status) {
+            std::printf(", %d: %llu", status.first, static_cast<unsigned long long>(status.second));
+        }
+        std::printf("\n");
+        if (final) {
+            for (const auto& endpoint : m_endpoints) {
+                std::printf("  %-34s %10llu requests %12llu bytes in %8llu injected errors %8llu rejected\n",
+                            endpoint.first.c_str(),
+                            static_cast<unsigned long long>(endpoint.second.requests),
+                            static_cast<unsigned long long>(endpoint.second.bytesIn),
+                            static_cast<unsigned long long>(endpoint.second.injectedErrors),
+                            static_cast<unsigned long long>(endpoint.second.rejected));
+            }
+        }
+        std::fflush(stdout);
+    }
+
+    Options m_options;
+    int m_listenFd;
+    std::vector<std::unique_ptr<Connection>> m_connections;
+
+    std::mt19937 m_random;
+    std::uniform_real_distribution<double> m_uniform;
+
+    uint64_t m_total;
+    uint64_t m_lastTotal;
+    SteadyClock::time_point m_lastStats;
+    std::map<int, uint64_t> m_status;
+    std::map<std::string, EndpointStats> m_endpoints;
+};
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char* value = argv[++i];
+        if (arg == "--port") {
+            options.port = std::atoi(value);
+        } else if (arg == "--bind") {
+            options.bind = value;
+        } else if (arg == "--latency") {
+            options.latencyMs = std::atoi(value);
+        } else if (arg == "--jitter") {
+            options.jitterMs = std::atoi(value);
+        } else if (arg == "--error-rate") {
+            options.errorRate = std::atof(value);
+        } else if (arg == "--api-key") {
+            options.apiKey = value;
+        } else if (arg == "--stats") {
+            options.statsSec = std::atoi(value);
+        } else if (arg == "--seed") {
+            options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else {
+            return false;
+        }
+    }
+    return options.port > 0 && options.port < 65536 && options.latencyMs >= 0 && options.jitterMs >= 0 &&
+           options.errorRate >= 0.0 && options.errorRate <= 1.0 && options.statsSec >= 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+                     "Usage: %s [--port 8080] [--bind 127.0.0.1] [--latency MS] [--jitter MS]\n"
+                     "          [--error-rate P] [--api-key KEY] [--stats SEC] [--seed N]\n", argv[0]);
+        return 1;
+    }
+
+    // No SA_RESTART: poll() returns on the signal
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = signalHandler;
+    ::sigaction(SIGINT, &action, nullptr);
+    ::sigaction(SIGTERM, &action, nullptr);
+
+    StubServer server(options);
+    if (!server.listen()) {
+        return 1;
+    }
+    std::printf("[stub] Listening on http://%s:%d (latency %d ms +/- %d, error rate %.3f%s)\n",
+                options.bind.c_str(), options.port, options.latencyMs, options.jitterMs, options.errorRate,
+                options.apiKey.empty() ? "" : ", API key required");
+    std::fflush(stdout);
+
+    server.run();
+    return 0;
+}
@@ -3,6 +3,7 @@ package lsj.spring.project.controller;
 import lsj.spring.project.dto.ApiResponse;
 import lsj.spring.project.dto.SkinAnalysisRequest;
 import lsj.spring.project.dto.TreatmentDataRequest;
+import lsj.spring.project.dto.WindowSummaryRequest;
 import lsj.spring.project.service.AdminDataService;
 import lsj.spring.project.vo.AdminData;
 import org.slf4j.Logger;
@@ -248,6 +249,82 @@ public class IoTApiController {
         return ResponseEntity.ok(ApiResponse.success("All telemetry data processed successfully", responseData));
     }
 
+    /**
+     * 구간 요약 텔레메트리 수신 (Batch)
+     * POST /api/iot/telemetry/summary
+     *
+     * THE3_UPLOAD_MODE=summary인 기기가 구간마다 보내는 요약 레코드 배열.
+     * 요약 1건을 측정 기록 1건으로 저장: 센서 값은 채널 평균, 결과는 구간에서 가장 많이 나온 값
+     */
+    @PostMapping("/telemetry/summary")
+    public ResponseEntity<ApiResponse<Map<String, Object>>> receiveSummaryTelemetry(
+            @RequestBody List<WindowSummaryRequest> requests,
+            @RequestHeader(value = "X-API-Key", required = false) String apiKey) {
+
+        logger.info("Received summary telemetry data - Count: {}", requests.size());
+
+        int successCount = 0;
+        int failCount = 0;
+
+        for (WindowSummaryRequest request : requests) {
+            try {
+                AdminData adminData = new AdminData();
+                adminData.setUname(request.getPatientName());
+                adminData.setUbdate(request.getBirthDate());
+                adminData.setPd1(mean(request.getPd1()));
+                adminData.setPd2(mean(request.getPd2()));
+                adminData.setS1(mean(request.getS1()));
+                adminData.setS2(mean(request.getS2()));
+                adminData.setS3(mean(request.getS3()));
+                adminData.setMoistureLev(mean(request.getMoistureLevel()));
+                adminData.setThicknessRes(mostFrequent(request.getThicknessResult()));
+                adminData.setElasticityRes(mostFrequent(request.getElasticityResult()));
+                adminData.setMoistureLevRes(mostFrequent(request.getMoistureLevelResult()));
+
+                adminDataService.newAdminDataLog(adminData);
+                successCount++;
+            } catch (Exception e) {
+                logger.error("Failed to process summary for device {}: {}",
+                        request.getDeviceId(), e.getMessage());
+                failCount++;
+            }
+        }
+
+        Map<String, Object> responseData = new HashMap<>();
+        responseData.put("totalReceived", requests.size());
+        responseData.put("successCount", successCount);
+        responseData.put("failCount", failCount);
+        responseData.put("processedAt", System.currentTimeMillis());
+
+        if (failCount > 0) {
+            return ResponseEntity.ok(ApiResponse.success(
+                    String.format("Summary processing completed with %d failures", failCount), responseData));
+        }
+
+        return ResponseEntity.ok(ApiResponse.success("All summary data processed successfully", responseData));
+    }
+
+    // 채널 평균 (채널이 없으면 null)
+    private static String mean(WindowSummaryRequest.ChannelSummary channel) {
+        return channel != null ? channel.getMean() : null;
+    }
+
+    // 측정 수가 가장 많은 결과 (결과가 없으면 null)
+    private static String mostFrequent(Map<String, String> counts) {
+        String result = null;
+        long best = -1;
+        if (counts != null) {
+            for (Map.Entry<String, String> entry : counts.entrySet()) {
+                long count = Long.parseLong(entry.getValue());
+                if (count > best) {
+                    best = count;
+                    result = entry.getKey();
+                }
+            }
+        }
+        return result;
+    }
+
     /**
      * 기기별 데이터 조회
      * GET /api/iot/data?patientName=홍길동
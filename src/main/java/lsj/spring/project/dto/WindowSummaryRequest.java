@@ -0,0 +1,273 @@
+package lsj.spring.project.dto;
+
+import java.util.Map;
+
+/**
+ * IoT 피부 측정 기기에서 전송하는 구간 요약 DTO (THE3_UPLOAD_MODE=summary)
+ * 구간(THE3_AGGREGATION_WINDOW_SEC)마다 측정값 대신 채널별 통계와 결과 개수 1건 전송
+ *
+ * C++ 임베디드 모듈에서 전송하는 JSON 예시:
+ * {
+ *   "deviceId": "DEVICE001",
+ *   "recordType": "summary",
+ *   "patientName": "홍길동",
+ *   "birthDate": "1990-01-01",
+ *   "windowStart": 1700000000000,
+ *   "windowEnd": 1700000060000,
+ *   "first": 1700000000412,
+ *   "last": 1700000059412,
+ *   "samples": 60,
+ *   "pd1": {"min": 120.5, "max": 131.2, "mean": 125.4, "stddev": 2.1, "p10": 122.8, "p50": 125.3, "p90": 128.1},
+ *   ...
+ *   "moistureLevelResult": {"adequate": 58, "slightly_dry": 2},
+ *   ...
+ * }
+ */
+public class WindowSummaryRequest {
+    private String deviceId;        // 기기 고유 ID
+    private String recordType;      // "summary"
+    private String patientName;     // 환자 이름
+    private String birthDate;       // 생년월일
+
+    // 구간 (Unix ms)
+    private String windowStart;     // 구간 시작
+    private String windowEnd;       // 구간 끝
+    private String first;           // 첫 측정 시각
+    private String last;            // 마지막 측정 시각
+    private String samples;         // 측정 수
+
+    // 채널별 통계
+    private ChannelSummary pd1;             // 광센서 1
+    private ChannelSummary pd2;             // 광센서 2
+    private ChannelSummary s1;              // 센서 1
+    private ChannelSummary s2;              // 센서 2
+    private ChannelSummary s3;              // 센서 3
+    private ChannelSummary moistureLevel;   // 수분 레벨
+    private ChannelSummary temperatureC;    // 온도
+
+    // 결과별 측정 수 (예: "adequate" -> "58")
+    private Map<String, String> moistureLevelResult;    // 수분 레벨 결과
+    private Map<String, String> elasticityResult;       // 탄력 측정 결과
+    private Map<String, String> thicknessResult;        // 두께 측정 결과
+
+    /**
+     * 한 채널의 구간 통계 (최소, 최대, 평균, 표준편차, 10/50/90 분위수)
+     */
+    public static class ChannelSummary {
+        private String min;
+        private String max;
+        private String mean;
+        private String stddev;
+        private String p10;
+        private String p50;
+        private String p90;
+
+        public String getMin() {
+            return min;
+        }
+
+        public void setMin(String min) {
+            this.min = min;
+        }
+
+        public String getMax() {
+            return max;
+        }
+
+        public void setMax(String max) {
+            this.max = max;
+        }
+
+        public String getMean() {
+            return mean;
+        }
+
+        public void setMean(String mean) {
+            this.mean = mean;
+        }
+
+        public String getStddev() {
+            return stddev;
+        }
+
+        public void setStddev(String stddev) {
+            this.stddev = stddev;
+        }
+
+        public String getP10() {
+            return p10;
+        }
+
+        public void setP10(String p10) {
+            this.p10 = p10;
+        }
+
+        public String getP50() {
+            return p50;
+        }
+
+        public void setP50(String p50) {
+            this.p50 = p50;
+        }
+
+        public String getP90() {
+            return p90;
+        }
+
+        public void setP90(String p90) {
+            this.p90 = p90;
+        }
+    }
+
+    public String getDeviceId() {
+        return deviceId;
+    }
+
+    public void setDeviceId(String deviceId) {
+        this.deviceId = deviceId;
+    }
+
+    public String getRecordType() {
+        return recordType;
+    }
+
+    public void setRecordType(String recordType) {
+        this.recordType = recordType;
+    }
+
+    public String getPatientName() {
+        return patientName;
+    }
+
+    public void setPatientName(String patientName) {
+        this.patientName = patientName;
+    }
+
+    public String getBirthDate() {
+        return birthDate;
+    }
+
+    public void setBirthDate(String birthDate) {
+        this.birthDate = birthDate;
+    }
+
+    public String getWindowStart() {
+        return windowStart;
+    }
+
+    public void setWindowStart(String windowStart) {
+        this.windowStart = windowStart;
+    }
+
+    public String getWindowEnd() {
+        return windowEnd;
+    }
+
+    public void setWindowEnd(String windowEnd) {
+        this.windowEnd = windowEnd;
+    }
+
+    public String getFirst() {
+        return first;
+    }
+
+    public void setFirst(String first) {
+        this.first = first;
+    }
+
+    public String getLast() {
+        return last;
+    }
+
+    public void setLast(String last) {
+        this.last = last;
+    }
+
+    public String getSamples() {
+        return samples;
+    }
+
+    public void setSamples(String samples) {
+        this.samples = samples;
+    }
+
+    public ChannelSummary getPd1() {
+        return pd1;
+    }
+
+    public void setPd1(ChannelSummary pd1) {
+        this.pd1 = pd1;
+    }
+
+    public ChannelSummary getPd2() {
+        return pd2;
+    }
+
+    public void setPd2(ChannelSummary pd2) {
+        this.pd2 = pd2;
+    }
+
+    public ChannelSummary getS1() {
+        return s1;
+    }
+
+    public void setS1(ChannelSummary s1) {
+        this.s1 = s1;
+    }
+
+    public ChannelSummary getS2() {
+        return s2;
+    }
+
+    public void setS2(ChannelSummary s2) {
+        this.s2 = s2;
+    }
+
+    public ChannelSummary getS3() {
+        return s3;
+    }
+
+    public void setS3(ChannelSummary s3) {
+        this.s3 = s3;
+    }
+
+    public ChannelSummary getMoistureLevel() {
+        return moistureLevel;
+    }
+
+    public void setMoistureLevel(ChannelSummary moistureLevel) {
+        this.moistureLevel = moistureLevel;
+    }
+
+    public ChannelSummary getTemperatureC() {
+        return temperatureC;
+    }
+
+    public void setTemperatureC(ChannelSummary temperatureC) {
+        this.temperatureC = temperatureC;
+    }
+
+    public Map<String, String> getMoistureLevelResult() {
+        return moistureLevelResult;
+    }
+
+    public void setMoistureLevelResult(Map<String, String> moistureLevelResult) {
+        this.moistureLevelResult = moistureLevelResult;
+    }
+
+    public Map<String, String> getElasticityResult() {
+        return elasticityResult;
+    }
+
+    public void setElasticityResult(Map<String, String> elasticityResult) {
+        this.elasticityResult = elasticityResult;
+    }
+
+    public Map<String, String> getThicknessResult() {
+        return thicknessResult;
+    }
+
+    public void setThicknessResult(Map<String, String> thicknessResult) {
+        this.thicknessResult = thicknessResult;
+    }
+}